@@ -23,7 +23,7 @@ namespace alg
 	// Just a random 64 bit prime number.
 	constexpr uint64_t MmhSeed = 0x6FA9DE0959342D4B;
 
-	uint64_t MurmurHash64A(const void* key, int len, uint64_t seed)
+	uint64_t MurmurHash64A(const void* key, size_t len, uint64_t seed)
 	{
 		const uint64_t m = BIG_CONSTANT(0xc6a4a7935bd1e995);
 		const int      r = 47;
@@ -73,7 +73,7 @@ namespace alg
 		return h;
 	}
 
-	uint64_t MurmurHash(const void* key, int len)
+	uint64_t MurmurHash(const void* key, size_t len)
 	{
 		return MurmurHash64A(key, len, MmhSeed);
 	}
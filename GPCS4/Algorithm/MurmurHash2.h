@@ -5,8 +5,8 @@
 namespace alg
 {
 
-	uint64_t MurmurHash(const void* key, int len);
+	uint64_t MurmurHash(const void* key, size_t len);
 
-	uint64_t MurmurHash64A(const void* key, int len, uint64_t seed);
+	uint64_t MurmurHash64A(const void* key, size_t len, uint64_t seed);
 
 }  // namespace alg
\ No newline at end of file
@@ -4,9 +4,10 @@
 // due to not understanding clang-specific directives, like "__attribute__"
 
 // "__INTELLISENSE__" macro works for me using VS2017,
-// but may not work in other situations, use `__clang__` macro as a workaround
+// but may not work in other situations, use `__clang__` macro as a workaround.
+// GCC understands these directives too, its intrinsic headers rely on them.
 
-#if defined(__INTELLISENSE__) || !defined(__clang__)
+#if defined(__INTELLISENSE__) || (!defined(__clang__) && !defined(__GNUC__))
 
 #define __attribute__(x) 
 
@@ -13,6 +13,16 @@ Emulator::Emulator()
 {
 	m_cpu = std::make_shared<VirtualCPU>();
 	m_gpu = std::make_shared<sce::VirtualGPU>();
+
+	std::weak_ptr<sce::VirtualGPU> gpu = m_gpu;
+	m_cpu->allocator().addUnmapCallback(
+		[gpu](void* start, size_t size)
+		{
+			if (auto ptr = gpu.lock())
+			{
+				ptr->onMemoryUnmap(start, size);
+			}
+		});
 }
 
 Emulator::~Emulator() {}
@@ -1,6 +1,8 @@
 #include "Memory.h"
+#include "MemoryWatch.h"
 
 #include "SceModules/sce_errors.h"
+#include <cstring>
 #include <mutex>
 
 LOG_CHANNEL(Memory);
@@ -140,17 +142,31 @@ int32_t MemoryAllocator::mapDirectMemory(
 
 int32_t MemoryAllocator::memoryUnmap(void* addr, size_t len)
 {
-	plat::VMFree(addr);
-
 	auto iter = findMemoryBlock(addr);
 	if (iter.has_value())
 	{
+		// Let observers drop what is backed by this
+		// block while the memory is still mapped.
+		void*  start = reinterpret_cast<void*>((*iter)->start);
+		size_t size  = (*iter)->size;
+		for (const auto& callback : m_unmapCallbacks)
+		{
+			callback(start, size);
+		}
+
 		m_memBlocks.erase(*iter);
 	}
 
+	plat::VMFree(addr);
+
 	return SCE_OK;
 }
 
+void MemoryAllocator::addUnmapCallback(UnmapCallback callback)
+{
+	m_unmapCallbacks.push_back(std::move(callback));
+}
+
 int32_t MemoryAllocator::checkedReleaseDirectMemory(int64_t start, size_t len)
 {
 	// umemory::VMFree(reinterpret_cast<void*>(start));
@@ -195,6 +211,35 @@ int32_t MemoryAllocator::queryMemoryProtection(
 	return err;
 }
 
+bool MemoryAllocator::isWatchableRange(void* addr, size_t len)
+{
+	bool ret = false;
+	do
+	{
+		auto iter = findMemoryBlock(addr);
+		if (!iter)
+		{
+			break;
+		}
+
+		size_t start = reinterpret_cast<size_t>(addr);
+		if (start + len > (*iter)->start + (*iter)->size)
+		{
+			break;
+		}
+
+		// Write protecting code or read only memory
+		// would change the protection seen by the game.
+		if (convertProtectFlags((*iter)->protection) != plat::VMPF_CPU_RW)
+		{
+			break;
+		}
+
+		ret = true;
+	} while (false);
+	return ret;
+}
+
 // TODO:
 // for malloc series functions, we need to implement somewhat memory pool
 // algorithm, Nginx Slab may be a choice.
@@ -416,7 +461,8 @@ MemoryAllocator::findMemoryBlock(void* addr)
 
 //////////////////////////////////////////////////////////////////////////
 
-MemoryController::MemoryController()
+MemoryController::MemoryController(MemoryWriteWatch* writeWatch) :
+	m_writeWatch(writeWatch)
 {
 }
 
@@ -426,8 +472,12 @@ MemoryController::~MemoryController()
 
 void MemoryController::OnMemoryRead(void* address, size_t size)
 {
+	m_writeWatch->resolve(address, size);
 }
 
 void MemoryController::OnMemoryWrite(void* address, size_t size)
 {
+	// Resolves pending readbacks first, a partial
+	// write must not lose the rest of them.
+	m_writeWatch->markDirty(address, size);
 }
\ No newline at end of file
@@ -7,8 +7,10 @@
 #include "SceLibkernel/sce_kernel_memory.h"
 #include "tinydbr/memory_callback.h"
 
+#include <functional>
 #include <list>
 #include <optional>
+#include <vector>
 
 // The emulated target process's memory must be allocated using this class.
 // Emulator itself's memory is free to use 'new', 'malloc' or functions in UtilMemory.
@@ -29,6 +31,9 @@ private:
 	using MemoryBlockList = std::list<MemoryBlock>;
 
 public:
+	// Called with the range of a block right before it is unmapped.
+	using UnmapCallback = std::function<void(void* start, size_t size)>;
+
 	MemoryAllocator();
 	~MemoryAllocator();
 
@@ -80,6 +85,17 @@ public:
 		void**    end,
 		uint32_t* prot);
 
+	// Whether the range lies in a single block mapped as
+	// plain read/write data, which can be write watched.
+	bool isWatchableRange(
+		void*  addr,
+		size_t len);
+
+	// Registers an observer of unmapped blocks.
+	// Higher layers use this to drop state backed by
+	// the block, e.g. GPU resources in guest memory.
+	void addUnmapCallback(UnmapCallback callback);
+
 	// C functions
 
 	void* sce_malloc(size_t size);
@@ -106,12 +122,16 @@ private:
 private:
 	util::sync::Spinlock m_lock;
 	MemoryBlockList m_memBlocks;
+
+	std::vector<UnmapCallback> m_unmapCallbacks;
 };
 
+class MemoryWriteWatch;
+
 class MemoryController : public MemoryCallback
 {
 public:
-	MemoryController();
+	MemoryController(MemoryWriteWatch* writeWatch);
 	virtual ~MemoryController();
 
 
@@ -121,5 +141,5 @@ private:
 	void OnMemoryWrite(void* address, size_t size) override;
 
 private:
-
+	MemoryWriteWatch* m_writeWatch;
 };
@@ -0,0 +1,778 @@
+#include "MemoryWatch.h"
+#include "Memory.h"
+#include "PlatMemory.h"
+
+#include <algorithm>
+#include <thread>
+
+LOG_CHANNEL(Emulator.MemoryWatch);
+
+// Last page a thread marked dirty, and the protect epoch
+// at that time. The page can't have been protected again
+// as long as the epoch hasn't changed.
+struct DirtyPageCache
+{
+	size_t   page         = SIZE_MAX;
+	uint64_t protectEpoch = 0;
+};
+
+static thread_local DirtyPageCache t_dirtyPage;
+
+MemoryWriteWatch::MemoryWriteWatch(MemoryAllocator& allocator) :
+	m_allocator(allocator)
+{
+}
+
+MemoryWriteWatch::~MemoryWriteWatch()
+{
+}
+
+bool MemoryWriteWatch::install()
+{
+	plat::ExceptionHandler handler;
+	handler.callback = &exceptionHandler;
+	handler.param    = this;
+	m_installed      = plat::addExceptionHandler(handler);
+	if (!m_installed)
+	{
+		LOG_WARN("install exception handler failed, memory write watch is disabled.");
+	}
+	return m_installed;
+}
+
+void MemoryWriteWatch::uninstall()
+{
+	if (m_installed)
+	{
+		plat::ExceptionHandler handler;
+		handler.callback = &exceptionHandler;
+		handler.param    = this;
+		plat::removeExceptionHandler(handler);
+		m_installed = false;
+	}
+}
+
+bool MemoryWriteWatch::watch(void* start, size_t size)
+{
+	bool ret = false;
+	do
+	{
+		if (!m_installed || !size)
+		{
+			break;
+		}
+
+		if (!m_allocator.isWatchableRange(start, size))
+		{
+			break;
+		}
+
+		std::lock_guard<util::sync::Spinlock> guard(m_lock);
+
+		size_t address   = reinterpret_cast<size_t>(start);
+		size_t firstPage = address / plat::VM_PAGE_SIZE;
+		size_t lastPage  = (address + size - 1) / plat::VM_PAGE_SIZE;
+
+		// Protect pages nobody watched before,
+		// one call per run of such pages.
+		size_t runStart  = 0;
+		size_t runLength = 0;
+		for (size_t page = firstPage; page <= lastPage; ++page)
+		{
+			auto&    group = m_groups[page / PagesPerGroup];
+			size_t   index = page % PagesPerGroup;
+			uint64_t bit   = 1ull << index;
+
+			LOG_ASSERT(group.refs[index] != UINT16_MAX, "too many watches on a single page.");
+			if (group.refs[index]++ == 0)
+			{
+				m_watchedPages.fetch_add(1, std::memory_order_relaxed);
+				group.watched |= bit;
+				group.dirty &= ~bit;
+
+				runStart = runLength ? runStart : page;
+				++runLength;
+			}
+			else if (runLength)
+			{
+				protectPages(runStart, runLength, false);
+				runLength = 0;
+			}
+		}
+
+		if (runLength)
+		{
+			protectPages(runStart, runLength, false);
+		}
+
+		ret = true;
+	} while (false);
+	return ret;
+}
+
+void MemoryWriteWatch::unwatch(void* start, size_t size)
+{
+	if (!size)
+	{
+		return;
+	}
+
+	std::lock_guard<util::sync::Spinlock> guard(m_lock);
+
+	size_t address   = reinterpret_cast<size_t>(start);
+	size_t firstPage = address / plat::VM_PAGE_SIZE;
+	size_t lastPage  = (address + size - 1) / plat::VM_PAGE_SIZE;
+
+	// Give write access back to pages which
+	// are still protected and no longer watched.
+	size_t runStart  = 0;
+	size_t runLength = 0;
+	for (size_t page = firstPage; page <= lastPage; ++page)
+	{
+		auto iter = m_groups.find(page / PagesPerGroup);
+		if (iter == m_groups.end())
+		{
+			continue;
+		}
+
+		auto&    group = iter->second;
+		size_t   index = page % PagesPerGroup;
+		uint64_t bit   = 1ull << index;
+
+		bool release = group.refs[index] != 0 && --group.refs[index] == 0;
+		if (release)
+		{
+			m_watchedPages.fetch_sub(1, std::memory_order_relaxed);
+			bool isProtected = !(group.dirty & bit);
+
+			group.watched &= ~bit;
+			group.dirty &= ~bit;
+			group.epochs[index] = 0;
+
+			if (isProtected)
+			{
+				runStart = runLength ? runStart : page;
+				++runLength;
+				continue;
+			}
+		}
+
+		if (runLength)
+		{
+			protectPages(runStart, runLength, true);
+			runLength = 0;
+		}
+	}
+
+	if (runLength)
+	{
+		protectPages(runStart, runLength, true);
+	}
+
+	for (size_t group = firstPage / PagesPerGroup; group <= lastPage / PagesPerGroup; ++group)
+	{
+		auto iter = m_groups.find(group);
+		if (iter != m_groups.end() &&
+			iter->second.watched == 0 &&
+			iter->second.fenced == 0 &&
+			iter->second.resolving == 0)
+		{
+			m_groups.erase(iter);
+		}
+	}
+}
+
+void MemoryWriteWatch::markDirty(void* start, size_t size)
+{
+	if (!m_installed || !size)
+	{
+		return;
+	}
+
+	resolve(start, size);
+
+	if (m_watchedPages.load(std::memory_order_relaxed) == 0)
+	{
+		return;
+	}
+
+	size_t   address      = reinterpret_cast<size_t>(start);
+	size_t   firstPage    = address / plat::VM_PAGE_SIZE;
+	size_t   lastPage     = (address + size - 1) / plat::VM_PAGE_SIZE;
+	uint64_t protectEpoch = m_protectEpoch.load(std::memory_order_acquire);
+
+	// Most instrumented writes hit the same page in a row.
+	if (firstPage == lastPage &&
+		t_dirtyPage.page == firstPage &&
+		t_dirtyPage.protectEpoch == protectEpoch)
+	{
+		return;
+	}
+
+	std::lock_guard<util::sync::Spinlock> guard(m_lock);
+
+	uint64_t stamp   = m_epoch.load(std::memory_order_relaxed) + 1;
+	bool     written = false;
+
+	for (size_t page = firstPage; page <= lastPage; ++page)
+	{
+		auto iter = m_groups.find(page / PagesPerGroup);
+		if (iter == m_groups.end())
+		{
+			continue;
+		}
+
+		auto&    group = iter->second;
+		size_t   index = page % PagesPerGroup;
+		uint64_t bit   = 1ull << index;
+		if (!(group.watched & bit))
+		{
+			continue;
+		}
+
+		if (!(group.dirty & bit))
+		{
+			group.dirty |= bit;
+			protectPages(page, 1, true);
+		}
+
+		group.epochs[index] = stamp;
+		written             = true;
+	}
+
+	if (written)
+	{
+		m_epoch.store(stamp, std::memory_order_release);
+	}
+
+	// Writable now whether watched or not.
+	t_dirtyPage.page         = firstPage == lastPage ? firstPage : SIZE_MAX;
+	t_dirtyPage.protectEpoch = protectEpoch;
+}
+
+uint64_t MemoryWriteWatch::collect(
+	void*                     start,
+	size_t                    size,
+	uint64_t                  since,
+	std::vector<MemoryRange>& ranges)
+{
+	return collectInternal(start, size, since, &ranges);
+}
+
+uint64_t MemoryWriteWatch::rearm(void* start, size_t size)
+{
+	return collectInternal(start, size, 0, nullptr);
+}
+
+uint64_t MemoryWriteWatch::collectInternal(
+	void*                     start,
+	size_t                    size,
+	uint64_t                  since,
+	std::vector<MemoryRange>* ranges)
+{
+	std::lock_guard<util::sync::Spinlock> guard(m_lock);
+
+	if (!size)
+	{
+		return m_epoch.load(std::memory_order_relaxed);
+	}
+
+	size_t rangeBegin = reinterpret_cast<size_t>(start);
+	size_t rangeEnd   = rangeBegin + size;
+	size_t firstPage  = rangeBegin / plat::VM_PAGE_SIZE;
+	size_t lastPage   = (rangeEnd - 1) / plat::VM_PAGE_SIZE;
+
+	// Write protect pages again before the caller
+	// reads them, writes following this will fault
+	// and show up in the next query.
+	size_t runStart  = 0;
+	size_t runLength = 0;
+	for (size_t page = firstPage; page <= lastPage; ++page)
+	{
+		auto iter = m_groups.find(page / PagesPerGroup);
+		if (iter == m_groups.end())
+		{
+			continue;
+		}
+
+		auto&    group = iter->second;
+		size_t   index = page % PagesPerGroup;
+		uint64_t bit   = 1ull << index;
+
+		if ((group.watched & bit) && ranges && group.epochs[index] > since)
+		{
+			size_t pageBegin = std::max(page * plat::VM_PAGE_SIZE, rangeBegin);
+			size_t pageEnd   = std::min((page + 1) * plat::VM_PAGE_SIZE, rangeEnd);
+			size_t offset    = pageBegin - rangeBegin;
+
+			if (!ranges->empty() && ranges->back().offset + ranges->back().size == offset)
+			{
+				ranges->back().size += pageEnd - pageBegin;
+			}
+			else
+			{
+				ranges->push_back(MemoryRange{ offset, pageEnd - pageBegin });
+			}
+		}
+
+		if ((group.watched & bit) && (group.dirty & bit))
+		{
+			group.dirty &= ~bit;
+
+			runStart = runLength ? runStart : page;
+			++runLength;
+		}
+		else if (runLength)
+		{
+			protectPages(runStart, runLength, false);
+			runLength = 0;
+		}
+	}
+
+	if (runLength)
+	{
+		protectPages(runStart, runLength, false);
+	}
+
+	return m_epoch.load(std::memory_order_relaxed);
+}
+
+bool MemoryWriteWatch::fence(void* start, size_t size, MemoryFenceCallback callback)
+{
+	bool ret = false;
+	do
+	{
+		if (!m_installed || !size)
+		{
+			break;
+		}
+
+		if (!m_allocator.isWatchableRange(start, size))
+		{
+			break;
+		}
+
+		std::lock_guard<util::sync::Spinlock> guard(m_lock);
+
+		size_t address = reinterpret_cast<size_t>(start);
+		auto   result  = m_fences.emplace(address, Fence{ address + size, std::move(callback) });
+		if (result.second)
+		{
+			m_fenceCount.fetch_add(1, std::memory_order_release);
+		}
+		else
+		{
+			// The old content is out of date, its pages
+			// stay fenced so nothing reads it meanwhile.
+			auto& fence    = result.first->second;
+			fence.end      = std::max(fence.end, address + size);
+			fence.callback = std::move(callback);
+			size           = fence.end - address;
+		}
+
+		m_maxFenceSize = std::max(m_maxFenceSize, size);
+
+		size_t firstPage = address / plat::VM_PAGE_SIZE;
+		size_t lastPage  = (address + size - 1) / plat::VM_PAGE_SIZE;
+		for (size_t page = firstPage; page <= lastPage; ++page)
+		{
+			m_groups[page / PagesPerGroup].fenced |= 1ull << (page % PagesPerGroup);
+		}
+
+		protectRange(firstPage, lastPage - firstPage + 1, plat::VMPF_NOACCESS);
+
+		ret = true;
+	} while (false);
+	return ret;
+}
+
+bool MemoryWriteWatch::unfence(void* start)
+{
+	std::lock_guard<util::sync::Spinlock> guard(m_lock);
+
+	bool ret = false;
+	auto iter = m_fences.find(reinterpret_cast<size_t>(start));
+	if (iter != m_fences.end())
+	{
+		size_t firstPage = iter->first / plat::VM_PAGE_SIZE;
+		size_t lastPage  = (iter->second.end - 1) / plat::VM_PAGE_SIZE;
+
+		m_fences.erase(iter);
+		m_fenceCount.fetch_sub(1, std::memory_order_release);
+
+		// Pages shared with other fences stay fenced.
+		std::vector<FenceMap::iterator> fences;
+		for (size_t page = firstPage; page <= lastPage; ++page)
+		{
+			fences.clear();
+			findFences(page * plat::VM_PAGE_SIZE, (page + 1) * plat::VM_PAGE_SIZE, fences);
+			if (fences.empty())
+			{
+				m_groups[page / PagesPerGroup].fenced &= ~(1ull << (page % PagesPerGroup));
+			}
+		}
+
+		restorePages(firstPage, lastPage - firstPage + 1);
+		ret = true;
+	}
+	return ret;
+}
+
+bool MemoryWriteWatch::hasFence(void* start)
+{
+	std::lock_guard<util::sync::Spinlock> guard(m_lock);
+	return m_fences.find(reinterpret_cast<size_t>(start)) != m_fences.end();
+}
+
+bool MemoryWriteWatch::resolve(void* start, size_t size)
+{
+	bool ret = false;
+	if (size && m_fenceCount.load(std::memory_order_acquire) != 0)
+	{
+		size_t address = reinterpret_cast<size_t>(start);
+		ret            = resolveInternal(address, address + size);
+	}
+	return ret;
+}
+
+bool MemoryWriteWatch::resolveInternal(size_t begin, size_t end)
+{
+	std::vector<MemoryFenceCallback> callbacks;
+
+	size_t firstPage = 0;
+	size_t lastPage  = 0;
+	bool   waited    = false;
+	while (true)
+	{
+		{
+			std::lock_guard<util::sync::Spinlock> guard(m_lock);
+
+			// Pages made accessible must not expose other
+			// fences, so resolve all fences sharing a page.
+			std::vector<FenceMap::iterator> fences;
+			size_t                          prevFirst = 0;
+			size_t                          prevLast  = 0;
+			firstPage                                 = begin / plat::VM_PAGE_SIZE;
+			lastPage                                  = (end - 1) / plat::VM_PAGE_SIZE;
+			do
+			{
+				prevFirst = firstPage;
+				prevLast  = lastPage;
+
+				fences.clear();
+				findFences(firstPage * plat::VM_PAGE_SIZE, (lastPage + 1) * plat::VM_PAGE_SIZE, fences);
+				for (auto iter : fences)
+				{
+					firstPage = std::min(firstPage, iter->first / plat::VM_PAGE_SIZE);
+					lastPage  = std::max(lastPage, (iter->second.end - 1) / plat::VM_PAGE_SIZE);
+				}
+			} while (firstPage != prevFirst || lastPage != prevLast);
+
+			// Another thread runs the callbacks of some of these
+			// pages, retry once the content is there. Exception
+			// handlers can't block on anything else here.
+			if (!isResolving(firstPage, lastPage))
+			{
+				// The pages stay fenced until filled, so accesses
+				// by other threads keep faulting and wait above.
+				for (auto iter : fences)
+				{
+					callbacks.push_back(std::move(iter->second.callback));
+					m_fences.erase(iter);
+				}
+
+				for (size_t page = firstPage; page <= lastPage && !callbacks.empty(); ++page)
+				{
+					m_groups[page / PagesPerGroup].resolving |= 1ull << (page % PagesPerGroup);
+				}
+				break;
+			}
+		}
+
+		waited = true;
+		std::this_thread::yield();
+	}
+
+	if (callbacks.empty())
+	{
+		return waited;
+	}
+
+	// Callbacks may wait for the GPU, don't hold the lock.
+	// The pages are still inaccessible meanwhile, so
+	// nothing reads the stale content.
+	for (auto& callback : callbacks)
+	{
+		if (callback.wait)
+		{
+			callback.wait();
+		}
+	}
+
+	// Guest memory has no second mapping to write through,
+	// only the copy itself runs with the pages accessible.
+	{
+		std::lock_guard<util::sync::Spinlock> guard(m_lock);
+		protectRange(firstPage, lastPage - firstPage + 1, plat::VMPF_CPU_RW);
+	}
+
+	for (auto& callback : callbacks)
+	{
+		callback.fill();
+	}
+
+	{
+		std::lock_guard<util::sync::Spinlock> guard(m_lock);
+
+		// Pages may have been fenced again meanwhile.
+		std::vector<FenceMap::iterator> fences;
+		for (size_t page = firstPage; page <= lastPage; ++page)
+		{
+			auto&    group = m_groups[page / PagesPerGroup];
+			uint64_t bit   = 1ull << (page % PagesPerGroup);
+
+			fences.clear();
+			findFences(page * plat::VM_PAGE_SIZE, (page + 1) * plat::VM_PAGE_SIZE, fences);
+			if (fences.empty())
+			{
+				group.fenced &= ~bit;
+			}
+			group.resolving &= ~bit;
+		}
+
+		restorePages(firstPage, lastPage - firstPage + 1);
+		m_fenceCount.fetch_sub(callbacks.size(), std::memory_order_release);
+	}
+
+	return true;
+}
+
+void MemoryWriteWatch::findFences(
+	size_t                           begin,
+	size_t                           end,
+	std::vector<FenceMap::iterator>& fences)
+{
+	// Fences are sorted by start, those starting before the
+	// range can't reach it if they start more than the size
+	// of the largest fence before it.
+	auto iter = m_fences.lower_bound(end);
+	while (iter != m_fences.begin())
+	{
+		--iter;
+		if (iter->first + m_maxFenceSize <= begin)
+		{
+			break;
+		}
+
+		if (iter->second.end > begin)
+		{
+			fences.push_back(iter);
+		}
+	}
+}
+
+bool MemoryWriteWatch::isResolving(size_t firstPage, size_t lastPage) const
+{
+	bool resolving = false;
+	for (size_t page = firstPage; page <= lastPage && !resolving; ++page)
+	{
+		auto iter = m_groups.find(page / PagesPerGroup);
+		resolving = iter != m_groups.end() &&
+					(iter->second.resolving & (1ull << (page % PagesPerGroup)));
+	}
+	return resolving;
+}
+
+bool MemoryWriteWatch::isFenced(size_t page) const
+{
+	bool fenced = false;
+	if (m_fenceCount.load(std::memory_order_relaxed) != 0)
+	{
+		auto iter = m_groups.find(page / PagesPerGroup);
+		fenced    = iter != m_groups.end() &&
+				 (iter->second.fenced & (1ull << (page % PagesPerGroup)));
+	}
+	return fenced;
+}
+
+void MemoryWriteWatch::restorePages(size_t firstPage, size_t pageCount)
+{
+	// Give pages the protection the write watch expects,
+	// none if fenced, read only if watched and not
+	// written yet.
+	size_t                runStart  = 0;
+	size_t                runLength = 0;
+	plat::VM_PROTECT_FLAG runFlags  = plat::VMPF_CPU_RW;
+	for (size_t page = firstPage; page != firstPage + pageCount; ++page)
+	{
+		auto     iter     = m_groups.find(page / PagesPerGroup);
+		uint64_t bit      = 1ull << (page % PagesPerGroup);
+		bool     readOnly = iter != m_groups.end() &&
+						(iter->second.watched & bit) &&
+						!(iter->second.dirty & bit);
+		auto flags = readOnly ? plat::VMPF_CPU_READ : plat::VMPF_CPU_RW;
+		if (isFenced(page))
+		{
+			flags = plat::VMPF_NOACCESS;
+		}
+
+		if (runLength && flags != runFlags)
+		{
+			protectRange(runStart, runLength, runFlags);
+			runLength = 0;
+		}
+
+		runStart = runLength ? runStart : page;
+		runFlags = flags;
+		++runLength;
+	}
+
+	if (runLength)
+	{
+		protectRange(runStart, runLength, runFlags);
+	}
+}
+
+bool MemoryWriteWatch::onReadFault(void* address)
+{
+	// The fence may be resolved by another thread
+	// between the fault and this handler.
+	plat::MemoryInformation info = {};
+	size_t page        = reinterpret_cast<size_t>(address) / plat::VM_PAGE_SIZE;
+	void*  pageAddress = reinterpret_cast<void*>(page * plat::VM_PAGE_SIZE);
+	return plat::VMQuery(pageAddress, &info) &&
+		   info.nRegionState == plat::VMRS_COMMIT &&
+		   (info.nRegionProtect & plat::VMPF_CPU_READ);
+}
+
+bool MemoryWriteWatch::onWriteFault(void* address)
+{
+	std::lock_guard<util::sync::Spinlock> guard(m_lock);
+
+	bool     handled = false;
+	size_t   page    = reinterpret_cast<size_t>(address) / plat::VM_PAGE_SIZE;
+	size_t   index   = page % PagesPerGroup;
+	uint64_t bit     = 1ull << index;
+	auto     iter    = m_groups.find(page / PagesPerGroup);
+	if (iter != m_groups.end() && (iter->second.watched & bit))
+	{
+		auto& group = iter->second;
+		if (!(group.dirty & bit))
+		{
+			group.dirty |= bit;
+			protectPages(page, 1, true);
+		}
+
+		uint64_t stamp      = m_epoch.load(std::memory_order_relaxed) + 1;
+		group.epochs[index] = stamp;
+		m_epoch.store(stamp, std::memory_order_release);
+
+		handled = true;
+	}
+	else
+	{
+		// The page may be unwatched by another thread
+		// between the fault and this handler,
+		// retry the write if it is allowed by now.
+		plat::MemoryInformation info = {};
+		void* pageAddress = reinterpret_cast<void*>(page * plat::VM_PAGE_SIZE);
+		handled           = plat::VMQuery(pageAddress, &info) &&
+				  info.nRegionState == plat::VMRS_COMMIT &&
+				  (info.nRegionProtect & plat::VMPF_CPU_WRITE);
+	}
+
+	return handled;
+}
+
+void MemoryWriteWatch::protectPages(size_t firstPage, size_t pageCount, bool writable)
+{
+	// Fenced pages stay inaccessible until resolved.
+	auto   flags     = writable ? plat::VMPF_CPU_RW : plat::VMPF_CPU_READ;
+	size_t runStart  = firstPage;
+	size_t runLength = 0;
+	for (size_t page = firstPage; page != firstPage + pageCount; ++page)
+	{
+		if (isFenced(page))
+		{
+			if (runLength)
+			{
+				protectRange(runStart, runLength, flags);
+				runLength = 0;
+			}
+			continue;
+		}
+
+		runStart = runLength ? runStart : page;
+		++runLength;
+	}
+
+	if (runLength)
+	{
+		protectRange(runStart, runLength, flags);
+	}
+}
+
+void MemoryWriteWatch::protectRange(size_t firstPage, size_t pageCount, plat::VM_PROTECT_FLAG flags)
+{
+	void*  address = reinterpret_cast<void*>(firstPage * plat::VM_PAGE_SIZE);
+	size_t size    = pageCount * plat::VM_PAGE_SIZE;
+	if (flags != plat::VMPF_CPU_RW)
+	{
+		m_protectEpoch.fetch_add(1, std::memory_order_release);
+	}
+
+	if (!plat::VMProtect(address, size, flags))
+	{
+		LOG_ERR("change protection of %p size %zx failed.", address, size);
+	}
+}
+
+plat::ExceptionAction MemoryWriteWatch::exceptionHandler(
+	plat::ExceptionRecord* record,
+	void*                  param)
+{
+	plat::ExceptionAction action = plat::ExceptionAction::CONTINUE_SEARCH;
+	MemoryWriteWatch*     pthis  = reinterpret_cast<MemoryWriteWatch*>(param);
+	do
+	{
+		if (!pthis)
+		{
+			break;
+		}
+
+		if (record->code != plat::EXCEPTION_ACCESS_VIOLATION)
+		{
+			break;
+		}
+
+		// Fenced pages fault on any access. Resolve them first,
+		// a write is then retried and caught as usual.
+		void* address = reinterpret_cast<void*>(record->info.virtualAddress);
+		if (pthis->resolve(address, 1))
+		{
+			action = plat::ExceptionAction::CONTINUE_EXECUTION;
+			break;
+		}
+
+		bool handled = false;
+		switch (record->info.access)
+		{
+		case plat::EXCEPTION_READ:
+			handled = pthis->onReadFault(address);
+			break;
+		case plat::EXCEPTION_WRITE:
+			handled = pthis->onWriteFault(address);
+			break;
+		default:
+			break;
+		}
+
+		if (!handled)
+		{
+			break;
+		}
+
+		action = plat::ExceptionAction::CONTINUE_EXECUTION;
+	} while (false);
+	return action;
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "GPCS4Common.h"
+#include "PlatException.h"
+#include "PlatMemory.h"
+#include "UtilSync.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class MemoryAllocator;
+
+/**
+ * \brief Range of guest memory
+ *
+ * Offset is relative to the start
+ * of the range being queried.
+ */
+struct MemoryRange
+{
+	size_t offset;
+	size_t size;
+};
+
+/**
+ * \brief Fills a fenced range with its content
+ *
+ * \c wait runs first, with the range still inaccessible,
+ * and may block, e.g. on the GPU. \c fill then runs with
+ * the range accessible and should only copy the content,
+ * other threads don't fault on the range during the copy.
+ */
+struct MemoryFenceCallback
+{
+	std::function<void()> wait;
+	std::function<void()> fill;
+
+	void operator()() const
+	{
+		if (wait)
+		{
+			wait();
+		}
+		fill();
+	}
+};
+
+/**
+ * \brief Guest memory write watch
+ *
+ * Catches CPU writes to guest memory backing GPU
+ * resources, so that the GPU copy can be refreshed
+ * without rehashing or reuploading the whole resource.
+ *
+ * Watched pages are made read only. The first write
+ * to such a page raises an access violation, which
+ * is handled here by recording the page as written
+ * and making it writable again, so only one fault is
+ * taken per page until the page is rearmed.
+ *
+ * Every write is stamped with an increasing epoch.
+ * Users remember the epoch returned by the last query
+ * and get back only the pages written after it, this
+ * way resources sharing a page don't steal each
+ * other's writes.
+ *
+ * Ranges whose content is only produced on demand,
+ * like GPU results not read back yet, can be fenced.
+ * Fenced pages can't be accessed at all, the first
+ * read or write runs the fence callback and gives the
+ * pages their write watch protection back. Fences
+ * sharing a page are resolved together. Other threads
+ * faulting on pages being resolved wait until the
+ * content is there.
+ */
+class MemoryWriteWatch
+{
+	constexpr static size_t PagesPerGroup = 64;
+
+	// Page state is kept in groups of 64 pages
+	// so that a bit of a mask maps to a page.
+	struct PageGroup
+	{
+		// watched by at least one user
+		uint64_t watched = 0;
+		// written and made writable again
+		uint64_t dirty = 0;
+		// covered by a fence, no access
+		uint64_t fenced = 0;
+		// fence callbacks running for the page
+		uint64_t resolving = 0;
+
+		std::array<uint16_t, PagesPerGroup> refs   = {};
+		std::array<uint64_t, PagesPerGroup> epochs = {};
+	};
+
+public:
+	MemoryWriteWatch(MemoryAllocator& allocator);
+	~MemoryWriteWatch();
+
+	/**
+	 * \brief Install the fault handler
+	 *
+	 * Watching is disabled if this fails.
+	 */
+	bool install();
+
+	void uninstall();
+
+	/**
+	 * \brief Write protect a range
+	 *
+	 * Only ranges inside a single read/write block
+	 * of the memory allocator can be watched.
+	 * Returns false if the range isn't watched,
+	 * the caller must detect changes on its own.
+	 */
+	bool watch(void* start, size_t size);
+
+	/**
+	 * \brief Stop watching a range
+	 *
+	 * Pages not watched by others are made
+	 * writable again.
+	 */
+	void unwatch(void* start, size_t size);
+
+	/**
+	 * \brief Record a write before it happens
+	 *
+	 * For writes which would fail instead of faulting
+	 * on a protected page, i.e. the host OS writing
+	 * guest memory in file IO calls. Every such call
+	 * must go through this, writes done by host code
+	 * such as memcpy fault and are caught as usual.
+	 *
+	 * Fences overlapping the range are resolved first,
+	 * so that a partial write doesn't lose the rest.
+	 *
+	 * Repeated writes to a page of a thread which is
+	 * already dirty return without taking the lock.
+	 */
+	void markDirty(void* start, size_t size);
+
+	/**
+	 * \brief Current write epoch
+	 *
+	 * Doesn't change as long as no
+	 * watched page is written.
+	 */
+	uint64_t epoch() const
+	{
+		return m_epoch.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * \brief Collect pages written since an epoch
+	 *
+	 * Appends the written ranges within the given range
+	 * and write protects them again. The memory must be
+	 * read after this call returns.
+	 *
+	 * Returns the epoch to pass to the next query.
+	 */
+	uint64_t collect(
+		void*                     start,
+		size_t                    size,
+		uint64_t                  since,
+		std::vector<MemoryRange>& ranges);
+
+	/**
+	 * \brief Write protect a range again
+	 *
+	 * Drops pending writes, used when the content
+	 * is known to be in sync, e.g. after the emulator
+	 * itself wrote the memory.
+	 *
+	 * Returns the epoch to pass to the next query.
+	 */
+	uint64_t rearm(void* start, size_t size);
+
+	/**
+	 * \brief Fence a range
+	 *
+	 * The callback runs on the first access to a page
+	 * of the range, in the thread doing the access.
+	 * Only one fence may start at an address, a fence
+	 * already starting there is replaced without running
+	 * it, so the range never becomes accessible between.
+	 * Returns false if the range can't be fenced,
+	 * the caller must fill it right away.
+	 */
+	bool fence(void* start, size_t size, MemoryFenceCallback callback);
+
+	/**
+	 * \brief Check for a fence not resolved yet
+	 *
+	 * Returns true if a fence starts at the address
+	 * and the range hasn't been accessed since.
+	 */
+	bool hasFence(void* start);
+
+	/**
+	 * \brief Remove a fence without running it
+	 *
+	 * Returns false if the fence was resolved
+	 * already, i.e. the range has been accessed.
+	 */
+	bool unfence(void* start);
+
+	/**
+	 * \brief Resolve fences overlapping a range
+	 *
+	 * For accesses which don't fault, e.g. reads
+	 * by instrumented code or host IO.
+	 * Returns false if no fence is resolved.
+	 */
+	bool resolve(void* start, size_t size);
+
+private:
+	static plat::ExceptionAction exceptionHandler(
+		plat::ExceptionRecord* record, void* param);
+
+	struct Fence
+	{
+		size_t              end;
+		MemoryFenceCallback callback;
+	};
+
+	using FenceMap = std::map<size_t, Fence>;
+
+	bool onWriteFault(void* address);
+
+	bool onReadFault(void* address);
+
+	bool resolveInternal(size_t begin, size_t end);
+
+	void findFences(
+		size_t                           begin,
+		size_t                           end,
+		std::vector<FenceMap::iterator>& fences);
+
+	bool isFenced(size_t page) const;
+
+	bool isResolving(size_t firstPage, size_t lastPage) const;
+
+	void restorePages(size_t firstPage, size_t pageCount);
+
+	uint64_t collectInternal(
+		void*                     start,
+		size_t                    size,
+		uint64_t                  since,
+		std::vector<MemoryRange>* ranges);
+
+	void protectPages(size_t firstPage, size_t pageCount, bool writable);
+
+	void protectRange(size_t firstPage, size_t pageCount, plat::VM_PROTECT_FLAG flags);
+
+private:
+	MemoryAllocator& m_allocator;
+	bool             m_installed = false;
+
+	util::sync::Spinlock                  m_lock;
+	std::unordered_map<size_t, PageGroup> m_groups;
+	std::atomic<uint64_t>                 m_epoch = { 1 };
+	// pages with at least one watch
+	std::atomic<size_t>                   m_watchedPages = { 0 };
+	// bumped whenever pages lose write access
+	std::atomic<uint64_t>                 m_protectEpoch = { 1 };
+
+	// Fences by start address, finding the fences
+	// covering a page needs the size of the largest.
+	FenceMap                m_fences;
+	size_t                  m_maxFenceSize = 0;
+	std::atomic<size_t>     m_fenceCount   = { 0 };
+};
@@ -2,15 +2,21 @@
 #include "tinydbr/memory_monitor.h"
 #include "UtilString.h"
 
-VirtualCPU::VirtualCPU()
+VirtualCPU::VirtualCPU() :
+	m_writeWatch(m_memAllocator),
+	m_memController(&m_writeWatch)
 {
 	MonitorFlags flags = IgnoreCode | IgnoreStack | IgnoreRipRelative /* | SaveExtendedState*/ ;
 
 	m_executor = std::make_unique<MemoryMonitor>(flags, &m_memController);
+
+	m_writeWatch.install();
 }
 
 VirtualCPU::~VirtualCPU()
 {
+	m_writeWatch.uninstall();
+
 	m_executor->Unit();
 }
 
@@ -40,3 +46,8 @@ MemoryAllocator& VirtualCPU::allocator()
 {
 	return m_memAllocator;
 }
+
+MemoryWriteWatch& VirtualCPU::writeWatch()
+{
+	return m_writeWatch;
+}
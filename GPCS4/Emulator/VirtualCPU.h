@@ -2,6 +2,7 @@
 
 #include "GPCS4Common.h"
 #include "Memory.h"
+#include "MemoryWatch.h"
 
 #include <memory>
 #include <vector>
@@ -35,9 +36,13 @@ public:
 	// except stack and image memory.
 	MemoryAllocator& allocator();
 
+	// catch guest writes to memory backing GPU resources.
+	MemoryWriteWatch& writeWatch();
+
 private:
 	std::unique_ptr<MemoryMonitor> m_executor;
-	MemoryController               m_memController;
 	MemoryAllocator                m_memAllocator;
+	MemoryWriteWatch               m_writeWatch;
+	MemoryController               m_memController;
 };
 
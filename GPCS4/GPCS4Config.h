@@ -14,11 +14,14 @@
 
 
 // Windows compile
+#ifdef _WIN32
 #define GPCS4_WINDOWS
-
+#else
 
 // Linux compile
-// #define GPCS4_LINUX
+// Only the standalone tests in Tests/CMakeLists.txt build on Linux so far.
+#define GPCS4_LINUX
+#endif
 
  
 // Graphics switch
@@ -26,3 +29,9 @@
 // useful when developing non-graphics parts of GPCS4
 // #define GPCS4_NO_GRAPHICS
 
+// PM4 benchmark
+// Define this will log packet parsing throughput of every
+// command buffer, combine with GPCS4_NO_GRAPHICS to measure
+// the command processor alone.
+// #define GPCS4_PM4_BENCHMARK
+
@@ -2,6 +2,7 @@
 #include "Emulator/SceModuleSystem.h"
 #include "Emulator/TLSHandler.h"
 #include "Loader/ModuleLoader.h"
+#include "Tests/TestFramework.h"
 
 #include <cxxopts/cxxopts.hpp>
 #include <memory>
@@ -12,7 +13,7 @@ cxxopts::ParseResult processCommandLine(int argc, char* argv[])
 {
 	cxxopts::Options opts("GPCS4", "PlayStation 4 Emulator");
 	opts.allow_unrecognised_options();
-	opts.add_options()("E,eboot", "Set main executable. The current working directory will be mapped to /app0.", cxxopts::value<std::string>())("D,debug-channel", "Enable debug channel. 'ALL' for all channels.", cxxopts::value<std::vector<std::string>>())("L,list-channels", "List debug channels.")("H,help", "Print help message.");
+	opts.add_options()("E,eboot", "Set main executable. The current working directory will be mapped to /app0.", cxxopts::value<std::string>())("D,debug-channel", "Enable debug channel. 'ALL' for all channels.", cxxopts::value<std::vector<std::string>>())("L,list-channels", "List debug channels.")("T,test", "Run unit tests, only those whose name contains the given filter if any.", cxxopts::value<std::string>()->implicit_value(""))("B,bench", "Run benchmarks, only those whose name contains the given filter if any.", cxxopts::value<std::string>()->implicit_value(""))("H,help", "Print help message.");
 
 	// Backup arg count,
 	// because cxxopts will change argc value internally,
@@ -41,6 +42,13 @@ int main(int argc, char* argv[])
 		// Initialize log system.
 		logsys::init(optResult);
 
+		if (optResult.count("T") || optResult.count("B"))
+		{
+			bool bench = optResult.count("B") != 0;
+			nRet       = test::runTests(optResult[bench ? "B" : "T"].as<std::string>(), bench);
+			break;
+		}
+
 		if (!optResult["E"].count())
 		{
 			break;
@@ -328,7 +328,10 @@ namespace sce::gcn
 
 		uint32_t stride = m_module.constu32(bufferInfo.buffer.stride);
 
-		LOG_ASSERT(bufferInfo.buffer.isSwizzle == false, "TODO: support swizzle buffer.");
+		// Swizzled buffers are kept linear on the GPU, the
+		// initializer and the resource tracker convert them
+		// on upload and readback, so they are addressed
+		// like linear ones.
 
 		// Note the returned address is in bytes.
 		GcnRegisterValue result;
@@ -2,6 +2,7 @@
 #include "GcnAnalysis.h"
 #include "GcnCompiler.h"
 #include "GcnDecoder.h"
+#include "GcnRectListShader.h"
 #include "ControlFlowGraph/GcnStackifier.h"
 
 #include "PlatFile.h"
@@ -67,6 +68,26 @@ namespace sce::gcn
 
 		return compiler.finalize();
 	}
+
+	Rc<VltShader> GcnModule::compileRectListShader() const
+	{
+		const uint32_t* start = reinterpret_cast<const uint32_t*>(m_code);
+		const uint32_t* end   = reinterpret_cast<const uint32_t*>(m_code + m_header.length());
+		GcnCodeSlice    slice(start, end);
+
+		auto insList = this->decodeShader(slice);
+
+		// Only the exports are needed
+		GcnAnalysisInfo analysisInfo;
+
+		GcnAnalyzer analyzer(
+			m_programInfo,
+			analysisInfo);
+
+		this->runAnalyzer(analyzer, insList);
+
+		return gcn::compileRectListShader(analysisInfo.exportInfo);
+	}
 	
 	GcnInstructionList GcnModule::decodeShader(GcnCodeSlice& slice) const
 	{
@@ -66,6 +66,16 @@ namespace sce::gcn
 			const GcnShaderMeta& meta,
 			const GcnModuleInfo& moduleInfo) const;
 
+		/**
+		 * \brief Compiles the rect list geometry shader
+		 *
+		 * Only valid for vertex shaders. The geometry
+		 * shader passes through the parameters this
+		 * shader exports and adds the fourth corner.
+		 * \returns The geometry shader
+		 */
+		vlt::Rc<vlt::VltShader> compileRectListShader() const;
+
 	private:
 
 		GcnInstructionList decodeShader(
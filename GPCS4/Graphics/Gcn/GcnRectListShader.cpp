@@ -0,0 +1,185 @@
+#include "GcnRectListShader.h"
+#include "GcnAnalysis.h"
+
+#include "SpirV/SpirvModule.h"
+#include "Violet/VltShader.h"
+
+#include <vector>
+
+using namespace sce::vlt;
+
+namespace sce::gcn
+{
+	namespace
+	{
+		struct RectListAttribute
+		{
+			uint32_t inputVar;
+			uint32_t outputVar;
+			uint32_t type;
+			// Index of the position in the per-vertex block,
+			// or -1 for a parameter.
+			int32_t member;
+		};
+
+		uint32_t emitLoadCorner(
+			SpirvModule&             module,
+			const RectListAttribute& attribute,
+			uint32_t                 corner)
+		{
+			uint32_t ptrType = module.defPointerType(
+				attribute.type, spv::StorageClassInput);
+
+			std::vector<uint32_t> indices = { module.constu32(corner) };
+			if (attribute.member >= 0)
+			{
+				indices.push_back(module.constu32(attribute.member));
+			}
+
+			uint32_t ptr = module.opAccessChain(
+				ptrType, attribute.inputVar,
+				indices.size(), indices.data());
+			return module.opLoad(attribute.type, ptr);
+		}
+
+		void emitStoreCorner(
+			SpirvModule&             module,
+			const RectListAttribute& attribute,
+			uint32_t                 value)
+		{
+			uint32_t ptr = attribute.outputVar;
+			if (attribute.member >= 0)
+			{
+				uint32_t ptrType = module.defPointerType(
+					attribute.type, spv::StorageClassOutput);
+				uint32_t member = module.constu32(attribute.member);
+				ptr             = module.opAccessChain(ptrType, ptr, 1, &member);
+			}
+			module.opStore(ptr, value);
+		}
+	}  // namespace
+
+	Rc<VltShader> compileRectListShader(
+		const GcnExportInfo& exportInfo)
+	{
+		SpirvModule module(spvVersion(1, 3));
+		module.enableCapability(spv::CapabilityShader);
+		module.enableCapability(spv::CapabilityGeometry);
+		module.setMemoryModel(
+			spv::AddressingModelLogical,
+			spv::MemoryModelGLSL450);
+
+		uint32_t entryPointId = module.allocateId();
+
+		std::vector<uint32_t>          interfaces;
+		std::vector<RectListAttribute> attributes;
+		VltInterfaceSlots              interfaceSlots;
+
+		uint32_t t_f32      = module.defFloatType(32);
+		uint32_t t_f32_v4   = module.defVectorType(t_f32, 4);
+		uint32_t inputCount = module.constu32(3);
+
+		// Same per-vertex block as the vertex shader writes.
+		uint32_t perVertexType = module.defStructTypeUnique(1, &t_f32_v4);
+		module.memberDecorateBuiltIn(perVertexType, 0, spv::BuiltInPosition);
+		module.decorateBlock(perVertexType);
+
+		RectListAttribute position;
+		position.type     = t_f32_v4;
+		position.member   = 0;
+		position.inputVar = module.newVar(
+			module.defPointerType(module.defArrayType(perVertexType, inputCount), spv::StorageClassInput),
+			spv::StorageClassInput);
+		position.outputVar = module.newVar(
+			module.defPointerType(perVertexType, spv::StorageClassOutput),
+			spv::StorageClassOutput);
+		module.setDebugName(position.inputVar, "gs_vertex_in");
+		module.setDebugName(position.outputVar, "gs_vertex_out");
+		attributes.push_back(position);
+
+		// Parameters must match the vertex shader
+		// outputs in location and component count.
+		for (uint32_t i = 0; i != exportInfo.paramCount; ++i)
+		{
+			uint32_t count = exportInfo.params[i].popCount();
+			if (count == 0)
+			{
+				continue;
+			}
+
+			RectListAttribute param;
+			param.type     = count == 1 ? t_f32 : module.defVectorType(t_f32, count);
+			param.member   = -1;
+			param.inputVar = module.newVar(
+				module.defPointerType(module.defArrayType(param.type, inputCount), spv::StorageClassInput),
+				spv::StorageClassInput);
+			param.outputVar = module.newVar(
+				module.defPointerType(param.type, spv::StorageClassOutput),
+				spv::StorageClassOutput);
+			module.decorateLocation(param.inputVar, i);
+			module.decorateLocation(param.outputVar, i);
+			attributes.push_back(param);
+
+			interfaceSlots.inputSlots |= 1u << i;
+			interfaceSlots.outputSlots |= 1u << i;
+		}
+
+		for (const auto& attribute : attributes)
+		{
+			interfaces.push_back(attribute.inputVar);
+			interfaces.push_back(attribute.outputVar);
+		}
+
+		uint32_t voidType = module.defVoidType();
+		module.functionBegin(voidType, entryPointId,
+							 module.defFunctionType(voidType, 0, nullptr),
+							 spv::FunctionControlMaskNone);
+		module.opLabel(module.allocateId());
+
+		// Emit upper-left, upper-right, lower-left and
+		// lower-right as a strip, which covers the rect.
+		for (uint32_t corner = 0; corner != 4; ++corner)
+		{
+			for (const auto& attribute : attributes)
+			{
+				uint32_t value = 0;
+				if (corner != 3)
+				{
+					value = emitLoadCorner(module, attribute, corner);
+				}
+				else
+				{
+					uint32_t v0 = emitLoadCorner(module, attribute, 0);
+					uint32_t v1 = emitLoadCorner(module, attribute, 1);
+					uint32_t v2 = emitLoadCorner(module, attribute, 2);
+					value       = module.opFSub(attribute.type,
+												module.opFAdd(attribute.type, v1, v2), v0);
+				}
+				emitStoreCorner(module, attribute, value);
+			}
+			module.opEmitVertex(0);
+		}
+		module.opEndPrimitive(0);
+
+		module.opReturn();
+		module.functionEnd();
+
+		module.addEntryPoint(entryPointId,
+							 spv::ExecutionModelGeometry, "main",
+							 interfaces.size(), interfaces.data());
+		module.setExecutionMode(entryPointId, spv::ExecutionModeTriangles);
+		module.setExecutionMode(entryPointId, spv::ExecutionModeOutputTriangleStrip);
+		module.setOutputVertices(entryPointId, 4);
+		module.setInvocations(entryPointId, 1);
+		module.setDebugName(entryPointId, "main");
+
+		return new VltShader(
+			VK_SHADER_STAGE_GEOMETRY_BIT,
+			VltResourceSlotList(),
+			interfaceSlots,
+			module.compile(),
+			VltShaderOptions(),
+			VltShaderConstData());
+	}
+
+}  // namespace sce::gcn
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "GcnCommon.h"
+#include "Violet/VltRc.h"
+
+namespace sce::vlt
+{
+	class VltShader;
+}  // namespace sce::vlt
+
+namespace sce::gcn
+{
+	struct GcnExportInfo;
+
+	/**
+	 * \brief Compiles the rect list geometry shader
+	 *
+	 * Vulkan has no rect list topology, rect lists are
+	 * drawn as triangle lists and this shader completes
+	 * each triangle to a rectangle. Vertices 0, 1 and 2
+	 * are the upper-left, upper-right and lower-left
+	 * corners, the lower-right one is v1 + v2 - v0 for
+	 * the position and every exported parameter.
+	 * \param [in] exportInfo Exports of the vertex shader
+	 * \returns The geometry shader
+	 */
+	vlt::Rc<vlt::VltShader> compileRectListShader(
+		const GcnExportInfo& exportInfo);
+
+}  // namespace sce::gcn
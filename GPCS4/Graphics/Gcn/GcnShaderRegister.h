@@ -1,6 +1,6 @@
 #pragma once
 
-#include "GcnCommon.h"
+#include "GPCS4Common.h"
 #include "GcnShaderRegField.h"
 
 namespace sce::gcn
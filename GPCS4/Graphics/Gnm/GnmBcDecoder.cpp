@@ -0,0 +1,1075 @@
+#include "GnmBcDecoder.h"
+
+#include "PlatHardware.h"
+#include "UtilWorkerPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <immintrin.h>
+
+LOG_CHANNEL(Graphic.Gnm.GnmBcDecoder);
+
+// Palette lookups use pshufb, which is not part of the
+// SSE2 baseline, so those kernels are built for SSSE3
+// and only selected if the CPU supports it.
+#define BC_TARGET_SSSE3 __attribute__((target("ssse3")))
+
+namespace sce::Gnm::bc
+{
+	// Decodes one block into 16 texels in row order.
+	typedef void (*PFN_decodeBlock)(const uint8_t* block, void* texels);
+
+	struct BlockDecoder
+	{
+		PFN_decodeBlock decode;
+		uint32_t        blockSize;
+		uint32_t        texelSize;
+	};
+
+	// Decoding jobs of at least this many texels are split over the worker pool.
+	constexpr uint32_t kMinDecodeBandTexels = 64 * 1024;
+
+	struct alignas(16) ShuffleMask
+	{
+		uint8_t bytes[16];
+	};
+
+	// Moves the texels of a 2 bit index row from a 4 entry palette,
+	// indexed by the index byte of the row.
+	static constexpr std::array<ShuffleMask, 256> buildColorRowMasks()
+	{
+		std::array<ShuffleMask, 256> masks = {};
+		for (uint32_t indices = 0; indices < 256; ++indices)
+		{
+			for (uint32_t x = 0; x < 4; ++x)
+			{
+				uint32_t entry = (indices >> (2 * x)) & 3;
+				for (uint32_t c = 0; c < 4; ++c)
+				{
+					masks[indices].bytes[x * 4 + c] = uint8_t(entry * 4 + c);
+				}
+			}
+		}
+		return masks;
+	}
+
+	// Moves the values of one row of a 16 byte single channel block
+	// into channel c of 4 RGBA8 texels, zeroing the other channels.
+	static constexpr std::array<std::array<ShuffleMask, 4>, 4> buildChannelRowMasks()
+	{
+		std::array<std::array<ShuffleMask, 4>, 4> masks = {};
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			for (uint32_t y = 0; y < 4; ++y)
+			{
+				for (uint32_t i = 0; i < 16; ++i)
+				{
+					masks[c][y].bytes[i] = (i & 3) == c ? uint8_t(y * 4 + i / 4) : 0x80;
+				}
+			}
+		}
+		return masks;
+	}
+
+	static constexpr std::array<ShuffleMask, 256> s_colorRowMasks = buildColorRowMasks();
+
+	static constexpr std::array<std::array<ShuffleMask, 4>, 4> s_channelRowMasks = buildChannelRowMasks();
+
+	static inline uint32_t packRgba(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+	{
+		return r | (g << 8) | (b << 16) | (a << 24);
+	}
+
+	static inline uint16_t readU16(const uint8_t* data)
+	{
+		return uint16_t(data[0] | (data[1] << 8));
+	}
+
+	static inline uint32_t readU32(const uint8_t* data)
+	{
+		uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static inline uint64_t readU64(const uint8_t* data)
+	{
+		uint64_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// BC1 - BC5
+
+	// Builds the RGBA8 palette of a BC1 - BC3 color block.
+	// Only BC1 has the 3 color mode, its last entry is black
+	// with an alpha of blackAlpha.
+	static void buildColorPalette(
+		const uint8_t* block,
+		bool           isBc1,
+		uint32_t       blackAlpha,
+		uint32_t       palette[4])
+	{
+		uint32_t c0 = readU16(block + 0);
+		uint32_t c1 = readU16(block + 2);
+
+		uint32_t color[2][3];
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			uint32_t c  = i == 0 ? c0 : c1;
+			uint32_t r  = (c >> 11) & 0x1F;
+			uint32_t g  = (c >> 5) & 0x3F;
+			uint32_t b  = c & 0x1F;
+			color[i][0] = (r << 3) | (r >> 2);
+			color[i][1] = (g << 2) | (g >> 4);
+			color[i][2] = (b << 3) | (b >> 2);
+		}
+
+		uint32_t mid[2][3];
+		bool     fourColors = !isBc1 || c0 > c1;
+		for (uint32_t c = 0; c < 3; ++c)
+		{
+			uint32_t a = color[0][c];
+			uint32_t b = color[1][c];
+			if (fourColors)
+			{
+				mid[0][c] = (2 * a + b + 1) / 3;
+				mid[1][c] = (a + 2 * b + 1) / 3;
+			}
+			else
+			{
+				mid[0][c] = (a + b + 1) / 2;
+				mid[1][c] = 0;
+			}
+		}
+
+		palette[0] = packRgba(color[0][0], color[0][1], color[0][2], 0xFF);
+		palette[1] = packRgba(color[1][0], color[1][1], color[1][2], 0xFF);
+		palette[2] = packRgba(mid[0][0], mid[0][1], mid[0][2], 0xFF);
+		palette[3] = fourColors
+						 ? packRgba(mid[1][0], mid[1][1], mid[1][2], 0xFF)
+						 : packRgba(0, 0, 0, blackAlpha);
+	}
+
+	// Builds the 8 entry palette of a BC3 alpha or BC4/BC5 channel block.
+	// Signed values are returned as their two's complement bytes.
+	static void buildChannelPalette(
+		const uint8_t* block,
+		bool           isSigned,
+		uint8_t        palette[8])
+	{
+		// Interpolate signed endpoints biased into the unsigned range,
+		// so rounding is the same in both cases.
+		int32_t bias = isSigned ? 128 : 0;
+		int32_t e0   = isSigned ? int32_t(int8_t(block[0])) : int32_t(block[0]);
+		int32_t e1   = isSigned ? int32_t(int8_t(block[1])) : int32_t(block[1]);
+		int32_t a    = e0 + bias;
+		int32_t b    = e1 + bias;
+
+		palette[0] = uint8_t(e0);
+		palette[1] = uint8_t(e1);
+		if (e0 > e1)
+		{
+			for (int32_t i = 1; i < 7; ++i)
+			{
+				palette[i + 1] = uint8_t(((7 - i) * a + i * b + 3) / 7 - bias);
+			}
+		}
+		else
+		{
+			for (int32_t i = 1; i < 5; ++i)
+			{
+				palette[i + 1] = uint8_t(((5 - i) * a + i * b + 2) / 5 - bias);
+			}
+			palette[6] = isSigned ? uint8_t(-127) : 0x00;
+			palette[7] = isSigned ? 0x7F : 0xFF;
+		}
+	}
+
+	// Extracts the 16 3 bit indices of a channel block.
+	static inline void extractChannelIndices(const uint8_t* block, uint8_t indices[16])
+	{
+		uint64_t bits = readU64(block) >> 16;
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			indices[i] = uint8_t((bits >> (3 * i)) & 7);
+		}
+	}
+
+	static void decodeChannelBlock(const uint8_t* block, bool isSigned, uint8_t values[16])
+	{
+		uint8_t palette[8];
+		uint8_t indices[16];
+		buildChannelPalette(block, isSigned, palette);
+		extractChannelIndices(block, indices);
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			values[i] = palette[indices[i]];
+		}
+	}
+
+	static void decodeColorBlock(
+		const uint8_t* block,
+		bool           isBc1,
+		uint32_t       blackAlpha,
+		uint32_t       texels[16])
+	{
+		uint32_t palette[4];
+		buildColorPalette(block, isBc1, blackAlpha, palette);
+
+		uint32_t indices = readU32(block + 4);
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			texels[i] = palette[(indices >> (2 * i)) & 3];
+		}
+	}
+
+	template <uint32_t BlackAlpha>
+	static void decodeBc1Block(const uint8_t* block, void* texels)
+	{
+		decodeColorBlock(block, true, BlackAlpha, reinterpret_cast<uint32_t*>(texels));
+	}
+
+	static void decodeBc2Block(const uint8_t* block, void* texels)
+	{
+		uint32_t* rgba = reinterpret_cast<uint32_t*>(texels);
+		decodeColorBlock(block + 8, false, 0xFF, rgba);
+
+		uint64_t alpha = readU64(block);
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			uint32_t a = uint32_t((alpha >> (4 * i)) & 0xF) * 0x11;
+			rgba[i]    = (rgba[i] & 0x00FFFFFF) | (a << 24);
+		}
+	}
+
+	static void decodeBc3Block(const uint8_t* block, void* texels)
+	{
+		uint32_t* rgba = reinterpret_cast<uint32_t*>(texels);
+		decodeColorBlock(block + 8, false, 0xFF, rgba);
+
+		uint8_t alpha[16];
+		decodeChannelBlock(block, false, alpha);
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			rgba[i] = (rgba[i] & 0x00FFFFFF) | (uint32_t(alpha[i]) << 24);
+		}
+	}
+
+	template <bool Signed>
+	static void decodeBc4Block(const uint8_t* block, void* texels)
+	{
+		uint32_t* rgba = reinterpret_cast<uint32_t*>(texels);
+		uint32_t  one  = Signed ? 0x7F : 0xFF;
+
+		uint8_t red[16];
+		decodeChannelBlock(block, Signed, red);
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			rgba[i] = packRgba(red[i], 0, 0, one);
+		}
+	}
+
+	template <bool Signed>
+	static void decodeBc5Block(const uint8_t* block, void* texels)
+	{
+		uint32_t* rgba = reinterpret_cast<uint32_t*>(texels);
+		uint32_t  one  = Signed ? 0x7F : 0xFF;
+
+		uint8_t red[16];
+		uint8_t green[16];
+		decodeChannelBlock(block + 0, Signed, red);
+		decodeChannelBlock(block + 8, Signed, green);
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			rgba[i] = packRgba(red[i], green[i], 0, one);
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// BC1 - BC5, SSSE3
+	//
+	// Palettes are built as above, then every row of texels
+	// is looked up from the palette register with one pshufb.
+
+	BC_TARGET_SSSE3 static inline void lookupColorRows(
+		const uint8_t* block,
+		const uint32_t palette[4],
+		__m128i        rows[4])
+	{
+		__m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(palette));
+		for (uint32_t y = 0; y < 4; ++y)
+		{
+			const ShuffleMask& mask = s_colorRowMasks[block[4 + y]];
+			rows[y]                 = _mm_shuffle_epi8(colors,
+                                       _mm_load_si128(reinterpret_cast<const __m128i*>(mask.bytes)));
+		}
+	}
+
+	BC_TARGET_SSSE3 static inline __m128i lookupChannelValues(
+		const uint8_t* block,
+		bool           isSigned)
+	{
+		alignas(16) uint8_t palette[16] = {};
+		alignas(16) uint8_t indices[16];
+		buildChannelPalette(block, isSigned, palette);
+		extractChannelIndices(block, indices);
+		return _mm_shuffle_epi8(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(palette)),
+			_mm_load_si128(reinterpret_cast<const __m128i*>(indices)));
+	}
+
+	// Moves one row of 16 single channel values into channel c of RGBA8 texels.
+	BC_TARGET_SSSE3 static inline __m128i spreadChannelRow(
+		__m128i  values,
+		uint32_t c,
+		uint32_t y)
+	{
+		return _mm_shuffle_epi8(values,
+								_mm_load_si128(reinterpret_cast<const __m128i*>(s_channelRowMasks[c][y].bytes)));
+	}
+
+	BC_TARGET_SSSE3 static inline void storeRows(void* texels, const __m128i rows[4])
+	{
+		__m128i* dst = reinterpret_cast<__m128i*>(texels);
+		for (uint32_t y = 0; y < 4; ++y)
+		{
+			_mm_store_si128(dst + y, rows[y]);
+		}
+	}
+
+	template <uint32_t BlackAlpha>
+	BC_TARGET_SSSE3 static void decodeBc1BlockSsse3(const uint8_t* block, void* texels)
+	{
+		uint32_t palette[4];
+		buildColorPalette(block, true, BlackAlpha, palette);
+
+		__m128i rows[4];
+		lookupColorRows(block, palette, rows);
+		storeRows(texels, rows);
+	}
+
+	BC_TARGET_SSSE3 static void decodeBc2BlockSsse3(const uint8_t* block, void* texels)
+	{
+		uint32_t palette[4];
+		buildColorPalette(block + 8, false, 0xFF, palette);
+
+		__m128i rows[4];
+		lookupColorRows(block + 8, palette, rows);
+
+		// Texels are in nibble order, low nibble first.
+		__m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block));
+		__m128i lo     = _mm_and_si128(packed, _mm_set1_epi8(0x0F));
+		__m128i hi     = _mm_and_si128(_mm_srli_epi16(packed, 4), _mm_set1_epi8(0x0F));
+		__m128i alpha  = _mm_unpacklo_epi8(lo, hi);
+		alpha          = _mm_or_si128(alpha, _mm_slli_epi16(alpha, 4));
+
+		__m128i colorMask = _mm_set1_epi32(0x00FFFFFF);
+		for (uint32_t y = 0; y < 4; ++y)
+		{
+			rows[y] = _mm_or_si128(_mm_and_si128(rows[y], colorMask),
+								   spreadChannelRow(alpha, 3, y));
+		}
+		storeRows(texels, rows);
+	}
+
+	BC_TARGET_SSSE3 static void decodeBc3BlockSsse3(const uint8_t* block, void* texels)
+	{
+		uint32_t palette[4];
+		buildColorPalette(block + 8, false, 0xFF, palette);
+
+		__m128i rows[4];
+		lookupColorRows(block + 8, palette, rows);
+
+		__m128i alpha     = lookupChannelValues(block, false);
+		__m128i colorMask = _mm_set1_epi32(0x00FFFFFF);
+		for (uint32_t y = 0; y < 4; ++y)
+		{
+			rows[y] = _mm_or_si128(_mm_and_si128(rows[y], colorMask),
+								   spreadChannelRow(alpha, 3, y));
+		}
+		storeRows(texels, rows);
+	}
+
+	template <bool Signed>
+	BC_TARGET_SSSE3 static void decodeBc4BlockSsse3(const uint8_t* block, void* texels)
+	{
+		__m128i red = lookupChannelValues(block, Signed);
+		__m128i one = _mm_set1_epi32(Signed ? 0x7F000000 : 0xFF000000);
+
+		__m128i rows[4];
+		for (uint32_t y = 0; y < 4; ++y)
+		{
+			rows[y] = _mm_or_si128(spreadChannelRow(red, 0, y), one);
+		}
+		storeRows(texels, rows);
+	}
+
+	template <bool Signed>
+	BC_TARGET_SSSE3 static void decodeBc5BlockSsse3(const uint8_t* block, void* texels)
+	{
+		__m128i red   = lookupChannelValues(block + 0, Signed);
+		__m128i green = lookupChannelValues(block + 8, Signed);
+		__m128i one   = _mm_set1_epi32(Signed ? 0x7F000000 : 0xFF000000);
+
+		__m128i rows[4];
+		for (uint32_t y = 0; y < 4; ++y)
+		{
+			rows[y] = _mm_or_si128(
+				_mm_or_si128(spreadChannelRow(red, 0, y), spreadChannelRow(green, 1, y)), one);
+		}
+		storeRows(texels, rows);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// BC6H and BC7
+
+	// Reads consecutive bit fields of a 128 bit block, LSB first.
+	class BlockBitReader
+	{
+	public:
+		explicit BlockBitReader(const uint8_t* block) :
+			m_lo(readU64(block)),
+			m_hi(readU64(block + 8))
+		{
+		}
+
+		uint32_t read(uint32_t count)
+		{
+			uint32_t value = 0;
+			if (count != 0)
+			{
+				value = uint32_t(m_lo & ((1ull << count) - 1));
+				m_lo  = (m_lo >> count) | (m_hi << (64 - count));
+				m_hi  = m_hi >> count;
+			}
+			return value;
+		}
+
+	private:
+		uint64_t m_lo;
+		uint64_t m_hi;
+	};
+
+	// Subsets of texels of the 2 subset partitions, one bit per texel.
+	static const uint16_t s_partitions2[64] = {
+		0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+		0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+		0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+		0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+		0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+		0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+		0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+		0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+	};
+
+	// Subsets of texels of the 3 subset partitions, two bits per texel.
+	static const uint32_t s_partitions3[64] = {
+		0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+		0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+		0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+		0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+		0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+		0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+		0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+		0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+	};
+
+	// Anchor texel of the second subset of the 2 subset partitions.
+	static const uint8_t s_anchors2[64] = {
+		15, 15, 15, 15, 15, 15, 15, 15,
+		15, 15, 15, 15, 15, 15, 15, 15,
+		15, 2, 8, 2, 2, 8, 8, 15,
+		2, 8, 2, 2, 8, 8, 2, 2,
+		15, 15, 6, 8, 2, 8, 15, 15,
+		2, 8, 2, 2, 2, 15, 15, 6,
+		6, 2, 6, 8, 15, 15, 2, 2,
+		15, 15, 15, 15, 15, 2, 2, 15,
+	};
+
+	// Anchor texels of the second and third subset of the 3 subset partitions.
+	static const uint8_t s_anchors3[2][64] = {
+		{
+			3, 3, 15, 15, 8, 3, 15, 15,
+			8, 8, 6, 6, 6, 5, 3, 3,
+			3, 3, 8, 15, 3, 3, 6, 10,
+			5, 8, 8, 6, 8, 5, 15, 15,
+			8, 15, 3, 5, 6, 10, 8, 15,
+			15, 3, 15, 5, 15, 15, 15, 15,
+			3, 15, 5, 5, 5, 8, 5, 10,
+			5, 10, 8, 13, 15, 12, 3, 3,
+		},
+		{
+			15, 8, 8, 3, 15, 15, 3, 8,
+			15, 15, 15, 15, 15, 15, 15, 8,
+			15, 8, 15, 3, 15, 8, 15, 8,
+			3, 15, 6, 10, 15, 15, 10, 8,
+			15, 3, 15, 10, 10, 8, 9, 10,
+			6, 15, 8, 15, 3, 6, 6, 8,
+			15, 3, 15, 15, 15, 15, 15, 15,
+			15, 15, 15, 15, 3, 15, 15, 8,
+		},
+	};
+
+	static const uint8_t s_weights2[4]  = { 0, 21, 43, 64 };
+	static const uint8_t s_weights3[8]  = { 0, 9, 18, 27, 37, 46, 55, 64 };
+	static const uint8_t s_weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	static inline const uint8_t* getWeights(uint32_t indexBits)
+	{
+		return indexBits == 2 ? s_weights2 : (indexBits == 3 ? s_weights3 : s_weights4);
+	}
+
+	static inline uint32_t getSubset(uint32_t subsetCount, uint32_t partition, uint32_t texel)
+	{
+		uint32_t subset = 0;
+		if (subsetCount == 2)
+		{
+			subset = (s_partitions2[partition] >> texel) & 1;
+		}
+		else if (subsetCount == 3)
+		{
+			subset = (s_partitions3[partition] >> (2 * texel)) & 3;
+		}
+		return subset;
+	}
+
+	// Anchor texels store their index with one bit less.
+	static inline bool isAnchor(uint32_t subsetCount, uint32_t partition, uint32_t texel)
+	{
+		return texel == 0 ||
+			   (subsetCount == 2 && texel == s_anchors2[partition]) ||
+			   (subsetCount == 3 && (texel == s_anchors3[0][partition] ||
+									 texel == s_anchors3[1][partition]));
+	}
+
+	struct Bc7ModeInfo
+	{
+		uint8_t subsetCount;
+		uint8_t partitionBits;
+		uint8_t rotationBits;
+		uint8_t indexSelectionBits;
+		uint8_t colorBits;
+		uint8_t alphaBits;
+		uint8_t endpointPBits;
+		uint8_t sharedPBits;
+		uint8_t indexBits;
+		uint8_t indexBits2;
+	};
+
+	static const Bc7ModeInfo s_bc7Modes[8] = {
+		{ 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+		{ 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+		{ 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+		{ 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+		{ 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+		{ 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+		{ 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+		{ 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+	};
+
+	static inline uint32_t interpolate(uint32_t e0, uint32_t e1, uint32_t weight)
+	{
+		return (e0 * (64 - weight) + e1 * weight + 32) >> 6;
+	}
+
+	static void decodeBc7Block(const uint8_t* block, void* texels)
+	{
+		uint32_t* rgba = reinterpret_cast<uint32_t*>(texels);
+
+		do
+		{
+			uint32_t mode = 0;
+			while (mode < 8 && !(block[0] & (1u << mode)))
+			{
+				++mode;
+			}
+
+			// Reserved mode, decodes to transparent black.
+			if (mode == 8)
+			{
+				std::memset(rgba, 0, 16 * sizeof(uint32_t));
+				break;
+			}
+
+			const Bc7ModeInfo& info = s_bc7Modes[mode];
+			BlockBitReader     bits(block);
+			bits.read(mode + 1);
+
+			uint32_t partition      = bits.read(info.partitionBits);
+			uint32_t rotation       = bits.read(info.rotationBits);
+			uint32_t indexSelection = bits.read(info.indexSelectionBits);
+
+			// [subset][endpoint][channel]
+			uint32_t endpoints[3][2][4] = {};
+			for (uint32_t c = 0; c < 3; ++c)
+			{
+				for (uint32_t s = 0; s < info.subsetCount; ++s)
+				{
+					endpoints[s][0][c] = bits.read(info.colorBits);
+					endpoints[s][1][c] = bits.read(info.colorBits);
+				}
+			}
+			for (uint32_t s = 0; s < info.subsetCount && info.alphaBits; ++s)
+			{
+				endpoints[s][0][3] = bits.read(info.alphaBits);
+				endpoints[s][1][3] = bits.read(info.alphaBits);
+			}
+
+			uint32_t colorBits = info.colorBits;
+			uint32_t alphaBits = info.alphaBits;
+			if (info.endpointPBits || info.sharedPBits)
+			{
+				uint32_t channelCount = alphaBits ? 4 : 3;
+				for (uint32_t s = 0; s < info.subsetCount; ++s)
+				{
+					uint32_t sharedBit = info.sharedPBits ? bits.read(1) : 0;
+					for (uint32_t e = 0; e < 2; ++e)
+					{
+						uint32_t pBit = info.sharedPBits ? sharedBit : bits.read(1);
+						for (uint32_t c = 0; c < channelCount; ++c)
+						{
+							endpoints[s][e][c] = (endpoints[s][e][c] << 1) | pBit;
+						}
+					}
+				}
+				colorBits += 1;
+				alphaBits += alphaBits ? 1 : 0;
+			}
+
+			for (uint32_t s = 0; s < info.subsetCount; ++s)
+			{
+				for (uint32_t e = 0; e < 2; ++e)
+				{
+					uint32_t* endpoint = endpoints[s][e];
+					for (uint32_t c = 0; c < 3; ++c)
+					{
+						endpoint[c] = (endpoint[c] << (8 - colorBits)) | (endpoint[c] >> (2 * colorBits - 8));
+					}
+					endpoint[3] = alphaBits
+									  ? (endpoint[3] << (8 - alphaBits)) | (endpoint[3] >> (2 * alphaBits - 8))
+									  : 0xFF;
+				}
+			}
+
+			uint8_t indices[16];
+			uint8_t indices2[16] = {};
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				bool anchor = isAnchor(info.subsetCount, partition, i);
+				indices[i]  = uint8_t(bits.read(info.indexBits - anchor));
+			}
+			for (uint32_t i = 0; i < 16 && info.indexBits2; ++i)
+			{
+				indices2[i] = uint8_t(bits.read(info.indexBits2 - (i == 0)));
+			}
+
+			// Modes with two index sets interpolate alpha with the second one,
+			// unless the index selection bit swaps them.
+			const uint8_t* colorIndices = indices;
+			const uint8_t* alphaIndices = info.indexBits2 ? indices2 : indices;
+			uint32_t       colorBitsIdx = info.indexBits;
+			uint32_t       alphaBitsIdx = info.indexBits2 ? info.indexBits2 : info.indexBits;
+			if (indexSelection)
+			{
+				std::swap(colorIndices, alphaIndices);
+				std::swap(colorBitsIdx, alphaBitsIdx);
+			}
+			const uint8_t* colorWeights = getWeights(colorBitsIdx);
+			const uint8_t* alphaWeights = getWeights(alphaBitsIdx);
+
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				uint32_t        subset = getSubset(info.subsetCount, partition, i);
+				const uint32_t* e0     = endpoints[subset][0];
+				const uint32_t* e1     = endpoints[subset][1];
+
+				uint32_t texel[4];
+				for (uint32_t c = 0; c < 3; ++c)
+				{
+					texel[c] = interpolate(e0[c], e1[c], colorWeights[colorIndices[i]]);
+				}
+				texel[3] = interpolate(e0[3], e1[3], alphaWeights[alphaIndices[i]]);
+
+				if (rotation != 0)
+				{
+					std::swap(texel[3], texel[rotation - 1]);
+				}
+
+				rgba[i] = packRgba(texel[0], texel[1], texel[2], texel[3]);
+			}
+		} while (false);
+	}
+
+	// BC6H endpoint fields, channel * 4 + endpoint, and the partition shape.
+	enum Bc6hField : uint8_t
+	{
+		RW, RX, RY, RZ,
+		GW, GX, GY, GZ,
+		BW, BX, BY, BZ,
+		D,
+	};
+
+	// A run of header bits, stored into bits [lsb, lsb + count) of a field.
+	struct Bc6hBitRun
+	{
+		uint8_t field;
+		uint8_t lsb;
+		uint8_t count;
+	};
+
+	struct Bc6hModeInfo
+	{
+		bool       transformed;
+		uint8_t    regionCount;
+		uint8_t    endpointBits;
+		uint8_t    deltaBits[3];
+		Bc6hBitRun runs[32];
+	};
+
+	// Header layouts following the mode bits, in stream order.
+	static const Bc6hModeInfo s_bc6hModes[14] = {
+		{ true, 2, 10, { 5, 5, 5 },
+		  { { GY, 4, 1 }, { BY, 4, 1 }, { BZ, 4, 1 }, { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 },
+			{ RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 },
+			{ BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 },
+			{ BZ, 3, 1 }, { D, 0, 5 } } },
+		{ true, 2, 7, { 6, 6, 6 },
+		  { { GY, 5, 1 }, { GZ, 4, 1 }, { GZ, 5, 1 }, { RW, 0, 7 }, { BZ, 0, 1 }, { BZ, 1, 1 },
+			{ BY, 4, 1 }, { GW, 0, 7 }, { BY, 5, 1 }, { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 7 },
+			{ BZ, 3, 1 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 6 }, { GY, 0, 4 }, { GX, 0, 6 },
+			{ GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 }, { D, 0, 5 } } },
+		{ true, 2, 11, { 5, 4, 4 },
+		  { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 5 }, { RW, 10, 1 }, { GY, 0, 4 },
+			{ GX, 0, 4 }, { GW, 10, 1 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 4 }, { BW, 10, 1 },
+			{ BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 },
+			{ D, 0, 5 } } },
+		{ true, 2, 11, { 4, 5, 4 },
+		  { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 10, 1 }, { GZ, 4, 1 },
+			{ GY, 0, 4 }, { GX, 0, 5 }, { GW, 10, 1 }, { GZ, 0, 4 }, { BX, 0, 4 }, { BW, 10, 1 },
+			{ BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 4 }, { BZ, 0, 1 }, { BZ, 2, 1 }, { RZ, 0, 4 },
+			{ GY, 4, 1 }, { BZ, 3, 1 }, { D, 0, 5 } } },
+		{ true, 2, 11, { 4, 4, 5 },
+		  { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 10, 1 }, { BY, 4, 1 },
+			{ GY, 0, 4 }, { GX, 0, 4 }, { GW, 10, 1 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 },
+			{ BW, 10, 1 }, { BY, 0, 4 }, { RY, 0, 4 }, { BZ, 1, 1 }, { BZ, 2, 1 }, { RZ, 0, 4 },
+			{ BZ, 4, 1 }, { BZ, 3, 1 }, { D, 0, 5 } } },
+		{ true, 2, 9, { 5, 5, 5 },
+		  { { RW, 0, 9 }, { BY, 4, 1 }, { GW, 0, 9 }, { GY, 4, 1 }, { BW, 0, 9 }, { BZ, 4, 1 },
+			{ RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 },
+			{ BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 },
+			{ BZ, 3, 1 }, { D, 0, 5 } } },
+		{ true, 2, 8, { 6, 5, 5 },
+		  { { RW, 0, 8 }, { GZ, 4, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { BZ, 2, 1 }, { GY, 4, 1 },
+			{ BW, 0, 8 }, { BZ, 3, 1 }, { BZ, 4, 1 }, { RX, 0, 6 }, { GY, 0, 4 }, { GX, 0, 5 },
+			{ BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 6 },
+			{ RZ, 0, 6 }, { D, 0, 5 } } },
+		{ true, 2, 8, { 5, 6, 5 },
+		  { { RW, 0, 8 }, { BZ, 0, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { GY, 5, 1 }, { GY, 4, 1 },
+			{ BW, 0, 8 }, { GZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 },
+			{ GX, 0, 6 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 },
+			{ BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 }, { D, 0, 5 } } },
+		{ true, 2, 8, { 5, 5, 6 },
+		  { { RW, 0, 8 }, { BZ, 1, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { BY, 5, 1 }, { GY, 4, 1 },
+			{ BW, 0, 8 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 },
+			{ GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 5 },
+			{ BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 }, { D, 0, 5 } } },
+		{ false, 2, 6, { 6, 6, 6 },
+		  { { RW, 0, 6 }, { GZ, 4, 1 }, { BZ, 0, 1 }, { BZ, 1, 1 }, { BY, 4, 1 }, { GW, 0, 6 },
+			{ GY, 5, 1 }, { BY, 5, 1 }, { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 6 }, { GZ, 5, 1 },
+			{ BZ, 3, 1 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 6 }, { GY, 0, 4 }, { GX, 0, 6 },
+			{ GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 }, { D, 0, 5 } } },
+		{ false, 1, 10, { 10, 10, 10 },
+		  { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 10 }, { GX, 0, 10 }, { BX, 0, 10 } } },
+		{ true, 1, 11, { 9, 9, 9 },
+		  { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 9 }, { RW, 10, 1 }, { GX, 0, 9 },
+			{ GW, 10, 1 }, { BX, 0, 9 }, { BW, 10, 1 } } },
+		{ true, 1, 12, { 8, 8, 8 },
+		  { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 8 }, { RW, 11, 1 }, { RW, 10, 1 },
+			{ GX, 0, 8 }, { GW, 11, 1 }, { GW, 10, 1 }, { BX, 0, 8 }, { BW, 11, 1 }, { BW, 10, 1 } } },
+		{ true, 1, 16, { 4, 4, 4 },
+		  { { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 15, 1 }, { RW, 14, 1 },
+			{ RW, 13, 1 }, { RW, 12, 1 }, { RW, 11, 1 }, { RW, 10, 1 }, { GX, 0, 4 }, { GW, 15, 1 },
+			{ GW, 14, 1 }, { GW, 13, 1 }, { GW, 12, 1 }, { GW, 11, 1 }, { GW, 10, 1 }, { BX, 0, 4 },
+			{ BW, 15, 1 }, { BW, 14, 1 }, { BW, 13, 1 }, { BW, 12, 1 }, { BW, 11, 1 }, { BW, 10, 1 } } },
+	};
+
+	// Maps the 5 bit mode field to a mode index, or -1 if reserved.
+	static const int8_t s_bc6hModeIndices[32] = {
+		0, 1, 2, 10, 0, 1, 3, 11, 0, 1, 4, 12, 0, 1, 5, 13,
+		0, 1, 6, -1, 0, 1, 7, -1, 0, 1, 8, -1, 0, 1, 9, -1,
+	};
+
+	static inline int32_t signExtend(uint32_t value, uint32_t bits)
+	{
+		uint32_t shift = 32 - bits;
+		return int32_t(value << shift) >> shift;
+	}
+
+	static int32_t unquantizeBc6h(int32_t value, uint32_t bits, bool isSigned)
+	{
+		int32_t result;
+		if (!isSigned)
+		{
+			if (bits >= 15)
+				result = value;
+			else if (value == 0)
+				result = 0;
+			else if (value == (1 << bits) - 1)
+				result = 0xFFFF;
+			else
+				result = ((value << 16) + 0x8000) >> bits;
+		}
+		else
+		{
+			if (bits >= 16)
+			{
+				result = value;
+			}
+			else
+			{
+				bool    negative  = value < 0;
+				int32_t magnitude = negative ? -value : value;
+				if (magnitude == 0)
+					result = 0;
+				else if (magnitude >= (1 << (bits - 1)) - 1)
+					result = 0x7FFF;
+				else
+					result = ((magnitude << 15) + 0x4000) >> (bits - 1);
+				result = negative ? -result : result;
+			}
+		}
+		return result;
+	}
+
+	// Scales an interpolated value to the bit pattern of a half float.
+	static inline uint16_t finishBc6h(int32_t value, bool isSigned)
+	{
+		uint16_t result;
+		if (!isSigned)
+		{
+			result = uint16_t((value * 31) >> 6);
+		}
+		else
+		{
+			int32_t scaled = value < 0 ? -(((-value) * 31) >> 5) : (value * 31) >> 5;
+			result         = scaled < 0 ? uint16_t(0x8000 | -scaled) : uint16_t(scaled);
+		}
+		return result;
+	}
+
+	template <bool Signed>
+	static void decodeBc6hBlock(const uint8_t* block, void* texels)
+	{
+		uint16_t* rgba = reinterpret_cast<uint16_t*>(texels);
+
+		do
+		{
+			BlockBitReader bits(block);
+
+			uint32_t modeBits = bits.read(2);
+			if (modeBits >= 2)
+			{
+				modeBits |= bits.read(3) << 2;
+			}
+
+			int32_t modeIndex = s_bc6hModeIndices[modeBits];
+			if (modeIndex < 0)
+			{
+				// Reserved mode, decodes to opaque black.
+				for (uint32_t i = 0; i < 16; ++i)
+				{
+					rgba[i * 4 + 0] = 0;
+					rgba[i * 4 + 1] = 0;
+					rgba[i * 4 + 2] = 0;
+					rgba[i * 4 + 3] = 0x3C00;
+				}
+				break;
+			}
+
+			const Bc6hModeInfo& info = s_bc6hModes[modeIndex];
+
+			uint32_t fields[D + 1] = {};
+			for (const Bc6hBitRun& run : info.runs)
+			{
+				if (run.count == 0)
+				{
+					break;
+				}
+				fields[run.field] |= bits.read(run.count) << run.lsb;
+			}
+
+			uint32_t endpointBits  = info.endpointBits;
+			uint32_t endpointCount = info.regionCount * 2;
+			uint32_t endpointMask  = (1u << endpointBits) - 1;
+
+			// [channel * 4 + endpoint]
+			int32_t endpoints[12];
+			for (uint32_t c = 0; c < 3; ++c)
+			{
+				int32_t* channel = endpoints + c * 4;
+				channel[0]       = Signed ? signExtend(fields[c * 4], endpointBits) : int32_t(fields[c * 4]);
+				for (uint32_t e = 1; e < endpointCount; ++e)
+				{
+					uint32_t value = fields[c * 4 + e];
+					if (info.transformed)
+					{
+						// Deltas from the first endpoint, wrapped to the endpoint precision.
+						int32_t delta = signExtend(value, info.deltaBits[c]);
+						value         = uint32_t(channel[0] + delta) & endpointMask;
+					}
+					channel[e] = Signed ? signExtend(value, endpointBits) : int32_t(value);
+				}
+				for (uint32_t e = 0; e < endpointCount; ++e)
+				{
+					channel[e] = unquantizeBc6h(channel[e], endpointBits, Signed);
+				}
+			}
+
+			uint32_t partition = fields[D];
+			uint32_t indexBits = info.regionCount == 2 ? 3 : 4;
+
+			uint8_t indices[16];
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				bool anchor = isAnchor(info.regionCount, partition, i);
+				indices[i]  = uint8_t(bits.read(indexBits - anchor));
+			}
+
+			const uint8_t* weights = getWeights(indexBits);
+			for (uint32_t i = 0; i < 16; ++i)
+			{
+				uint32_t region = getSubset(info.regionCount, partition, i);
+				int32_t  weight = weights[indices[i]];
+				for (uint32_t c = 0; c < 3; ++c)
+				{
+					int32_t e0 = endpoints[c * 4 + region * 2 + 0];
+					int32_t e1 = endpoints[c * 4 + region * 2 + 1];
+					int32_t v  = (e0 * (64 - weight) + e1 * weight + 32) >> 6;
+
+					rgba[i * 4 + c] = finishBc6h(v, Signed);
+				}
+				rgba[i * 4 + 3] = 0x3C00;
+			}
+		} while (false);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	static BlockDecoder getBlockDecoder(BlockFormat format)
+	{
+		bool ssse3 = plat::GetCpuFeatures().ssse3;
+
+		BlockDecoder decoder = {};
+		switch (format)
+		{
+			case BlockFormat::Bc1Rgb:
+				decoder = { ssse3 ? decodeBc1BlockSsse3<0xFF> : decodeBc1Block<0xFF>, 8, 4 };
+				break;
+			case BlockFormat::Bc1Rgba:
+				decoder = { ssse3 ? decodeBc1BlockSsse3<0x00> : decodeBc1Block<0x00>, 8, 4 };
+				break;
+			case BlockFormat::Bc2:
+				decoder = { ssse3 ? decodeBc2BlockSsse3 : decodeBc2Block, 16, 4 };
+				break;
+			case BlockFormat::Bc3:
+				decoder = { ssse3 ? decodeBc3BlockSsse3 : decodeBc3Block, 16, 4 };
+				break;
+			case BlockFormat::Bc4Unorm:
+				decoder = { ssse3 ? decodeBc4BlockSsse3<false> : decodeBc4Block<false>, 8, 4 };
+				break;
+			case BlockFormat::Bc4Snorm:
+				decoder = { ssse3 ? decodeBc4BlockSsse3<true> : decodeBc4Block<true>, 8, 4 };
+				break;
+			case BlockFormat::Bc5Unorm:
+				decoder = { ssse3 ? decodeBc5BlockSsse3<false> : decodeBc5Block<false>, 16, 4 };
+				break;
+			case BlockFormat::Bc5Snorm:
+				decoder = { ssse3 ? decodeBc5BlockSsse3<true> : decodeBc5Block<true>, 16, 4 };
+				break;
+			case BlockFormat::Bc6hUfloat:
+				decoder = { decodeBc6hBlock<false>, 16, 8 };
+				break;
+			case BlockFormat::Bc6hSfloat:
+				decoder = { decodeBc6hBlock<true>, 16, 8 };
+				break;
+			case BlockFormat::Bc7:
+				decoder = { decodeBc7Block, 16, 4 };
+				break;
+			default:
+				break;
+		}
+		return decoder;
+	}
+
+	void decodeImage(
+		BlockFormat format,
+		void*       dst,
+		const void* src,
+		uint32_t    width,
+		uint32_t    height,
+		uint32_t    depth)
+	{
+		do
+		{
+			BlockDecoder decoder = getBlockDecoder(format);
+			if (decoder.decode == nullptr)
+			{
+				LOG_ERR("format %d is not block compressed.", uint32_t(format));
+				break;
+			}
+
+			uint32_t blocksX   = (width + 3) / 4;
+			uint32_t blocksY   = (height + 3) / 4;
+			uint32_t blockRows = blocksY * depth;
+			if (blocksX == 0 || blockRows == 0)
+			{
+				break;
+			}
+
+			// Block rows are independent, decode bands
+			// of them in parallel for large images.
+			uint32_t rowsPerBand = std::max(kMinDecodeBandTexels / (blocksX * 16), 1u);
+			uint32_t bandCount   = (blockRows + rowsPerBand - 1) / rowsPerBand;
+
+			const uint8_t* srcBlocks = reinterpret_cast<const uint8_t*>(src);
+			uint8_t*       dstTexels = reinterpret_cast<uint8_t*>(dst);
+
+			util::WorkerPool::global().parallelFor(bandCount, [&](uint32_t band)
+			{
+				uint32_t firstRow = band * rowsPerBand;
+				uint32_t lastRow  = std::min(firstRow + rowsPerBand, blockRows);
+				size_t   rowPitch = size_t(width) * decoder.texelSize;
+
+				alignas(16) uint8_t texels[16 * 8];
+				for (uint32_t row = firstRow; row < lastRow; ++row)
+				{
+					uint32_t z = row / blocksY;
+					uint32_t y = (row % blocksY) * 4;
+
+					const uint8_t* block = srcBlocks + size_t(row) * blocksX * decoder.blockSize;
+					uint8_t*       slice = dstTexels + size_t(z) * height * rowPitch;
+
+					uint32_t rows = std::min(height - y, 4u);
+					for (uint32_t bx = 0; bx < blocksX; ++bx, block += decoder.blockSize)
+					{
+						decoder.decode(block, texels);
+
+						// Edge blocks are clipped to the image.
+						uint32_t x       = bx * 4;
+						size_t   rowSize = size_t(std::min(width - x, 4u)) * decoder.texelSize;
+						for (uint32_t ty = 0; ty < rows; ++ty)
+						{
+							std::memcpy(slice + (y + ty) * rowPitch + x * decoder.texelSize,
+										texels + ty * 4 * decoder.texelSize,
+										rowSize);
+						}
+					}
+				}
+			});
+		} while (false);
+	}
+
+}  // namespace sce::Gnm::bc
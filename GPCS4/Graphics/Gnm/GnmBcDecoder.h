@@ -0,0 +1,54 @@
+#pragma once
+
+#include "GPCS4Common.h"
+
+namespace sce::Gnm::bc
+{
+	/**
+	 * \brief Block compressed format
+	 *
+	 * Only what decoding depends on, sRGB
+	 * formats decode like their UNORM ones.
+	 */
+	enum class BlockFormat : uint32_t
+	{
+		Invalid,
+		Bc1Rgb,
+		Bc1Rgba,
+		Bc2,
+		Bc3,
+		Bc4Unorm,
+		Bc4Snorm,
+		Bc5Unorm,
+		Bc5Snorm,
+		Bc6hUfloat,
+		Bc6hSfloat,
+		Bc7,
+	};
+
+	/**
+	 * \brief Decodes a BCn image
+	 *
+	 * Decodes tightly packed blocks into tightly packed
+	 * texels, spread over the worker pool for large images.
+	 * BC1-BC5 and BC7 decode to RGBA8, BC6H to RGBA16F.
+	 *
+	 * Only the texture upload path decodes. Images are
+	 * never read back to guest memory, the resource
+	 * tracker reads back buffers only.
+	 * \param [in] format Block compressed format
+	 * \param [out] dst Decoded texels
+	 * \param [in] src Compressed blocks
+	 * \param [in] width Image width in texels
+	 * \param [in] height Image height in texels
+	 * \param [in] depth Image depth in texels
+	 */
+	void decodeImage(
+		BlockFormat format,
+		void*       dst,
+		const void* src,
+		uint32_t    width,
+		uint32_t    height,
+		uint32_t    depth);
+
+}  // namespace sce::Gnm::bc
@@ -94,6 +94,18 @@ namespace sce::Gnm
 			return SCE_GNM_GET_FIELD(m_regs[kSqBufRsrcWord2], SQ_BUF_RSRC_WORD2, NUM_RECORDS);
 		}
 
+		void setBaseAddress(const void* baseAddr)
+		{
+			uint64_t address = reinterpret_cast<uint64_t>(baseAddr);
+			SCE_GNM_SET_FIELD(m_regs[kSqBufRsrcWord0], SQ_BUF_RSRC_WORD0, BASE_ADDRESS, static_cast<uint32_t>(address));
+			SCE_GNM_SET_FIELD(m_regs[kSqBufRsrcWord1], SQ_BUF_RSRC_WORD1, BASE_ADDRESS_HI, static_cast<uint32_t>(address >> 32));
+		}
+
+		void setNumElements(uint32_t numElements)
+		{
+			SCE_GNM_SET_FIELD(m_regs[kSqBufRsrcWord2], SQ_BUF_RSRC_WORD2, NUM_RECORDS, numElements);
+		}
+
 		DataFormat getDataFormat() const
 		{
 			return DataFormat::build(
@@ -13,7 +13,10 @@
 #include "Sce/SceLabelManager.h"
 #include "Violet/VltCmdList.h"
 #include "Violet/VltDevice.h"
+#include "Violet/VltFormat.h"
+#include "Violet/VltImage.h"
 
+#include <algorithm>
 #include <fstream>
 
 using namespace sce::vlt;
@@ -63,9 +66,15 @@ namespace sce::Gnm
 		}
 
 		//std::memcpy(dstGpuAddr, data, sizeInDwords * sizeof(uint32_t));
+		downloadBeforeLabel();
 		label->write(m_context.ptr(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, selector, value);
 	}
 
+	void GnmCommandBuffer::downloadBeforeLabel()
+	{
+		m_tracker->download(m_device, m_context.ptr(), m_labelManager->nextPoint());
+	}
+
 	const uint32_t* GnmCommandBuffer::findUserData(
 		const gcn::GcnShaderResource& res,
 		uint32_t                      eudIndex,
@@ -142,6 +151,10 @@ namespace sce::Gnm
 
 		if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
 		{
+			// CPU writes to watched guest memory
+			// are copied in with transfer commands.
+			info.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			info.stage |= VK_PIPELINE_STAGE_TRANSFER_BIT;
 			info.memoryType = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
 							  VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 		}
@@ -169,8 +182,6 @@ namespace sce::Gnm
 		VkImageTiling         tiling,
 		VkImageLayout         layout)
 	{
-		SceTexture texture;
-
 		GnmImageCreateInfo info;
 		info.tsharp     = tsharp;
 		info.usage      = usage;
@@ -180,15 +191,149 @@ namespace sce::Gnm
 		info.layout     = layout;
 		info.memoryType = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-		m_factory.createImage(info, texture);
-		m_tracker->track(texture);
+		// Lookup or create image
+
+		Rc<VltImageView> imageView = nullptr;
+		do
+		{
+			void* baseAddress = tsharp->getBaseAddress();
+			auto  resource    = m_tracker->find(baseAddress);
+			if (resource != nullptr && resource->cpuMemory() != baseAddress)
+			{
+				// The texture lives inside another resource,
+				// track it on its own.
+				resource = nullptr;
+			}
+
+			if (resource != nullptr &&
+				!resource->type().any(SceResourceType::Texture,
+									  SceResourceType::RenderTarget,
+									  SceResourceType::DepthRenderTarget))
+			{
+				// A plain buffer aliasing the texture, attaching an
+				// image would make later buffer binds copy into it.
+				SceTexture texture;
+				m_factory.createImage(info, texture);
+				m_initializer->initTexture(texture.image, tsharp);
+
+				imageView = texture.imageView;
+				break;
+			}
+
+			// Render targets have their content on the GPU,
+			// guest memory is stale until read back.
+			bool isTarget = resource != nullptr &&
+							resource->type().test(SceResourceType::RenderTarget);
 
-		m_initializer->initTexture(texture.image, tsharp);
+			Rc<VltImage> image = nullptr;
+			if (resource != nullptr &&
+				resource->type().test(SceResourceType::Texture) &&
+				m_factory.isImageCompatible(info, resource->texture()))
+			{
+				// The tracker drops the resource once its
+				// memory is written, so the content is up to date.
+				image = resource->texture().image;
+
+				if (isTarget && resource->isTextureStale())
+				{
+					copyTargetToTexture(resource->renderTarget(), image);
+				}
+			}
+			else
+			{
+				SceTexture texture;
+				m_factory.createImage(info, texture);
+				// Initialization is submitted before this context,
+				// so the copy still wins where it wrote to.
+				if (!isTarget || !copyTargetToTexture(resource->renderTarget(), texture.image))
+				{
+					m_initializer->initTexture(texture.image, tsharp);
+				}
+
+				if (resource != nullptr)
+				{
+					// Same memory viewed with an incompatible T#,
+					// or a render target sampled as texture.
+					resource->setTexture(texture);
+				}
+				else
+				{
+					resource = m_tracker->track(texture).first;
+				}
+
+				image = texture.image;
+			}
+
+			if (isTarget)
+			{
+				resource->setTextureStale(false);
+			}
+
+			SceTextureViewKey viewKey(*tsharp);
+			imageView = resource->findTextureView(viewKey);
+			if (imageView == nullptr)
+			{
+				m_factory.createImageView(tsharp, image, imageView);
+				resource->addTextureView(viewKey, imageView);
+			}
+		} while (false);
 
 		uint32_t slot = computeResourceBinding(
 			gcnProgramTypeFromVkStage(stage), startRegister);
 
-		m_context->bindResourceView(slot, texture.imageView, nullptr);
+		m_context->bindResourceView(slot, imageView, nullptr);
+	}
+
+	bool GnmCommandBuffer::copyTargetToTexture(
+		const SceRenderTarget& target,
+		const Rc<VltImage>&    image)
+	{
+		bool ret = false;
+		do
+		{
+			auto& srcInfo = target.image->info();
+			auto& dstInfo = image->info();
+
+			// Copies need texels of the same size,
+			// the texture may view the memory with another format.
+			auto srcFormat = imageFormatInfo(srcInfo.format);
+			auto dstFormat = imageFormatInfo(dstInfo.format);
+			if (srcFormat->elementSize != dstFormat->elementSize ||
+				dstFormat->flags.test(VltFormatFlag::BlockCompressed) ||
+				srcInfo.sampleCount != dstInfo.sampleCount)
+			{
+				LOG_WARN("render target sampled as incompatible texture, "
+						 "format %d as %d, content may be stale.",
+						 srcInfo.format, dstInfo.format);
+				break;
+			}
+
+			// Copy every mip level and layer both images have.
+			uint32_t mipLevels = std::min(srcInfo.mipLevels, dstInfo.mipLevels);
+			uint32_t numLayers = std::min(srcInfo.numLayers, dstInfo.numLayers);
+			for (uint32_t level = 0; level != mipLevels; ++level)
+			{
+				VkExtent3D srcExtent = target.image->mipLevelExtent(level);
+				VkExtent3D dstExtent = image->mipLevelExtent(level);
+
+				VkImageSubresourceLayers subresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, numLayers };
+				VkExtent3D               extent      = {
+					std::min(srcExtent.width, dstExtent.width),
+					std::min(srcExtent.height, dstExtent.height),
+					1
+				};
+
+				m_context->copyImage(
+					image, subresource, VkOffset3D{ 0, 0, 0 },
+					target.image, subresource, VkOffset3D{ 0, 0, 0 },
+					extent);
+			}
+
+			// Other subresources are not in the target.
+			ret = mipLevels == dstInfo.mipLevels &&
+				  numLayers == dstInfo.numLayers;
+		} while (false);
+		return ret;
 	}
 
 	void GnmCommandBuffer::bindResourceSampler(
@@ -237,7 +382,7 @@ namespace sce::Gnm
 					bindResourceBuffer(
 						vsharp,
 						res.startRegister,
-						VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+						VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 						stage,
 						VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
 
@@ -383,7 +528,14 @@ namespace sce::Gnm
 			// upload content
 			m_initializer->initBuffer(result.buffer, vsharp);
 			// track the new buffer
-			m_tracker->track(result);
+			resource = m_tracker->track(result).first;
+		}
+
+		// Shader writes need to be read back
+		// before CPU sees the guest memory.
+		if (info.access & VK_ACCESS_SHADER_WRITE_BIT)
+		{
+			resource->setGpuWritten(true);
 		}
 
 		return result;
@@ -419,6 +571,13 @@ namespace sce::Gnm
 
 	void GnmCommandBuffer::initGcnModuleInfo()
 	{
+		// The dummy command buffer may be used without
+		// a device, e.g. to replay packets in benchmarks.
+		if (m_device == nullptr)
+		{
+			return;
+		}
+
 		const auto& devInfo = m_device->properties();
 
 		const uint32_t amdWavefrontSize       = 64;
@@ -27,6 +27,7 @@ namespace sce
 		class VltDevice;
 		class VltContext;
 		class VltCommandList;
+		class VltImage;
 	}  // namespace vlt
 }  // namespace sce
 
@@ -453,6 +454,18 @@ namespace sce::Gnm
 			VkImageTiling         tiling,
 			VkImageLayout         layout);
 
+		/**
+		 * \brief Copies a render target into a texture image
+		 *
+		 * For render targets sampled as texture. Copies all
+		 * mip levels and layers both images have. Returns
+		 * false if the image can't take a copy, or has
+		 * subresources the target doesn't cover.
+		 */
+		bool copyTargetToTexture(
+			const SceRenderTarget&        target,
+			const vlt::Rc<vlt::VltImage>& image);
+
 		void bindResourceSampler(
 			const Sampler*        ssharp,
 			uint32_t              startRegister,
@@ -466,6 +479,16 @@ namespace sce::Gnm
 		void commitComputeState(
 			GnmShaderContext& ctx);
 
+		/**
+		 * \brief Records readbacks ahead of a label write
+		 *
+		 * Labels reach guest memory as soon as the GPU passes
+		 * them. Buffers written so far are copied and fenced
+		 * first, so a guest which sees the label doesn't read
+		 * stale memory.
+		 */
+		void downloadBeforeLabel();
+
 
 		ShaderStage getShaderStage(
 			VkPipelineStageFlags pipeStage);
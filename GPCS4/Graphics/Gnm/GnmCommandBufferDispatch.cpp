@@ -302,6 +302,8 @@ namespace sce::Gnm
 										  ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
 										  : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 
+		downloadBeforeLabel();
+
 		auto label = m_labelManager->getLabel(dstGpuAddr);
 		label->writeWithInterrupt(m_context.ptr(), stage, srcSelector, immValue);
 	}
@@ -312,6 +314,8 @@ namespace sce::Gnm
 										  ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
 										  : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 
+		downloadBeforeLabel();
+
 		auto label = m_labelManager->getLabel(dstGpuAddr);
 		label->write(m_context.ptr(), stage, srcSelector, immValue);
 	}
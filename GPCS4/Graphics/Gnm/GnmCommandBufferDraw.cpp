@@ -1,11 +1,16 @@
 #include "GnmCommandBufferDraw.h"
+#include "Emulator.h"
+#include "VirtualGPU.h"
 
 #include "GnmBuffer.h"
 #include "GnmConverter.h"
+#include "GnmIndexBufferCache.h"
+#include "GnmIndexScan.h"
 #include "GnmSampler.h"
 #include "GnmSharpBuffer.h"
 #include "GnmTexture.h"
 #include "GnmGpuLabel.h"
+#include "GnmStateFilter.h"
 #include "GpuAddress/GnmGpuAddress.h"
 
 #include "Gcn/GcnUtil.h"
@@ -23,9 +28,13 @@
 #include <array>
 #include <fstream>
 #include <functional>
+#include <limits>
 
 LOG_CHANNEL(Graphic.Gnm.GnmCommandBufferDraw);
 
+// Number of draw commands one indirect argument buffer holds.
+constexpr uint32_t MaxDrawArgCount = 4096;
+
 using namespace sce::vlt;
 using namespace sce::gcn;
 
@@ -45,6 +54,10 @@ namespace sce::Gnm
 	{
 		m_initializer = std::make_unique<GnmInitializer>(m_device, VltQueueType::Graphics);
 		m_context     = m_device->createContext();
+		m_indexCache  = std::make_unique<GnmIndexBufferCache>(m_device, m_initializer.get());
+		m_stateFilter = std::make_unique<GnmStateFilter>(
+			m_context.ptr(), [this]()
+			{ flushDraws(); });
 	}
 
 	GnmCommandBufferDraw::~GnmCommandBufferDraw()
@@ -57,8 +70,21 @@ namespace sce::Gnm
 		// We do some initialize work here.
 		GnmCommandBuffer::initializeDefaultHardwareState();
 
+		m_stateFilter->resetStats();
+		m_mergeStats = GnmDrawMergeStats();
+
+		// The previous buffer may still be in flight.
+		m_drawArgBuffer = nullptr;
+		m_drawArgCount  = 0;
+
 		m_context->beginRecording(
 			m_device->createCommandList(VltQueueType::Graphics));
+
+		// Context state may have been changed
+		// by others since the last frame.
+		m_stateFilter->invalidate();
+
+		m_state.om.renderTargets = {};
 	}
 
 	void GnmCommandBufferDraw::setViewportTransformControl(ViewportTransformControl vportControl)
@@ -83,7 +109,7 @@ namespace sce::Gnm
 			VK_CONSERVATIVE_RASTERIZATION_MODE_DISABLED_EXT
 		};
 
-		m_context->setRasterizerState(rs);
+		m_stateFilter->setRasterizerState(rs);
 	}
 
 	void GnmCommandBufferDraw::setScreenScissor(int32_t left, int32_t top, int32_t right, int32_t bottom)
@@ -93,7 +119,7 @@ namespace sce::Gnm
 		scissor.offset.y      = top;
 		scissor.extent.width  = right - left;
 		scissor.extent.height = bottom - top;
-		m_context->setScissors(1, &scissor);
+		m_stateFilter->setScissor(scissor);
 	}
 
 	void GnmCommandBufferDraw::setViewport(uint32_t viewportId, float dmin, float dmax, const float scale[3], const float offset[3])
@@ -121,7 +147,7 @@ namespace sce::Gnm
 		viewport.minDepth = dmin;
 		viewport.maxDepth = dmax;
 
-		m_context->setViewports(1, &viewport);
+		m_stateFilter->setViewport(viewport);
 	}
 
 	void GnmCommandBufferDraw::setHardwareScreenOffset(uint32_t offsetX, uint32_t offsetY)
@@ -136,6 +162,8 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::setPsShaderUsage(const uint32_t* inputTable, uint32_t numItems)
 	{
+		flushDraws();
+
 		auto& ctx = m_state.shaderContext[kShaderStagePs];
 		std::transform(inputTable, inputTable + numItems,
 					   ctx.meta.ps.semanticMapping.begin(),
@@ -291,6 +319,8 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::setRenderTarget(uint32_t rtSlot, RenderTarget const* target)
 	{
+		flushDraws();
+
 		auto resource = m_tracker->find(target->getBaseAddress());
 		do
 		{
@@ -306,7 +336,7 @@ namespace sce::Gnm
 				rtTexture.initFromRenderTarget(target, false);
 				m_initializer->initTexture(rtRes.image, &rtTexture);
 
-				m_tracker->track(rtRes);
+				resource = m_tracker->track(rtRes).first;
 			}
 			else
 			{
@@ -324,6 +354,8 @@ namespace sce::Gnm
 				targetView = rtRes.imageView;
 			}
 
+			m_state.om.renderTargets[rtSlot] = resource;
+
 			VltAttachment attachment = 
 			{
 				targetView,
@@ -336,6 +368,8 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::setDepthRenderTarget(DepthRenderTarget const* depthTarget)
 	{
+		flushDraws();
+
 		do
 		{
 			if (depthTarget == nullptr)
@@ -355,8 +389,7 @@ namespace sce::Gnm
 				m_factory.createDepthImage(depthTarget, depthResource);
 				depthView = depthResource.imageView;
 
-				auto iter = m_tracker->track(depthResource).first;
-				resource  = &iter->second;
+				resource = m_tracker->track(depthResource).first;
 			}
 			else
 			{
@@ -388,6 +421,8 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::setDepthClearValue(float clearValue)
 	{
+		flushDraws();
+
 		VkClearValue value;
 		value.depthStencil.depth = clearValue;
 		m_context->setDepthClearValue(value);
@@ -395,6 +430,8 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::setStencilClearValue(uint8_t clearValue)
 	{
+		flushDraws();
+
 		VkClearValue value;
 		value.depthStencil.stencil = clearValue;
 		m_context->setStencilClearValue(value);
@@ -405,7 +442,7 @@ namespace sce::Gnm
 		auto writeMasks = cvt::convertRenderTargetMask(mask);
 		for (uint32_t attachment = 0; attachment != writeMasks.size(); ++attachment)
 		{
-			m_context->setBlendMask(
+			m_stateFilter->setBlendMask(
 				attachment, writeMasks[attachment]);
 		}
 	}
@@ -440,13 +477,13 @@ namespace sce::Gnm
 			fullMask
 		};
 
-		m_context->setBlendMode(rtSlot, blend);
+		m_stateFilter->setBlendMode(rtSlot, blend);
 
 		VltLogicOpState loState;
 		loState.enableLogicOp = VK_FALSE;
 		loState.logicOp       = VK_LOGIC_OP_NO_OP;
 
-		m_context->setLogicOpState(loState);
+		m_stateFilter->setLogicOpState(loState);
 	}
 
 	void GnmCommandBufferDraw::setDepthStencilControl(DepthStencilControl depthControl)
@@ -472,11 +509,11 @@ namespace sce::Gnm
 		};
 
 		// We use depth bounds test to emulate DbRenderControl
-		m_context->setDepthBoundsTestEnable(m_state.ds.dbClearDepth
-												? VK_TRUE
-												: depthControl.depthBoundsEnable);
+		m_stateFilter->setDepthBoundsTestEnable(m_state.ds.dbClearDepth
+													? VK_TRUE
+													: depthControl.depthBoundsEnable);
 
-		m_context->setDepthStencilState(ds);
+		m_stateFilter->setDepthStencilState(ds);
 	}
 
 	void GnmCommandBufferDraw::setDbRenderControl(DbRenderControl reg)
@@ -497,18 +534,18 @@ namespace sce::Gnm
 			// TODO:
 			// This approach is not accurate, fix it in the future.
 
-			m_context->setDepthBoundsTestEnable(VK_TRUE);
+			m_stateFilter->setDepthBoundsTestEnable(VK_TRUE);
 
 			VltDepthBoundsRange depthBounds;
 			depthBounds.minDepthBounds    = 1.0;
 			depthBounds.maxDepthBounds    = 0.0;
-			m_context->setDepthBoundsRange(depthBounds);
+			m_stateFilter->setDepthBoundsRange(depthBounds);
 
 			m_state.ds.dbClearDepth = true;
 		}
 		else
 		{
-			m_context->setDepthBoundsTestEnable(VK_FALSE);
+			m_stateFilter->setDepthBoundsTestEnable(VK_FALSE);
 			m_state.ds.dbClearDepth = false;
 		}
 
@@ -522,17 +559,9 @@ namespace sce::Gnm
 	void GnmCommandBufferDraw::setPrimitiveType(PrimitiveType primType)
 	{
 		VkPrimitiveTopology topology = cvt::convertPrimitiveType(primType);
-		
-		// TODO:
-		// This is a temporary solution, mainly for embedded vertex shader.
-		// For a primitive type which is not supported by vulkan natively,
-		// we need to find a workaround.
-		if (primType == kPrimitiveTypeRectList)
-		{
-			topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-		}
 
 		LOG_ASSERT(topology != VK_PRIMITIVE_TOPOLOGY_MAX_ENUM, "primType not supported.");
+		m_state.ia.primType = primType;
 		m_state.ia.topology = topology;
 
 		VltInputAssemblyState ia = {
@@ -540,7 +569,7 @@ namespace sce::Gnm
 			VK_FALSE,
 			0
 		};
-		m_context->setInputAssemblyState(ia);
+		m_stateFilter->setInputAssemblyState(ia);
 	}
 
 	void GnmCommandBufferDraw::setIndexSize(IndexSize indexSize, CachePolicy cachePolicy)
@@ -550,13 +579,34 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::drawIndexAuto(uint32_t indexCount, DrawModifier modifier)
 	{
+		// Auto indexed draws sharing state would draw the
+		// same vertices, there's nothing worth merging.
+		flushDraws();
+
 		// If the index size is currently 32 bits, this command will partially set it to 16 bits
-		m_state.ia.indexType   = VK_INDEX_TYPE_UINT16;
-		m_state.ia.indexBuffer = generateIndexBufferAuto(indexCount);
+		m_state.ia.indexType = VK_INDEX_TYPE_UINT16;
 
 		commitGraphicsState();
 
-		m_context->drawIndexed(indexCount, 1, 0, 0, 0);
+		uint32_t drawCount = GnmIndexBufferCache::getIndexCount(m_state.ia.primType, indexCount);
+		if (drawCount == 0)
+		{
+			return;
+		}
+
+		m_context->bindIndexBuffer(
+			m_indexCache->getAutoIndices(m_state.ia.primType, indexCount),
+			VK_INDEX_TYPE_UINT32);
+
+		GnmIndexRange range;
+		range.minIndex = 0;
+		range.maxIndex = indexCount - 1;
+		bindVertexBuffers(range);
+
+		m_initializer->flush();
+		m_tracker->transform(m_context.ptr());
+
+		m_context->drawIndexed(drawCount, 1, 0, 0, 0);
 	}
 
 	void GnmCommandBufferDraw::drawIndexAuto(uint32_t indexCount)
@@ -568,16 +618,20 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::drawIndex(uint32_t indexCount, const void* indexAddr, DrawModifier modifier)
 	{
-		uint32_t indexBufferSize =
-			m_state.ia.indexType == VK_INDEX_TYPE_UINT16
-				? sizeof(uint16_t) * indexCount
-				: sizeof(uint32_t) * indexCount;
+		++m_mergeStats.draws;
 
-		m_state.ia.indexBuffer = generateIndexBuffer(indexAddr, indexBufferSize);
+		auto fingerprint = getDrawFingerprint();
+		if (m_pendingDraws.empty() || !(fingerprint == m_pendingFingerprint))
+		{
+			flushDraws();
 
-		commitGraphicsState();
+			commitGraphicsState();
 
-		m_context->drawIndexed(indexCount, 1, 0, 0, 0);
+			m_pendingFingerprint = fingerprint;
+		}
+
+		m_pendingDraws.push_back(GnmPendingDraw{
+			reinterpret_cast<const uint8_t*>(indexAddr), indexCount });
 	}
 
 	void GnmCommandBufferDraw::drawIndex(uint32_t indexCount, const void* indexAddr)
@@ -589,6 +643,8 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::dispatch(uint32_t threadGroupX, uint32_t threadGroupY, uint32_t threadGroupZ)
 	{
+		flushDraws();
+
 		commitComputeState();
 
 		m_context->dispatch(threadGroupX, threadGroupY, threadGroupZ);
@@ -600,57 +656,83 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::writeDataInline(void* dstGpuAddr, const void* data, uint32_t sizeInDwords, WriteDataConfirmMode writeConfirm)
 	{
+		flushDraws();
+
 		GnmCommandBuffer::writeDataInline(dstGpuAddr, data, sizeInDwords, writeConfirm);
 	}
 
 	void GnmCommandBufferDraw::writeDataInlineThroughL2(void* dstGpuAddr, const void* data, uint32_t sizeInDwords, CachePolicy cachePolicy, WriteDataConfirmMode writeConfirm)
 	{
+		flushDraws();
+
 		GnmCommandBuffer::writeDataInline(dstGpuAddr, data, sizeInDwords, writeConfirm);
 	}
 
 	void GnmCommandBufferDraw::writeAtEndOfPipe(EndOfPipeEventType eventType, EventWriteDest dstSelector, void* dstGpuAddr, EventWriteSource srcSelector, uint64_t immValue, CacheAction cacheAction, CachePolicy cachePolicy)
 	{
+		flushDraws();
+
 		VkPipelineStageFlags2 stage = eventType == kEopCsDone
 										  ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
 										  : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 
+		downloadBeforeLabel();
+
 		auto label = m_labelManager->getLabel(dstGpuAddr);
 		label->write(m_context.ptr(), stage, srcSelector, immValue);
 	}
 
 	void GnmCommandBufferDraw::writeAtEndOfPipeWithInterrupt(EndOfPipeEventType eventType, EventWriteDest dstSelector, void* dstGpuAddr, EventWriteSource srcSelector, uint64_t immValue, CacheAction cacheAction, CachePolicy cachePolicy)
 	{
+		flushDraws();
+
 		VkPipelineStageFlags2 stage = eventType == kEopCsDone
 										  ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
 										  : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 
+		downloadBeforeLabel();
+
 		auto label = m_labelManager->getLabel(dstGpuAddr);
 		label->writeWithInterrupt(m_context.ptr(), stage, srcSelector, immValue);
 	}
 
 	void GnmCommandBufferDraw::writeAtEndOfShader(EndOfShaderEventType eventType, void* dstGpuAddr, uint32_t immValue)
 	{
+		flushDraws();
+
 		VkPipelineStageFlags2 stage = eventType == kEosPsDone
 										  ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
 										  : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 
+		downloadBeforeLabel();
+
 		auto label = m_labelManager->getLabel(dstGpuAddr);
 		label->write(m_context.ptr(), stage, kEventWriteSource64BitsImmediate, immValue);
 	}
 
 	void GnmCommandBufferDraw::waitOnAddress(void* gpuAddr, uint32_t mask, WaitCompareFunc compareFunc, uint32_t refValue)
 	{
+		flushDraws();
+
 		auto label = m_labelManager->getLabel(gpuAddr);
 		label->wait(m_context.ptr(), mask, compareFunc, refValue);
 	}
 
 	void GnmCommandBufferDraw::waitOnAddressAndStallCommandBufferParser(void* gpuAddr, uint32_t mask, uint32_t refValue)
 	{
-		LOG_ASSERT(false, "TODO");
+		flushDraws();
+
+		// We record commands ahead of execution, stalling
+		// the parser is equivalent to a timeline wait before
+		// the following commands.
+		auto label = m_labelManager->getLabel(gpuAddr);
+		label->wait(m_context.ptr(), mask, kWaitCompareFuncEqual, refValue);
 	}
 
 	void GnmCommandBufferDraw::waitForGraphicsWrites(uint32_t baseAddr256, uint32_t sizeIn256ByteBlocks, uint32_t targetMask, CacheAction cacheAction, uint32_t extendedCacheMask, StallCommandBufferParserMode commandBufferStallMode)
 	{
+		flushDraws();
+
 		// TODO:
 		// This should be done more accurately,
 		// e.g. specify the render target image and use an image barrier.
@@ -660,7 +742,7 @@ namespace sce::Gnm
 	void GnmCommandBufferDraw::setDepthStencilDisable()
 	{
 		VltDepthStencilState ds = {};
-		m_context->setDepthStencilState(ds);
+		m_stateFilter->setDepthStencilState(ds);
 	}
 
 	void GnmCommandBufferDraw::setClipControl(ClipControl reg)
@@ -674,6 +756,8 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::waitUntilSafeForRendering(uint32_t videoOutHandle, uint32_t displayBufferIndex)
 	{
+		flushDraws();
+
 		// This cmd blocks command processor until the specified display buffer is no longer displayed.
 		// should we call vkAcquireNextImageKHR here to implement it?
 		// or should we create a new render target image and then bilt to swapchain like DXVK does?
@@ -707,8 +791,8 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::prepareFlip(void* labelAddr, uint32_t value)
 	{
-		*(uint32_t*)labelAddr = value;
 		onPrepareFlip();
+		*(uint32_t*)labelAddr = value;
 	}
 
 	void GnmCommandBufferDraw::prepareFlipWithEopInterrupt(EndOfPipeEventType eventType, CacheAction cacheAction)
@@ -718,8 +802,8 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::prepareFlipWithEopInterrupt(EndOfPipeEventType eventType, void* labelAddr, uint32_t value, CacheAction cacheAction)
 	{
-		*(uint32_t*)labelAddr = value;
 		onPrepareFlip();
+		*(uint32_t*)labelAddr = value;
 	}
 
 	void GnmCommandBufferDraw::setCsShader(const gcn::CsStageRegisters* computeData, uint32_t shaderModifier)
@@ -749,28 +833,6 @@ namespace sce::Gnm
 		return buffer.buffer;
 	}
 
-	Rc<VltBuffer> GnmCommandBufferDraw::generateIndexBufferAuto(uint32_t indexCount)
-	{
-		// Auto-generated indexes are forced in 16 bits width.
-		std::vector<uint16_t> indexes;
-
-		switch (m_state.ia.topology)
-		{
-		case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST:
-		{
-			indexes.resize(indexCount);
-			std::generate(indexes.begin(), indexes.end(),
-				[n = 0]() mutable -> uint16_t { return n++; });
-		}
-			break;
-		default:
-			LOG_ASSERT(false, "topology type not supported.");
-			break;
-		}
-
-		return generateIndexBuffer(indexes.data(), sizeof(uint16_t) * indexes.size());
-	}
-
 	bool GnmCommandBufferDraw::isSingleVertexBinding(
 		const uint32_t*                 vtxTable,
 		const VertexInputSemanticTable& semanticTable)
@@ -810,21 +872,105 @@ namespace sce::Gnm
 		return isSingleBinding;
 	}
 
-	inline void GnmCommandBufferDraw::bindVertexBuffer(
-		const Buffer* vsharp, uint32_t binding)
+	void GnmCommandBufferDraw::bindVertexBuffer(
+		const Buffer*        vsharp,
+		uint32_t             binding,
+		const GnmIndexRange& range)
 	{
-		GnmBufferCreateInfo info;
-		info.vsharp     = vsharp;
-		info.usage      = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-		info.stage      = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
-		info.access     = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
-		info.memoryType = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		uint32_t stride      = vsharp->getStride();
+		uint32_t numElements = vsharp->getNumElements();
 
-		SceBuffer buffer = getResourceBuffer(info);
+		VltBufferSlice bufferSlice;
+		VkDeviceSize   skipSize = 0;
+		do
+		{
+			// Only upload the vertices referenced by the draw, which
+			// may be a small window of a large shared vertex pool.
+			// Draws offset their indices by the first vertex.
+			Buffer slice = *vsharp;
+			if (stride != 0)
+			{
+				if (range.minIndex >= numElements)
+				{
+					// Nothing in range, fetches return zero.
+					break;
+				}
+
+				// Records of swizzled buffers are interleaved in blocks,
+				// those are sliced at a block boundary and the leading
+				// records skipped when binding.
+				uint32_t firstRecord = range.minIndex;
+				if (vsharp->isSwizzled())
+				{
+					uint32_t indexStride = 8u << vsharp->getSwizzleStride();
+					firstRecord          = range.minIndex & ~(indexStride - 1);
+				}
+
+				const uint8_t* base = reinterpret_cast<const uint8_t*>(vsharp->getBaseAddress());
+				slice.setBaseAddress(base + size_t(firstRecord) * stride);
+				slice.setNumElements(std::min(range.maxIndex + 1, numElements) - firstRecord);
+				skipSize = VkDeviceSize(range.minIndex - firstRecord) * stride;
+			}
+
+			GnmBufferCreateInfo info;
+			info.vsharp     = &slice;
+			info.usage      = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+			info.stage      = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+			info.access     = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+			info.memoryType = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+			uint8_t* sliceStart = reinterpret_cast<uint8_t*>(slice.getBaseAddress());
+			size_t   sliceSize  = slice.getSize();
+
+			auto resource = m_tracker->find(sliceStart);
+			if (resource == nullptr ||
+				resource->type().any(SceResourceType::Texture,
+									 SceResourceType::RenderTarget,
+									 SceResourceType::DepthRenderTarget))
+			{
+				SceBuffer buffer = getResourceBuffer(info);
+				bufferSlice      = VltBufferSlice(buffer.buffer, 0, buffer.buffer->info().size);
+				break;
+			}
+
+			uint8_t* resourceStart = reinterpret_cast<uint8_t*>(resource->cpuMemory());
+			if (sliceStart + sliceSize <= resourceStart + resource->size())
+			{
+				// Vertices uploaded by an earlier draw,
+				// bind them at their offset in that buffer.
+				bufferSlice = VltBufferSlice(resource->buffer().buffer,
+											 sliceStart - resourceStart,
+											 sliceSize);
+			}
+			else
+			{
+				// Runs past the end of a tracked buffer, upload
+				// the slice on its own rather than widening it.
+				SceBuffer buffer;
+				m_factory.createBuffer(info, buffer);
+				m_initializer->initBuffer(buffer.buffer, &slice);
+				bufferSlice = VltBufferSlice(buffer.buffer);
+			}
+		} while (false);
 
-		m_context->bindVertexBuffer(binding,
-									VltBufferSlice(buffer.buffer, 0, buffer.buffer->info().size),
-									vsharp->getStride());
+		if (skipSize != 0 && bufferSlice.defined())
+		{
+			bufferSlice = bufferSlice.subSlice(skipSize, bufferSlice.length() - skipSize);
+		}
+
+		m_context->bindVertexBuffer(binding, bufferSlice, stride);
+	}
+
+	void GnmCommandBufferDraw::bindVertexBuffers(
+		const GnmIndexRange& range)
+	{
+		auto& ia = m_state.ia;
+		for (uint32_t i = 0; i != ia.vertexBufferCount; ++i)
+		{
+			bindVertexBuffer(&ia.vertexBuffers[i].vsharp,
+							 ia.vertexBuffers[i].binding,
+							 range);
+		}
 	}
 
 	void GnmCommandBufferDraw::updateVertexBinding(GcnModule& vsModule)
@@ -896,14 +1042,17 @@ namespace sce::Gnm
 				singleBinding ? 1 : semanticCount,
 				bindings.data());
 
-			// Create, upload and bind vertex buffer
+			// Vertex buffers are uploaded and bound by the draw,
+			// once its index range is known.
 			for (uint32_t i = 0; i != semanticCount; ++i)
 			{
 				auto&         sema           = semaTable[i];
 				uint32_t      offsetInDwords = sema.m_semantic * ShaderConstantDwordSize::kDwordSizeVertexBuffer;
 				const Buffer* vsharp         = reinterpret_cast<const Buffer*>(vertexTable + offsetInDwords);
 
-				bindVertexBuffer(vsharp, sema.m_semantic);
+				auto& vertexBuffer   = m_state.ia.vertexBuffers[m_state.ia.vertexBufferCount++];
+				vertexBuffer.vsharp  = *vsharp;
+				vertexBuffer.binding = sema.m_semantic;
 
 				if (singleBinding)
 				{
@@ -932,6 +1081,8 @@ namespace sce::Gnm
 		// Update vertex input
 		auto& ctx = m_state.shaderContext[kShaderStageVs];
 
+		m_state.ia.vertexBufferCount = 0;
+
 		do 
 		{
 			if (ctx.code == nullptr)
@@ -939,13 +1090,6 @@ namespace sce::Gnm
 				break;
 			}
 
-			// Update index
-			// All draw calls in Gnm need index buffer.
-			auto& indexBuffer = m_state.ia.indexBuffer;
-			m_context->bindIndexBuffer(
-				VltBufferSlice(indexBuffer, 0, indexBuffer->info().size),
-				m_state.ia.indexType);
-
 			GcnModule vsModule(
 				GcnProgramType::VertexShader,
 				reinterpret_cast<const uint8_t*>(ctx.code));
@@ -962,6 +1106,14 @@ namespace sce::Gnm
 			m_context->bindShader(
 				VK_SHADER_STAGE_VERTEX_BIT,
 				vsModule.compile(ctx.meta, m_moduleInfo));
+
+			// Rect lists need the fourth corner generated
+			Rc<VltShader> gsShader;
+			if (m_state.ia.primType == kPrimitiveTypeRectList)
+			{
+				gsShader = vsModule.compileRectListShader();
+			}
+			m_context->bindShader(VK_SHADER_STAGE_GEOMETRY_BIT, gsShader);
 		} while (false);
 	}
 
@@ -994,6 +1146,16 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::commitGraphicsState()
 	{
+		// The draw writes the bound targets, textures
+		// sampling them need a fresh copy.
+		for (auto target : m_state.om.renderTargets)
+		{
+			if (target != nullptr)
+			{
+				target->setTextureStale(true);
+			}
+		}
+
 		updateVertexShaderStage();
 
 		updatePixelShaderStage();
@@ -1002,7 +1164,7 @@ namespace sce::Gnm
 		VltMultisampleState msState;
 		msState.enableAlphaToCoverage = VK_FALSE;
 		msState.sampleMask            = 0xFFFFFFFF;
-		m_context->setMultisampleState(msState);
+		m_stateFilter->setMultisampleState(msState);
 
 		// Flush memory to buffer and texture resources.
 		m_initializer->flush();
@@ -1038,6 +1200,262 @@ namespace sce::Gnm
 		// This is the last cmd for a command buffer submission,
 		// we can do some finish works before submit and present.
 
+		flushDraws();
+
+		const auto& stats = m_stateFilter->stats();
+		LOG_DEBUG("state calls filtered %u applied %u", stats.filtered, stats.applied);
+		LOG_DEBUG("draws %u merged %u into %u indirect draws",
+				  m_mergeStats.draws, m_mergeStats.merged, m_mergeStats.indirect);
+
+		const auto staging = m_context->getStagingStats();
+		LOG_DEBUG("staging ring high water mark %llu of %llu, %llu dedicated allocs",
+				  static_cast<unsigned long long>(staging.highWaterMark),
+				  static_cast<unsigned long long>(staging.ringSize),
+				  static_cast<unsigned long long>(staging.dedicatedAllocs));
+
+		const auto barriers = m_context->takeBarrierStats();
+		LOG_DEBUG("barriers %u batches, %u buffer, %u image, %u elided",
+				  barriers.batches, barriers.bufferBarriers, barriers.imageBarriers, barriers.elided);
+
+		const auto memProps = m_device->adapter()->memoryProperties();
+		for (uint32_t i = 0; i < memProps.memoryHeapCount; i++)
+		{
+			const auto memory = m_device->getMemoryStats(i);
+			const auto chunks = m_device->getMemoryChunkStats(i);
+			if (memory.memoryAllocated == 0)
+			{
+				continue;
+			}
+
+			LOG_DEBUG("heap %u used %llu of %llu, %u chunks with %llu free in %u blocks, largest %llu, fragmentation %.2f",
+					  i,
+					  static_cast<unsigned long long>(memory.memoryUsed),
+					  static_cast<unsigned long long>(memory.memoryAllocated),
+					  chunks.chunkCount,
+					  static_cast<unsigned long long>(chunks.memoryFree),
+					  chunks.freeBlockCount,
+					  static_cast<unsigned long long>(chunks.largestFreeBlock),
+					  chunks.fragmentation);
+		}
+	}
+
+	GnmDrawFingerprint GnmCommandBufferDraw::getDrawFingerprint() const
+	{
+		GnmDrawFingerprint fingerprint;
+		for (uint32_t i = 0; i != kShaderStageCount; ++i)
+		{
+			fingerprint.code[i]     = m_state.shaderContext[i].code;
+			fingerprint.userData[i] = m_state.shaderContext[i].userData;
+		}
+		fingerprint.indexType    = m_state.ia.indexType;
+		fingerprint.primType     = m_state.ia.primType;
+		fingerprint.topology     = m_state.ia.topology;
+		fingerprint.dbClearDepth = m_state.ds.dbClearDepth;
+		fingerprint.displayRT    = m_state.om.displayRenderTarget;
+		return fingerprint;
+	}
+
+	void GnmCommandBufferDraw::flushDraws()
+	{
+		if (m_pendingDraws.empty())
+		{
+			return;
+		}
+
+		if (m_pendingDraws.size() == 1 || !emitMergedDraws())
+		{
+			uint32_t indexSize = m_pendingFingerprint.indexType == VK_INDEX_TYPE_UINT16
+									 ? sizeof(uint16_t)
+									 : sizeof(uint32_t);
+
+			PrimitiveType primType = m_pendingFingerprint.primType;
+			for (const auto& draw : m_pendingDraws)
+			{
+				uint32_t drawCount = GnmIndexBufferCache::getIndexCount(primType, draw.indexCount);
+				if (drawCount == 0)
+				{
+					continue;
+				}
+
+				VltBufferSlice indexSlice;
+				if (GnmIndexBufferCache::needsConversion(primType))
+				{
+					indexSlice = m_indexCache->convertIndices(
+						primType, draw.indexAddr, draw.indexCount, m_pendingFingerprint.indexType);
+				}
+				else
+				{
+					auto indexBuffer = generateIndexBuffer(
+						draw.indexAddr, indexSize * draw.indexCount);
+					indexSlice = VltBufferSlice(indexBuffer, 0, indexBuffer->info().size);
+				}
+
+				m_context->bindIndexBuffer(
+					indexSlice,
+					m_pendingFingerprint.indexType);
+
+				GnmIndexRange range = scanIndexRange(
+					draw.indexAddr, draw.indexCount, m_pendingFingerprint.indexType);
+				bindVertexBuffers(range);
+
+				m_initializer->flush();
+				m_tracker->transform(m_context.ptr());
+
+				m_context->drawIndexed(drawCount, 1, 0, -int32_t(range.minIndex), 0);
+			}
+		}
+
+		m_pendingDraws.clear();
+	}
+
+	bool GnmCommandBufferDraw::emitMergedDraws()
+	{
+		// Converted indices don't live in guest memory.
+		if (GnmIndexBufferCache::needsConversion(m_pendingFingerprint.primType))
+		{
+			return false;
+		}
+
+		uint32_t indexSize = m_pendingFingerprint.indexType == VK_INDEX_TYPE_UINT16
+								 ? sizeof(uint16_t)
+								 : sizeof(uint32_t);
+
+		// All draws must index into one compact memory range,
+		// so that a single index buffer covers all of them.
+		const uint8_t* begin      = m_pendingDraws.front().indexAddr;
+		const uint8_t* end        = begin;
+		size_t         totalBytes = 0;
+		for (const auto& draw : m_pendingDraws)
+		{
+			size_t size = size_t(draw.indexCount) * indexSize;
+			begin       = std::min(begin, draw.indexAddr);
+			end         = std::max(end, draw.indexAddr + size);
+			totalBytes += size;
+		}
+
+		size_t span = end - begin;
+		if (span > totalBytes * 2 + 4096 ||
+			span > std::numeric_limits<uint32_t>::max())
+		{
+			return false;
+		}
+
+		for (const auto& draw : m_pendingDraws)
+		{
+			if ((draw.indexAddr - begin) % indexSize != 0)
+			{
+				return false;
+			}
+		}
+
+		auto indexBuffer = generateIndexBuffer(begin, span);
+		if (indexBuffer->info().size < span)
+		{
+			// Overlaps a smaller buffer already tracked.
+			return false;
+		}
+
+		// One vertex range for all draws, they share
+		// their vertex buffers.
+		GnmIndexRange range;
+		range.minIndex = std::numeric_limits<uint32_t>::max();
+		range.maxIndex = 0;
+		for (const auto& draw : m_pendingDraws)
+		{
+			GnmIndexRange drawRange = scanIndexRange(
+				draw.indexAddr, draw.indexCount, m_pendingFingerprint.indexType);
+			range.minIndex = std::min(range.minIndex, drawRange.minIndex);
+			range.maxIndex = std::max(range.maxIndex, drawRange.maxIndex);
+		}
+
+		m_context->bindIndexBuffer(
+			VltBufferSlice(indexBuffer, 0, indexBuffer->info().size),
+			m_pendingFingerprint.indexType);
+		bindVertexBuffers(range);
+
+		m_initializer->flush();
+		m_tracker->transform(m_context.ptr());
+
+		uint32_t drawCount = m_pendingDraws.size();
+		uint32_t maxCount  = getMaxDrawIndirectCount();
+		if (maxCount <= 1)
+		{
+			// Without multiDrawIndirect the draws still
+			// share one index buffer and vertex range.
+			for (const auto& draw : m_pendingDraws)
+			{
+				m_context->drawIndexed(draw.indexCount, 1,
+									   (draw.indexAddr - begin) / indexSize,
+									   -int32_t(range.minIndex), 0);
+			}
+
+			m_mergeStats.merged += drawCount;
+			return true;
+		}
+
+		VkDeviceSize argOffset = allocDrawArgs(drawCount);
+
+		auto args = reinterpret_cast<VkDrawIndexedIndirectCommand*>(
+			m_drawArgBuffer->mapPtr(argOffset));
+		for (const auto& draw : m_pendingDraws)
+		{
+			args->indexCount    = draw.indexCount;
+			args->instanceCount = 1;
+			args->firstIndex    = (draw.indexAddr - begin) / indexSize;
+			args->vertexOffset  = -int32_t(range.minIndex);
+			args->firstInstance = 0;
+			++args;
+		}
+
+		m_context->bindDrawBuffer(
+			VltBufferSlice(m_drawArgBuffer));
+
+		for (uint32_t first = 0; first < drawCount; first += maxCount)
+		{
+			uint32_t count = std::min(drawCount - first, maxCount);
+			m_context->drawIndexedIndirect(
+				argOffset + first * sizeof(VkDrawIndexedIndirectCommand),
+				count, sizeof(VkDrawIndexedIndirectCommand));
+
+			++m_mergeStats.indirect;
+		}
+
+		m_mergeStats.merged += drawCount;
+		return true;
+	}
+
+	uint32_t GnmCommandBufferDraw::getMaxDrawIndirectCount() const
+	{
+		if (!m_device->features().core.features.multiDrawIndirect)
+		{
+			return 1;
+		}
+
+		return m_device->properties().core.properties.limits.maxDrawIndirectCount;
+	}
+
+	VkDeviceSize GnmCommandBufferDraw::allocDrawArgs(uint32_t drawCount)
+	{
+		// Arguments are written by the host before submission,
+		// so no barrier is needed for them.
+		if (m_drawArgBuffer == nullptr ||
+			m_drawArgCount + drawCount > MaxDrawArgCount)
+		{
+			VltBufferCreateInfo info;
+			info.size   = sizeof(VkDrawIndexedIndirectCommand) * std::max(drawCount, MaxDrawArgCount);
+			info.usage  = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+			info.stages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+			info.access = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+
+			m_drawArgBuffer = m_device->createBuffer(info,
+													 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+														 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+			m_drawArgCount = 0;
+		}
+
+		VkDeviceSize offset = sizeof(VkDrawIndexedIndirectCommand) * m_drawArgCount;
+		m_drawArgCount += drawCount;
+		return offset;
 	}
 
 	void GnmCommandBufferDraw::updateMetaTextureInfo(
@@ -1156,17 +1574,32 @@ namespace sce::Gnm
 
 	void GnmCommandBufferDraw::pushMarker(const char* debugString)
 	{
-		//throw std::logic_error("The method or operation is not implemented.");
+		// Draws must not be moved across marker boundaries.
+		flushDraws();
 	}
 
 	void GnmCommandBufferDraw::pushMarker(const char* debugString, uint32_t argbColor)
 	{
-		//throw std::logic_error("The method or operation is not implemented.");
+		flushDraws();
 	}
 
 	void GnmCommandBufferDraw::popMarker()
 	{
-		//throw std::logic_error("The method or operation is not implemented.");
+		flushDraws();
+	}
+
+	void GnmCommandBufferDraw::writeReleaseMemEvent(ReleaseMemEventType eventType, EventWriteDest dstSelector, void* dstGpuAddr, EventWriteSource srcSelector, uint64_t immValue, CacheAction cacheAction, CachePolicy writePolicy)
+	{
+		flushDraws();
+
+		GnmCommandBuffer::writeReleaseMemEvent(eventType, dstSelector, dstGpuAddr, srcSelector, immValue, cacheAction, writePolicy);
+	}
+
+	void GnmCommandBufferDraw::writeReleaseMemEventWithInterrupt(ReleaseMemEventType eventType, EventWriteDest dstSelector, void* dstGpuAddr, EventWriteSource srcSelector, uint64_t immValue, CacheAction cacheAction, CachePolicy writePolicy)
+	{
+		flushDraws();
+
+		GnmCommandBuffer::writeReleaseMemEventWithInterrupt(eventType, dstSelector, dstGpuAddr, srcSelector, immValue, cacheAction, writePolicy);
 	}
 
 }  // namespace sce::Gnm
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "GnmCommandBuffer.h"
 #include "GnmCommon.h"
+#include "GnmIndexScan.h"
 #include "GnmRenderState.h"
 
 #include "Gcn/GcnShaderBinary.h"
@@ -13,6 +14,11 @@ namespace sce::gcn
 
 namespace sce::Gnm
 {
+	class GnmIndexBufferCache;
+	template <typename Context>
+	class GnmStateFilterT;
+	using GnmStateFilter = GnmStateFilterT<vlt::VltContext>;
+
 	// This class is designed for graphics development,
 	// no reverse engineering knowledge should be required.
 	// It's responsible for mapping Gnm input/structures to Violet input/structures,
@@ -157,6 +163,10 @@ namespace sce::Gnm
 
 		virtual void popMarker() override;
 
+		virtual void writeReleaseMemEvent(ReleaseMemEventType eventType, EventWriteDest dstSelector, void* dstGpuAddr, EventWriteSource srcSelector, uint64_t immValue, CacheAction cacheAction, CachePolicy writePolicy) override;
+
+		virtual void writeReleaseMemEventWithInterrupt(ReleaseMemEventType eventType, EventWriteDest dstSelector, void* dstGpuAddr, EventWriteSource srcSelector, uint64_t immValue, CacheAction cacheAction, CachePolicy writePolicy) override;
+
  private:
 
 		const void* findFetchShader(
@@ -171,11 +181,24 @@ namespace sce::Gnm
 			const void* data,
 			uint32_t    size);
 
-		vlt::Rc<vlt::VltBuffer> generateIndexBufferAuto(
-			uint32_t indexCount);
+		void bindVertexBuffer(
+			const Buffer*        vsharp,
+			uint32_t             binding,
+			const GnmIndexRange& range);
+
+		void bindVertexBuffers(
+			const GnmIndexRange& range);
+
+		GnmDrawFingerprint getDrawFingerprint() const;
+
+		void flushDraws();
 
-		inline void bindVertexBuffer(
-			const Buffer* vsharp, uint32_t binding);
+		bool emitMergedDraws();
+
+		uint32_t getMaxDrawIndirectCount() const;
+
+		VkDeviceSize allocDrawArgs(
+			uint32_t drawCount);
 
 
 		void updateVertexBinding(gcn::GcnModule& vsModule);
@@ -202,6 +225,18 @@ namespace sce::Gnm
 	private:
 		GnmGraphicsState m_state;
 		GnmContextFlags  m_flags; 
+
+		std::unique_ptr<GnmStateFilter>      m_stateFilter;
+		std::unique_ptr<GnmIndexBufferCache> m_indexCache;
+
+		// Consecutive draws sharing the same state,
+		// recorded once the run is broken.
+		GnmDrawFingerprint          m_pendingFingerprint;
+		std::vector<GnmPendingDraw> m_pendingDraws;
+		GnmDrawMergeStats           m_mergeStats;
+
+		vlt::Rc<vlt::VltBuffer> m_drawArgBuffer;
+		uint32_t                m_drawArgCount = 0;
 	};
 
 }  // namespace sce::Gnm
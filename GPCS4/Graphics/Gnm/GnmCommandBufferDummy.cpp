@@ -240,6 +240,67 @@ namespace sce::Gnm
 	{
 	}
 
+	void GnmCommandBufferDummy::setClipControl(ClipControl reg)
+	{
+	}
+
+	void GnmCommandBufferDummy::setDbCountControl(DbCountControlPerfectZPassCounts perfectZPassCounts, uint32_t log2SampleRate)
+	{
+	}
+
+	void GnmCommandBufferDummy::setBorderColorTableAddr(void* tableAddr)
+	{
+	}
+
+	void* GnmCommandBufferDummy::allocateFromCommandBuffer(uint32_t sizeInBytes, EmbeddedDataAlignment alignment)
+	{
+		return nullptr;
+	}
+
+	void GnmCommandBufferDummy::setStencil(StencilControl stencilControl)
+	{
+	}
+
+	void GnmCommandBufferDummy::setStencilSeparate(StencilControl front, StencilControl back)
+	{
+	}
+
+	void GnmCommandBufferDummy::setCbControl(CbMode mode, RasterOp op)
+	{
+	}
+
+	void GnmCommandBufferDummy::setStencilOpControl(StencilOpControl stencilControl)
+	{
+	}
+
+	void GnmCommandBufferDummy::triggerEvent(EventType eventType)
+	{
+	}
+
+	void GnmCommandBufferDummy::prefetchIntoL2(void* dataAddr, uint32_t sizeInBytes)
+	{
+	}
+
+	void GnmCommandBufferDummy::pushMarker(const char* debugString)
+	{
+	}
+
+	void GnmCommandBufferDummy::pushMarker(const char* debugString, uint32_t argbColor)
+	{
+	}
+
+	void GnmCommandBufferDummy::popMarker()
+	{
+	}
+
+	void GnmCommandBufferDummy::updateMetaBufferInfo(VkPipelineStageFlags stage, uint32_t startRegister, const Buffer* vsharp)
+	{
+	}
+
+	void GnmCommandBufferDummy::updateMetaTextureInfo(VkPipelineStageFlags stage, uint32_t startRegister, bool isDepth, const Texture* tsharp)
+	{
+	}
+
 	void GnmCommandBufferDummy::emuWriteGpuLabel(EventWriteSource selector, void* label, uint64_t value)
 	{
 		do
@@ -128,6 +128,37 @@ public:
 
 	virtual void setDepthStencilDisable() override;
 
+	virtual void setClipControl(ClipControl reg) override;
+
+	virtual void setDbCountControl(DbCountControlPerfectZPassCounts perfectZPassCounts, uint32_t log2SampleRate) override;
+
+	virtual void setBorderColorTableAddr(void* tableAddr) override;
+
+	virtual void* allocateFromCommandBuffer(uint32_t sizeInBytes, EmbeddedDataAlignment alignment) override;
+
+	virtual void setStencil(StencilControl stencilControl) override;
+
+	virtual void setStencilSeparate(StencilControl front, StencilControl back) override;
+
+	virtual void setCbControl(CbMode mode, RasterOp op) override;
+
+	virtual void setStencilOpControl(StencilOpControl stencilControl) override;
+
+	virtual void triggerEvent(EventType eventType) override;
+
+	virtual void prefetchIntoL2(void* dataAddr, uint32_t sizeInBytes) override;
+
+	virtual void pushMarker(const char* debugString) override;
+
+	virtual void pushMarker(const char* debugString, uint32_t argbColor) override;
+
+	virtual void popMarker() override;
+
+protected:
+	virtual void updateMetaBufferInfo(VkPipelineStageFlags stage, uint32_t startRegister, const Buffer* vsharp) override;
+
+	virtual void updateMetaTextureInfo(VkPipelineStageFlags stage, uint32_t startRegister, bool isDepth, const Texture* tsharp) override;
+
 private:
 	void emuWriteGpuLabel(EventWriteSource selector, void* label, uint64_t value);
 };
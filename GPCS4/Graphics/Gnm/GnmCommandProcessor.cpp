@@ -9,6 +9,9 @@
 #include "Gcn/GcnShaderRegister.h"
 #include "Violet/VltBuffer.h"
 
+#include <algorithm>
+#include <chrono>
+
 using namespace util;
 using namespace sce::vlt;
 
@@ -64,18 +67,27 @@ namespace sce::Gnm
 			{
 				uint32_t pm4Type = pm4Hdr->type;
 
+				// Type 2 packet is an 1 dword NOP, opcode should be 0x80000000
+				uint32_t packetSize = pm4Type == PM4_TYPE_2
+										  ? sizeof(uint32_t)
+										  : PM4_LENGTH_DW(pm4Hdr->u32All) * sizeof(uint32_t);
+
+				// Validate the packet length once here,
+				// so that handlers can read the packet body freely.
+				if (processedCmdSize + packetSize > commandSize)
+				{
+					LOG_ERR("pm4 packet exceeds command buffer, offset %d size %d", processedCmdSize, packetSize);
+					break;
+				}
+
+				m_remainSize = commandSize - processedCmdSize;
+
 				switch (pm4Type)
 				{
 				case PM4_TYPE_0:
 					processPM4Type0((PPM4_TYPE_0_HEADER)pm4Hdr, (uint32_t*)(pm4Hdr + 1));
 					break;
 				case PM4_TYPE_2:
-				{
-					// opcode should be 0x80000000, this is an 1 dword NOP
-					++pm4Hdr;
-					processedCmdSize += sizeof(PPM4_HEADER);
-					continue;
-				}
 					break;
 				case PM4_TYPE_3:
 					processPM4Type3((PPM4_TYPE_3_HEADER)pm4Hdr, (uint32_t*)(pm4Hdr + 1));
@@ -85,24 +97,36 @@ namespace sce::Gnm
 					break;
 				}
 
+#ifdef GPCS4_PM4_BENCHMARK
+				++m_packetCount;
+#endif  // GPCS4_PM4_BENCHMARK
+
 				if (m_flipPacketDone)
 				{
 					m_flipPacketDone = false;
 					break;
 				}
 
-				uint32_t processedPm4Count = 1;
-
 				if (m_skipPm4Count != 0)
 				{
-					processedPm4Count += m_skipPm4Count;
+					// Skipped packets have been consumed by the handler,
+					// their length is only known by walking the headers.
+					packetSize = getSkippedSize(pm4Hdr, m_skipPm4Count, commandSize - processedCmdSize);
+					if (packetSize == 0)
+					{
+						LOG_ERR("skipped pm4 packets exceed command buffer, offset %d", processedCmdSize);
+						break;
+					}
+
+#ifdef GPCS4_PM4_BENCHMARK
+					m_packetCount += m_skipPm4Count;
+#endif  // GPCS4_PM4_BENCHMARK
 					m_skipPm4Count = 0;
 				}
 
-				const PM4_HEADER* nextPm4Hdr      = getNextNPm4(pm4Hdr, processedPm4Count);
-				uint32_t          processedLength = reinterpret_cast<uintptr_t>(nextPm4Hdr) - reinterpret_cast<uintptr_t>(pm4Hdr);
-				pm4Hdr                            = nextPm4Hdr;
-				processedCmdSize += processedLength;
+				pm4Hdr = reinterpret_cast<const PM4_HEADER*>(
+					reinterpret_cast<const uint8_t*>(pm4Hdr) + packetSize);
+				processedCmdSize += packetSize;
 			}
 
 			bRet = true;
@@ -113,7 +137,19 @@ namespace sce::Gnm
 
 	void GnmCommandProcessor::processCommandBuffer(const void* commandBuffer, uint32_t commandSize)
 	{
+#ifdef GPCS4_PM4_BENCHMARK
+		m_packetCount = 0;
+		auto begin    = std::chrono::high_resolution_clock::now();
+#endif  // GPCS4_PM4_BENCHMARK
+
 		processCmdInternal(commandBuffer, commandSize);
+
+#ifdef GPCS4_PM4_BENCHMARK
+		auto   end     = std::chrono::high_resolution_clock::now();
+		double elapsed = std::chrono::duration<double, std::micro>(end - begin).count();
+		LOG_DEBUG("pm4 benchmark: %d packets %d bytes in %.2f us, %.3f packets/us",
+				  m_packetCount, commandSize, elapsed, m_packetCount / elapsed);
+#endif  // GPCS4_PM4_BENCHMARK
 	}
 
 	void GnmCommandProcessor::processPM4Type0(PPM4_TYPE_0_HEADER pm4Hdr, uint32_t* regDataX)
@@ -123,209 +159,221 @@ namespace sce::Gnm
 
 	void GnmCommandProcessor::processPM4Type3(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
 	{
-		IT_OpCodeType opcode = (IT_OpCodeType)pm4Hdr->opcode;
-
 		// LOG_DEBUG("OpCode Name %s", opcodeName(*(uint32_t*)pm4Hdr));
 
-		switch (opcode)
-		{
-		case IT_NOP:
-			onNop(pm4Hdr, itBody);
-			break;
-		case IT_SET_BASE:
-			onSetBase(pm4Hdr, itBody);
-			break;
-		case IT_INDEX_BUFFER_SIZE:
-			onIndexBufferSize(pm4Hdr, itBody);
-			break;
-		case IT_SET_PREDICATION:
-			onSetPredication(pm4Hdr, itBody);
-			break;
-		case IT_COND_EXEC:
-			onCondExec(pm4Hdr, itBody);
-			break;
-		case IT_INDEX_BASE:
-			onIndexBase(pm4Hdr, itBody);
-			break;
-		case IT_INDEX_TYPE:
-			onIndexType(pm4Hdr, itBody);
-			break;
-		case IT_NUM_INSTANCES:
-			onNumInstances(pm4Hdr, itBody);
-			break;
-		case IT_STRMOUT_BUFFER_UPDATE:
-			onStrmoutBufferUpdate(pm4Hdr, itBody);
-			break;
-		case IT_WRITE_DATA:
-			onWriteData(pm4Hdr, itBody);
-			break;
-		case IT_MEM_SEMAPHORE:
-			onMemSemaphore(pm4Hdr, itBody);
-			break;
-		case IT_WAIT_REG_MEM:
-			onWaitRegMem(pm4Hdr, itBody);
-			break;
-		case IT_INDIRECT_BUFFER:
-			onIndirectBuffer(pm4Hdr, itBody);
-			break;
-		case IT_PFP_SYNC_ME:
-			onPfpSyncMe(pm4Hdr, itBody);
-			break;
-		case IT_EVENT_WRITE:
-			onEventWrite(pm4Hdr, itBody);
-			break;
-		case IT_EVENT_WRITE_EOP:
-			onEventWriteEop(pm4Hdr, itBody);
-			break;
-		case IT_EVENT_WRITE_EOS:
-			onEventWriteEos(pm4Hdr, itBody);
-			break;
-		case IT_DMA_DATA:
-			onDmaData(pm4Hdr, itBody);
-			break;
-		case IT_ACQUIRE_MEM:
-			onAcquireMem(pm4Hdr, itBody);
-			break;
-		case IT_REWIND:
-			onRewind(pm4Hdr, itBody);
-			break;
-		case IT_SET_CONFIG_REG:
-			onSetConfigReg(pm4Hdr, itBody);
-			break;
-		case IT_SET_CONTEXT_REG:  // 0x69
-			onSetContextReg(pm4Hdr, itBody);
-			break;
-		case IT_SET_SH_REG:
-			onSetShReg(pm4Hdr, itBody);
-			break;
-		case IT_SET_UCONFIG_REG:  // 0x79
-			onSetUconfigReg(pm4Hdr, itBody);
-			break;
-		case IT_INCREMENT_DE_COUNTER:
-			onIncrementDeCounter(pm4Hdr, itBody);
-			break;
-		case IT_WAIT_ON_CE_COUNTER:
-			onWaitOnCeCounter(pm4Hdr, itBody);
-			break;
-		case IT_DISPATCH_DRAW_PREAMBLE__GFX09:
-			onDispatchDrawPreambleGfx09(pm4Hdr, itBody);
-			break;
-		case IT_DISPATCH_DRAW__GFX09:
-			onDispatchDrawGfx09(pm4Hdr, itBody);
-			break;
-		case IT_GET_LOD_STATS__GFX09:
-			onGetLodStatsGfx09(pm4Hdr, itBody);
-			break;
-		case IT_RELEASE_MEM:
-			onReleaseMem(pm4Hdr, itBody);
-			break;
-		// Private handler
-		case IT_GNM_PRIVATE:
-			onGnmPrivate(pm4Hdr, itBody);
-			break;
+		uint32_t opcode  = pm4Hdr->opcode;
+		uint32_t handler = opcode != IT_GNM_PRIVATE
+							   ? opcode
+							   : PrivateHandlerBase + PM4_PRIV(pm4Hdr->u32All);
+
+		(this->*m_handlerTable[handler])(pm4Hdr, itBody);
+	}
+
+	GnmCommandProcessor::PacketHandlerTable GnmCommandProcessor::createHandlerTable()
+	{
+		// Type 3 opcodes index the lower half of the table,
+		// private Gnm opcodes (IT_GNM_PRIVATE) the upper half.
+		PacketHandlerTable table = {};
+		std::fill(table.begin(), table.begin() + PrivateHandlerBase, &GnmCommandProcessor::onInvalidOpcode);
+		std::fill(table.begin() + PrivateHandlerBase, table.end(), &GnmCommandProcessor::onIgnored);
+
+		table[IT_NOP]                           = &GnmCommandProcessor::onNop;
+		table[IT_SET_BASE]                      = &GnmCommandProcessor::onSetBase;
+		table[IT_INDEX_BUFFER_SIZE]             = &GnmCommandProcessor::onIndexBufferSize;
+		table[IT_SET_PREDICATION]               = &GnmCommandProcessor::onSetPredication;
+		table[IT_COND_EXEC]                     = &GnmCommandProcessor::onCondExec;
+		table[IT_INDEX_BASE]                    = &GnmCommandProcessor::onIndexBase;
+		table[IT_INDEX_TYPE]                    = &GnmCommandProcessor::onIndexType;
+		table[IT_NUM_INSTANCES]                 = &GnmCommandProcessor::onNumInstances;
+		table[IT_STRMOUT_BUFFER_UPDATE]         = &GnmCommandProcessor::onStrmoutBufferUpdate;
+		table[IT_WRITE_DATA]                    = &GnmCommandProcessor::onWriteData;
+		table[IT_MEM_SEMAPHORE]                 = &GnmCommandProcessor::onMemSemaphore;
+		table[IT_WAIT_REG_MEM]                  = &GnmCommandProcessor::onWaitRegMem;
+		table[IT_INDIRECT_BUFFER]               = &GnmCommandProcessor::onIndirectBuffer;
+		table[IT_PFP_SYNC_ME]                   = &GnmCommandProcessor::onPfpSyncMe;
+		table[IT_EVENT_WRITE]                   = &GnmCommandProcessor::onEventWrite;
+		table[IT_EVENT_WRITE_EOP]               = &GnmCommandProcessor::onEventWriteEop;
+		table[IT_EVENT_WRITE_EOS]               = &GnmCommandProcessor::onEventWriteEos;
+		table[IT_DMA_DATA]                      = &GnmCommandProcessor::onDmaData;
+		table[IT_ACQUIRE_MEM]                   = &GnmCommandProcessor::onAcquireMem;
+		table[IT_REWIND]                        = &GnmCommandProcessor::onRewind;
+		table[IT_SET_CONFIG_REG]                = &GnmCommandProcessor::onSetConfigReg;
+		table[IT_SET_CONTEXT_REG]               = &GnmCommandProcessor::onSetContextReg;
+		table[IT_SET_SH_REG]                    = &GnmCommandProcessor::onSetShReg;
+		table[IT_SET_UCONFIG_REG]               = &GnmCommandProcessor::onSetUconfigReg;
+		table[IT_INCREMENT_DE_COUNTER]          = &GnmCommandProcessor::onIncrementDeCounter;
+		table[IT_WAIT_ON_CE_COUNTER]            = &GnmCommandProcessor::onWaitOnCeCounter;
+		table[IT_DISPATCH_DRAW_PREAMBLE__GFX09] = &GnmCommandProcessor::onDispatchDrawPreambleGfx09;
+		table[IT_DISPATCH_DRAW__GFX09]          = &GnmCommandProcessor::onDispatchDrawGfx09;
+		table[IT_GET_LOD_STATS__GFX09]          = &GnmCommandProcessor::onGetLodStatsGfx09;
+		table[IT_RELEASE_MEM]                   = &GnmCommandProcessor::onReleaseMem;
 
 		// Legacy packets used in old SDKs.
-		case IT_DRAW_INDEX_AUTO:
-		case IT_DISPATCH_DIRECT:
-			onGnmLegacy(pm4Hdr, itBody);
-			break;
+		table[IT_DRAW_INDEX_AUTO] = &GnmCommandProcessor::onGnmLegacy;
+		table[IT_DISPATCH_DIRECT] = &GnmCommandProcessor::onGnmLegacy;
 
 		// The following opcode types are not used by Gnm
 
 		// TODO:
 		// There maybe still some opcodes belongs to Gnm that is not found.
 		// We should find all and place them above.
-		case IT_CLEAR_STATE:
-		case IT_DISPATCH_INDIRECT:
-		case IT_INDIRECT_BUFFER_END:
-		case IT_INDIRECT_BUFFER_CNST_END:
-		case IT_ATOMIC_GDS:
-		case IT_ATOMIC_MEM:
-		case IT_OCCLUSION_QUERY:
-		case IT_REG_RMW:
-		case IT_PRED_EXEC:
-		case IT_DRAW_INDIRECT:
-		case IT_DRAW_INDEX_INDIRECT:
-		case IT_DRAW_INDEX_2:
-		case IT_CONTEXT_CONTROL:
-		case IT_DRAW_INDIRECT_MULTI:
-		case IT_DRAW_INDEX_MULTI_AUTO:
-		case IT_INDIRECT_BUFFER_PRIV:
-		case IT_INDIRECT_BUFFER_CNST:
-		case IT_DRAW_INDEX_OFFSET_2:
-		case IT_DRAW_PREAMBLE:
-		case IT_DRAW_INDEX_INDIRECT_MULTI:
-		case IT_DRAW_INDEX_MULTI_INST:
-		case IT_COPY_DW:
-		case IT_COPY_DATA:
-		case IT_CP_DMA:
-		case IT_SURFACE_SYNC:
-		case IT_ME_INITIALIZE:
-		case IT_COND_WRITE:
-		case IT_PREAMBLE_CNTL:
-		case IT_DRAW_RESERVED0:
-		case IT_DRAW_RESERVED1:
-		case IT_DRAW_RESERVED2:
-		case IT_DRAW_RESERVED3:
-		case IT_CONTEXT_REG_RMW:
-		case IT_GFX_CNTX_UPDATE:
-		case IT_BLK_CNTX_UPDATE:
-		case IT_INCR_UPDT_STATE:
-		case IT_INTERRUPT:
-		case IT_GEN_PDEPTE:
-		case IT_INDIRECT_BUFFER_PASID:
-		case IT_PRIME_UTCL2:
-		case IT_LOAD_UCONFIG_REG:
-		case IT_LOAD_SH_REG:
-		case IT_LOAD_CONFIG_REG:
-		case IT_LOAD_CONTEXT_REG:
-		case IT_LOAD_COMPUTE_STATE:
-		case IT_LOAD_SH_REG_INDEX:
-		case IT_SET_CONTEXT_REG_INDEX:
-		case IT_SET_VGPR_REG_DI_MULTI:
-		case IT_SET_SH_REG_DI:
-		case IT_SET_CONTEXT_REG_INDIRECT:
-		case IT_SET_SH_REG_DI_MULTI:
-		case IT_GFX_PIPE_LOCK:
-		case IT_SET_SH_REG_OFFSET:
-		case IT_SET_QUEUE_REG:
-		case IT_SET_UCONFIG_REG_INDEX:
-		case IT_FORWARD_HEADER:
-		case IT_SCRATCH_RAM_WRITE:
-		case IT_SCRATCH_RAM_READ:
-		case IT_LOAD_CONST_RAM:
-		case IT_WRITE_CONST_RAM:
-		case IT_DUMP_CONST_RAM:
-		case IT_INCREMENT_CE_COUNTER:
-		case IT_WAIT_ON_DE_COUNTER_DIFF:
-		case IT_SWITCH_BUFFER:
-		case IT_FRAME_CONTROL:
-		case IT_INDEX_ATTRIBUTES_INDIRECT:
-		case IT_WAIT_REG_MEM64:
-		case IT_COND_PREEMPT:
-		case IT_HDP_FLUSH:
-		case IT_INVALIDATE_TLBS:
-		case IT_DMA_DATA_FILL_MULTI:
-		case IT_SET_SH_REG_INDEX:
-		case IT_DRAW_INDIRECT_COUNT_MULTI:
-		case IT_DRAW_INDEX_INDIRECT_COUNT_MULTI:
-		case IT_DUMP_CONST_RAM_OFFSET:
-		case IT_LOAD_CONTEXT_REG_INDEX:
-		case IT_SET_RESOURCES:
-		case IT_MAP_PROCESS:
-		case IT_MAP_QUEUES:
-		case IT_UNMAP_QUEUES:
-		case IT_QUERY_STATUS:
-		case IT_RUN_LIST:
-		case IT_MAP_PROCESS_VM:
-		case IT_DRAW_MULTI_PREAMBLE__GFX09:
-		case IT_AQL_PACKET__GFX09:
-			LOG_ERR("Opcode not supported %X", opcode);
-			break;
-		default:
-			LOG_ERR("Invalid opcode %X", opcode);
-			break;
+		const IT_OpCodeType unsupportedOpcodes[] = {
+			IT_CLEAR_STATE,
+			IT_DISPATCH_INDIRECT,
+			IT_INDIRECT_BUFFER_END,
+			IT_INDIRECT_BUFFER_CNST_END,
+			IT_ATOMIC_GDS,
+			IT_ATOMIC_MEM,
+			IT_OCCLUSION_QUERY,
+			IT_REG_RMW,
+			IT_PRED_EXEC,
+			IT_DRAW_INDIRECT,
+			IT_DRAW_INDEX_INDIRECT,
+			IT_DRAW_INDEX_2,
+			IT_CONTEXT_CONTROL,
+			IT_DRAW_INDIRECT_MULTI,
+			IT_DRAW_INDEX_MULTI_AUTO,
+			IT_INDIRECT_BUFFER_PRIV,
+			IT_INDIRECT_BUFFER_CNST,
+			IT_DRAW_INDEX_OFFSET_2,
+			IT_DRAW_PREAMBLE,
+			IT_DRAW_INDEX_INDIRECT_MULTI,
+			IT_DRAW_INDEX_MULTI_INST,
+			IT_COPY_DW,
+			IT_COPY_DATA,
+			IT_CP_DMA,
+			IT_SURFACE_SYNC,
+			IT_ME_INITIALIZE,
+			IT_COND_WRITE,
+			IT_PREAMBLE_CNTL,
+			IT_DRAW_RESERVED0,
+			IT_DRAW_RESERVED1,
+			IT_DRAW_RESERVED2,
+			IT_DRAW_RESERVED3,
+			IT_CONTEXT_REG_RMW,
+			IT_GFX_CNTX_UPDATE,
+			IT_BLK_CNTX_UPDATE,
+			IT_INCR_UPDT_STATE,
+			IT_INTERRUPT,
+			IT_GEN_PDEPTE,
+			IT_INDIRECT_BUFFER_PASID,
+			IT_PRIME_UTCL2,
+			IT_LOAD_UCONFIG_REG,
+			IT_LOAD_SH_REG,
+			IT_LOAD_CONFIG_REG,
+			IT_LOAD_CONTEXT_REG,
+			IT_LOAD_COMPUTE_STATE,
+			IT_LOAD_SH_REG_INDEX,
+			IT_SET_CONTEXT_REG_INDEX,
+			IT_SET_VGPR_REG_DI_MULTI,
+			IT_SET_SH_REG_DI,
+			IT_SET_CONTEXT_REG_INDIRECT,
+			IT_SET_SH_REG_DI_MULTI,
+			IT_GFX_PIPE_LOCK,
+			IT_SET_SH_REG_OFFSET,
+			IT_SET_QUEUE_REG,
+			IT_SET_UCONFIG_REG_INDEX,
+			IT_FORWARD_HEADER,
+			IT_SCRATCH_RAM_WRITE,
+			IT_SCRATCH_RAM_READ,
+			IT_LOAD_CONST_RAM,
+			IT_WRITE_CONST_RAM,
+			IT_DUMP_CONST_RAM,
+			IT_INCREMENT_CE_COUNTER,
+			IT_WAIT_ON_DE_COUNTER_DIFF,
+			IT_SWITCH_BUFFER,
+			IT_FRAME_CONTROL,
+			IT_INDEX_ATTRIBUTES_INDIRECT,
+			IT_WAIT_REG_MEM64,
+			IT_COND_PREEMPT,
+			IT_HDP_FLUSH,
+			IT_INVALIDATE_TLBS,
+			IT_DMA_DATA_FILL_MULTI,
+			IT_SET_SH_REG_INDEX,
+			IT_DRAW_INDIRECT_COUNT_MULTI,
+			IT_DRAW_INDEX_INDIRECT_COUNT_MULTI,
+			IT_DUMP_CONST_RAM_OFFSET,
+			IT_LOAD_CONTEXT_REG_INDEX,
+			IT_SET_RESOURCES,
+			IT_MAP_PROCESS,
+			IT_MAP_QUEUES,
+			IT_UNMAP_QUEUES,
+			IT_QUERY_STATUS,
+			IT_RUN_LIST,
+			IT_MAP_PROCESS_VM,
+			IT_DRAW_MULTI_PREAMBLE__GFX09,
+			IT_AQL_PACKET__GFX09,
+		};
+		for (auto opcode : unsupportedOpcodes)
+		{
+			table[opcode] = &GnmCommandProcessor::onUnsupportedOpcode;
 		}
+
+		// Private opcodes not listed here are silently ignored.
+		auto priv = [&table](IT_OpCodePriv op, PacketHandler handler)
+		{
+			table[PrivateHandlerBase + op] = handler;
+		};
+		priv(OP_PRIV_INITIALIZE_DEFAULT_HARDWARE_STATE, &GnmCommandProcessor::onInitializeDefaultHardwareState);
+		priv(OP_PRIV_SET_EMBEDDED_VS_SHADER, &GnmCommandProcessor::onSetEmbeddedVsShader);
+		priv(OP_PRIV_SET_VS_SHADER, &GnmCommandProcessor::onSetVsShader);
+		priv(OP_PRIV_SET_PS_SHADER, &GnmCommandProcessor::onSetPsShader);
+		priv(OP_PRIV_SET_CS_SHADER, &GnmCommandProcessor::onSetCsShader);
+		priv(OP_PRIV_UPDATE_PS_SHADER, &GnmCommandProcessor::onUpdatePsShader);
+		priv(OP_PRIV_UPDATE_VS_SHADER, &GnmCommandProcessor::onUpdateVsShader);
+		priv(OP_PRIV_SET_VGT_CONTROL, &GnmCommandProcessor::onSetVgtControl);
+		priv(OP_PRIV_DRAW_INDEX, &GnmCommandProcessor::onDrawIndex);
+		priv(OP_PRIV_DRAW_INDEX_AUTO, &GnmCommandProcessor::onDrawIndexAuto);
+		priv(OP_PRIV_WAIT_UNTIL_SAFE_FOR_RENDERING, &GnmCommandProcessor::onWaitUntilSafeForRendering);
+		priv(OP_PRIV_PUSH_MARKER, &GnmCommandProcessor::onPushMarker);
+		priv(OP_PRIV_PUSH_COLOR_MARKER, &GnmCommandProcessor::onPushColorMarker);
+		priv(OP_PRIV_POP_MARKER, &GnmCommandProcessor::onPopMarker);
+		priv(OP_PRIV_DISPATCH_DIRECT, &GnmCommandProcessor::onDispatchDirect);
+		priv(OP_PRIV_COMPUTE_WAIT_ON_ADDRESS, &GnmCommandProcessor::onComputeWaitOnAddress);
+
+		return table;
+	}
+
+	const GnmCommandProcessor::PacketHandlerTable GnmCommandProcessor::m_handlerTable =
+		GnmCommandProcessor::createHandlerTable();
+
+	void GnmCommandProcessor::onInvalidOpcode(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		LOG_ERR("Invalid opcode %X", pm4Hdr->opcode);
+	}
+
+	void GnmCommandProcessor::onUnsupportedOpcode(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		LOG_ERR("Opcode not supported %X", pm4Hdr->opcode);
+	}
+
+	uint32_t GnmCommandProcessor::getSkippedSize(const PM4_HEADER* pm4Hdr, uint32_t skipCount, uint32_t remainSize)
+	{
+		// Size of the current packet plus the skipped ones,
+		// or 0 if any of them runs past the command buffer.
+		uint32_t size   = 0;
+		auto     curHdr = pm4Hdr;
+		for (uint32_t i = 0; i <= skipCount; ++i)
+		{
+			if (size + sizeof(uint32_t) > remainSize)
+			{
+				return 0;
+			}
+
+			uint32_t packetSize = PM4_LENGTH_DW(curHdr->u32All) * sizeof(uint32_t);
+			if (size + packetSize > remainSize)
+			{
+				return 0;
+			}
+
+			size += packetSize;
+			curHdr = getNextPm4(curHdr);
+		}
+		return size;
+	}
+
+	void GnmCommandProcessor::onIgnored(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
 	}
 
 	// NOP packet usually used for providing a hint for the following packet,
@@ -335,10 +383,15 @@ namespace sce::Gnm
 	{
 		// TODO:
 		// Here we should handle allocateFromCommandBuffer and other calls
-		// 
-		// And a better way to handle nop should check the if upper 16 bits of itBody is equal to 0x6875
-		// then dispatch the lower 16 bits
 		uint32_t hint = *itBody;
+
+		// Only prepare flip packets carry a label,
+		// other nops may be shorter than that.
+		auto labelAddr = [itBody]()
+		{ return (void*)*(uint64_t*)(itBody + 1); };
+		auto value = [itBody]()
+		{ return itBody[3]; };
+
 		switch (hint)
 		{
 		case OP_HINT_SET_VSHARP_IN_USER_DATA:
@@ -348,24 +401,50 @@ namespace sce::Gnm
 			m_lastHint = hint;
 			break;
 		case OP_HINT_PREPARE_FLIP_VOID:
+			LOG_SCE_GRAPHIC("Gnm: prepareFlip");
+			m_cb->prepareFlip();
+			onFlipPacket();
+			break;
 		case OP_HINT_PREPARE_FLIP_LABEL:
+			LOG_SCE_GRAPHIC("Gnm: prepareFlip");
+			m_cb->prepareFlip(labelAddr(), value());
+			onFlipPacket();
+			break;
 		case OP_HINT_PREPARE_FLIP_WITH_EOP_INTERRUPT_VOID:
+			LOG_FIXME("Not implemented.");
+			onFlipPacket();
+			break;
 		case OP_HINT_PREPARE_FLIP_WITH_EOP_INTERRUPT_LABEL:
-			onPrepareFlipOrEopInterrupt(pm4Hdr, itBody);
+		{
+			EndOfPipeEventType eventType   = (EndOfPipeEventType)itBody[4];
+			CacheAction        cacheAction = (CacheAction)itBody[5];
+			LOG_SCE_GRAPHIC("Gnm: prepareFlipWithEopInterrupt");
+			m_cb->prepareFlipWithEopInterrupt(eventType, labelAddr(), value(), cacheAction);
+			onFlipPacket();
+		}
 			break;
 		default:
+			// allocateFromCommandBuffer encodes the
+			// alignment above the low 12 bits of the hint.
+			if ((hint >> 16) == 0x6875 && (hint & 0xFFF) == 0)
+			{
+				LOG_SCE_GRAPHIC("Gnm: allocateFromCommandBuffer");
+				uint32_t align             = (hint - 0x68750000) >> 12;
+				uint32_t alignInBytes      = 1 << align;
+				uint32_t packetSizeInBytes = PM4_LENGTH_DW(pm4Hdr->u32All) * 4;
+				uint32_t size              = (uintptr_t)pm4Hdr + packetSizeInBytes - (((uintptr_t)pm4Hdr + alignInBytes + 7) & ~(alignInBytes - 1));
+				m_cb->allocateFromCommandBuffer(size, (EmbeddedDataAlignment)align);
+			}
 			break;
 		}
+	}
 
-		if ((hint & 0xFFF) == 0)
-		{
-			LOG_SCE_GRAPHIC("Gnm: allocateFromCommandBuffer");
-			uint32_t align             = (hint - 0x68750000) >> 12;
-			uint32_t alignInBytes      = 1 << align;
-			uint32_t packetSizeInBytes = PM4_LENGTH_DW(pm4Hdr->u32All) * 4;
-			uint32_t size              = (uintptr_t)pm4Hdr + packetSizeInBytes - (((uintptr_t)pm4Hdr + alignInBytes + 7) & ~(alignInBytes - 1));
-			m_cb->allocateFromCommandBuffer(size, (EmbeddedDataAlignment)align);
-		}
+	void GnmCommandProcessor::onFlipPacket()
+	{
+		LOG_SCE_GRAPHIC("Gnm: =======================================");
+
+		// mark this is the last packet in command buffer.
+		m_flipPacketDone = true;
 	}
 
 	void GnmCommandProcessor::onSetBase(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
@@ -655,8 +734,9 @@ namespace sce::Gnm
 		break;
 		case OP_HINT_SET_DEPTH_RENDER_TARGET:
 		{
-			auto nextPm4 = getNextPm4(pm4Hdr);
-			if (nextPm4->opcode == IT_SET_CONTEXT_REG &&
+			auto nextPm4 = peekNextPm4(pm4Hdr, m_remainSize);
+			if (nextPm4 != nullptr &&
+				nextPm4->opcode == IT_SET_CONTEXT_REG &&
 				(((uint32_t*)nextPm4)[1] == 15 ||
 				 ((uint32_t*)nextPm4)[1] == 17))
 			{
@@ -954,169 +1034,116 @@ namespace sce::Gnm
 		}
 	}
 
-	void GnmCommandProcessor::onGnmPrivate(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	// Note:
+	// Most private opcode handlers are not much complicated,
+	// just cast pm4Hdr to proper GnmCmdxxx and call the graphic function.
+
+	void GnmCommandProcessor::onInitializeDefaultHardwareState(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		LOG_SCE_GRAPHIC("Gnm: initializeDefaultHardwareState");
+		m_cb->initializeDefaultHardwareState();
+	}
+
+	void GnmCommandProcessor::onSetEmbeddedVsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdVSShader* param = (GnmCmdVSShader*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: setEmbeddedVsShader");
+		m_cb->setEmbeddedVsShader(param->shaderId, param->modifier);
+	}
+
+	void GnmCommandProcessor::onSetVsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdVSShader* param = (GnmCmdVSShader*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: setVsShader");
+		m_cb->setVsShader(&param->vsRegs, param->modifier);
+	}
+
+	void GnmCommandProcessor::onSetPsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdPSShader* param = (GnmCmdPSShader*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: setPsShader");
+		m_cb->setPsShader(&param->psRegs);
+	}
+
+	void GnmCommandProcessor::onSetCsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdCSShader* param = (GnmCmdCSShader*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: setCsShader");
+		m_cb->setCsShader(&param->csRegs, param->modifier);
+	}
+
+	void GnmCommandProcessor::onUpdatePsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdPSShader* param = (GnmCmdPSShader*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: updatePsShader");
+		m_cb->updatePsShader(&param->psRegs);
+	}
+
+	void GnmCommandProcessor::onUpdateVsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdVSShader* param = (GnmCmdVSShader*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: updateVsShader");
+		m_cb->updateVsShader(&param->vsRegs, param->modifier);
+	}
+
+	void GnmCommandProcessor::onSetVgtControl(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdVgtControl* param = (GnmCmdVgtControl*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: setVgtControlForNeo");
+		m_cb->setVgtControlForNeo(param->primGroupSizeMinusOne,
+								  (WdSwitchOnlyOnEopMode)param->wdSwitchOnlyOnEopMode,
+								  (VgtPartialVsWaveMode)param->partialVsWaveMode);
+	}
+
+	void GnmCommandProcessor::onWaitUntilSafeForRendering(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdWaitFlipDone* param = (GnmCmdWaitFlipDone*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: waitUntilSafeForRendering");
+		m_cb->waitUntilSafeForRendering(param->videoOutHandle, param->displayBufferIndex);
+	}
+
+	void GnmCommandProcessor::onPushMarker(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
 	{
-		// Note:
-		// Most private opcode handle cases are not much complicated,
-		// just cast pm4Hdr to proper GnmCmdxxx and call the graphic function.
-		// But if it's going to be complicated (eg. contains 'if' statement),
-		// please write a new function to handle it,
-		// like onDrawIndex
-
-		IT_OpCodePriv priv = PM4_PRIV(*(uint32_t*)pm4Hdr);
-		switch (priv)
+		GnmCmdPushMarker* param = (GnmCmdPushMarker*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: pushMarker");
+		m_cb->pushMarker(param->debugString);
+	}
+
+	void GnmCommandProcessor::onPushColorMarker(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdPushColorMarker* param = (GnmCmdPushColorMarker*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: pushColorMarker");
+		m_cb->pushMarker(param->debugString, param->argbColor);
+	}
+
+	void GnmCommandProcessor::onPopMarker(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		LOG_SCE_GRAPHIC("Gnm: popMarker");
+		m_cb->popMarker();
+	}
+
+	void GnmCommandProcessor::onDispatchDirect(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdDispatchDirect*     param = (GnmCmdDispatchDirect*)pm4Hdr;
+		DispatchOrderedAppendMode mode  = (DispatchOrderedAppendMode)bit::extract(param->pred, 4, 3);
+		if (mode == kDispatchOrderedAppendModeDisabled)
 		{
-			case OP_PRIV_INITIALIZE_DEFAULT_HARDWARE_STATE:
-				LOG_SCE_GRAPHIC("Gnm: initializeDefaultHardwareState");
-				m_cb->initializeDefaultHardwareState();
-				break;
-			case OP_PRIV_INITIALIZE_TO_DEFAULT_CONTEXT_STATE:
-				break;
-			case OP_PRIV_SET_EMBEDDED_VS_SHADER:
-			{
-				GnmCmdVSShader* param = (GnmCmdVSShader*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: setEmbeddedVsShader");
-				m_cb->setEmbeddedVsShader(param->shaderId, param->modifier);
-			}
-			break;
-			case OP_PRIV_SET_EMBEDDED_PS_SHADER:
-				break;
-			case OP_PRIV_SET_VS_SHADER:
-			{
-				GnmCmdVSShader* param = (GnmCmdVSShader*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: setVsShader");
-				m_cb->setVsShader(&param->vsRegs, param->modifier);
-			}
-			break;
-			case OP_PRIV_SET_PS_SHADER:
-			{
-				GnmCmdPSShader* param = (GnmCmdPSShader*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: setPsShader");
-				m_cb->setPsShader(&param->psRegs);
-			}
-			break;
-			case OP_PRIV_SET_CS_SHADER:
-			{
-				GnmCmdCSShader* param = (GnmCmdCSShader*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: setCsShader");
-				m_cb->setCsShader(&param->csRegs, param->modifier);
-			}
-			break;
-			case OP_PRIV_SET_ES_SHADER:
-				break;
-			case OP_PRIV_SET_GS_SHADER:
-				break;
-			case OP_PRIV_SET_HS_SHADER:
-				break;
-			case OP_PRIV_SET_LS_SHADER:
-				break;
-			case OP_PRIV_UPDATE_GS_SHADER:
-				break;
-			case OP_PRIV_UPDATE_HS_SHADER:
-				break;
-			case OP_PRIV_UPDATE_PS_SHADER:
-			{
-				GnmCmdPSShader* param = (GnmCmdPSShader*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: updatePsShader");
-				m_cb->updatePsShader(&param->psRegs);
-			}
-			break;
-			case OP_PRIV_UPDATE_VS_SHADER:
-			{
-				GnmCmdVSShader* param = (GnmCmdVSShader*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: updateVsShader");
-				m_cb->updateVsShader(&param->vsRegs, param->modifier);
-			}
-			break;
-			case OP_PRIV_SET_VGT_CONTROL:
-			{
-				GnmCmdVgtControl* param = (GnmCmdVgtControl*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: setVgtControlForNeo");
-				m_cb->setVgtControlForNeo(param->primGroupSizeMinusOne,
-										  (WdSwitchOnlyOnEopMode)param->wdSwitchOnlyOnEopMode,
-										  (VgtPartialVsWaveMode)param->partialVsWaveMode);
-			}
-			break;
-			case OP_PRIV_RESET_VGT_CONTROL:
-				break;
-			case OP_PRIV_DRAW_INDEX:
-				onDrawIndex(pm4Hdr, itBody);
-				break;
-			case OP_PRIV_DRAW_INDEX_AUTO:
-				onDrawIndexAuto(pm4Hdr, itBody);
-				break;
-			case OP_PRIV_DRAW_INDEX_INDIRECT:
-				break;
-			case OP_PRIV_DRAW_INDEX_INDIRECT_COUNT_MULTI:
-				break;
-			case OP_PRIV_DRAW_INDEX_MULTI_INSTANCED:
-				break;
-			case OP_PRIV_DRAW_INDEX_OFFSET:
-				break;
-			case OP_PRIV_DRAW_INDIRECT:
-				break;
-			case OP_PRIV_DRAW_INDIRECT_COUNT_MULTI:
-				break;
-			case OP_PRIV_DRAW_OPAQUE_AUTO:
-				break;
-			case OP_PRIV_WAIT_UNTIL_SAFE_FOR_RENDERING:
-			{
-				GnmCmdWaitFlipDone* param = (GnmCmdWaitFlipDone*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: waitUntilSafeForRendering");
-				m_cb->waitUntilSafeForRendering(param->videoOutHandle, param->displayBufferIndex);
-			}
-			break;
-			case OP_PRIV_PUSH_MARKER:
-			{
-				GnmCmdPushMarker* param = (GnmCmdPushMarker*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: pushMarker");
-				m_cb->pushMarker(param->debugString);
-			}
-				break;
-			case OP_PRIV_PUSH_COLOR_MARKER:
-			{
-				GnmCmdPushColorMarker* param = (GnmCmdPushColorMarker*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: pushColorMarker");
-				m_cb->pushMarker(param->debugString, param->argbColor);
-			}
-				break;
-			case OP_PRIV_POP_MARKER:
-			{
-				LOG_SCE_GRAPHIC("Gnm: popMarker");
-				m_cb->popMarker();
-			}
-				break;
-			case OP_PRIV_SET_MARKER:
-				break;
-			case OP_PRIV_DISPATCH_DIRECT:
-			{
-				GnmCmdDispatchDirect*     param = (GnmCmdDispatchDirect*)pm4Hdr;
-				DispatchOrderedAppendMode mode  = (DispatchOrderedAppendMode)bit::extract(param->pred, 4, 3);
-				if (mode == kDispatchOrderedAppendModeDisabled)
-				{
-					LOG_SCE_GRAPHIC("Gnm: dispatch");
-					m_cb->dispatch(param->threadGroupX, param->threadGroupY, param->threadGroupZ);
-				}
-				else
-				{
-					LOG_SCE_GRAPHIC("Gnm: dispatchWithOrderedAppend");
-					m_cb->dispatchWithOrderedAppend(param->threadGroupX, param->threadGroupY, param->threadGroupZ, mode);
-				}
-				LOG_SCE_GRAPHIC("Gnm: ---------------------------------------");
-			}
-				break;
-			case OP_PRIV_DISPATCH_INDIRECT:
-				break;
-			case OP_PRIV_COMPUTE_WAIT_ON_ADDRESS:
-			{
-				GnmCmdComputeWaitOnAddress* param = (GnmCmdComputeWaitOnAddress*)pm4Hdr;
-				LOG_SCE_GRAPHIC("Gnm: waitOnAddress");
-				m_cb->waitOnAddress((void*)param->gpuAddr, param->mask, (WaitCompareFunc)param->compareFunc, param->refValue);
-			}
-				break;
-			default:
-				break;
+			LOG_SCE_GRAPHIC("Gnm: dispatch");
+			m_cb->dispatch(param->threadGroupX, param->threadGroupY, param->threadGroupZ);
 		}
+		else
+		{
+			LOG_SCE_GRAPHIC("Gnm: dispatchWithOrderedAppend");
+			m_cb->dispatchWithOrderedAppend(param->threadGroupX, param->threadGroupY, param->threadGroupZ, mode);
+		}
+		LOG_SCE_GRAPHIC("Gnm: ---------------------------------------");
+	}
+
+	void GnmCommandProcessor::onComputeWaitOnAddress(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
+	{
+		GnmCmdComputeWaitOnAddress* param = (GnmCmdComputeWaitOnAddress*)pm4Hdr;
+		LOG_SCE_GRAPHIC("Gnm: waitOnAddress");
+		m_cb->waitOnAddress((void*)param->gpuAddr, param->mask, (WaitCompareFunc)param->compareFunc, param->refValue);
 	}
 
 	void GnmCommandProcessor::onGnmLegacy(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
@@ -1154,45 +1181,6 @@ namespace sce::Gnm
 		}
 	}
 
-	void GnmCommandProcessor::onPrepareFlipOrEopInterrupt(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
-	{
-		uint32_t hint = itBody[0];
-
-		//void* labelAddr = (void*)((uint64_t(itBody[2]) << 32) | itBody[1]);
-		void*    labelAddr = (void*)*(uint64_t*)(itBody + 1);
-		uint32_t value     = itBody[3];
-
-		switch (hint)
-		{
-		case OP_HINT_PREPARE_FLIP_VOID:
-			LOG_SCE_GRAPHIC("Gnm: prepareFlip");
-			m_cb->prepareFlip();
-			break;
-		case OP_HINT_PREPARE_FLIP_LABEL:
-			LOG_SCE_GRAPHIC("Gnm: prepareFlip");
-			m_cb->prepareFlip(labelAddr, value);
-			break;
-		case OP_HINT_PREPARE_FLIP_WITH_EOP_INTERRUPT_VOID:
-			LOG_FIXME("Not implemented.");
-			break;
-		case OP_HINT_PREPARE_FLIP_WITH_EOP_INTERRUPT_LABEL:
-		{
-			EndOfPipeEventType eventType   = (EndOfPipeEventType)itBody[4];
-			CacheAction        cacheAction = (CacheAction)itBody[5];
-			LOG_SCE_GRAPHIC("Gnm: prepareFlipWithEopInterrupt");
-			m_cb->prepareFlipWithEopInterrupt(eventType, labelAddr, value, cacheAction);
-		}
-			break;
-		default:
-			break;
-		}
-
-		LOG_SCE_GRAPHIC("Gnm: =======================================");
-
-		// mark this is the last packet in command buffer.
-		m_flipPacketDone = true;
-	}
-
 	void GnmCommandProcessor::onDrawIndex(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
 	{
 		LOG_SCE_GRAPHIC("Gnm: drawIndex");
@@ -1231,11 +1219,19 @@ namespace sce::Gnm
 	{
 		LOG_SCE_GRAPHIC("Gnm: setViewport");
 
+		// Scale and offset are in the next packet,
+		// register offset plus 6 values.
+		PPM4_TYPE_3_HEADER nextPacket = peekNextPm4(pm4Hdr, m_remainSize, 8);
+		if (nextPacket == nullptr)
+		{
+			LOG_ERR("set viewport packet is truncated");
+			return;
+		}
+
 		float dmin = *reinterpret_cast<float*>(&itBody[1]);
 		float dmax = *reinterpret_cast<float*>(&itBody[2]);
 
-		PPM4_TYPE_3_HEADER nextPacket = getNextPm4(pm4Hdr);
-		uint32_t*          nextItBody = reinterpret_cast<uint32_t*>(nextPacket + 1);
+		uint32_t* nextItBody = reinterpret_cast<uint32_t*>(nextPacket + 1);
 
 		float scale[3]  = { 0.0 };
 		float offset[3] = { 0.0 };
@@ -1271,7 +1267,13 @@ namespace sce::Gnm
 			std::memcpy(&target.m_regs[0], &itBody[1], sizeof(uint32_t) * setCtxPacket->header.count);
 
 			// Get the next nop packet, which is used to hold width and height information.
-			auto      nopPacket                         = getNextPm4(pm4Hdr);
+			auto nopPacket = peekNextPm4(pm4Hdr, m_remainSize);
+			if (nopPacket == nullptr)
+			{
+				LOG_ERR("set render target packet is truncated");
+				return;
+			}
+
 			uint32_t* nopBody                           = reinterpret_cast<uint32_t*>(nopPacket) + 1;
 			uint32_t  packWidthHeight                   = nopBody[0];
 			target.m_regs[RenderTarget::kCbWidthHeight] = packWidthHeight;
@@ -1292,9 +1294,17 @@ namespace sce::Gnm
 	void GnmCommandProcessor::onSetDepthRenderTarget(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody)
 	{
 		LOG_SCE_GRAPHIC("Gnm: setDepthRenderTarget");
+		// The caller checked that the next packet is complete.
 		PPM4ME_SET_CONTEXT_REG nextPacket = (PPM4ME_SET_CONTEXT_REG)getNextPm4(pm4Hdr);
 		if (nextPacket->bitfields2.reg_offset == 15)
 		{
+			// Registers are read from all 6 packets of the call.
+			if (getSkippedSize(reinterpret_cast<const PM4_HEADER*>(pm4Hdr), 5, m_remainSize) < 24 * sizeof(uint32_t))
+			{
+				LOG_ERR("set depth render target packets are truncated");
+				return;
+			}
+
 			DepthRenderTarget target;
 
 			std::memcpy(&target.m_regs[0], &itBody[1], 0x20);
@@ -6,6 +6,8 @@
 
 #include "Violet/VltRc.h"
 
+#include <array>
+
 namespace sce
 {
 	namespace vlt
@@ -40,9 +42,23 @@ namespace sce
 			void processCommandBuffer(const void* commandBuffer, uint32_t commandSize);
 
 		private:
+			using PacketHandler = void (GnmCommandProcessor::*)(PPM4_TYPE_3_HEADER, uint32_t*);
+
+			// Type 3 opcodes are 8 bits wide, private opcodes are
+			// placed right after them, so a single lookup covers both.
+			static constexpr uint32_t PrivateHandlerBase = 256;
+			using PacketHandlerTable                     = std::array<PacketHandler, PrivateHandlerBase * 2>;
+
+			static PacketHandlerTable createHandlerTable();
+
 			void processPM4Type0(PPM4_TYPE_0_HEADER pm4Hdr, uint32_t* regDataX);
 			void processPM4Type3(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
 
+			// Default handlers
+			void onInvalidOpcode(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onUnsupportedOpcode(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onIgnored(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+
 			// Type 3 pm4 packet handlers
 			void onNop(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
 			void onSetBase(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
@@ -76,12 +92,25 @@ namespace sce
 			void onReleaseMem(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
 
 			// Private
-			void onGnmPrivate(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onInitializeDefaultHardwareState(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onSetEmbeddedVsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onSetVsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onSetPsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onSetCsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onUpdatePsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onUpdateVsShader(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onSetVgtControl(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onWaitUntilSafeForRendering(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onPushMarker(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onPushColorMarker(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onPopMarker(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onDispatchDirect(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onComputeWaitOnAddress(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
 			// Legacy packets used in old SDKs.
 			void onGnmLegacy(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
 
 			// Parsing methods
-			void onPrepareFlipOrEopInterrupt(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
+			void onFlipPacket();
 			void onDrawIndex(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
 			void onDrawIndexAuto(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
 			void onSetViewport(PPM4_TYPE_3_HEADER pm4Hdr, uint32_t* itBody);
@@ -108,9 +137,35 @@ namespace sce
 				return getNextNPm4<HdrType>(thisPm4, 1);
 			}
 
+			// Step to next PM4 header for handlers which look ahead,
+			// returns nullptr if the next packet doesn't lie within
+			// remainSize bytes from thisPm4 or has less than minDwords.
+			template <typename HdrType>
+			HdrType peekNextPm4(HdrType thisPm4, uint32_t remainSize, uint32_t minDwords = 2)
+			{
+				HdrType  result   = nullptr;
+				uint32_t thisSize = PM4_LENGTH_DW(thisPm4->u32All) * sizeof(uint32_t);
+				if (thisSize + sizeof(uint32_t) <= remainSize)
+				{
+					HdrType  nextPm4  = getNextPm4(thisPm4);
+					uint32_t nextSize = PM4_LENGTH_DW(nextPm4->u32All) * sizeof(uint32_t);
+					if (thisSize + nextSize <= remainSize &&
+						nextSize >= minDwords * sizeof(uint32_t))
+					{
+						result = nextPm4;
+					}
+				}
+				return result;
+			}
+
 			bool processCmdInternal(const void* commandBuffer, uint32_t commandSize);
 
+			uint32_t getSkippedSize(const PM4_HEADER* pm4Hdr, uint32_t skipCount, uint32_t remainSize);
+
 		private:
+			// Indexed by opcode, or PrivateHandlerBase + private opcode.
+			static const PacketHandlerTable m_handlerTable;
+
 			GnmCommandBuffer* m_cb;
 
 			// Flip packet is the last pm4 packet of a command buffer,
@@ -127,6 +182,15 @@ namespace sce
 			// This should be the the real pm4 packet count which forms a gnm call minus one.
 			// e.g. 2 packets makes gnm call, m_skipPm4Count = 1
 			uint32_t m_skipPm4Count = 0;
+
+			// Bytes from the packet being handled to the end of
+			// its command buffer, for handlers which look ahead.
+			uint32_t m_remainSize = 0;
+
+#ifdef GPCS4_PM4_BENCHMARK
+			// Number of pm4 packets processed, used for benchmark.
+			uint32_t m_packetCount = 0;
+#endif  // GPCS4_PM4_BENCHMARK
 		};
 
 	}  // namespace Gnm
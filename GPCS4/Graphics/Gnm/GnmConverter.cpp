@@ -118,26 +118,26 @@ namespace sce::Gnm::cvt
 			//{ kDataFormatR1ReversedUint, VK_FORMAT_R1_REVERSEDUINT },
 			//{ kDataFormatL1ReversedUint, VK_FORMAT_L1_REVERSEDUINT },
 			//{ kDataFormatA1ReversedUint, VK_FORMAT_A1_REVERSEDUINT },
-			//{ kDataFormatBc1Unorm, VK_FORMAT_BC1_UNORM },
+			{ kDataFormatBc1Unorm, VK_FORMAT_BC1_RGBA_UNORM_BLOCK },
 			//{ kDataFormatBc1UBNorm, VK_FORMAT_BC1_UBNORM },
-			//{ kDataFormatBc1UnormSrgb, VK_FORMAT_BC1_UNORMSRGB },
-			//{ kDataFormatBc2Unorm, VK_FORMAT_BC2_UNORM },
+			{ kDataFormatBc1UnormSrgb, VK_FORMAT_BC1_RGBA_SRGB_BLOCK },
+			{ kDataFormatBc2Unorm, VK_FORMAT_BC2_UNORM_BLOCK },
 			//{ kDataFormatBc2UBNorm, VK_FORMAT_BC2_UBNORM },
-			//{ kDataFormatBc2UnormSrgb, VK_FORMAT_BC2_UNORMSRGB },
+			{ kDataFormatBc2UnormSrgb, VK_FORMAT_BC2_SRGB_BLOCK },
 			{ kDataFormatBc3Unorm, VK_FORMAT_BC3_UNORM_BLOCK },
 			//{ kDataFormatBc3UBNorm, VK_FORMAT_BC3_UBNORM },
 			{ kDataFormatBc3UnormSrgb, VK_FORMAT_BC3_SRGB_BLOCK },
-			//{ kDataFormatBc4Unorm, VK_FORMAT_BC4_UNORM },
-			//{ kDataFormatBc4Snorm, VK_FORMAT_BC4_SNORM },
-			//{ kDataFormatBc5Unorm, VK_FORMAT_BC5_UNORM },
-			//{ kDataFormatBc5Snorm, VK_FORMAT_BC5_SNORM },
+			{ kDataFormatBc4Unorm, VK_FORMAT_BC4_UNORM_BLOCK },
+			{ kDataFormatBc4Snorm, VK_FORMAT_BC4_SNORM_BLOCK },
+			{ kDataFormatBc5Unorm, VK_FORMAT_BC5_UNORM_BLOCK },
+			{ kDataFormatBc5Snorm, VK_FORMAT_BC5_SNORM_BLOCK },
 			//{ kDataFormatBc6Unorm, VK_FORMAT_BC6_UNORM },
 			//{ kDataFormatBc6Snorm, VK_FORMAT_BC6_SNORM },
-			//{ kDataFormatBc6Uf16, VK_FORMAT_BC6UF16_ },
-			//{ kDataFormatBc6Sf16, VK_FORMAT_BC6SF16_ },
-			//{ kDataFormatBc7Unorm, VK_FORMAT_BC7_UNORM },
+			{ kDataFormatBc6Uf16, VK_FORMAT_BC6H_UFLOAT_BLOCK },
+			{ kDataFormatBc6Sf16, VK_FORMAT_BC6H_SFLOAT_BLOCK },
+			{ kDataFormatBc7Unorm, VK_FORMAT_BC7_UNORM_BLOCK },
 			//{ kDataFormatBc7UBNorm, VK_FORMAT_BC7_UBNORM },
-			//{ kDataFormatBc7UnormSrgb, VK_FORMAT_BC7_UNORMSRGB },
+			{ kDataFormatBc7UnormSrgb, VK_FORMAT_BC7_SRGB_BLOCK },
 			//{ kDataFormatB5G6R5Unorm, VK_FORMAT_B5G6R5_UNORM },
 			//{ kDataFormatR5G5B5A1Unorm, VK_FORMAT_R5G5B5A1_UNORM },
 			//{ kDataFormatB5G5R5A1Unorm, VK_FORMAT_B5G5R5A1_UNORM },
@@ -162,8 +162,8 @@ namespace sce::Gnm::cvt
 			//{ kDataFormatR9G9B9E5Float, VK_FORMAT_R9G9B9E5_FLOAT },
 			//{ kDataFormatB8G8R8G8Unorm, VK_FORMAT_B8G8R8G8_UNORM },
 			//{ kDataFormatG8B8G8R8Unorm, VK_FORMAT_G8B8G8R8_UNORM },
-			//{ kDataFormatBc1UnormNoAlpha, VK_FORMAT_BC1_UNORMNOALPHA },
-			//{ kDataFormatBc1UnormSrgbNoAlpha, VK_FORMAT_BC1_UNORMSRGBNOALPHA },
+			{ kDataFormatBc1UnormNoAlpha, VK_FORMAT_BC1_RGB_UNORM_BLOCK },
+			{ kDataFormatBc1UnormSrgbNoAlpha, VK_FORMAT_BC1_RGB_SRGB_BLOCK },
 			//{ kDataFormatBc7UnormNoAlpha, VK_FORMAT_BC7_UNORMNOALPHA },
 			//{ kDataFormatBc7UnormSrgbNoAlpha, VK_FORMAT_BC7_UNORMSRGBNOALPHA },
 			//{ kDataFormatBc3UnormRABG, VK_FORMAT_BC3_UNORMRABG },
@@ -201,6 +201,90 @@ namespace sce::Gnm::cvt
 		return format;
 	}
 
+	bc::BlockFormat convertBlockFormat(VkFormat format)
+	{
+		bc::BlockFormat result = bc::BlockFormat::Invalid;
+		switch (format)
+		{
+			case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+				result = bc::BlockFormat::Bc1Rgb;
+				break;
+			case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+				result = bc::BlockFormat::Bc1Rgba;
+				break;
+			case VK_FORMAT_BC2_UNORM_BLOCK:
+			case VK_FORMAT_BC2_SRGB_BLOCK:
+				result = bc::BlockFormat::Bc2;
+				break;
+			case VK_FORMAT_BC3_UNORM_BLOCK:
+			case VK_FORMAT_BC3_SRGB_BLOCK:
+				result = bc::BlockFormat::Bc3;
+				break;
+			case VK_FORMAT_BC4_UNORM_BLOCK:
+				result = bc::BlockFormat::Bc4Unorm;
+				break;
+			case VK_FORMAT_BC4_SNORM_BLOCK:
+				result = bc::BlockFormat::Bc4Snorm;
+				break;
+			case VK_FORMAT_BC5_UNORM_BLOCK:
+				result = bc::BlockFormat::Bc5Unorm;
+				break;
+			case VK_FORMAT_BC5_SNORM_BLOCK:
+				result = bc::BlockFormat::Bc5Snorm;
+				break;
+			case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+				result = bc::BlockFormat::Bc6hUfloat;
+				break;
+			case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+				result = bc::BlockFormat::Bc6hSfloat;
+				break;
+			case VK_FORMAT_BC7_UNORM_BLOCK:
+			case VK_FORMAT_BC7_SRGB_BLOCK:
+				result = bc::BlockFormat::Bc7;
+				break;
+			default:
+				break;
+		}
+		return result;
+	}
+
+	VkFormat getDecodedFormat(VkFormat format)
+	{
+		VkFormat result = VK_FORMAT_UNDEFINED;
+		switch (format)
+		{
+			case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+			case VK_FORMAT_BC2_UNORM_BLOCK:
+			case VK_FORMAT_BC3_UNORM_BLOCK:
+			case VK_FORMAT_BC4_UNORM_BLOCK:
+			case VK_FORMAT_BC5_UNORM_BLOCK:
+			case VK_FORMAT_BC7_UNORM_BLOCK:
+				result = VK_FORMAT_R8G8B8A8_UNORM;
+				break;
+			case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+			case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+			case VK_FORMAT_BC2_SRGB_BLOCK:
+			case VK_FORMAT_BC3_SRGB_BLOCK:
+			case VK_FORMAT_BC7_SRGB_BLOCK:
+				result = VK_FORMAT_R8G8B8A8_SRGB;
+				break;
+			case VK_FORMAT_BC4_SNORM_BLOCK:
+			case VK_FORMAT_BC5_SNORM_BLOCK:
+				result = VK_FORMAT_R8G8B8A8_SNORM;
+				break;
+			case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+			case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+				result = VK_FORMAT_R16G16B16A16_SFLOAT;
+				break;
+			default:
+				break;
+		}
+		return result;
+	}
+
 	VkSampleCountFlagBits convertNumFragments(NumFragments numFragments)
 	{
 		VkSampleCountFlagBits sampleCount = VK_SAMPLE_COUNT_FLAG_BITS_MAX_ENUM;
@@ -371,12 +455,15 @@ namespace sce::Gnm::cvt
 		case kPrimitiveTypeLineStripAdjacency: topology = VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY; break;
 		case kPrimitiveTypeTriListAdjacency: topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_WITH_ADJACENCY; break;
 		case kPrimitiveTypeTriStripAdjacency: topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY; break;
-		// Not supported by vulkan
-		//case kPrimitiveTypeRectList: topology = ; break;
-		//case kPrimitiveTypeLineLoop: topology = ; break;
-		//case kPrimitiveTypeQuadList: topology = ; break;
-		//case kPrimitiveTypeQuadStrip: topology = ; break;
-		//case kPrimitiveTypePolygon: topology = ; break;
+		// Not supported by vulkan, indices are converted
+		// by GnmIndexBufferCache to these topologies.
+		case kPrimitiveTypeLineLoop: topology = VK_PRIMITIVE_TOPOLOGY_LINE_STRIP; break;
+		case kPrimitiveTypeQuadList: topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST; break;
+		case kPrimitiveTypeQuadStrip: topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST; break;
+		case kPrimitiveTypePolygon: topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST; break;
+		// The fourth corner of a rect can't be expressed with
+		// indices, it is emitted by the rect list geometry shader.
+		case kPrimitiveTypeRectList: topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST; break;
 		default:
 			topology = VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
 			LOG_ERR("unsupported PrimitiveType %d", primType);
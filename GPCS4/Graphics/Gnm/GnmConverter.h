@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GnmCommon.h"
+#include "GnmBcDecoder.h"
 #include "GnmDataFormat.h"
 #include "SceVideoOut/sce_videoout_types.h"
 
@@ -22,6 +23,24 @@ namespace sce::Gnm::cvt
 
 	VkFormat convertDataFormat(DataFormat dataFormat);
 
+	/**
+	 * \brief Block format for CPU decoding
+	 *
+	 * \returns Block format, or \c bc::BlockFormat::Invalid
+	 *          if \c format is not block compressed
+	 */
+	bc::BlockFormat convertBlockFormat(VkFormat format);
+
+	/**
+	 * \brief Format of decoded BCn data
+	 *
+	 * BC1-BC5 and BC7 decode to RGBA8 of the same
+	 * numeric format, BC6H decodes to RGBA16F.
+	 * \returns Decoded format, or \c VK_FORMAT_UNDEFINED
+	 *          if \c format is not block compressed
+	 */
+	VkFormat getDecodedFormat(VkFormat format);
+
 	VkFormat convertVideoOutPixelFormat(SceVideoOutPixelFormat format);
 
 	DataFormat convertDataFormatFromVideoOutPixelFormat(SceVideoOutPixelFormat format);
@@ -1,8 +1,9 @@
 #include "GnmGpuLabel.h"
-#include "Violet/VltDevice.h"
+#include "Sce/SceLabelManager.h"
 #include "Violet/VltContext.h"
 #include "Violet/VltSemaphore.h"
-#include "PlatProcess.h"
+
+#include <mutex>
 
 using namespace sce::vlt;
 
@@ -10,18 +11,30 @@ LOG_CHANNEL(Graphic.Gnm.GnmGpuLabel);
 
 namespace sce::Gnm
 {
-	GnmGpuLabel::GnmGpuLabel(vlt::VltDevice* device,
-							 void*           label) :
-		m_device(device),
-		m_label(label)
+	GnmGpuLabel::GnmGpuLabel()
 	{
-		createSemaphore();
 	}
 
 	GnmGpuLabel::~GnmGpuLabel()
 	{
 	}
 
+	void GnmGpuLabel::init(
+		SceLabelManager* manager,
+		void*            label)
+	{
+		std::lock_guard<util::sync::Spinlock> guard(m_lock);
+		m_manager = manager;
+		m_label   = label;
+		m_value   = 0;
+		m_point   = 0;
+
+		// A reused slot keeps its semaphore. Its value
+		// can't go back, so continue in the next epoch.
+		m_epoch          = m_semaphore != nullptr ? (m_semaphoreValue >> 32) + 1 : 0;
+		m_semaphoreValue = m_epoch << 32;
+	}
+
 	void GnmGpuLabel::set(uint64_t value)
 	{
 		// Currently not used.
@@ -33,30 +46,47 @@ namespace sce::Gnm
 		EventWriteSource      srcSelector,
 		uint64_t              immValue)
 	{
-		m_value = immValue == 0 ? 1 : immValue;
+		SceLabelWrite labelWrite;
+		labelWrite.address     = m_label;
+		labelWrite.srcSelector = srcSelector;
+		labelWrite.value       = immValue;
+
+		// The memory write happens on the completion
+		// thread once the returned point is signaled.
+		uint64_t point = m_manager->signal(context, stage, labelWrite);
 
 		VltSemaphoreSubmission submission;
-		submission.semaphore = m_semaphore;
+		submission.semaphore = nullptr;
 		submission.stageMask = stage;
-		submission.value     = m_value;
-
-		// Queue the semaphore
-		context->signalSemaphore(submission);
-
-		// Asynchronously set label value upon semaphore is signaled.
-		// Record the returned future so that when the class is destructed,
-		// we can make sure the label has been updated.
-		m_future = std::async(std::launch::async, [this, srcSelector, immValue]()
-			{ 
-				m_semaphore->wait(immValue);
-
-				if (srcSelector == kEventWriteSource32BitsImmediate)
-					*reinterpret_cast<uint32_t*>(m_label) = immValue;
-				else if (srcSelector == kEventWriteSource64BitsImmediate)
-					*reinterpret_cast<uint64_t*>(m_label) = immValue; 
-				else
-					*reinterpret_cast<uint64_t*>(m_label) = plat::GetProcessTimeCounter();
-			});
+		{
+			std::lock_guard<util::sync::Spinlock> guard(m_lock);
+			m_value = immValue;
+			m_point = point;
+
+			// Waits compare the low 32 bits. Timeline values
+			// can't go backwards, so a write which doesn't
+			// increase the value starts a new epoch. This also
+			// releases waits left over from the previous one.
+			uint32_t labelValue = static_cast<uint32_t>(immValue);
+			uint64_t value      = getSemaphoreValue(m_epoch, labelValue);
+			if (value <= m_semaphoreValue)
+			{
+				value = getSemaphoreValue(++m_epoch, labelValue);
+			}
+			m_semaphoreValue = value;
+
+			// Release waits recorded before this write.
+			if (m_semaphore != nullptr)
+			{
+				submission.semaphore = m_semaphore;
+				submission.value     = value;
+			}
+		}
+
+		if (submission.semaphore != nullptr)
+		{
+			context->signalSemaphore(submission);
+		}
 	}
 
 	void GnmGpuLabel::writeWithInterrupt(
@@ -84,21 +114,71 @@ namespace sce::Gnm
 		// Only support equal compare now.
 		LOG_ASSERT(compareFunc == kWaitCompareFuncEqual, "Only equal compareFunc is supported yet.");
 
-		m_value = refValue == 0 ? 1 : refValue;
+		uint64_t value = 0;
+		uint64_t point = 0;
+		{
+			std::lock_guard<util::sync::Spinlock> guard(m_lock);
+			value = m_value;
+			point = m_point;
+		}
+
+		if (point != 0 && (value & mask) == refValue)
+		{
+			// Wait for the write which produces the reference value.
+			m_manager->wait(context, point);
+		}
+		else if (!isSatisfied(mask, refValue))
+		{
+			// The label is written later on another queue, we can't
+			// know its timeline point yet. Wait on the label's own
+			// semaphore, the write signals it with its value.
+			VltSemaphoreSubmission submission;
+			submission.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+			{
+				std::lock_guard<util::sync::Spinlock> guard(m_lock);
+				submission.semaphore = m_semaphore;
+
+				// A value not above the last write can only
+				// be produced after the label is reset.
+				submission.value = getSemaphoreValue(m_epoch, refValue);
+				if (submission.value <= m_semaphoreValue)
+				{
+					submission.value = getSemaphoreValue(m_epoch + 1, refValue);
+				}
+			}
+
+			if (submission.semaphore == nullptr)
+			{
+				// Don't create Vulkan objects under the spinlock.
+				Rc<VltSemaphore> semaphore = m_manager->createLabelSemaphore();
+
+				std::lock_guard<util::sync::Spinlock> guard(m_lock);
+				if (m_semaphore == nullptr)
+				{
+					m_semaphore = std::move(semaphore);
+				}
+				submission.semaphore = m_semaphore;
+			}
+
+			context->waitSemaphore(submission);
+		}
+	}
 
-		VltSemaphoreSubmission submission;
-		submission.semaphore = m_semaphore;
-		submission.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-		submission.value     = m_value & mask;
-		context->waitSemaphore(submission);
+	uint64_t GnmGpuLabel::getSemaphoreValue(
+		uint64_t epoch,
+		uint32_t labelValue)
+	{
+		// Timeline semaphores start at 0,
+		// which would never block a wait.
+		return (epoch << 32) | (labelValue == 0 ? 1 : labelValue);
 	}
 
-	void GnmGpuLabel::createSemaphore()
+	bool GnmGpuLabel::isSatisfied(
+		uint32_t mask,
+		uint32_t refValue) const
 	{
-		VltSemaphoreCreateInfo info;
-		info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
-		info.initialValue  = 0;
-		m_semaphore        = m_device->createSemaphore(info);
+		uint32_t value = *reinterpret_cast<volatile uint32_t*>(m_label);
+		return (value & mask) == refValue;
 	}
 
-}  // namespace sce::Gnm
\ No newline at end of file
+}  // namespace sce::Gnm
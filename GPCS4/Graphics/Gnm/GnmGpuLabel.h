@@ -2,28 +2,61 @@
 
 #include "GnmCommon.h"
 #include "GnmConstant.h"
+#include "UtilSync.h"
 #include "Violet/VltRc.h"
 
-#include <unordered_map>
-#include <future>
+namespace sce
+{
+	class SceLabelManager;
+}  // namespace sce
 
 namespace sce::vlt
 {
-	class VltDevice;
 	class VltContext;
 	class VltSemaphore;
 }  // namespace sce::vlt
 
 namespace sce::Gnm
 {
-    class GnmGpuLabel
+	/**
+	 * \brief GPU label
+	 *
+	 * A label is a piece of guest memory written
+	 * by the GPU, usually at end of pipe, which
+	 * the CPU or another queue polls on.
+	 *
+	 * Labels don't own any Vulkan object. Each write
+	 * signals a new point on the device-wide timeline
+	 * semaphore of the label manager, and the memory
+	 * is updated by the manager's completion thread
+	 * once that point is reached.
+	 *
+	 * A wait recorded before the write it depends on
+	 * falls back to a timeline semaphore owned by the
+	 * label, which is signaled with the written value.
+	 * Label values may go back, e.g. when a counter is
+	 * reset, so each such write starts a new epoch in
+	 * the upper 32 bits of the semaphore value.
+	 */
+	class GnmGpuLabel
 	{
 	public:
-		GnmGpuLabel(
-			vlt::VltDevice* device,
-			void*           label);
+		GnmGpuLabel();
 		~GnmGpuLabel();
 
+		/**
+		 * \brief Binds the label to a guest address
+		 *
+		 * Labels live in the manager's table and get
+		 * rebound when a stale slot is reused. The
+		 * semaphore of the old label is kept.
+		 * \param [in] manager Label manager
+		 * \param [in] label Guest label address
+		 */
+		void init(
+			SceLabelManager* manager,
+			void*            label);
+
 		void set(uint64_t value);
 
 		void write(
@@ -45,15 +78,30 @@ namespace sce::Gnm
 			uint32_t         refValue);
 
 	private:
-		void createSemaphore();
-		
+		static uint64_t getSemaphoreValue(
+			uint64_t epoch,
+			uint32_t labelValue);
+
+		bool isSatisfied(
+			uint32_t mask,
+			uint32_t refValue) const;
+
 	private:
-		vlt::VltDevice* m_device;
-		void*           m_label;
-		uint64_t        m_value = 0;
+		SceLabelManager* m_manager = nullptr;
+		void*            m_label   = nullptr;
+
+		// Value and timeline point of the last write
+		// to this label, point is 0 if never written.
+		uint64_t             m_value = 0;
+		uint64_t             m_point = 0;
+		util::sync::Spinlock m_lock;
 
+		// Only created once a wait comes before its write.
+		// The value and epoch are tracked for every write,
+		// so waits recorded later map to the same epoch.
 		vlt::Rc<vlt::VltSemaphore> m_semaphore;
-		std::future<void>          m_future;
+		uint64_t                   m_semaphoreValue = 0;
+		uint64_t                   m_epoch          = 0;
 	};
 
-}  // namespace sce::Gnm
\ No newline at end of file
+}  // namespace sce::Gnm
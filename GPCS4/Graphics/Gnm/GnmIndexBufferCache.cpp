@@ -0,0 +1,371 @@
+#include "GnmIndexBufferCache.h"
+
+#include "GnmBuffer.h"
+#include "GnmInitializer.h"
+#include "PlatHardware.h"
+#include "UtilMath.h"
+
+#include "Violet/VltDevice.h"
+
+#include <algorithm>
+#include <immintrin.h>
+#include <vector>
+
+LOG_CHANNEL(Graphic.Gnm.GnmIndexBufferCache);
+
+#define INDEX_CONVERT_TARGET_SSSE3 __attribute__((target("ssse3")))
+
+namespace sce::Gnm
+{
+	using namespace vlt;
+
+	///////////////////////////////////////////////////////////////////////////
+	// Conversion kernels
+	//
+	// Primitive types are converted as described in
+	// the PrimitiveType documentation, incomplete
+	// primitives at the end are dropped.
+
+	static void generateSequential(uint32_t* dst, uint32_t indexCount)
+	{
+		__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+		__m128i step  = _mm_set1_epi32(4);
+
+		uint32_t i = 0;
+		for (; i + 4 <= indexCount; i += 4)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), index);
+			index = _mm_add_epi32(index, step);
+		}
+		for (; i < indexCount; ++i)
+		{
+			dst[i] = i;
+		}
+	}
+
+	template <typename T>
+	static void convertQuadList(T* dst, const T* src, uint32_t quadCount)
+	{
+		for (uint32_t q = 0; q != quadCount; ++q)
+		{
+			const T* quad = src + q * 4;
+			T*       tris = dst + q * 6;
+			tris[0]       = quad[0];
+			tris[1]       = quad[1];
+			tris[2]       = quad[2];
+			tris[3]       = quad[0];
+			tris[4]       = quad[2];
+			tris[5]       = quad[3];
+		}
+	}
+
+	INDEX_CONVERT_TARGET_SSSE3 static void convertQuadList16Ssse3(uint16_t* dst, const uint16_t* src, uint32_t quadCount)
+	{
+		// Two quads per iteration, 8 indices in, 12 out.
+		const __m128i lo = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 0, 1, 4, 5, 6, 7, 8, 9, 10, 11);
+		const __m128i hi = _mm_setr_epi8(12, 13, 8, 9, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+
+		uint32_t q = 0;
+		for (; q + 2 <= quadCount; q += 2)
+		{
+			__m128i quads = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + q * 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + q * 6), _mm_shuffle_epi8(quads, lo));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + q * 6 + 8), _mm_shuffle_epi8(quads, hi));
+		}
+
+		convertQuadList(dst + q * 6, src + q * 4, quadCount - q);
+	}
+
+	static void convertQuadList32Sse2(uint32_t* dst, const uint32_t* src, uint32_t quadCount)
+	{
+		for (uint32_t q = 0; q != quadCount; ++q)
+		{
+			__m128i quad = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + q * 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + q * 6), _mm_shuffle_epi32(quad, _MM_SHUFFLE(0, 2, 1, 0)));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + q * 6 + 4), _mm_unpackhi_epi64(quad, quad));
+		}
+	}
+
+	template <typename T>
+	static void convertQuadStrip(T* dst, const T* src, uint32_t quadCount)
+	{
+		for (uint32_t q = 0; q != quadCount; ++q)
+		{
+			const T* quad = src + q * 2;
+			T*       tris = dst + q * 6;
+			tris[0]       = quad[0];
+			tris[1]       = quad[1];
+			tris[2]       = quad[3];
+			tris[3]       = quad[0];
+			tris[4]       = quad[3];
+			tris[5]       = quad[2];
+		}
+	}
+
+	template <typename T>
+	static void convertPolygon(T* dst, const T* src, uint32_t triCount)
+	{
+		// Unlike a Vulkan triangle fan, the first
+		// vertex of the polygon leads every triangle.
+		for (uint32_t t = 0; t != triCount; ++t)
+		{
+			dst[t * 3 + 0] = src[0];
+			dst[t * 3 + 1] = src[t + 1];
+			dst[t * 3 + 2] = src[t + 2];
+		}
+	}
+
+	template <typename T>
+	static void convertLineLoop(T* dst, const T* src, uint32_t indexCount)
+	{
+		std::copy(src, src + indexCount, dst);
+		dst[indexCount] = src[0];
+	}
+
+	template <typename T>
+	static void convertIndicesTyped(
+		PrimitiveType primType,
+		T*            dst,
+		const T*      src,
+		uint32_t      indexCount)
+	{
+		static const bool hasSsse3 = plat::GetCpuFeatures().ssse3;
+
+		uint32_t outCount = GnmIndexBufferCache::getIndexCount(primType, indexCount);
+		if (outCount == 0)
+		{
+			return;
+		}
+
+		switch (primType)
+		{
+			case kPrimitiveTypeQuadList:
+				if constexpr (sizeof(T) == sizeof(uint16_t))
+				{
+					hasSsse3
+						? convertQuadList16Ssse3(dst, src, outCount / 6)
+						: convertQuadList(dst, src, outCount / 6);
+				}
+				else
+				{
+					convertQuadList32Sse2(dst, src, outCount / 6);
+				}
+				break;
+			case kPrimitiveTypeQuadStrip:
+				convertQuadStrip(dst, src, outCount / 6);
+				break;
+			case kPrimitiveTypePolygon:
+				convertPolygon(dst, src, outCount / 3);
+				break;
+			case kPrimitiveTypeLineLoop:
+				convertLineLoop(dst, src, indexCount);
+				break;
+			default:
+				std::copy(src, src + indexCount, dst);
+				break;
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	size_t GnmIndexBufferKey::hash() const
+	{
+		VltHashState result;
+		result.add(std::hash<uint32_t>()(primType));
+		result.add(std::hash<uint32_t>()(indexCount));
+		return result;
+	}
+
+	bool GnmIndexBufferKey::eq(const GnmIndexBufferKey& other) const
+	{
+		return primType == other.primType &&
+			   indexCount == other.indexCount;
+	}
+
+	GnmIndexBufferCache::GnmIndexBufferCache(
+		VltDevice*      device,
+		GnmInitializer* initializer) :
+		m_device(device),
+		m_initializer(initializer)
+	{
+	}
+
+	GnmIndexBufferCache::~GnmIndexBufferCache()
+	{
+	}
+
+	bool GnmIndexBufferCache::needsConversion(PrimitiveType primType)
+	{
+		return primType == kPrimitiveTypeQuadList ||
+			   primType == kPrimitiveTypeQuadStrip ||
+			   primType == kPrimitiveTypePolygon ||
+			   primType == kPrimitiveTypeLineLoop;
+	}
+
+	uint32_t GnmIndexBufferCache::getIndexCount(
+		PrimitiveType primType,
+		uint32_t      indexCount)
+	{
+		uint32_t count = 0;
+		switch (primType)
+		{
+			case kPrimitiveTypeQuadList:
+				count = (indexCount / 4) * 6;
+				break;
+			case kPrimitiveTypeQuadStrip:
+				count = indexCount >= 4 ? ((indexCount - 2) / 2) * 6 : 0;
+				break;
+			case kPrimitiveTypePolygon:
+				count = indexCount >= 3 ? (indexCount - 2) * 3 : 0;
+				break;
+			case kPrimitiveTypeLineLoop:
+				count = indexCount >= 2 ? indexCount + 1 : 0;
+				break;
+			default:
+				count = indexCount;
+				break;
+		}
+		return count;
+	}
+
+	VltBufferSlice GnmIndexBufferCache::getAutoIndices(
+		PrimitiveType primType,
+		uint32_t      indexCount)
+	{
+		VltBufferSlice slice;
+		do
+		{
+			if (!needsConversion(primType))
+			{
+				if (indexCount > m_sequentialCount)
+				{
+					// Grow geometrically so that a slowly increasing
+					// count doesn't upload the buffer every draw.
+					uint32_t count = std::max(indexCount, m_sequentialCount * 2);
+					count          = std::max(count, 4096u);
+
+					std::vector<uint32_t> indices(count);
+					generateSequential(indices.data(), count);
+
+					m_sequentialBuffer = createIndexBuffer(indices.data(), count);
+					m_sequentialCount  = count;
+				}
+
+				slice = VltBufferSlice(m_sequentialBuffer, 0, sizeof(uint32_t) * indexCount);
+				break;
+			}
+
+			GnmIndexBufferKey key = { primType, indexCount };
+
+			auto iter = m_convertedBuffers.find(key);
+			if (iter != m_convertedBuffers.end())
+			{
+				slice = VltBufferSlice(iter->second);
+				break;
+			}
+
+			uint32_t outCount = getIndexCount(primType, indexCount);
+			if (outCount == 0)
+			{
+				break;
+			}
+
+			std::vector<uint32_t> sequential(indexCount);
+			std::vector<uint32_t> indices(outCount);
+			generateSequential(sequential.data(), indexCount);
+			convertIndicesTyped(primType, indices.data(), sequential.data(), indexCount);
+
+			auto buffer = createIndexBuffer(indices.data(), outCount);
+			m_convertedBuffers.emplace(key, buffer);
+
+			slice = VltBufferSlice(buffer);
+		} while (false);
+		return slice;
+	}
+
+	VltBufferSlice GnmIndexBufferCache::convertIndices(
+		PrimitiveType primType,
+		const void*   indices,
+		uint32_t      indexCount,
+		VkIndexType   indexType)
+	{
+		VltBufferSlice slice;
+		do
+		{
+			uint32_t outCount = getIndexCount(primType, indexCount);
+			if (outCount == 0)
+			{
+				break;
+			}
+
+			VkDeviceSize indexSize = indexType == VK_INDEX_TYPE_UINT16
+										 ? sizeof(uint16_t)
+										 : sizeof(uint32_t);
+			VkDeviceSize size      = indexSize * outCount;
+			VkDeviceSize offset    = allocScratch(size);
+			void*        dst       = m_scratchBuffer->mapPtr(offset);
+
+			if (indexType == VK_INDEX_TYPE_UINT16)
+			{
+				convertIndicesTyped(primType,
+									reinterpret_cast<uint16_t*>(dst),
+									reinterpret_cast<const uint16_t*>(indices),
+									indexCount);
+			}
+			else
+			{
+				convertIndicesTyped(primType,
+									reinterpret_cast<uint32_t*>(dst),
+									reinterpret_cast<const uint32_t*>(indices),
+									indexCount);
+			}
+
+			slice = VltBufferSlice(m_scratchBuffer, offset, size);
+		} while (false);
+		return slice;
+	}
+
+	Rc<VltBuffer> GnmIndexBufferCache::createIndexBuffer(
+		const uint32_t* indices,
+		uint32_t        indexCount)
+	{
+		Buffer vsharp = {};
+		vsharp.initAsDataBuffer(indices, kDataFormatR32Uint, indexCount);
+
+		VltBufferCreateInfo info;
+		info.size   = sizeof(uint32_t) * indexCount;
+		info.usage  = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+		info.stages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+		info.access = VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		auto buffer = m_device->createBuffer(info, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		m_initializer->initBuffer(buffer, &vsharp);
+		return buffer;
+	}
+
+	VkDeviceSize GnmIndexBufferCache::allocScratch(VkDeviceSize size)
+	{
+		// Written by the host before submission,
+		// so no barrier is needed. A full buffer is
+		// replaced, command lists keep the old one alive.
+		VkDeviceSize offset = util::align(m_scratchOffset, 16);
+		if (m_scratchBuffer == nullptr ||
+			offset + size > m_scratchBuffer->info().size)
+		{
+			VltBufferCreateInfo info;
+			info.size   = std::max(size, MinScratchSize);
+			info.usage  = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+			info.stages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+			info.access = VK_ACCESS_INDEX_READ_BIT;
+
+			m_scratchBuffer = m_device->createBuffer(info,
+													 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+														 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+			offset          = 0;
+		}
+
+		m_scratchOffset = offset + size;
+		return offset;
+	}
+
+}  // namespace sce::Gnm
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "GnmCommon.h"
+#include "GnmConstant.h"
+
+#include "Violet/VltBuffer.h"
+#include "Violet/VltHash.h"
+#include "Violet/VltRc.h"
+
+#include <unordered_map>
+
+namespace sce::vlt
+{
+	class VltDevice;
+}  // namespace sce::vlt
+
+namespace sce::Gnm
+{
+	class GnmInitializer;
+
+	/**
+	 * \brief Converted index buffer key
+	 *
+	 * Auto generated indices only depend on
+	 * the primitive type and the index count.
+	 */
+	struct GnmIndexBufferKey
+	{
+		PrimitiveType primType;
+		uint32_t      indexCount;
+
+		size_t hash() const;
+
+		bool eq(const GnmIndexBufferKey& other) const;
+	};
+
+	/**
+	 * \brief Index buffer cache
+	 *
+	 * Provides index buffers for auto indexed draws
+	 * and converts indices of primitive types Vulkan
+	 * has no topology for into triangle or line lists.
+	 *
+	 * Sequential indices live in one shared buffer that
+	 * only grows, converted auto indices are generated
+	 * once per primitive type and count. Both are uploaded
+	 * to device local memory once and reused afterwards.
+	 *
+	 * Indices of indexed draws depend on guest memory and
+	 * are converted for every draw into host visible memory.
+	 */
+	class GnmIndexBufferCache
+	{
+		constexpr static VkDeviceSize MinScratchSize = 1024 * 1024;
+
+	public:
+		GnmIndexBufferCache(
+			vlt::VltDevice* device,
+			GnmInitializer* initializer);
+		~GnmIndexBufferCache();
+
+		/**
+		 * \brief Checks whether indices need conversion
+		 *
+		 * \param [in] primType Primitive type
+		 * \returns \c true if the primitive type has
+		 *          no matching Vulkan topology
+		 */
+		static bool needsConversion(PrimitiveType primType);
+
+		/**
+		 * \brief Number of indices after conversion
+		 *
+		 * \param [in] primType Primitive type
+		 * \param [in] indexCount Number of guest indices
+		 * \returns Number of indices drawn
+		 */
+		static uint32_t getIndexCount(
+			PrimitiveType primType,
+			uint32_t      indexCount);
+
+		/**
+		 * \brief Index buffer of an auto indexed draw
+		 *
+		 * Indices are always 32 bits wide.
+		 * \param [in] primType Primitive type
+		 * \param [in] indexCount Number of guest indices
+		 * \returns Slice holding \c getIndexCount indices
+		 */
+		vlt::VltBufferSlice getAutoIndices(
+			PrimitiveType primType,
+			uint32_t      indexCount);
+
+		/**
+		 * \brief Converts indices of an indexed draw
+		 *
+		 * Converted indices keep the index type.
+		 * \param [in] primType Primitive type
+		 * \param [in] indices Guest indices
+		 * \param [in] indexCount Number of guest indices
+		 * \param [in] indexType Index type
+		 * \returns Slice holding \c getIndexCount indices
+		 */
+		vlt::VltBufferSlice convertIndices(
+			PrimitiveType primType,
+			const void*   indices,
+			uint32_t      indexCount,
+			VkIndexType   indexType);
+
+	private:
+		vlt::VltDevice* m_device;
+		GnmInitializer* m_initializer;
+
+		vlt::Rc<vlt::VltBuffer> m_sequentialBuffer;
+		uint32_t                m_sequentialCount = 0;
+
+		std::unordered_map<
+			GnmIndexBufferKey,
+			vlt::Rc<vlt::VltBuffer>,
+			vlt::VltHash,
+			vlt::VltEq>
+			m_convertedBuffers;
+
+		vlt::Rc<vlt::VltBuffer> m_scratchBuffer;
+		VkDeviceSize            m_scratchOffset = 0;
+
+		vlt::Rc<vlt::VltBuffer> createIndexBuffer(
+			const uint32_t* indices,
+			uint32_t        indexCount);
+
+		VkDeviceSize allocScratch(
+			VkDeviceSize size);
+	};
+
+}  // namespace sce::Gnm
@@ -0,0 +1,259 @@
+#include "GnmIndexScan.h"
+
+#include "PlatHardware.h"
+
+#include <algorithm>
+#include <immintrin.h>
+
+LOG_CHANNEL(Graphic.Gnm.GnmIndexScan);
+
+#define INDEX_SCAN_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace sce::Gnm
+{
+	typedef GnmIndexRange (*PFN_scanIndices)(const void* indices, uint32_t indexCount);
+
+	template <typename T>
+	static GnmIndexRange scanIndicesScalar(const T* indices, uint32_t indexCount)
+	{
+		T minIndex = indices[0];
+		T maxIndex = indices[0];
+		for (uint32_t i = 1; i < indexCount; ++i)
+		{
+			minIndex = std::min(minIndex, indices[i]);
+			maxIndex = std::max(maxIndex, indices[i]);
+		}
+		return GnmIndexRange{ minIndex, maxIndex };
+	}
+
+	static inline GnmIndexRange mergeRanges(GnmIndexRange a, GnmIndexRange b)
+	{
+		return GnmIndexRange{ std::min(a.minIndex, b.minIndex), std::max(a.maxIndex, b.maxIndex) };
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// SSE2
+	//
+	// SSE2 only has signed 16 bit min/max, unsigned indices
+	// are biased into the signed range by flipping the sign bit.
+
+	static GnmIndexRange scanIndices16Sse2(const void* data, uint32_t indexCount)
+	{
+		const uint16_t* indices = reinterpret_cast<const uint16_t*>(data);
+
+		GnmIndexRange range = scanIndicesScalar(indices, std::min(indexCount, 8u));
+		if (indexCount > 8)
+		{
+			const __m128i bias   = _mm_set1_epi16(int16_t(0x8000));
+			__m128i       first  = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices)), bias);
+			__m128i       minVec = first;
+			__m128i       maxVec = first;
+
+			uint32_t i = 8;
+			for (; i + 8 <= indexCount; i += 8)
+			{
+				__m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i)), bias);
+				minVec    = _mm_min_epi16(minVec, v);
+				maxVec    = _mm_max_epi16(maxVec, v);
+			}
+
+			alignas(16) uint16_t mins[8];
+			alignas(16) uint16_t maxs[8];
+			_mm_store_si128(reinterpret_cast<__m128i*>(mins), _mm_xor_si128(minVec, bias));
+			_mm_store_si128(reinterpret_cast<__m128i*>(maxs), _mm_xor_si128(maxVec, bias));
+			range = mergeRanges(range, GnmIndexRange{ *std::min_element(mins, mins + 8),
+													  *std::max_element(maxs, maxs + 8) });
+
+			if (i < indexCount)
+			{
+				range = mergeRanges(range, scanIndicesScalar(indices + i, indexCount - i));
+			}
+		}
+		return range;
+	}
+
+	static GnmIndexRange scanIndices32Sse2(const void* data, uint32_t indexCount)
+	{
+		const uint32_t* indices = reinterpret_cast<const uint32_t*>(data);
+
+		GnmIndexRange range = scanIndicesScalar(indices, std::min(indexCount, 4u));
+		if (indexCount > 4)
+		{
+			const __m128i bias   = _mm_set1_epi32(int32_t(0x80000000));
+			__m128i       first  = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices)), bias);
+			__m128i       minVec = first;
+			__m128i       maxVec = first;
+
+			uint32_t i = 4;
+			for (; i + 4 <= indexCount; i += 4)
+			{
+				__m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i)), bias);
+
+				// No 32 bit min/max before SSE4.1, select with compares.
+				__m128i less    = _mm_cmplt_epi32(v, minVec);
+				__m128i greater = _mm_cmpgt_epi32(v, maxVec);
+				minVec          = _mm_or_si128(_mm_and_si128(less, v), _mm_andnot_si128(less, minVec));
+				maxVec          = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, maxVec));
+			}
+
+			alignas(16) uint32_t mins[4];
+			alignas(16) uint32_t maxs[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(mins), _mm_xor_si128(minVec, bias));
+			_mm_store_si128(reinterpret_cast<__m128i*>(maxs), _mm_xor_si128(maxVec, bias));
+			range = mergeRanges(range, GnmIndexRange{ *std::min_element(mins, mins + 4),
+													  *std::max_element(maxs, maxs + 4) });
+
+			if (i < indexCount)
+			{
+				range = mergeRanges(range, scanIndicesScalar(indices + i, indexCount - i));
+			}
+		}
+		return range;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// AVX2
+	//
+	// Unsigned min/max of 16 or 8 indices at once,
+	// two accumulators to hide the instruction latency.
+
+	INDEX_SCAN_TARGET_AVX2 static GnmIndexRange scanIndices16Avx2(const void* data, uint32_t indexCount)
+	{
+		const uint16_t* indices = reinterpret_cast<const uint16_t*>(data);
+
+		GnmIndexRange range = scanIndicesScalar(indices, std::min(indexCount, 16u));
+		if (indexCount > 16)
+		{
+			__m256i first   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices));
+			__m256i minVec0 = first;
+			__m256i maxVec0 = first;
+			__m256i minVec1 = first;
+			__m256i maxVec1 = first;
+
+			uint32_t i = 16;
+			for (; i + 32 <= indexCount; i += 32)
+			{
+				__m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+				__m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i + 16));
+				minVec0    = _mm256_min_epu16(minVec0, v0);
+				maxVec0    = _mm256_max_epu16(maxVec0, v0);
+				minVec1    = _mm256_min_epu16(minVec1, v1);
+				maxVec1    = _mm256_max_epu16(maxVec1, v1);
+			}
+			for (; i + 16 <= indexCount; i += 16)
+			{
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+				minVec0   = _mm256_min_epu16(minVec0, v);
+				maxVec0   = _mm256_max_epu16(maxVec0, v);
+			}
+
+			__m256i minVec = _mm256_min_epu16(minVec0, minVec1);
+			__m256i maxVec = _mm256_max_epu16(maxVec0, maxVec1);
+			__m128i min128 = _mm_min_epu16(_mm256_castsi256_si128(minVec), _mm256_extracti128_si256(minVec, 1));
+			__m128i max128 = _mm_max_epu16(_mm256_castsi256_si128(maxVec), _mm256_extracti128_si256(maxVec, 1));
+
+			// phminposuw finds the minimum of 8 words, the
+			// maximum is the minimum of the complement.
+			uint32_t minIndex = uint32_t(_mm_cvtsi128_si32(_mm_minpos_epu16(min128))) & 0xFFFF;
+			uint32_t maxIndex = ~uint32_t(_mm_cvtsi128_si32(_mm_minpos_epu16(
+									_mm_xor_si128(max128, _mm_set1_epi16(-1))))) & 0xFFFF;
+			range = mergeRanges(range, GnmIndexRange{ minIndex, maxIndex });
+
+			if (i < indexCount)
+			{
+				range = mergeRanges(range, scanIndicesScalar(indices + i, indexCount - i));
+			}
+		}
+		return range;
+	}
+
+	INDEX_SCAN_TARGET_AVX2 static GnmIndexRange scanIndices32Avx2(const void* data, uint32_t indexCount)
+	{
+		const uint32_t* indices = reinterpret_cast<const uint32_t*>(data);
+
+		GnmIndexRange range = scanIndicesScalar(indices, std::min(indexCount, 8u));
+		if (indexCount > 8)
+		{
+			__m256i first   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices));
+			__m256i minVec0 = first;
+			__m256i maxVec0 = first;
+			__m256i minVec1 = first;
+			__m256i maxVec1 = first;
+
+			uint32_t i = 8;
+			for (; i + 16 <= indexCount; i += 16)
+			{
+				__m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+				__m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i + 8));
+				minVec0    = _mm256_min_epu32(minVec0, v0);
+				maxVec0    = _mm256_max_epu32(maxVec0, v0);
+				minVec1    = _mm256_min_epu32(minVec1, v1);
+				maxVec1    = _mm256_max_epu32(maxVec1, v1);
+			}
+			for (; i + 8 <= indexCount; i += 8)
+			{
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+				minVec0   = _mm256_min_epu32(minVec0, v);
+				maxVec0   = _mm256_max_epu32(maxVec0, v);
+			}
+
+			__m256i minVec = _mm256_min_epu32(minVec0, minVec1);
+			__m256i maxVec = _mm256_max_epu32(maxVec0, maxVec1);
+			__m128i min128 = _mm_min_epu32(_mm256_castsi256_si128(minVec), _mm256_extracti128_si256(minVec, 1));
+			__m128i max128 = _mm_max_epu32(_mm256_castsi256_si128(maxVec), _mm256_extracti128_si256(maxVec, 1));
+			min128         = _mm_min_epu32(min128, _mm_shuffle_epi32(min128, _MM_SHUFFLE(1, 0, 3, 2)));
+			max128         = _mm_max_epu32(max128, _mm_shuffle_epi32(max128, _MM_SHUFFLE(1, 0, 3, 2)));
+			min128         = _mm_min_epu32(min128, _mm_shuffle_epi32(min128, _MM_SHUFFLE(2, 3, 0, 1)));
+			max128         = _mm_max_epu32(max128, _mm_shuffle_epi32(max128, _MM_SHUFFLE(2, 3, 0, 1)));
+
+			range = mergeRanges(range, GnmIndexRange{ uint32_t(_mm_cvtsi128_si32(min128)),
+													  uint32_t(_mm_cvtsi128_si32(max128)) });
+
+			if (i < indexCount)
+			{
+				range = mergeRanges(range, scanIndicesScalar(indices + i, indexCount - i));
+			}
+		}
+		return range;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	GnmIndexRange scanIndexRange(
+		const void* indices,
+		uint32_t    indexCount,
+		VkIndexType indexType)
+	{
+		static const bool hasAvx2 = plat::GetCpuFeatures().avx2;
+
+		GnmIndexRange range = {};
+		do
+		{
+			if (indexCount == 0)
+			{
+				break;
+			}
+
+			PFN_scanIndices scan = nullptr;
+			switch (indexType)
+			{
+				case VK_INDEX_TYPE_UINT16:
+					scan = hasAvx2 ? scanIndices16Avx2 : scanIndices16Sse2;
+					break;
+				case VK_INDEX_TYPE_UINT32:
+					scan = hasAvx2 ? scanIndices32Avx2 : scanIndices32Sse2;
+					break;
+				default:
+					LOG_ERR("index type %d not supported.", indexType);
+					break;
+			}
+
+			if (scan != nullptr)
+			{
+				range = scan(indices, indexCount);
+			}
+		} while (false);
+		return range;
+	}
+
+}  // namespace sce::Gnm
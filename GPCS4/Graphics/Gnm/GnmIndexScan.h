@@ -0,0 +1,37 @@
+#pragma once
+
+#include "GnmCommon.h"
+
+namespace sce::Gnm
+{
+	/**
+	 * \brief Range of vertices referenced by indices
+	 */
+	struct GnmIndexRange
+	{
+		uint32_t minIndex = 0;
+		uint32_t maxIndex = 0;
+
+		uint32_t vertexCount() const
+		{
+			return maxIndex - minIndex + 1;
+		}
+	};
+
+	/**
+	 * \brief Finds the smallest and largest index
+	 *
+	 * Scans 16 or 32 bit indices with SIMD min/max,
+	 * using AVX2 if the CPU supports it.
+	 * \param [in] indices Index data
+	 * \param [in] indexCount Number of indices
+	 * \param [in] indexType Index type
+	 * \returns Referenced range, \c [0, 0] if
+	 *          \c indexCount is zero
+	 */
+	GnmIndexRange scanIndexRange(
+		const void* indices,
+		uint32_t    indexCount,
+		VkIndexType indexType);
+
+}  // namespace sce::Gnm
@@ -1,11 +1,16 @@
 #include "GnmInitializer.h"
 
+#include "GnmBcDecoder.h"
 #include "GnmBuffer.h"
+#include "GnmConverter.h"
 #include "GnmTexture.h"
 
 #include "Violet/VltDevice.h"
 #include "Violet/VltContext.h"
 
+#include <algorithm>
+#include <vector>
+
 using namespace sce::vlt;
 
 LOG_CHANNEL(Graphic.Gnm.GnmInitializer);
@@ -61,9 +66,9 @@ namespace sce::Gnm
 		m_transferMemory += bufferSlice.length();
 		m_transferCommands += 1;
 
-		m_context->uploadBuffer(
-			bufferSlice.buffer(),
-			vsharp->getBaseAddress());
+		void* stagingData = m_context->mapBufferUpload(
+			bufferSlice.buffer());
+		copyBufferData(stagingData, vsharp, bufferSlice.length());
 
 		flushImplicit();
 	}
@@ -78,9 +83,9 @@ namespace sce::Gnm
 
 		if (vsharp != nullptr && vsharp->getBaseAddress())
 		{
-			std::memcpy(
+			copyBufferData(
 				bufferSlice.mapPtr(0),
-				vsharp->getBaseAddress(),
+				vsharp,
 				vsharp->getSize());
 		}
 		else
@@ -91,16 +96,61 @@ namespace sce::Gnm
 		}
 	}
 
+	void GnmInitializer::copyBufferData(
+		void*         dst,
+		const Buffer* vsharp,
+		size_t        size)
+	{
+		// Shaders address buffers linearly, so swizzled
+		// records are transposed back while copying.
+		int32_t status = GpuAddress::kStatusInvalidArgument;
+		if (vsharp->isSwizzled() && vsharp->getStride() != 0)
+		{
+			status = GpuAddress::deswizzleBufferData(
+				kGpuModeBase,
+				dst,
+				vsharp->getBaseAddress(),
+				vsharp->getStride(),
+				vsharp->getNumElements(),
+				vsharp->getSwizzleElementSize(),
+				vsharp->getSwizzleStride());
+		}
+
+		if (status != GpuAddress::kStatusSuccess)
+		{
+			std::memcpy(dst, vsharp->getBaseAddress(), size);
+		}
+	}
+
 	void GnmInitializer::initDeviceLocalTexture(
 		const Rc<VltImage>& image, const Texture* tsharp)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
 
-		auto           formatInfo      = imageFormatInfo(image->info().format);
-		auto           textureFormat   = tsharp->getDataFormat();
-		uint32_t       bytesPerElement = textureFormat.getTotalBytesPerElement();
-		bool           isCompressed    = textureFormat.isBlockCompressedFormat();
-		const uint8_t* textureMem      = reinterpret_cast<uint8_t*>(tsharp->getBaseAddress());
+		auto           formatInfo = imageFormatInfo(image->info().format);
+		const uint8_t* textureMem = reinterpret_cast<uint8_t*>(tsharp->getBaseAddress());
+
+		// Block compressed textures the device can't sample are
+		// created with the decoded format. Their blocks are detiled
+		// into scratch memory and decoded into staging memory.
+		VkFormat srcFormat     = cvt::convertDataFormat(tsharp->getDataFormat());
+		VkFormat decodedFormat = cvt::getDecodedFormat(srcFormat);
+		bool     isDecoded     = decodedFormat != VK_FORMAT_UNDEFINED && decodedFormat == image->info().format;
+		auto     srcFormatInfo = isDecoded ? imageFormatInfo(srcFormat) : formatInfo;
+
+		struct DecodeJob
+		{
+			void*       dst;
+			const void* src;
+			VkExtent3D  extent;
+		};
+		std::vector<std::vector<uint8_t>> blockData;
+		std::vector<DecodeJob>            decodeJobs;
+
+		// Tiled subresources are detiled together once all
+		// of them are mapped, so big mip chains and arrays
+		// are spread over the worker pool.
+		std::vector<GpuAddress::DetileRegionJob> detileJobs;
 
 		for (uint32_t layer = 0; layer < image->info().numLayers; layer++)
 		{
@@ -112,20 +162,12 @@ namespace sce::Gnm
 				subresourceLayers.baseArrayLayer = layer;
 				subresourceLayers.layerCount     = 1;
 
-				GpuAddress::TilingParameters params;
-				params.initFromTexture(tsharp, level, layer);
-				GpuAddress::SurfaceInfo surfaceInfo;
-				GpuAddress::computeSurfaceInfo(&surfaceInfo, &params);
-
-				VkOffset3D mipLevelOffset = { 0, 0, 0 };
 				VkExtent3D mipLevelExtent = image->mipLevelExtent(level);
 
 				m_transferCommands += 1;
 				m_transferMemory += vutil::computeImageDataSize(
 					image->info().format, mipLevelExtent);
 
-				uint32_t elementPerRow = isCompressed ? surfaceInfo.m_pitch / 4 : surfaceInfo.m_pitch;
-				uint32_t pitchInBytes  = elementPerRow * bytesPerElement;
 				if (formatInfo->aspectMask != (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT))
 				{
 					uint64_t surfaceOffset = 0;
@@ -134,11 +176,27 @@ namespace sce::Gnm
 						&surfaceOffset, &surfaceSize, tsharp, level, layer);
 					const void* memory = textureMem + surfaceOffset;
 
-					m_context->uploadImage(
-						image, subresourceLayers,
-						memory,
-						pitchInBytes,
-						surfaceInfo.m_surfaceSize);
+					void* stagingData = m_context->mapImageUpload(
+						image, subresourceLayers);
+
+					VkExtent3D blockCount = vutil::computeBlockCount(
+						mipLevelExtent, srcFormatInfo->blockSize);
+
+					void* subresourceData = stagingData;
+					if (isDecoded)
+					{
+						auto& blocks = blockData.emplace_back(
+							size_t(blockCount.width) * blockCount.height * blockCount.depth *
+							srcFormatInfo->elementSize);
+						subresourceData = blocks.data();
+						decodeJobs.push_back({ stagingData, blocks.data(), mipLevelExtent });
+					}
+
+					prepareSubresource(
+						subresourceData, memory,
+						tsharp, level, layer,
+						blockCount, srcFormatInfo,
+						detileJobs);
 				}
 				else
 				{
@@ -155,9 +213,77 @@ namespace sce::Gnm
 			}
 		}
 
+		if (!detileJobs.empty())
+		{
+			int32_t status = GpuAddress::detileSurfaceRegions(
+				detileJobs.data(), uint32_t(detileJobs.size()));
+			if (status != GpuAddress::kStatusSuccess)
+			{
+				LOG_ERR("detile texture %p failed %d.",
+						tsharp->getBaseAddress(), status);
+			}
+		}
+
+		for (const auto& job : decodeJobs)
+		{
+			bc::decodeImage(cvt::convertBlockFormat(srcFormat), job.dst, job.src,
+							job.extent.width, job.extent.height, job.extent.depth);
+		}
+
 		flushImplicit();
 	}
 
+	void GnmInitializer::prepareSubresource(
+		void*                                     dst,
+		const void*                               src,
+		const Texture*                            tsharp,
+		uint32_t                                  level,
+		uint32_t                                  layer,
+		VkExtent3D                                blockCount,
+		const vlt::VltFormatInfo*                 formatInfo,
+		std::vector<GpuAddress::DetileRegionJob>& detileJobs)
+	{
+		GpuAddress::TilingParameters params;
+		params.initFromTexture(tsharp, level, layer);
+		GpuAddress::SurfaceInfo surfaceInfo;
+		GpuAddress::computeSurfaceInfo(&surfaceInfo, &params);
+
+		// Small mip levels of tiled textures may be linear,
+		// so check the array mode actually used by the level.
+		bool isLinear = surfaceInfo.m_arrayMode == kArrayModeLinearGeneral ||
+						surfaceInfo.m_arrayMode == kArrayModeLinearAligned;
+		if (isLinear)
+		{
+			// Linear surfaces only differ from packed data in
+			// row padding, copy rows from guest memory directly,
+			// or the whole surface at once if there is no padding.
+			VkDeviceSize rowPitch   = (surfaceInfo.m_pitch / formatInfo->blockSize.width) * formatInfo->elementSize;
+			VkDeviceSize slicePitch = surfaceInfo.m_surfaceSize / std::max(surfaceInfo.m_depth, 1u);
+
+			vutil::packImageData(dst, src,
+								 blockCount, formatInfo->elementSize,
+								 rowPitch, slicePitch);
+		}
+		else
+		{
+			// Detile straight into staging memory,
+			// the region and pitches are in blocks.
+			GpuAddress::DetileRegionJob job;
+			job.m_outUntiledSurface  = dst;
+			job.m_tiledSurface       = src;
+			job.m_tp                 = params;
+			job.m_srcRegion.m_left   = 0;
+			job.m_srcRegion.m_top    = 0;
+			job.m_srcRegion.m_front  = 0;
+			job.m_srcRegion.m_right  = blockCount.width;
+			job.m_srcRegion.m_bottom = blockCount.height;
+			job.m_srcRegion.m_back   = blockCount.depth;
+			job.m_destPitch          = blockCount.width;
+			job.m_destSlicePitch     = blockCount.width * blockCount.height;
+			detileJobs.push_back(job);
+		}
+	}
+
 	void GnmInitializer::initHostVisibleTexture(
 		const Rc<VltImage>& image, const Texture* tsharp)
 	{
@@ -5,6 +5,7 @@
 #include "Violet/VltRc.h"
 
 #include <mutex>
+#include <vector>
 
 namespace sce::vlt
 {
@@ -12,9 +13,15 @@ namespace sce::vlt
 	class VltContext;
 	class VltBuffer;
 	class VltImage;
+	struct VltFormatInfo;
 	enum class VltQueueType : uint32_t;
 }  // namespace sce::vlt
 
+namespace sce::GpuAddress
+{
+	struct DetileRegionJob;
+}  // namespace sce::GpuAddress
+
 namespace sce::Gnm
 {
 	class Buffer;
@@ -50,6 +57,11 @@ namespace sce::Gnm
 			const vlt::Rc<vlt::VltBuffer>& buffer,
 			const Buffer*                  vsharp);
 
+		void copyBufferData(
+			void*         dst,
+			const Buffer* vsharp,
+			size_t        size);
+
 		void initDeviceLocalTexture(
 			const vlt::Rc<vlt::VltImage>& image,
 			const Texture*                tsharp);
@@ -58,6 +70,16 @@ namespace sce::Gnm
 			const vlt::Rc<vlt::VltImage>& image,
 			const Texture*                tsharp);
 
+		void prepareSubresource(
+			void*                                     dst,
+			const void*                               src,
+			const Texture*                            tsharp,
+			uint32_t                                  level,
+			uint32_t                                  layer,
+			VkExtent3D                                blockCount,
+			const vlt::VltFormatInfo*                 formatInfo,
+			std::vector<GpuAddress::DetileRegionJob>& detileJobs);
+
 		void flushImplicit();
 		void flushInternal();
 
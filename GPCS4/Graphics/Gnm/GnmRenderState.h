@@ -1,5 +1,6 @@
 #pragma once
 
+#include "GnmBuffer.h"
 #include "GnmCommon.h"
 #include "GnmConstant.h"
 #include "GnmStructure.h"
@@ -7,6 +8,7 @@
 #include "Gcn/GcnConstants.h"
 #include "Gcn/GcnShaderMeta.h"
 #include "Gcn/GcnModule.h"
+#include "Violet/VltLimit.h"
 
 #include <array>
 
@@ -46,11 +48,26 @@ namespace sce::Gnm
 		gcn::GcnShaderMeta meta     = {};
 	};
 
+	/**
+	 * \brief Vertex buffer of the vertex shader
+	 *
+	 * Bound at draw time, once the index range
+	 * of the draw tells which vertices to upload.
+	 */
+	struct GnmVertexBufferBinding
+	{
+		Buffer   vsharp;
+		uint32_t binding;
+	};
+
 	struct GnmInputAssemblerState
 	{
-		vlt::Rc<vlt::VltBuffer> indexBuffer = nullptr;
-		VkIndexType             indexType   = VK_INDEX_TYPE_UINT32;
-		VkPrimitiveTopology     topology    = VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
+		PrimitiveType       primType  = kPrimitiveTypeNone;
+		VkIndexType         indexType = VK_INDEX_TYPE_UINT32;
+		VkPrimitiveTopology topology  = VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
+
+		std::array<GnmVertexBufferBinding, gcn::kMaxVertexBufferCount> vertexBuffers     = {};
+		uint32_t                                                      vertexBufferCount = 0;
 	};
 
 	struct GnmDepthStencilState
@@ -62,6 +79,8 @@ namespace sce::Gnm
 	{
 		// Display buffer back render target
 		SceResource* displayRenderTarget = nullptr;
+		// Tracked resources of the bound color targets
+		std::array<SceResource*, vlt::MaxNumRenderTargets> renderTargets = {};
 	};
 
 	struct GnmGraphicsState
@@ -77,4 +96,62 @@ namespace sce::Gnm
 	{
 		GnmShaderContext shaderContext = {};
 	};
+
+	/**
+	 * \brief Draw state fingerprint
+	 *
+	 * Everything a draw takes from the Gnm state
+	 * which is not already forwarded to the context
+	 * at the time it is set. Two consecutive draws
+	 * with equal fingerprints only differ in their
+	 * index range and can be merged.
+	 *
+	 * Resources are read through the user data of
+	 * each stage, so equal user data means the draws
+	 * bind the same resources.
+	 */
+	struct GnmDrawFingerprint
+	{
+		std::array<const void*, kShaderStageCount>   code         = {};
+		std::array<UserDataArray, kShaderStageCount> userData     = {};
+		VkIndexType                                  indexType    = VK_INDEX_TYPE_UINT32;
+		PrimitiveType                                primType     = kPrimitiveTypeNone;
+		VkPrimitiveTopology                          topology     = VK_PRIMITIVE_TOPOLOGY_MAX_ENUM;
+		bool                                         dbClearDepth = false;
+		SceResource*                                 displayRT    = nullptr;
+
+		bool operator==(const GnmDrawFingerprint& other) const
+		{
+			return code == other.code &&
+				   indexType == other.indexType &&
+				   primType == other.primType &&
+				   topology == other.topology &&
+				   dbClearDepth == other.dbClearDepth &&
+				   displayRT == other.displayRT &&
+				   userData == other.userData;
+		}
+	};
+
+	/**
+	 * \brief Indexed draw waiting to be merged
+	 */
+	struct GnmPendingDraw
+	{
+		const uint8_t* indexAddr;
+		uint32_t       indexCount;
+	};
+
+	/**
+	 * \brief Draw merge counters
+	 *
+	 * Indexed draws seen in the frame, how many of
+	 * them were merged, and the number of indirect
+	 * draws which have been emitted for them.
+	 */
+	struct GnmDrawMergeStats
+	{
+		uint32_t draws    = 0;
+		uint32_t merged   = 0;
+		uint32_t indirect = 0;
+	};
 }  // namespace sce::Gnm
\ No newline at end of file
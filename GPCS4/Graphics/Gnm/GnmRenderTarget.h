@@ -1,16 +1,22 @@
 #pragma once
 
-#include "GnmCommon.h"
+#include "GPCS4Common.h"
 #include "GnmConstant.h"
 #include "GnmDataFormat.h"
 #include "GnmRegInfo.h"
 #include "GnmStructure.h"
 #include "GpuAddress/GnmGpuAddress.h"
-#include "Emulator.h"
-#include "VirtualGPU.h"
 
 namespace sce::Gnm
 {
+	/**
+	 * \brief Global GPU mode
+	 *
+	 * Implemented on top of VirtualGPU::mode, declared
+	 * here so the address library doesn't depend on
+	 * the emulator.
+	 */
+	GpuMode getGpuMode();
 
 	union RenderTargetInitFlags
 	{
@@ -43,7 +49,7 @@ namespace sce::Gnm
                                               kTextureChannelConstant0,
                                               kTextureChannelConstant0);
 			m_colorTileModeHint = kTileModeDisplay_LinearAligned;
-			m_minGpuMode        = GPU().mode();
+			m_minGpuMode        = getGpuMode();
 			m_numSlices         = kNumSamples1;
 			m_numFragments      = kNumFragments1;
 			m_flags.asInt       = 0;
@@ -119,7 +125,7 @@ namespace sce::Gnm
 
 				memset(this, 0, sizeof(RenderTarget));
 
-				if (GPU().mode() != kGpuModeNeo || spec->m_minGpuMode == kGpuModeNeo)
+				if (getGpuMode() != kGpuModeNeo || spec->m_minGpuMode == kGpuModeNeo)
 				{
 					if (spec->m_minGpuMode == kGpuModeNeo)
 					{
@@ -175,7 +181,7 @@ namespace sce::Gnm
 				m_regs[5] = (m_regs[5] & 0xFFFE0FFF) | ((spec->m_numSamples & 7) << 12) | ((spec->m_numFragments & 3) << 15);
 
 				m_regs[1] = (unsigned int)(m_regs[1] & 0x800FF800) |
-							(((unsigned __int16)(surfaceInfo.m_pitch >> 3) + 0x7FF) & 0x7FF) |
+							(((uint16_t)(surfaceInfo.m_pitch >> 3) + 0x7FF) & 0x7FF) |
 							(((surfaceInfo.m_pitch >> 3 << 20) + 0x7FF00000) & 0x7FF00000);
 
 				uint32_t v21 = (surfaceInfo.m_pitch * surfaceInfo.m_height >> 6) + 0x3FFFFF;
@@ -193,7 +199,7 @@ namespace sce::Gnm
 					initFmaskForTarget();
 				}
 
-				if (GPU().mode() == kGpuModeNeo &&
+				if (getGpuMode() == kGpuModeNeo &&
 					(*(uint8_t*)&spec->m_flags & 0x10))
 				{
 					*((uint8_t*)m_regs + 0x13) |= 0x10u;
@@ -229,7 +235,7 @@ namespace sce::Gnm
 			int                      v4;  // er15
 			RenderTargetChannelOrder order;  // [rsp+0h] [rbp-40h]
 			RenderTargetChannelType  type;  // [rsp+4h] [rbp-3Ch]
-			__int64                  v9;  // [rsp+10h] [rbp-30h]
+			int64_t                  v9;  // [rsp+10h] [rbp-30h]
 
 			bool typeConvertable = format.getRenderTargetChannelType(&type);
 			
@@ -497,7 +503,7 @@ namespace sce::Gnm
 
 		bool getLinearCmask(void) const
 		{
-			if (GPU().mode() == kGpuModeNeo)
+			if (getGpuMode() == kGpuModeNeo)
 				return SCE_GNM_GET_FIELD(m_regs[kCbColorInfo], CB_COLOR0_INFO, CMASK_ADDR_TYPE) == 1;  // [vi]
 			else
 				return SCE_GNM_GET_FIELD(m_regs[kCbColorInfo], CB_COLOR0_INFO, CMASK_IS_LINEAR) == 1;
@@ -4,6 +4,8 @@
 #include "GnmConverter.h"
 #include "GnmDepthRenderTarget.h"
 #include "Sce/SceResourceTracker.h"
+#include "Sce/SceSamplerCache.h"
+#include "Violet/VltAdapter.h"
 #include "Violet/VltDevice.h"
 #include "Violet/VltBuffer.h"
 #include "Violet/VltImage.h"
@@ -80,7 +82,7 @@ namespace sce::Gnm
 		imageInfo.extent      = { target->getWidth(), target->getHeight(), 1 };
 		imageInfo.numLayers   = 1;
 		imageInfo.mipLevels   = 1;
-		imageInfo.usage       = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		imageInfo.usage       = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 		imageInfo.stages      = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
 		imageInfo.access      = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
 		imageInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
@@ -137,12 +139,15 @@ namespace sce::Gnm
 			default: flags = 0; break;
 		}
 
-		uint32_t mipLevelCount = tsharp->getLastMipLevel() - tsharp->getBaseMipLevel() + 1;
-		uint32_t sliceCount = tsharp->getLastArraySliceIndex() - tsharp->getBaseArraySliceIndex() + 1;
+		// The image holds the whole mip chain and array up to
+		// the last level and slice, so that T#s selecting
+		// different ranges of it can share the image.
+		uint32_t mipLevelCount = tsharp->getLastMipLevel() + 1;
+		uint32_t sliceCount    = tsharp->getLastArraySliceIndex() + 1;
 
 		VltImageCreateInfo imageInfo;
 		imageInfo.type        = cvt::convertTextureType(textureType);
-		imageInfo.format      = cvt::convertDataFormat(tsharp->getDataFormat());
+		imageInfo.format      = getTextureFormat(tsharp);
 		imageInfo.flags       = flags;
 		imageInfo.sampleCount = cvt::convertNumFragments(tsharp->getNumFragments());
 		imageInfo.extent      = { tsharp->getWidth(), tsharp->getHeight(), tsharp->getDepth() };
@@ -154,26 +159,95 @@ namespace sce::Gnm
 		imageInfo.tiling      = createInfo.tiling;
 		imageInfo.layout      = createInfo.layout;
 
+		sceTexture.image   = m_device->createImage(imageInfo, createInfo.memoryType);
+		sceTexture.texture = *tsharp;
+
+		return createImageView(tsharp, sceTexture.image, sceTexture.imageView);
+	}
+
+	bool GnmResourceFactory::createImageView(
+		const Texture*       tsharp,
+		const Rc<VltImage>&  image,
+		Rc<VltImageView>&    imageView)
+	{
 		VltImageViewCreateInfo viewInfo;
-		viewInfo.type      = cvt::convertTextureTypeView(textureType);
-		viewInfo.format    = imageInfo.format;
-		viewInfo.usage     = imageInfo.usage;
+		viewInfo.type      = cvt::convertTextureTypeView(tsharp->getTextureType());
+		viewInfo.format    = getTextureFormat(tsharp);
+		viewInfo.usage     = image->info().usage;
 		viewInfo.aspect    = VK_IMAGE_ASPECT_COLOR_BIT;
 		viewInfo.minLevel  = tsharp->getBaseMipLevel();
-		viewInfo.numLevels = mipLevelCount;
+		viewInfo.numLevels = tsharp->getLastMipLevel() - tsharp->getBaseMipLevel() + 1;
 		viewInfo.minLayer  = tsharp->getBaseArraySliceIndex();
-		viewInfo.numLayers = sliceCount;
+		viewInfo.numLayers = tsharp->getLastArraySliceIndex() - tsharp->getBaseArraySliceIndex() + 1;
+
+		imageView = m_device->createImageView(image, viewInfo);
+		return imageView != nullptr;
+	}
 
-		sceTexture.image     = m_device->createImage(imageInfo, createInfo.memoryType);
-		sceTexture.imageView = m_device->createImageView(sceTexture.image, viewInfo);
-		sceTexture.texture   = *tsharp;
+	bool GnmResourceFactory::isImageCompatible(
+		const GnmImageCreateInfo& createInfo,
+		const SceTexture&         sceTexture)
+	{
+		auto& info = sceTexture.image->info();
+		auto  lhs  = createInfo.tsharp;
+		auto& rhs  = sceTexture.texture;
 
-		return true;
+		// Channel select is folded into the Vulkan format,
+		// comparing formats covers it.
+		return lhs->getBaseAddress() == rhs.getBaseAddress() &&
+			   lhs->getTextureType() == rhs.getTextureType() &&
+			   lhs->getWidth() == rhs.getWidth() &&
+			   lhs->getHeight() == rhs.getHeight() &&
+			   lhs->getDepth() == rhs.getDepth() &&
+			   lhs->getPitch() == rhs.getPitch() &&
+			   lhs->getTileMode() == rhs.getTileMode() &&
+			   lhs->isPaddedToPow2() == rhs.isPaddedToPow2() &&
+			   lhs->getNumFragments() == rhs.getNumFragments() &&
+			   lhs->getLastMipLevel() == rhs.getLastMipLevel() &&
+			   lhs->getLastArraySliceIndex() == rhs.getLastArraySliceIndex() &&
+			   getTextureFormat(lhs) == info.format &&
+			   (info.usage & createInfo.usage) == createInfo.usage &&
+			   info.tiling == createInfo.tiling &&
+			   info.layout == createInfo.layout;
+	}
+
+	VkFormat GnmResourceFactory::getTextureFormat(
+		const Texture* tsharp)
+	{
+		VkFormat format        = cvt::convertDataFormat(tsharp->getDataFormat());
+		VkFormat decodedFormat = cvt::getDecodedFormat(format);
+		if (decodedFormat != VK_FORMAT_UNDEFINED)
+		{
+			VkFormatProperties properties = m_device->adapter()->formatProperties(format);
+			if (!(properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+			{
+				format = decodedFormat;
+			}
+		}
+		return format;
 	}
 
 	bool GnmResourceFactory::createSampler(
 		const Sampler* ssharp,
 		SceSampler&    sampler)
+	{
+		// Samplers are shared by all S# which
+		// differ only in unused fields.
+		auto&         cache = GPU().samplerCache();
+		SceSamplerKey key(*ssharp);
+
+		sampler.ssharp  = *ssharp;
+		sampler.sampler = cache.find(key);
+		if (sampler.sampler == nullptr)
+		{
+			sampler.sampler = cache.add(key, createSamplerObject(ssharp));
+		}
+
+		return sampler.sampler != nullptr;
+	}
+
+	Rc<VltSampler> GnmResourceFactory::createSamplerObject(
+		const Sampler* ssharp)
 	{
 		DepthCompare depthComp = ssharp->getDepthCompareFunction();
 
@@ -200,10 +274,7 @@ namespace sce::Gnm
 		samplerInfo.borderColor    = s_borderColors[ssharp->getBorderColor()];
 		samplerInfo.usePixelCoord  = ssharp->getForceUnnormalized();
 
-		sampler.sampler = m_device->createSampler(samplerInfo);
-		sampler.ssharp  = *ssharp;
-
-		return true;
+		return m_device->createSampler(samplerInfo);
 	}
 
 
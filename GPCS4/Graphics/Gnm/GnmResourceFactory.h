@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GnmCommon.h"
+#include "Violet/VltRc.h"
 
 namespace sce
 {
@@ -13,6 +14,9 @@ namespace sce
 	namespace vlt
 	{
 		class VltDevice;
+		class VltImage;
+		class VltImageView;
+		class VltSampler;
 		struct VltBufferCreateInfo;
 	}  // namespace vlt
 
@@ -58,6 +62,22 @@ namespace sce
 				const GnmImageCreateInfo& createInfo,
 				SceTexture&               sceTexture);
 
+			bool createImageView(
+				const Texture*                tsharp,
+				const vlt::Rc<vlt::VltImage>& image,
+				vlt::Rc<vlt::VltImageView>&   imageView);
+
+			/**
+			 * \brief Whether an existing texture image can be reused
+			 *
+			 * True if the image created for a previous T# has
+			 * the same memory layout, format and usage as the
+			 * one to create. Views are not considered.
+			 */
+			bool isImageCompatible(
+				const GnmImageCreateInfo& createInfo,
+				const SceTexture&         sceTexture);
+
 			bool createDepthImage(
 				const DepthRenderTarget* depthTarget,
 				SceDepthRenderTarget&    depthImage);
@@ -70,6 +90,20 @@ namespace sce
 				const Sampler* ssharp,
 				SceSampler&    sampler);
 
+		private:
+			vlt::Rc<vlt::VltSampler> createSamplerObject(
+				const Sampler* ssharp);
+
+			/**
+			 * \brief Vulkan format of a texture image
+			 *
+			 * Block compressed formats the device can't
+			 * sample are replaced by their decoded format,
+			 * the initializer then decodes on upload.
+			 */
+			VkFormat getTextureFormat(
+				const Texture* tsharp);
+
 		private:
 			vlt::VltDevice* m_device;
 		};
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "GnmCommon.h"
+#include "GPCS4Common.h"
 
 namespace sce::Gnm
 {
@@ -0,0 +1,10 @@
+#include "GnmStateFilter.h"
+
+#include "Violet/VltContext.h"
+
+namespace sce::Gnm
+{
+
+	template class GnmStateFilterT<vlt::VltContext>;
+
+}  // namespace sce::Gnm
@@ -0,0 +1,355 @@
+#pragma once
+
+#include "GnmCommon.h"
+
+#include "Violet/VltConstantState.h"
+#include "Violet/VltLimit.h"
+
+#include <array>
+#include <cstring>
+#include <functional>
+
+namespace sce::vlt
+{
+	class VltContext;
+}  // namespace sce::vlt
+
+namespace sce::Gnm
+{
+	/**
+	 * \brief State filter counters
+	 *
+	 * Number of state calls dropped because they
+	 * match the state already applied to the context,
+	 * versus those forwarded to the context.
+	 */
+	struct GnmStateFilterStats
+	{
+		uint32_t filtered = 0;
+		uint32_t applied  = 0;
+	};
+
+	/**
+	 * \brief Redundant state filter
+	 *
+	 * Games re-emit the same fixed function state
+	 * for almost every draw. Each of those calls would
+	 * dirty the pipeline state of the Violet context
+	 * and force a pipeline lookup on the next draw.
+	 *
+	 * This keeps a copy of the last state applied to
+	 * the context and only forwards calls which actually
+	 * change something.
+	 *
+	 * An optional hook is invoked right before a change
+	 * reaches the context, so that work recorded against
+	 * the old state (e.g. merged draws) can be flushed.
+	 *
+	 * The context type is a parameter so that tests can
+	 * record the calls which get through, the emulator
+	 * only uses \c GnmStateFilter below.
+	 */
+	template <typename Context>
+	class GnmStateFilterT
+	{
+		template <typename T>
+		struct CachedState
+		{
+			T    state = {};
+			bool valid = false;
+		};
+
+	public:
+		GnmStateFilterT(
+			Context*              context,
+			std::function<void()> onStateChange = nullptr);
+		~GnmStateFilterT();
+
+		void setInputAssemblyState(
+			const vlt::VltInputAssemblyState& ia);
+
+		void setRasterizerState(
+			const vlt::VltRasterizerState& rs);
+
+		void setMultisampleState(
+			const vlt::VltMultisampleState& ms);
+
+		void setDepthStencilState(
+			const vlt::VltDepthStencilState& ds);
+
+		void setLogicOpState(
+			const vlt::VltLogicOpState& lo);
+
+		void setBlendMode(
+			uint32_t                 attachment,
+			const vlt::VltBlendMode& blendMode);
+
+		void setBlendMask(
+			uint32_t              attachment,
+			VkColorComponentFlags writeMask);
+
+		void setViewport(
+			const VkViewport& viewport);
+
+		void setScissor(
+			const VkRect2D& scissor);
+
+		void setDepthBoundsTestEnable(
+			VkBool32 depthBoundsTestEnable);
+
+		void setDepthBoundsRange(
+			const vlt::VltDepthBoundsRange& depthBoundsRange);
+
+		/**
+		 * \brief Forgets all cached state
+		 *
+		 * Must be called if the context state is
+		 * modified without going through this filter.
+		 */
+		void invalidate();
+
+		/**
+		 * \brief Counters since last reset
+		 */
+		const GnmStateFilterStats& stats() const
+		{
+			return m_stats;
+		}
+
+		/**
+		 * \brief Resets the counters
+		 *
+		 * Called once per frame.
+		 */
+		void resetStats();
+
+	private:
+		template <typename T>
+		bool filter(CachedState<T>& cache, const T& state);
+
+	private:
+		Context*              m_context;
+		std::function<void()> m_onStateChange;
+		GnmStateFilterStats   m_stats;
+
+		CachedState<vlt::VltInputAssemblyState> m_ia;
+		CachedState<vlt::VltRasterizerState>    m_rs;
+		CachedState<vlt::VltMultisampleState>   m_ms;
+		CachedState<vlt::VltDepthStencilState>  m_ds;
+		CachedState<vlt::VltLogicOpState>       m_lo;
+		CachedState<VkViewport>                 m_viewport;
+		CachedState<VkRect2D>                   m_scissor;
+		CachedState<VkBool32>                   m_depthBoundsEnable;
+		CachedState<vlt::VltDepthBoundsRange>   m_depthBoundsRange;
+
+		std::array<CachedState<vlt::VltBlendMode>, vlt::MaxNumRenderTargets>    m_blend;
+		std::array<CachedState<VkColorComponentFlags>, vlt::MaxNumRenderTargets> m_blendMask;
+	};
+
+
+	template <typename Context>
+	GnmStateFilterT<Context>::GnmStateFilterT(
+		Context*              context,
+		std::function<void()> onStateChange) :
+		m_context(context),
+		m_onStateChange(std::move(onStateChange))
+	{
+	}
+
+	template <typename Context>
+	GnmStateFilterT<Context>::~GnmStateFilterT()
+	{
+	}
+
+	template <typename Context>
+	template <typename T>
+	bool GnmStateFilterT<Context>::filter(CachedState<T>& cache, const T& state)
+	{
+		// All the state structures are tightly packed
+		// 32 bit fields, so a plain memcmp is enough.
+		bool changed = !cache.valid ||
+					   std::memcmp(&cache.state, &state, sizeof(T)) != 0;
+		if (changed)
+		{
+			if (m_onStateChange)
+			{
+				m_onStateChange();
+			}
+
+			cache.state = state;
+			cache.valid = true;
+			++m_stats.applied;
+		}
+		else
+		{
+			++m_stats.filtered;
+		}
+		return changed;
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setInputAssemblyState(
+		const vlt::VltInputAssemblyState& ia)
+	{
+		if (filter(m_ia, ia))
+		{
+			m_context->setInputAssemblyState(ia);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setRasterizerState(
+		const vlt::VltRasterizerState& rs)
+	{
+		if (filter(m_rs, rs))
+		{
+			m_context->setRasterizerState(rs);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setMultisampleState(
+		const vlt::VltMultisampleState& ms)
+	{
+		if (filter(m_ms, ms))
+		{
+			m_context->setMultisampleState(ms);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setDepthStencilState(
+		const vlt::VltDepthStencilState& ds)
+	{
+		if (filter(m_ds, ds))
+		{
+			m_context->setDepthStencilState(ds);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setLogicOpState(
+		const vlt::VltLogicOpState& lo)
+	{
+		if (filter(m_lo, lo))
+		{
+			m_context->setLogicOpState(lo);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setBlendMode(
+		uint32_t                 attachment,
+		const vlt::VltBlendMode& blendMode)
+	{
+		if (filter(m_blend[attachment], blendMode))
+		{
+			// Blend mode overwrites the write mask too.
+			m_blendMask[attachment].state = blendMode.writeMask;
+			m_blendMask[attachment].valid = true;
+
+			m_context->setBlendMode(attachment, blendMode);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setBlendMask(
+		uint32_t              attachment,
+		VkColorComponentFlags writeMask)
+	{
+		if (filter(m_blendMask[attachment], writeMask))
+		{
+			// Keep the cached blend mode in sync with the
+			// context, so that a later blend mode call carrying
+			// the full mask is not filtered out by mistake.
+			m_blend[attachment].state.writeMask = writeMask;
+
+			m_context->setBlendMask(attachment, writeMask);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setViewport(
+		const VkViewport& viewport)
+	{
+		if (filter(m_viewport, viewport))
+		{
+			m_context->setViewports(1, &viewport);
+		}
+
+		// The context replaces a zero width viewport with
+		// a dummy one and an empty scissor rect, so neither
+		// cached value matches the context state anymore.
+		if (viewport.width == 0.0f)
+		{
+			m_viewport.valid = false;
+			m_scissor.valid  = false;
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setScissor(
+		const VkRect2D& scissor)
+	{
+		if (filter(m_scissor, scissor))
+		{
+			m_context->setScissors(1, &scissor);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setDepthBoundsTestEnable(
+		VkBool32 depthBoundsTestEnable)
+	{
+		if (filter(m_depthBoundsEnable, depthBoundsTestEnable))
+		{
+			m_context->setDepthBoundsTestEnable(depthBoundsTestEnable);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::setDepthBoundsRange(
+		const vlt::VltDepthBoundsRange& depthBoundsRange)
+	{
+		if (filter(m_depthBoundsRange, depthBoundsRange))
+		{
+			m_context->setDepthBoundsRange(depthBoundsRange);
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::invalidate()
+	{
+		m_ia.valid                = false;
+		m_rs.valid                = false;
+		m_ms.valid                = false;
+		m_ds.valid                = false;
+		m_lo.valid                = false;
+		m_viewport.valid          = false;
+		m_scissor.valid           = false;
+		m_depthBoundsEnable.valid = false;
+		m_depthBoundsRange.valid  = false;
+
+		for (auto& blend : m_blend)
+		{
+			blend.valid = false;
+		}
+
+		for (auto& mask : m_blendMask)
+		{
+			mask.valid = false;
+		}
+	}
+
+	template <typename Context>
+	void GnmStateFilterT<Context>::resetStats()
+	{
+		m_stats = GnmStateFilterStats();
+	}
+
+	using GnmStateFilter = GnmStateFilterT<vlt::VltContext>;
+
+	// Instantiated once in GnmStateFilter.cpp
+	extern template class GnmStateFilterT<vlt::VltContext>;
+
+}  // namespace sce::Gnm
@@ -10,6 +10,10 @@
 
 #include <cstring>
 
+namespace util
+{
+	class WorkerPool;
+}  // namespace util
 
 namespace sce
 {
@@ -628,6 +632,52 @@ namespace sce
 		 */
 		int32_t detileSurface(void *outUntiledSurface, const void *tiledSurface, const TilingParameters *tp);
 
+		/**
+		 * @brief Describes one surface region to detile with detileSurfaceRegions().
+		 *
+		 * The members match the arguments of detileSurfaceRegion().
+		 */
+		typedef struct DetileRegionJob
+		{
+			void *m_outUntiledSurface;    ///< The destination buffer that is to receive the de-tiled surface data.
+			const void *m_tiledSurface;   ///< The base address of the source-tiled surface data.
+			TilingParameters m_tp;        ///< The tiling parameters.
+			SurfaceRegion m_srcRegion;    ///< The bounds of the region in the source surface from which tiled data is read.
+			uint32_t m_destPitch;         ///< The pitch of the <c><i>m_outUntiledSurface</i></c> data, in pixels or elements.
+			uint32_t m_destSlicePitch;    ///< The size of one Z-slice of the <c><i>m_outUntiledSurface</i></c> data, in pixels or elements.
+		} DetileRegionJob;
+
+		/**
+		 * @brief Detiles many surface regions in parallel, for example all mip levels and array slices of a texture.
+		 *
+		 * Each region is split into bands of whole macro-tile rows (or slices, for volume surfaces), and the bands of all jobs
+		 * are detiled by the shared worker pool and the calling thread. The function returns once every band is done.
+		 * Destination buffers must be allocated by the caller and must not overlap each other.
+		 *
+		 * @param[in] jobs		The regions to detile. This pointer must not be <c>NULL</c> if <c><i>jobCount</i></c> is not <c>0</c>.
+		 * @param[in] jobCount	The number of entries in <c><i>jobs</i></c>.
+		 *
+		 * @return				A status code from GpuAddress::Status. If several bands fail, the status of one of them is returned.
+		 *
+		 * @sa     detileSurfaceRegion()
+		 */
+		int32_t detileSurfaceRegions(const DetileRegionJob *jobs, uint32_t jobCount);
+
+		/**
+		 * @brief Detiles many surface regions in parallel on a specific worker pool.
+		 *
+		 * Same as detileSurfaceRegions(), with the bands detiled by <c><i>pool</i></c> instead of the shared worker pool.
+		 *
+		 * @param[in] jobs		The regions to detile. This pointer must not be <c>NULL</c> if <c><i>jobCount</i></c> is not <c>0</c>.
+		 * @param[in] jobCount	The number of entries in <c><i>jobs</i></c>.
+		 * @param[in] pool		The worker pool which detiles the bands, together with the calling thread.
+		 *
+		 * @return				A status code from GpuAddress::Status. If several bands fail, the status of one of them is returned.
+		 *
+		 * @sa     detileSurfaceRegions()
+		 */
+		int32_t detileSurfaceRegions(const DetileRegionJob *jobs, uint32_t jobCount, util::WorkerPool &pool);
+
 		/////////////////////////////////////////////////////////
 		// Buffer swizzling functions
 		/////////////////////////////////////////////////////////
@@ -1,5 +1,9 @@
 ﻿#include "GnmGpuAddressInternal.h"
 #include "GnmGpuAddress.h"
+#include "GnmSwizzlerSSE2.h"
+#include "GnmSwizzlerAVX2.h"
+
+#include "PlatHardware.h"
 
 using namespace sce;
 using namespace sce::GpuAddress;
@@ -8,6 +12,74 @@ using namespace sce::GpuAddress;
 
 LOG_CHANNEL("GpuAddress");
 
+static DeswizzleBlockFunc getDeswizzleFuncSse2(const uint32_t elemSize, const uint32_t indexStride)
+{
+	switch(elemSize)
+	{
+	case  2:
+		if (indexStride ==  8) return deswizzleBlock2Sse2< 8>;
+		if (indexStride == 16) return deswizzleBlock2Sse2<16>;
+		if (indexStride == 32) return deswizzleBlock2Sse2<32>;
+		if (indexStride == 64) return deswizzleBlock2Sse2<64>;
+		return NULL;
+	case  4:
+		if (indexStride ==  8) return deswizzleBlock4Sse2< 8>;
+		if (indexStride == 16) return deswizzleBlock4Sse2<16>;
+		if (indexStride == 32) return deswizzleBlock4Sse2<32>;
+		if (indexStride == 64) return deswizzleBlock4Sse2<64>;
+		return NULL;
+	case  8:
+		if (indexStride ==  8) return deswizzleBlock8Sse2< 8>;
+		if (indexStride == 16) return deswizzleBlock8Sse2<16>;
+		if (indexStride == 32) return deswizzleBlock8Sse2<32>;
+		if (indexStride == 64) return deswizzleBlock8Sse2<64>;
+		return NULL;
+	case 16:
+		if (indexStride ==  8) return deswizzleBlock16Sse2< 8>;
+		if (indexStride == 16) return deswizzleBlock16Sse2<16>;
+		if (indexStride == 32) return deswizzleBlock16Sse2<32>;
+		if (indexStride == 64) return deswizzleBlock16Sse2<64>;
+		return NULL;
+	default:
+		return NULL;
+	}
+}
+static DeswizzleBlockFunc getDeswizzleFuncAvx2(const uint32_t elemSize, const uint32_t indexStride)
+{
+	switch(elemSize)
+	{
+	case  2:
+		if (indexStride == 16) return deswizzleBlock2Avx2<16>;
+		if (indexStride == 32) return deswizzleBlock2Avx2<32>;
+		if (indexStride == 64) return deswizzleBlock2Avx2<64>;
+		return NULL;
+	case  4:
+		if (indexStride ==  8) return deswizzleBlock4Avx2< 8>;
+		if (indexStride == 16) return deswizzleBlock4Avx2<16>;
+		if (indexStride == 32) return deswizzleBlock4Avx2<32>;
+		if (indexStride == 64) return deswizzleBlock4Avx2<64>;
+		return NULL;
+	case  8:
+		if (indexStride ==  8) return deswizzleBlock8Avx2< 8>;
+		if (indexStride == 16) return deswizzleBlock8Avx2<16>;
+		if (indexStride == 32) return deswizzleBlock8Avx2<32>;
+		if (indexStride == 64) return deswizzleBlock8Avx2<64>;
+		return NULL;
+	default:
+		return NULL;
+	}
+}
+
+// 16-byte elements are plain register moves, AVX2 doesn't help there.
+// Blocks of 8 records are too short for the 2-byte AVX2 kernel.
+static DeswizzleBlockFunc getDeswizzleFunc(const uint32_t elemSize, const uint32_t indexStride)
+{
+	DeswizzleBlockFunc func = NULL;
+	if (plat::GetCpuFeatures().avx2)
+		func = getDeswizzleFuncAvx2(elemSize, indexStride);
+	return func != NULL ? func : getDeswizzleFuncSse2(elemSize, indexStride);
+}
+
 int32_t sce::GpuAddress::computeSwizzledBufferSize(Gnm::GpuMode targetGpuMode, uint64_t *outSizeBytes, uint32_t elemStride, uint32_t numElements, Gnm::BufferSwizzleElementSize swizzleSize, Gnm::BufferSwizzleStride swizzleStride)
 {
 	SCE_GNM_UNUSED(targetGpuMode);
@@ -93,7 +165,17 @@ int32_t sce::GpuAddress::deswizzleBufferData(Gnm::GpuMode targetGpuMode, void *o
 #ifdef SCE_GNM_DEBUG
 	memset(outLinearData, 0xCD, linearBufferSize);
 #endif
-	for(uint32_t iRecord=0; iRecord<numElements; ++iRecord)
+	// Full blocks are transposed by the vector kernels,
+	// a trailing partial block falls back to the byte loop.
+	const uint32_t blockCount = numElements / actualIndexStride;
+	const uint32_t blockBytes = elemStride * actualIndexStride;
+	DeswizzleBlockFunc deswizzleBlock = getDeswizzleFunc(actualElemSize, actualIndexStride);
+	if (deswizzleBlock != NULL)
+	{
+		for(uint32_t iBlock=0; iBlock<blockCount; ++iBlock)
+			deswizzleBlock(linearBytes + iBlock*blockBytes, swizzledBytes + iBlock*blockBytes, elemStride);
+	}
+	for(uint32_t iRecord=deswizzleBlock != NULL ? blockCount*actualIndexStride : 0; iRecord<numElements; ++iRecord)
 	{
 		for(uint32_t iOffset=0; iOffset<elemStride; ++iOffset)
 		{
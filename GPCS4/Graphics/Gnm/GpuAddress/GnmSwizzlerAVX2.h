@@ -0,0 +1,141 @@
+#pragma once
+
+#include "GnmGpuAddressInternal.h"
+#include "GnmSwizzlerSSE2.h"
+#include "GnmTilerAVX2.h"
+
+#include <cstdint>
+#include <x86intrin.h>
+
+
+namespace sce
+{
+	namespace GpuAddress
+	{
+		/** @brief Deswizzles a block with 2-byte swizzle elements using AVX2.
+			Transposes 4 chunks of 16 records at a time, each 128-bit lane holds 8 records.
+			Needs blocks of at least 16 records.
+		*/
+		template<uint32_t kIndexStride>
+		SCE_GNM_TARGET_AVX2 inline void deswizzleBlock2Avx2(uint8_t * __restrict linearBlock, const uint8_t * __restrict swizzledBlock, const uint32_t elemStride)
+		{
+			static_assert(kIndexStride >= 16, "AVX2 kernel needs 16 records per block.");
+			const uint32_t chunkCount = elemStride / 2;
+			const uint32_t chunkPitch = 2 * kIndexStride;
+			uint32_t iChunk = 0;
+			for(; iChunk+4<=chunkCount; iChunk+=4)
+			{
+				const uint8_t *src = swizzledBlock + iChunk * chunkPitch;
+				uint8_t       *dst = linearBlock + iChunk * 2;
+				for(uint32_t iRecord=0; iRecord<kIndexStride; iRecord+=16)
+				{
+					const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 0 * chunkPitch + iRecord * 2));
+					const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 1 * chunkPitch + iRecord * 2));
+					const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * chunkPitch + iRecord * 2));
+					const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 3 * chunkPitch + iRecord * 2));
+
+					const __m256i abLo = _mm256_unpacklo_epi16(a, b);
+					const __m256i abHi = _mm256_unpackhi_epi16(a, b);
+					const __m256i cdLo = _mm256_unpacklo_epi16(c, d);
+					const __m256i cdHi = _mm256_unpackhi_epi16(c, d);
+
+					// Lane 0 holds records 0-7, lane 1 records 8-15.
+					const __m256i r01 = _mm256_unpacklo_epi32(abLo, cdLo);
+					const __m256i r23 = _mm256_unpackhi_epi32(abLo, cdLo);
+					const __m256i r45 = _mm256_unpacklo_epi32(abHi, cdHi);
+					const __m256i r67 = _mm256_unpackhi_epi32(abHi, cdHi);
+
+					const __m256i rows[4] = { r01, r23, r45, r67 };
+					for(uint32_t iLane=0; iLane<2; ++iLane)
+					{
+						uint8_t *rec = dst + (iRecord + iLane * 8) * elemStride;
+						for(uint32_t iRow=0; iRow<4; ++iRow)
+						{
+							const __m128i row = iLane ? _mm256_extracti128_si256(rows[iRow], 1) : _mm256_castsi256_si128(rows[iRow]);
+							_mm_storel_epi64(reinterpret_cast<__m128i*>(rec + (iRow * 2 + 0) * elemStride), row);
+							_mm_storeh_pd(reinterpret_cast<double*>(rec + (iRow * 2 + 1) * elemStride), _mm_castsi128_pd(row));
+						}
+					}
+				}
+			}
+			deswizzleChunks(linearBlock, swizzledBlock, elemStride, 2, kIndexStride, iChunk, kIndexStride);
+		}
+
+		/** @brief Deswizzles a block with 4-byte swizzle elements using AVX2.
+			Transposes 4 chunks of 8 records at a time, each 128-bit lane holds 4 records.
+		*/
+		template<uint32_t kIndexStride>
+		SCE_GNM_TARGET_AVX2 inline void deswizzleBlock4Avx2(uint8_t * __restrict linearBlock, const uint8_t * __restrict swizzledBlock, const uint32_t elemStride)
+		{
+			const uint32_t chunkCount = elemStride / 4;
+			const uint32_t chunkPitch = 4 * kIndexStride;
+			uint32_t iChunk = 0;
+			for(; iChunk+4<=chunkCount; iChunk+=4)
+			{
+				const uint8_t *src = swizzledBlock + iChunk * chunkPitch;
+				uint8_t       *dst = linearBlock + iChunk * 4;
+				for(uint32_t iRecord=0; iRecord<kIndexStride; iRecord+=8)
+				{
+					const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 0 * chunkPitch + iRecord * 4));
+					const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 1 * chunkPitch + iRecord * 4));
+					const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * chunkPitch + iRecord * 4));
+					const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 3 * chunkPitch + iRecord * 4));
+
+					const __m256i abLo = _mm256_unpacklo_epi32(a, b);
+					const __m256i abHi = _mm256_unpackhi_epi32(a, b);
+					const __m256i cdLo = _mm256_unpacklo_epi32(c, d);
+					const __m256i cdHi = _mm256_unpackhi_epi32(c, d);
+
+					// Lane 0 holds records 0-3, lane 1 records 4-7.
+					const __m256i r0 = _mm256_unpacklo_epi64(abLo, cdLo);
+					const __m256i r1 = _mm256_unpackhi_epi64(abLo, cdLo);
+					const __m256i r2 = _mm256_unpacklo_epi64(abHi, cdHi);
+					const __m256i r3 = _mm256_unpackhi_epi64(abHi, cdHi);
+
+					uint8_t *rec = dst + iRecord * elemStride;
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 0 * elemStride), _mm256_castsi256_si128(r0));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 1 * elemStride), _mm256_castsi256_si128(r1));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 2 * elemStride), _mm256_castsi256_si128(r2));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 3 * elemStride), _mm256_castsi256_si128(r3));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 4 * elemStride), _mm256_extracti128_si256(r0, 1));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 5 * elemStride), _mm256_extracti128_si256(r1, 1));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 6 * elemStride), _mm256_extracti128_si256(r2, 1));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 7 * elemStride), _mm256_extracti128_si256(r3, 1));
+				}
+			}
+			deswizzleChunks(linearBlock, swizzledBlock, elemStride, 4, kIndexStride, iChunk, kIndexStride);
+		}
+
+		/** @brief Deswizzles a block with 8-byte swizzle elements using AVX2.
+			Transposes 2 chunks of 4 records at a time, each 128-bit lane holds 2 records.
+		*/
+		template<uint32_t kIndexStride>
+		SCE_GNM_TARGET_AVX2 inline void deswizzleBlock8Avx2(uint8_t * __restrict linearBlock, const uint8_t * __restrict swizzledBlock, const uint32_t elemStride)
+		{
+			const uint32_t chunkCount = elemStride / 8;
+			const uint32_t chunkPitch = 8 * kIndexStride;
+			uint32_t iChunk = 0;
+			for(; iChunk+2<=chunkCount; iChunk+=2)
+			{
+				const uint8_t *src = swizzledBlock + iChunk * chunkPitch;
+				uint8_t       *dst = linearBlock + iChunk * 8;
+				for(uint32_t iRecord=0; iRecord<kIndexStride; iRecord+=4)
+				{
+					const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 0 * chunkPitch + iRecord * 8));
+					const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 1 * chunkPitch + iRecord * 8));
+
+					// Lane 0 holds records 0-1, lane 1 records 2-3.
+					const __m256i r02 = _mm256_unpacklo_epi64(a, b);
+					const __m256i r13 = _mm256_unpackhi_epi64(a, b);
+
+					uint8_t *rec = dst + iRecord * elemStride;
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 0 * elemStride), _mm256_castsi256_si128(r02));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 1 * elemStride), _mm256_castsi256_si128(r13));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 2 * elemStride), _mm256_extracti128_si256(r02, 1));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 3 * elemStride), _mm256_extracti128_si256(r13, 1));
+				}
+			}
+			deswizzleChunks(linearBlock, swizzledBlock, elemStride, 8, kIndexStride, iChunk, kIndexStride);
+		}
+	}
+}
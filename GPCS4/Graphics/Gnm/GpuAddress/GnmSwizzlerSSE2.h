@@ -0,0 +1,164 @@
+#pragma once
+
+#include "GnmGpuAddressInternal.h"
+
+#include <cstdint>
+#include <cstring>
+#include <x86intrin.h>
+
+
+namespace sce
+{
+	namespace GpuAddress
+	{
+		/** @brief Deswizzles one full block of swizzled buffer records.
+			A block stores chunk 0 of all records, then chunk 1 of all records and so on, which is a transpose of its linear layout.
+			@param[out] linearBlock Pointer to the first linear record of the block.
+			@param[in] swizzledBlock Pointer to the beginning of the block in the swizzled data.
+			@param[in] elemStride The size of a single buffer element, expressed as a number of bytes.
+		*/
+		typedef void (*DeswizzleBlockFunc)(uint8_t * __restrict linearBlock, const uint8_t * __restrict swizzledBlock, const uint32_t elemStride);
+
+		/** @brief Deswizzles chunks of a block one at a time. Handles chunks left over by the vector kernels, and partial blocks.
+			@param[in] elemSize Swizzle element size in bytes (2, 4, 8 or 16).
+			@param[in] indexStride Number of records in a block (8, 16, 32 or 64).
+			@param[in] firstChunk Index of the first chunk to deswizzle.
+			@param[in] recordCount Number of records in the block to deswizzle.
+		*/
+		inline void deswizzleChunks(uint8_t * __restrict linearBlock, const uint8_t * __restrict swizzledBlock, const uint32_t elemStride,
+			const uint32_t elemSize, const uint32_t indexStride, const uint32_t firstChunk, const uint32_t recordCount)
+		{
+			const uint32_t chunkCount = elemStride / elemSize;
+			for(uint32_t iChunk=firstChunk; iChunk<chunkCount; ++iChunk)
+			{
+				const uint8_t *srcChunk = swizzledBlock + iChunk * elemSize * indexStride;
+				for(uint32_t iRecord=0; iRecord<recordCount; ++iRecord)
+					memcpy(linearBlock + iRecord * elemStride + iChunk * elemSize, srcChunk + iRecord * elemSize, elemSize);
+			}
+		}
+
+		/** @brief Deswizzles a block with 2-byte swizzle elements.
+			Transposes 4 chunks of 8 records at a time.
+		*/
+		template<uint32_t kIndexStride>
+		inline void deswizzleBlock2Sse2(uint8_t * __restrict linearBlock, const uint8_t * __restrict swizzledBlock, const uint32_t elemStride)
+		{
+			const uint32_t chunkCount = elemStride / 2;
+			const uint32_t chunkPitch = 2 * kIndexStride;
+			uint32_t iChunk = 0;
+			for(; iChunk+4<=chunkCount; iChunk+=4)
+			{
+				const uint8_t *src = swizzledBlock + iChunk * chunkPitch;
+				uint8_t       *dst = linearBlock + iChunk * 2;
+				for(uint32_t iRecord=0; iRecord<kIndexStride; iRecord+=8)
+				{
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0 * chunkPitch + iRecord * 2));
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 1 * chunkPitch + iRecord * 2));
+					const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * chunkPitch + iRecord * 2));
+					const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * chunkPitch + iRecord * 2));
+
+					const __m128i abLo = _mm_unpacklo_epi16(a, b);
+					const __m128i abHi = _mm_unpackhi_epi16(a, b);
+					const __m128i cdLo = _mm_unpacklo_epi16(c, d);
+					const __m128i cdHi = _mm_unpackhi_epi16(c, d);
+
+					const __m128i r01 = _mm_unpacklo_epi32(abLo, cdLo);
+					const __m128i r23 = _mm_unpackhi_epi32(abLo, cdLo);
+					const __m128i r45 = _mm_unpacklo_epi32(abHi, cdHi);
+					const __m128i r67 = _mm_unpackhi_epi32(abHi, cdHi);
+
+					uint8_t *rec = dst + iRecord * elemStride;
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(rec + 0 * elemStride), r01);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(rec + 1 * elemStride), _mm_unpackhi_epi64(r01, r01));
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(rec + 2 * elemStride), r23);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(rec + 3 * elemStride), _mm_unpackhi_epi64(r23, r23));
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(rec + 4 * elemStride), r45);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(rec + 5 * elemStride), _mm_unpackhi_epi64(r45, r45));
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(rec + 6 * elemStride), r67);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(rec + 7 * elemStride), _mm_unpackhi_epi64(r67, r67));
+				}
+			}
+			deswizzleChunks(linearBlock, swizzledBlock, elemStride, 2, kIndexStride, iChunk, kIndexStride);
+		}
+
+		/** @brief Deswizzles a block with 4-byte swizzle elements.
+			Transposes 4 chunks of 4 records at a time.
+		*/
+		template<uint32_t kIndexStride>
+		inline void deswizzleBlock4Sse2(uint8_t * __restrict linearBlock, const uint8_t * __restrict swizzledBlock, const uint32_t elemStride)
+		{
+			const uint32_t chunkCount = elemStride / 4;
+			const uint32_t chunkPitch = 4 * kIndexStride;
+			uint32_t iChunk = 0;
+			for(; iChunk+4<=chunkCount; iChunk+=4)
+			{
+				const uint8_t *src = swizzledBlock + iChunk * chunkPitch;
+				uint8_t       *dst = linearBlock + iChunk * 4;
+				for(uint32_t iRecord=0; iRecord<kIndexStride; iRecord+=4)
+				{
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0 * chunkPitch + iRecord * 4));
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 1 * chunkPitch + iRecord * 4));
+					const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * chunkPitch + iRecord * 4));
+					const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * chunkPitch + iRecord * 4));
+
+					const __m128i abLo = _mm_unpacklo_epi32(a, b);
+					const __m128i abHi = _mm_unpackhi_epi32(a, b);
+					const __m128i cdLo = _mm_unpacklo_epi32(c, d);
+					const __m128i cdHi = _mm_unpackhi_epi32(c, d);
+
+					uint8_t *rec = dst + iRecord * elemStride;
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 0 * elemStride), _mm_unpacklo_epi64(abLo, cdLo));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 1 * elemStride), _mm_unpackhi_epi64(abLo, cdLo));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 2 * elemStride), _mm_unpacklo_epi64(abHi, cdHi));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 3 * elemStride), _mm_unpackhi_epi64(abHi, cdHi));
+				}
+			}
+			deswizzleChunks(linearBlock, swizzledBlock, elemStride, 4, kIndexStride, iChunk, kIndexStride);
+		}
+
+		/** @brief Deswizzles a block with 8-byte swizzle elements.
+			Transposes 2 chunks of 2 records at a time.
+		*/
+		template<uint32_t kIndexStride>
+		inline void deswizzleBlock8Sse2(uint8_t * __restrict linearBlock, const uint8_t * __restrict swizzledBlock, const uint32_t elemStride)
+		{
+			const uint32_t chunkCount = elemStride / 8;
+			const uint32_t chunkPitch = 8 * kIndexStride;
+			uint32_t iChunk = 0;
+			for(; iChunk+2<=chunkCount; iChunk+=2)
+			{
+				const uint8_t *src = swizzledBlock + iChunk * chunkPitch;
+				uint8_t       *dst = linearBlock + iChunk * 8;
+				for(uint32_t iRecord=0; iRecord<kIndexStride; iRecord+=2)
+				{
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0 * chunkPitch + iRecord * 8));
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 1 * chunkPitch + iRecord * 8));
+
+					uint8_t *rec = dst + iRecord * elemStride;
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 0 * elemStride), _mm_unpacklo_epi64(a, b));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(rec + 1 * elemStride), _mm_unpackhi_epi64(a, b));
+				}
+			}
+			deswizzleChunks(linearBlock, swizzledBlock, elemStride, 8, kIndexStride, iChunk, kIndexStride);
+		}
+
+		/** @brief Deswizzles a block with 16-byte swizzle elements.
+			Every chunk is one register, so this only moves registers around.
+		*/
+		template<uint32_t kIndexStride>
+		inline void deswizzleBlock16Sse2(uint8_t * __restrict linearBlock, const uint8_t * __restrict swizzledBlock, const uint32_t elemStride)
+		{
+			const uint32_t chunkCount = elemStride / 16;
+			for(uint32_t iChunk=0; iChunk<chunkCount; ++iChunk)
+			{
+				const uint8_t *src = swizzledBlock + iChunk * 16 * kIndexStride;
+				uint8_t       *dst = linearBlock + iChunk * 16;
+				for(uint32_t iRecord=0; iRecord<kIndexStride; ++iRecord)
+				{
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + iRecord * 16));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + iRecord * elemStride), chunk);
+				}
+			}
+		}
+	}
+}
@@ -1,6 +1,7 @@
 ﻿#include "GnmGpuAddress.h"
 #include "GnmGpuAddressInternal.h"
 #include "GnmTilerSSE2.h"
+#include "GnmTilerAVX2.h"
 #include "GnmRegsinfo.h"
 #include "GnmRegsinfoPrivate.h"
 
@@ -8,13 +9,18 @@
 #include "Gnm/GnmRenderTarget.h"
 #include "Gnm/GnmDepthRenderTarget.h"
 
+#include "PlatHardware.h"
+#include "UtilWorkerPool.h"
+
 using namespace sce::GpuAddress;
 using namespace sce;
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 LOG_CHANNEL("GpuAddress");
 
@@ -98,6 +104,70 @@ static MicroTileFunc getDetileFuncSse2(const Gnm::MicroTileMode microTileMode, c
 	}
 }
 
+static MicroTileFunc getTileFuncAvx2(const Gnm::MicroTileMode microTileMode, const uint32_t bitsPerElement)
+{
+	switch(microTileMode)
+	{
+	case Gnm::kMicroTileModeDisplay:
+		if (bitsPerElement ==  32) return tileMicroTileAvx2<Gnm::kMicroTileModeDisplay,  32>;
+		if (bitsPerElement ==  64) return tileMicroTileAvx2<Gnm::kMicroTileModeDisplay,  64>;
+		return NULL;
+	case Gnm::kMicroTileModeDepth:
+	case Gnm::kMicroTileModeThin:
+		if (bitsPerElement ==  32) return tileMicroTileAvx2<Gnm::kMicroTileModeThin,  32>;
+		if (bitsPerElement ==  64) return tileMicroTileAvx2<Gnm::kMicroTileModeThin,  64>;
+		if (bitsPerElement == 128) return tileMicroTileAvx2<Gnm::kMicroTileModeThin, 128>;
+		return NULL;
+	case Gnm::kMicroTileModeThick:
+		if (bitsPerElement ==  32) return tileMicroTileAvx2<Gnm::kMicroTileModeThick,  32>;
+		if (bitsPerElement ==  64) return tileMicroTileAvx2<Gnm::kMicroTileModeThick,  64>;
+		if (bitsPerElement == 128) return tileMicroTileAvx2<Gnm::kMicroTileModeThick, 128>;
+		return NULL;
+	default:
+		return NULL;
+	}
+}
+static MicroTileFunc getDetileFuncAvx2(const Gnm::MicroTileMode microTileMode, const uint32_t bitsPerElement)
+{
+	switch(microTileMode)
+	{
+	case Gnm::kMicroTileModeDisplay:
+		if (bitsPerElement ==  32) return detileMicroTileAvx2<Gnm::kMicroTileModeDisplay,  32>;
+		if (bitsPerElement ==  64) return detileMicroTileAvx2<Gnm::kMicroTileModeDisplay,  64>;
+		return NULL;
+	case Gnm::kMicroTileModeDepth:
+	case Gnm::kMicroTileModeThin:
+		if (bitsPerElement ==  32) return detileMicroTileAvx2<Gnm::kMicroTileModeThin,  32>;
+		if (bitsPerElement ==  64) return detileMicroTileAvx2<Gnm::kMicroTileModeThin,  64>;
+		if (bitsPerElement == 128) return detileMicroTileAvx2<Gnm::kMicroTileModeThin, 128>;
+		return NULL;
+	case Gnm::kMicroTileModeThick:
+		if (bitsPerElement ==  32) return detileMicroTileAvx2<Gnm::kMicroTileModeThick,  32>;
+		if (bitsPerElement ==  64) return detileMicroTileAvx2<Gnm::kMicroTileModeThick,  64>;
+		if (bitsPerElement == 128) return detileMicroTileAvx2<Gnm::kMicroTileModeThick, 128>;
+		return NULL;
+	default:
+		return NULL;
+	}
+}
+
+// AVX2 kernels are only used for elements of 32 bits or more,
+// smaller elements are shuffled faster by the SSE2 kernels.
+static MicroTileFunc getTileFunc(const Gnm::MicroTileMode microTileMode, const uint32_t bitsPerElement)
+{
+	MicroTileFunc func = NULL;
+	if (plat::GetCpuFeatures().avx2)
+		func = getTileFuncAvx2(microTileMode, bitsPerElement);
+	return func != NULL ? func : getTileFuncSse2(microTileMode, bitsPerElement);
+}
+static MicroTileFunc getDetileFunc(const Gnm::MicroTileMode microTileMode, const uint32_t bitsPerElement)
+{
+	MicroTileFunc func = NULL;
+	if (plat::GetCpuFeatures().avx2)
+		func = getDetileFuncAvx2(microTileMode, bitsPerElement);
+	return func != NULL ? func : getDetileFuncSse2(microTileMode, bitsPerElement);
+}
+
 // Only works for count=1,2,4,8,16
 static inline void* small_memcpy(void *dest, const void *src, size_t count)
 {
@@ -838,7 +908,7 @@ int32_t sce::GpuAddress::Tiler1d::tileSurfaceRegion(void *outTiledPixels, const
 	const auto out_bytes = static_cast<uint8_t*>(outTiledPixels);
 	const auto bytesPerElement = m_bitsPerElement / 8;
 
-	const auto tileFunc = getTileFuncSse2(m_microTileMode, m_bitsPerElement);
+	const auto tileFunc = getTileFunc(m_microTileMode, m_bitsPerElement);
 	if(tileFunc != nullptr && (intptr_t(out_bytes) % 16) == 0)
 	{
         Regions regions;
@@ -901,7 +971,7 @@ int32_t sce::GpuAddress::Tiler1d::detileSurfaceRegion(void *outUntiledPixels, co
 	const auto out_bytes = static_cast<uint8_t*>(outUntiledPixels);
 	const auto bytesPerElement = m_bitsPerElement / 8;
 
-	const auto detileFunc = getDetileFuncSse2(m_microTileMode, m_bitsPerElement);
+	const auto detileFunc = getDetileFunc(m_microTileMode, m_bitsPerElement);
 	if(nullptr != detileFunc && (intptr_t(in_bytes) % 16) == 0)
 	{
         Regions regions;
@@ -1360,7 +1430,7 @@ int32_t sce::GpuAddress::Tiler2d::tileSurfaceRegionOneFragment(void *outTiledPix
         regions.Init(region, m_tileThickness);
         if(hasTexels(regions.m_aligned))
         {   
-            const auto microTileFunc = getTileFuncSse2(m_microTileMode, m_bitsPerElement);
+            const auto microTileFunc = getTileFunc(m_microTileMode, m_bitsPerElement);
             SCE_GNM_ASSERT_MSG_RETURN(nullptr != microTileFunc, kStatusInvalidArgument, "Can't find SSE2 tiling function for micro tilemode %d.", m_microTileMode);
             const auto offsetOfCacheLine = &g_offsetOfCacheLine[m_microTileMode][fastIntLog2(bytesPerElement)];
             const int dx = regions.m_aligned.m_left   - region.m_left;
@@ -1485,7 +1555,7 @@ int32_t sce::GpuAddress::Tiler2d::detileSurfaceRegionOneFragment(void *outUntile
         regions.Init(region, m_tileThickness);
         if(hasTexels(regions.m_aligned))
         {
-            const auto microTileFunc = getDetileFuncSse2(m_microTileMode, m_bitsPerElement);
+            const auto microTileFunc = getDetileFunc(m_microTileMode, m_bitsPerElement);
             SCE_GNM_ASSERT_MSG_RETURN(nullptr != microTileFunc, kStatusInvalidArgument, "Can't find SSE2 detiling function for micro tilemode %d.", m_microTileMode);
             const auto offsetOfCacheLine = &g_offsetOfCacheLine[m_microTileMode][fastIntLog2(bytesPerElement)];
             const int dx = regions.m_aligned.m_left   - region.m_left;
@@ -3451,6 +3521,109 @@ int32_t sce::GpuAddress::detileSurface(void *outUntiledPixels, const void *tiled
 	return detileSurfaceRegion(outUntiledPixels, tiledPixels, tp, &srcRegion, elemWidth, elemWidth*elemHeight);
 }
 
+// Bands smaller than this cost more to schedule than to detile.
+static const uint64_t kMinDetileBandBytes = 256 * 1024;
+
+struct DetileBand
+{
+	uint32_t      m_job;
+	SurfaceRegion m_region;
+	uint64_t      m_destOffset;
+};
+
+static void splitDetileJob(std::vector<DetileBand> *outBands, const DetileRegionJob &job, uint32_t jobIndex)
+{
+	const SurfaceRegion &region = job.m_srcRegion;
+	DetileBand band = { jobIndex, region, 0 };
+
+	SurfaceInfo surfInfo = {0};
+	int32_t status = computeSurfaceInfo(&surfInfo, &job.m_tp);
+	// Linear general surfaces are copied whole, whatever the region.
+	if (status != kStatusSuccess || !hasTexels(region) ||
+		surfInfo.m_arrayMode == Gnm::kArrayModeLinearGeneral || job.m_tp.m_numFragmentsPerPixel != 1)
+	{
+		outBands->push_back(band);
+		return;
+	}
+
+	// Same element size and height as the tilers use for multi-texel-per-element formats.
+	uint32_t bitsPerElement = job.m_tp.m_bitsPerFragment;
+	uint32_t heightAlign    = surfInfo.m_heightAlign;
+	if (job.m_tp.m_isBlockCompressed)
+	{
+		if (bitsPerElement == 1)
+		{
+			bitsPerElement *= 8;
+		}
+		else if (bitsPerElement == 4 || bitsPerElement == 8)
+		{
+			bitsPerElement *= 16;
+			heightAlign     = std::max((heightAlign + 3) / 4, 1U);
+		}
+	}
+
+	// Bands start on macro tile rows, or on tile thick slice groups for volumes,
+	// so each of them keeps to the fast aligned path of the tilers.
+	const uint64_t rowBytes   = (uint64_t(region.m_right - region.m_left) * bitsPerElement + 7) / 8;
+	const uint32_t rowCount   = region.m_bottom - region.m_top;
+	const uint32_t sliceCount = region.m_back - region.m_front;
+	if (sliceCount > 1)
+	{
+		const uint32_t sliceAlign    = std::max(surfInfo.m_depthAlign, 1U);
+		const uint64_t sliceBytes    = std::max<uint64_t>(rowBytes * rowCount, 1);
+		const uint32_t bandSlices    = static_cast<uint32_t>((kMinDetileBandBytes + sliceBytes - 1) / sliceBytes);
+		const uint32_t slicesPerBand = (bandSlices + sliceAlign - 1) / sliceAlign * sliceAlign;
+		for (uint32_t z = region.m_front; z < region.m_back; )
+		{
+			band.m_region.m_front = z;
+			band.m_region.m_back  = std::min(region.m_back, (z / slicesPerBand + 1) * slicesPerBand);
+			computeLinearElementByteOffset(&band.m_destOffset, 0, 0, z - region.m_front, 0, job.m_destPitch, job.m_destSlicePitch, bitsPerElement, 1);
+			outBands->push_back(band);
+			z = band.m_region.m_back;
+		}
+	}
+	else
+	{
+		const uint32_t rowAlign    = std::max(heightAlign, kMicroTileHeight);
+		const uint32_t bandRows    = static_cast<uint32_t>((kMinDetileBandBytes + rowBytes - 1) / std::max<uint64_t>(rowBytes, 1));
+		const uint32_t rowsPerBand = (bandRows + rowAlign - 1) / rowAlign * rowAlign;
+		for (uint32_t y = region.m_top; y < region.m_bottom; )
+		{
+			band.m_region.m_top    = y;
+			band.m_region.m_bottom = std::min(region.m_bottom, (y / rowsPerBand + 1) * rowsPerBand);
+			computeLinearElementByteOffset(&band.m_destOffset, 0, y - region.m_top, 0, 0, job.m_destPitch, job.m_destSlicePitch, bitsPerElement, 1);
+			outBands->push_back(band);
+			y = band.m_region.m_bottom;
+		}
+	}
+}
+
+int32_t sce::GpuAddress::detileSurfaceRegions(const DetileRegionJob *jobs, uint32_t jobCount)
+{
+	return detileSurfaceRegions(jobs, jobCount, util::WorkerPool::global());
+}
+
+int32_t sce::GpuAddress::detileSurfaceRegions(const DetileRegionJob *jobs, uint32_t jobCount, util::WorkerPool &pool)
+{
+	SCE_GNM_ASSERT_MSG_RETURN(jobs != 0 || jobCount == 0, kStatusInvalidArgument, "jobs must not be NULL.");
+
+	std::vector<DetileBand> bands;
+	for(uint32_t i = 0; i < jobCount; ++i)
+		splitDetileJob(&bands, jobs[i], i);
+
+	std::atomic<int32_t> result(kStatusSuccess);
+	pool.parallelFor(static_cast<uint32_t>(bands.size()), [&](uint32_t index)
+	{
+		const DetileBand      &band = bands[index];
+		const DetileRegionJob &job  = jobs[band.m_job];
+		uint8_t *out = static_cast<uint8_t*>(job.m_outUntiledSurface) + band.m_destOffset;
+		int32_t status = detileSurfaceRegion(out, job.m_tiledSurface, &job.m_tp, &band.m_region, job.m_destPitch, job.m_destSlicePitch);
+		if (status != kStatusSuccess)
+			result.store(status);
+	});
+	return result.load();
+}
+
 int32_t sce::GpuAddress::computeLinearElementByteOffset(uint64_t *outUntiledByteOffset, uint32_t x, uint32_t y, uint32_t z, uint32_t fragmentIndex,
 														uint32_t pitch, uint32_t SlicePitchElems, uint32_t bitsPerElement, uint32_t numFragmentsPerPixel)
 {
@@ -0,0 +1,418 @@
+#pragma once
+
+#include "GnmGpuAddressInternal.h"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <x86intrin.h>
+
+// Kernels are compiled for AVX2 regardless of the compiler flags,
+// callers must check the CPU supports it before calling them.
+#define SCE_GNM_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace sce
+{
+	namespace GpuAddress
+	{
+		/** @brief Returns the index of an element inside a microtile.
+			Same as the element index used by the tilers, limited to the microtile modes and bit depths with optimized kernels.
+			@param[in] microTileMode Display, Thin, Depth or Thick. Thick microtiles are 4 slices deep.
+			@param[in] bitsPerElement 8, 16, 32, 64 or 128 (64 at most for Display).
+		*/
+		constexpr uint32_t getMicroTileElementIndex(Gnm::MicroTileMode microTileMode, uint32_t bitsPerElement, uint32_t x, uint32_t y, uint32_t z)
+		{
+			// Source coordinate bit for each element index bit, low to high.
+			// 0-2 are x bits, 3-5 are y bits and 6-7 are z bits.
+			uint32_t order[8] = {};
+			uint32_t count    = 6;
+			if (microTileMode == Gnm::kMicroTileModeDisplay)
+			{
+				const uint32_t display8[]  = { 0, 1, 2, 4, 3, 5 };
+				const uint32_t display16[] = { 0, 1, 2, 3, 4, 5 };
+				const uint32_t display32[] = { 0, 1, 3, 2, 4, 5 };
+				const uint32_t display64[] = { 0, 3, 1, 2, 4, 5 };
+				const uint32_t* bits = bitsPerElement == 8 ? display8 : bitsPerElement == 16 ? display16 : bitsPerElement == 32 ? display32 : display64;
+				for (uint32_t i = 0; i < count; ++i)
+					order[i] = bits[i];
+			}
+			else if (microTileMode == Gnm::kMicroTileModeThick)
+			{
+				const uint32_t thick8[]  = { 0, 3, 1, 4, 6, 7, 2, 5 };
+				const uint32_t thick32[] = { 0, 3, 1, 6, 4, 7, 2, 5 };
+				const uint32_t thick64[] = { 0, 3, 6, 1, 4, 7, 2, 5 };
+				const uint32_t* bits = bitsPerElement <= 16 ? thick8 : bitsPerElement == 32 ? thick32 : thick64;
+				count = 8;
+				for (uint32_t i = 0; i < count; ++i)
+					order[i] = bits[i];
+			}
+			else
+			{
+				const uint32_t thin[] = { 0, 3, 1, 4, 2, 5 };
+				for (uint32_t i = 0; i < count; ++i)
+					order[i] = thin[i];
+			}
+
+			const uint32_t coord = (x & 7) | ((y & 7) << 3) | ((z & 3) << 6);
+			uint32_t elem = 0;
+			for (uint32_t i = 0; i < count; ++i)
+				elem |= ((coord >> order[i]) & 0x1) << i;
+			return elem;
+		}
+
+		/** @brief Describes the linear side of a microtile for the AVX2 kernels.
+			A microtile is made of rows of 8 elements, numbered y + 8*z.
+			Elements of 32 bits or more are moved in dwords, with cross lane permutes of 32-byte chunks.
+			Smaller elements are moved in bytes, with in lane shuffles of 16-byte tile chunks and rows.
+		*/
+		template <Gnm::MicroTileMode MicroTileMode, uint32_t BitsPerElement>
+		struct MicroTileLayoutAvx2
+		{
+			static constexpr Gnm::MicroTileMode kMicroTileMode  = MicroTileMode;
+			static constexpr uint32_t           kBitsPerElement = BitsPerElement;
+
+			static constexpr uint32_t kElementBytes = BitsPerElement / 8;
+			static constexpr uint32_t kThickness    = MicroTileMode == Gnm::kMicroTileModeThick ? 4 : 1;
+			static constexpr uint32_t kRowBytes     = 8 * kElementBytes;
+			static constexpr uint32_t kRowCount     = 8 * kThickness;
+			static constexpr uint32_t kTileBytes    = kRowBytes * kRowCount;
+			static constexpr bool     kDwordMoves   = kElementBytes >= 4;
+			static constexpr uint32_t kUnitBytes    = kDwordMoves ? 4 : 1;
+			static constexpr uint32_t kChunkBytes   = kDwordMoves ? 32 : 16;
+		};
+
+		/** @brief One 32-byte register written by an AVX2 kernel.
+			For dword moves, dword i comes from dword dwordIndex[k][i] of source k, k being the last source with dwordSelect[k][i] set.
+			For byte moves, lane l of source k is loaded from chunk source[k][l], and bytes are ORed after shuffling with byteIndex[k].
+			Dword moves whose lanes are each a whole 16-byte unit of the input are laneCopy moves, loading lane l from input offset laneInput[l].
+		*/
+		struct MicroTileMoveAvx2
+		{
+			static constexpr uint32_t kMaxSources = 4;
+
+			uint32_t sourceCount;
+			bool     laneCopy;
+			uint32_t laneInput[2];
+			uint32_t source[kMaxSources][2];
+			uint32_t dwordIndex[kMaxSources][8];
+			uint32_t dwordSelect[kMaxSources][8];
+			uint8_t  byteIndex[kMaxSources][32];
+		};
+
+		/** @brief Computes the moves of a microtile at compile time.
+			When detiling, sources are chunks of the tile, and moves write rows (two per move for byte moves) or 32-byte chunks of rows.
+			When tiling, sources are 32-byte chunks of rows, or whole rows for byte moves, and moves write 32 bytes of the tile.
+		*/
+		template <class Layout, bool Tile>
+		struct MicroTileMovesAvx2
+		{
+			static constexpr uint32_t kMoveCount = Layout::kDwordMoves || Tile ? Layout::kTileBytes / 32 : Layout::kRowCount / 2;
+
+			static constexpr std::array<MicroTileMoveAvx2, kMoveCount> build()
+			{
+				// Tiled offset of each linear offset, and the reverse.
+				uint32_t tiled[Layout::kTileBytes]  = {};
+				uint32_t linear[Layout::kTileBytes] = {};
+				for (uint32_t row = 0; row < Layout::kRowCount; ++row)
+				{
+					for (uint32_t rowByte = 0; rowByte < Layout::kRowBytes; ++rowByte)
+					{
+						uint32_t element      = getMicroTileElementIndex(Layout::kMicroTileMode, Layout::kBitsPerElement, rowByte / Layout::kElementBytes, row % 8, row / 8);
+						uint32_t linearOffset = row * Layout::kRowBytes + rowByte;
+						uint32_t tiledOffset  = element * Layout::kElementBytes + rowByte % Layout::kElementBytes;
+						tiled[linearOffset]   = tiledOffset;
+						linear[tiledOffset]   = linearOffset;
+					}
+				}
+
+				// Linear sources of byte moves are whole rows, which may be shorter than a lane.
+				const uint32_t sourceBytes = (Tile && !Layout::kDwordMoves) ? Layout::kRowBytes : Layout::kChunkBytes;
+				const uint32_t laneCount   = Layout::kDwordMoves ? 1 : 2;
+
+				std::array<MicroTileMoveAvx2, kMoveCount> moves = {};
+				for (uint32_t m = 0; m < kMoveCount; ++m)
+				{
+					MicroTileMoveAvx2& move = moves[m];
+					for (uint32_t k = 0; k < MicroTileMoveAvx2::kMaxSources; ++k)
+					{
+						for (uint32_t i = 0; i < 32; ++i)
+							move.byteIndex[k][i] = 0x80;
+					}
+
+					uint32_t laneSources[2] = {};
+					uint32_t inputs[8]      = {};
+					for (uint32_t lane = 0; lane < laneCount; ++lane)
+					{
+						uint32_t outputBase  = Layout::kDwordMoves ? m * 32 : (Tile ? (2 * m + lane) * 16 : (2 * m + lane) * Layout::kRowBytes);
+						uint32_t outputBytes = Layout::kDwordMoves ? 32 : (Tile ? 16 : Layout::kRowBytes);
+						for (uint32_t unit = 0; unit < outputBytes / Layout::kUnitBytes; ++unit)
+						{
+							uint32_t output   = outputBase + unit * Layout::kUnitBytes;
+							uint32_t input    = Tile ? linear[output] : tiled[output];
+							inputs[unit % 8]  = input;
+							uint32_t chunk    = input / sourceBytes;
+							uint32_t position = (input % sourceBytes) / Layout::kUnitBytes;
+
+							uint32_t k = 0;
+							while (k < laneSources[lane] && move.source[k][lane] != chunk)
+								++k;
+							if (k == laneSources[lane])
+							{
+								move.source[k][lane] = chunk;
+								++laneSources[lane];
+							}
+
+							if (Layout::kDwordMoves)
+							{
+								move.dwordIndex[k][unit]  = position;
+								move.dwordSelect[k][unit] = 0xFFFFFFFF;
+							}
+							else
+							{
+								move.byteIndex[k][lane * 16 + unit] = static_cast<uint8_t>(position);
+							}
+						}
+					}
+
+					if (Layout::kDwordMoves)
+					{
+						move.laneCopy = true;
+						for (uint32_t unit = 0; unit < 8; ++unit)
+							move.laneCopy = move.laneCopy && inputs[unit] == inputs[unit & ~3u] + (unit & 3) * 4 && inputs[unit & ~3u] % 16 == 0;
+						move.laneInput[0] = inputs[0];
+						move.laneInput[1] = inputs[4];
+					}
+
+					// A lane with fewer sources than the other reloads its first source.
+					move.sourceCount = laneSources[0] > laneSources[1] ? laneSources[0] : laneSources[1];
+					for (uint32_t lane = 0; lane < laneCount; ++lane)
+					{
+						for (uint32_t k = laneSources[lane]; k < MicroTileMoveAvx2::kMaxSources; ++k)
+							move.source[k][lane] = move.source[0][lane];
+					}
+				}
+				return moves;
+			}
+
+			static constexpr std::array<MicroTileMoveAvx2, kMoveCount> kMoves = build();
+		};
+
+		template <class Moves, uint32_t M, uint32_t K, size_t... I>
+		SCE_GNM_TARGET_AVX2 inline __m256i getDwordIndexAvx2(std::index_sequence<I...>)
+		{
+			return _mm256_setr_epi32(static_cast<int>(Moves::kMoves[M].dwordIndex[K][I])...);
+		}
+
+		template <class Moves, uint32_t M, uint32_t K>
+		constexpr int getDwordBlendMaskAvx2()
+		{
+			int mask = 0;
+			for (uint32_t i = 0; i < 8; ++i)
+				mask |= Moves::kMoves[M].dwordSelect[K][i] ? (1 << i) : 0;
+			return mask;
+		}
+
+		template <class Moves, uint32_t M, uint32_t K, size_t... I>
+		SCE_GNM_TARGET_AVX2 inline __m256i getByteIndexAvx2(std::index_sequence<I...>)
+		{
+			return _mm256_setr_epi8(static_cast<char>(Moves::kMoves[M].byteIndex[K][I])...);
+		}
+
+		/** @brief Gathers the dwords of source K into their place of move M.
+		*/
+		template <class Moves, uint32_t M, uint32_t K>
+		SCE_GNM_TARGET_AVX2 inline __m256i permuteDwordsAvx2(__m256i result, const uint8_t *source)
+		{
+			constexpr int blendMask = getDwordBlendMaskAvx2<Moves, M, K>();
+			const __m256i value     = _mm256_permutevar8x32_epi32(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)),
+				getDwordIndexAvx2<Moves, M, K>(std::make_index_sequence<8>()));
+			return K == 0 ? value : _mm256_blend_epi32(result, value, blendMask);
+		}
+
+		/** @brief Loads two 16-byte units into the lanes of a register.
+		*/
+		SCE_GNM_TARGET_AVX2 inline __m256i loadLanesAvx2(const uint8_t *lane0, const uint8_t *lane1)
+		{
+			return _mm256_inserti128_si256(
+				_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lane0))),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(lane1)), 1);
+		}
+
+		/** @brief Gathers the bytes of source K into their place of move M.
+		*/
+		template <class Moves, uint32_t M, uint32_t K>
+		SCE_GNM_TARGET_AVX2 inline __m256i shuffleBytesAvx2(__m256i result, __m128i lane0, __m128i lane1)
+		{
+			const __m256i value = _mm256_inserti128_si256(_mm256_castsi128_si256(lane0), lane1, 1);
+			return _mm256_or_si256(result, _mm256_shuffle_epi8(value, getByteIndexAvx2<Moves, M, K>(std::make_index_sequence<32>())));
+		}
+
+		template <uint32_t Bytes>
+		inline __m128i loadRowAvx2(const uint8_t *row)
+		{
+			return Bytes == 8 ? _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row)) : _mm_loadu_si128(reinterpret_cast<const __m128i*>(row));
+		}
+
+		template <uint32_t Bytes>
+		inline void storeRowAvx2(uint8_t *row, __m128i value)
+		{
+			if (Bytes == 8)
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(row), value);
+			else
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(row), value);
+		}
+
+		inline uint32_t getRowOffsetAvx2(uint32_t row, uint32_t pitchBytes, uint32_t slicePitchBytes)
+		{
+			return (row / 8) * slicePitchBytes + (row % 8) * pitchBytes;
+		}
+
+		template <class Layout, uint32_t M>
+		SCE_GNM_TARGET_AVX2 inline void detileMoveAvx2(uint8_t *destBytes, const uint8_t *srcBytes, const uint32_t destPitchBytes, const uint32_t destSlicePitchBytes)
+		{
+			using Moves = MicroTileMovesAvx2<Layout, false>;
+			constexpr const MicroTileMoveAvx2& move = Moves::kMoves[M];
+
+			if constexpr (Layout::kDwordMoves)
+			{
+				constexpr uint32_t chunksPerRow = Layout::kRowBytes / 32;
+				constexpr uint32_t row          = M / chunksPerRow;
+				uint8_t *dest = destBytes + getRowOffsetAvx2(row, destPitchBytes, destSlicePitchBytes) + (M % chunksPerRow) * 32;
+
+				__m256i result = _mm256_setzero_si256();
+				if constexpr (move.laneCopy)
+				{
+					result = loadLanesAvx2(srcBytes + move.laneInput[0], srcBytes + move.laneInput[1]);
+				}
+				else
+				{
+					result = permuteDwordsAvx2<Moves, M, 0>(result, srcBytes + move.source[0][0] * 32);
+					if constexpr (move.sourceCount > 1)
+						result = permuteDwordsAvx2<Moves, M, 1>(result, srcBytes + move.source[1][0] * 32);
+					if constexpr (move.sourceCount > 2)
+						result = permuteDwordsAvx2<Moves, M, 2>(result, srcBytes + move.source[2][0] * 32);
+					if constexpr (move.sourceCount > 3)
+						result = permuteDwordsAvx2<Moves, M, 3>(result, srcBytes + move.source[3][0] * 32);
+				}
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), result);
+			}
+			else
+			{
+				auto source = [srcBytes](uint32_t chunk)
+				{
+					return _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBytes + chunk * 16));
+				};
+
+				__m256i result = _mm256_setzero_si256();
+				result = shuffleBytesAvx2<Moves, M, 0>(result, source(move.source[0][0]), source(move.source[0][1]));
+				if constexpr (move.sourceCount > 1)
+					result = shuffleBytesAvx2<Moves, M, 1>(result, source(move.source[1][0]), source(move.source[1][1]));
+				if constexpr (move.sourceCount > 2)
+					result = shuffleBytesAvx2<Moves, M, 2>(result, source(move.source[2][0]), source(move.source[2][1]));
+				if constexpr (move.sourceCount > 3)
+					result = shuffleBytesAvx2<Moves, M, 3>(result, source(move.source[3][0]), source(move.source[3][1]));
+
+				storeRowAvx2<Layout::kRowBytes>(destBytes + getRowOffsetAvx2(2 * M + 0, destPitchBytes, destSlicePitchBytes), _mm256_castsi256_si128(result));
+				storeRowAvx2<Layout::kRowBytes>(destBytes + getRowOffsetAvx2(2 * M + 1, destPitchBytes, destSlicePitchBytes), _mm256_extracti128_si256(result, 1));
+			}
+		}
+
+		template <class Layout, uint32_t M>
+		SCE_GNM_TARGET_AVX2 inline void tileMoveAvx2(uint8_t *destBytes, const uint8_t *srcBytes, const uint32_t srcPitchBytes, const uint32_t srcSlicePitchBytes)
+		{
+			using Moves = MicroTileMovesAvx2<Layout, true>;
+			constexpr const MicroTileMoveAvx2& move = Moves::kMoves[M];
+
+			__m256i result = _mm256_setzero_si256();
+			if constexpr (Layout::kDwordMoves)
+			{
+				constexpr uint32_t chunksPerRow = Layout::kRowBytes / 32;
+				auto source = [=](uint32_t chunk)
+				{
+					return srcBytes + getRowOffsetAvx2(chunk / chunksPerRow, srcPitchBytes, srcSlicePitchBytes) + (chunk % chunksPerRow) * 32;
+				};
+
+				auto lane = [=](uint32_t input)
+				{
+					return srcBytes + getRowOffsetAvx2(input / Layout::kRowBytes, srcPitchBytes, srcSlicePitchBytes) + input % Layout::kRowBytes;
+				};
+
+				if constexpr (move.laneCopy)
+				{
+					result = loadLanesAvx2(lane(move.laneInput[0]), lane(move.laneInput[1]));
+				}
+				else
+				{
+					result = permuteDwordsAvx2<Moves, M, 0>(result, source(move.source[0][0]));
+					if constexpr (move.sourceCount > 1)
+						result = permuteDwordsAvx2<Moves, M, 1>(result, source(move.source[1][0]));
+					if constexpr (move.sourceCount > 2)
+						result = permuteDwordsAvx2<Moves, M, 2>(result, source(move.source[2][0]));
+					if constexpr (move.sourceCount > 3)
+						result = permuteDwordsAvx2<Moves, M, 3>(result, source(move.source[3][0]));
+				}
+			}
+			else
+			{
+				auto source = [=](uint32_t row)
+				{
+					return loadRowAvx2<Layout::kRowBytes>(srcBytes + getRowOffsetAvx2(row, srcPitchBytes, srcSlicePitchBytes));
+				};
+
+				result = shuffleBytesAvx2<Moves, M, 0>(result, source(move.source[0][0]), source(move.source[0][1]));
+				if constexpr (move.sourceCount > 1)
+					result = shuffleBytesAvx2<Moves, M, 1>(result, source(move.source[1][0]), source(move.source[1][1]));
+				if constexpr (move.sourceCount > 2)
+					result = shuffleBytesAvx2<Moves, M, 2>(result, source(move.source[2][0]), source(move.source[2][1]));
+				if constexpr (move.sourceCount > 3)
+					result = shuffleBytesAvx2<Moves, M, 3>(result, source(move.source[3][0]), source(move.source[3][1]));
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destBytes + M * 32), result);
+		}
+
+		template <class Layout, uint32_t... M>
+		SCE_GNM_TARGET_AVX2 inline void detileMovesAvx2(uint8_t *destBytes, const uint8_t *srcBytes, const uint32_t destPitchBytes, const uint32_t destSlicePitchBytes, std::integer_sequence<uint32_t, M...>)
+		{
+			(detileMoveAvx2<Layout, M>(destBytes, srcBytes, destPitchBytes, destSlicePitchBytes), ...);
+		}
+
+		template <class Layout, uint32_t... M>
+		SCE_GNM_TARGET_AVX2 inline void tileMovesAvx2(uint8_t *destBytes, const uint8_t *srcBytes, const uint32_t srcPitchBytes, const uint32_t srcSlicePitchBytes, std::integer_sequence<uint32_t, M...>)
+		{
+			(tileMoveAvx2<Layout, M>(destBytes, srcBytes, srcPitchBytes, srcSlicePitchBytes), ...);
+		}
+
+		/** @brief Tiles a microtile using AVX2. Display, Thin and Depth microtiles are 8x8, Thick microtiles are 8x8x4.
+			@param[out] destTileBase Pointer to the beginning of the destination microtile in the tiled data. There is no alignment requirement.
+			@param[in] srcTileBase Pointer to the beginning of the source microtile in the untiled data.
+			@param[in] srcPitch Number of elements in one row of source data.
+			@param[in] srcSlicePitch Number of elements in one slice of source data. Ignored for 8x8 microtiles.
+		*/
+		template <Gnm::MicroTileMode MicroTileMode, uint32_t BitsPerElement>
+		SCE_GNM_TARGET_AVX2 void tileMicroTileAvx2(void * __restrict destTileBase, const void * __restrict srcTileBase, const uint32_t srcPitch, const uint32_t srcSlicePitch)
+		{
+			using Layout = MicroTileLayoutAvx2<MicroTileMode, BitsPerElement>;
+			using Moves  = MicroTileMovesAvx2<Layout, true>;
+			tileMovesAvx2<Layout>((uint8_t*)destTileBase, (const uint8_t*)srcTileBase,
+				srcPitch * Layout::kElementBytes, srcSlicePitch * Layout::kElementBytes,
+				std::make_integer_sequence<uint32_t, Moves::kMoveCount>());
+		}
+
+		/** @brief Detiles a microtile using AVX2. Display, Thin and Depth microtiles are 8x8, Thick microtiles are 8x8x4.
+			@param[out] destTileBase Pointer to the beginning of the destination microtile in the untiled data.
+			@param[in] srcTileBase Pointer to the beginning of the source microtile in the tiled data. There is no alignment requirement.
+			@param[in] destPitch Number of elements in one row of destination data.
+			@param[in] destSlicePitch Number of elements in one slice of destination data. Ignored for 8x8 microtiles.
+		*/
+		template <Gnm::MicroTileMode MicroTileMode, uint32_t BitsPerElement>
+		SCE_GNM_TARGET_AVX2 void detileMicroTileAvx2(void * __restrict destTileBase, const void * __restrict srcTileBase, const uint32_t destPitch, const uint32_t destSlicePitch)
+		{
+			using Layout = MicroTileLayoutAvx2<MicroTileMode, BitsPerElement>;
+			using Moves  = MicroTileMovesAvx2<Layout, false>;
+			detileMovesAvx2<Layout>((uint8_t*)destTileBase, (const uint8_t*)srcTileBase,
+				destPitch * Layout::kElementBytes, destSlicePitch * Layout::kElementBytes,
+				std::make_integer_sequence<uint32_t, Moves::kMoveCount>());
+		}
+	}
+}
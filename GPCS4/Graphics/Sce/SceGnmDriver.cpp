@@ -6,6 +6,7 @@
 #include "SceGpuQueue.h"
 #include "SceComputeQueue.h"
 #include "SceSwapchain.h"
+#include "SceResidencyManager.h"
 #include "SceResourceTracker.h"
 #include "SceLabelManager.h"
 #include "UtilMath.h"
@@ -78,6 +79,8 @@ namespace sce
 				break;
 			}
 
+			m_residency = std::make_unique<SceResidencyManager>(m_device.ptr());
+
 			ret = true;
 		}while(false);
 		return ret;
@@ -294,45 +297,51 @@ namespace sce
 	{
 		// Reset global objects.
 
+		// Resources persist across frames,
+		// they are validated on next use.
 		auto& tracker = GPU().resourceTracker();
-		tracker.reset();
+		tracker.nextFrame();
+
+		// Evict what's not needed if we run out of video memory.
+		m_residency->update(tracker);
 
+		// Labels persist across frames, only make sure
+		// the values of this frame reach guest memory.
 		auto& labelMgr = GPU().labelManager();
-		labelMgr.reset();
+		labelMgr.synchronize();
+		labelMgr.nextGeneration();
 	}
 
 	void SceGnmDriver::downloadResource()
 	{
 		// Download the resource from vulkan back to it's
 		// Gnm object.
-		// This has two purpose:
-		// 1. After the download, we can then safely
-		//    release vulkan object, no matter the Gnm
-		//    resource is released by game or not.
-		//    If it is released after current frame,
-		//    we are fine, the cost is a useless memory copy.
-	    //    If it is still used by the next frame,
-		//    we just create a new vulkan object using previous
-		//    content downloaded here. The cost is a vulkan object
-		//    creation.
-		// 2. If the game access the Gnm object on CPU side,
-		//    we are fine.
-		//    
-		//    This need to be optimized a lot.
-
-		auto& tracker = GPU().resourceTracker();
+		// Buffers written by GPU are copied to guest memory
+		// when the CPU first accesses them, not here. Their
+		// guest memory is fenced until then, so a resource
+		// which is never read costs no memory copy and
+		// the frame doesn't wait for the GPU.
+		// Resources read by CPU after most frames are
+		// copied eagerly in prefetch.
+		// Buffers written before a label are already
+		// downloaded by the command buffer, this only
+		// covers writes after the last label.
+
+		auto& tracker  = GPU().resourceTracker();
+		auto& labelMgr = GPU().labelManager();
 
 		auto context = m_device->createContext();
 		context->beginRecording(
 			m_device->createCommandList(VltQueueType::Graphics));
 
-		tracker.download(context.ptr());
+		tracker.download(m_device.ptr(), context.ptr(), labelMgr.nextPoint());
 
 		m_device->submitCommandList(
 			context->endRecording(),
 			VK_NULL_HANDLE,
 			VK_NULL_HANDLE);
-		m_device->syncSubmission();
+
+		tracker.prefetch();
 	}
 
 }  // namespace sce
\ No newline at end of file
@@ -25,6 +25,7 @@ namespace sce
 	class SceGpuQueue;
 	class SceComputeQueue;
 	class SceSwapchain;
+	class SceResidencyManager;
 	struct PresenterDesc;
 
 	// Valid vqueue id should be positive value.
@@ -106,6 +107,8 @@ namespace sce
 				   MaxComputeQueueCount> m_computeQueues;
 
 		std::unique_ptr<SceSwapchain> m_swapchain;
+
+		std::unique_ptr<SceResidencyManager> m_residency;
 	};
 
 }  // namespace sce
\ No newline at end of file
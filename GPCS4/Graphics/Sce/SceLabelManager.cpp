@@ -1,7 +1,11 @@
 #include "SceLabelManager.h"
+#include "SceResourceTracker.h"
 
+#include "PlatProcess.h"
 #include "Gnm/GnmGpuLabel.h"
+#include "Violet/VltContext.h"
 #include "Violet/VltDevice.h"
+#include "Violet/VltSemaphore.h"
 
 #include <mutex>
 
@@ -10,42 +14,315 @@ LOG_CHANNEL(Graphic.Gnm.SceLabelManager);
 namespace sce
 {
 	using namespace Gnm;
+	using namespace vlt;
 
-	SceLabelManager::SceLabelManager(vlt::VltDevice* device) :
-		m_device(device)
+	// Must be a power of two.
+	constexpr uint32_t MaxLabelCount = 4096;
+	// Labels not used for this many generations can be reused.
+	constexpr uint64_t LabelRetireAge = 16;
+	// How often the completion thread checks for shutdown
+	// while waiting for a point, in nanoseconds.
+	constexpr uint64_t CompletionPollTimeout = 100'000'000ull;
+
+	struct SceLabelManager::LabelSlot
+	{
+		std::atomic<void*>    key        = { nullptr };
+		std::atomic<bool>     ready      = { false };
+		std::atomic<uint64_t> generation = { 0 };
+		GnmGpuLabel           label;
+	};
+
+	static inline uint32_t hashAddress(void* address)
 	{
+		// Labels are at least 4 bytes aligned.
+		uint64_t value = reinterpret_cast<uint64_t>(address) >> 2;
+		return static_cast<uint32_t>((value * 0x9E3779B97F4A7C15ull) >> 32);
+	}
+
+	SceLabelManager::SceLabelManager(
+		vlt::VltDevice*     device,
+		SceResourceTracker* tracker) :
+		m_device(device),
+		m_tracker(tracker),
+		m_slots(std::make_unique<LabelSlot[]>(MaxLabelCount))
+	{
+		VltSemaphoreCreateInfo info;
+		info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		info.initialValue  = 0;
+		m_timeline         = m_device->createSemaphore(info);
+
+		m_completionThread = std::thread([this]()
+										 { runCompletion(); });
 	}
 
 	SceLabelManager::~SceLabelManager()
 	{
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_stopped = true;
+		}
+		m_queueCond.notify_one();
+		m_completionThread.join();
 	}
 
 	GnmGpuLabel* SceLabelManager::getLabel(void* labelAddress)
 	{
 		LOG_ASSERT(labelAddress != nullptr, "null label address passed.");
 
-		std::lock_guard<util::sync::Spinlock> guard(m_lock);
-		GnmGpuLabel* label = nullptr;
+		GnmGpuLabel* label = findOrInsert(labelAddress);
+		if (unlikely(label == nullptr))
+		{
+			label = findOrInsertOverflow(labelAddress);
+		}
+
+		return label;
+	}
+
+	GnmGpuLabel* SceLabelManager::findOrInsert(void* labelAddress)
+	{
+		uint64_t generation = m_generation.load(std::memory_order_relaxed);
+		uint32_t index      = hashAddress(labelAddress);
 
-		auto iter = m_labels.find(labelAddress);
-		if (iter == m_labels.end())
+		for (uint32_t i = 0; i != MaxLabelCount; ++i)
 		{
-			auto pair = m_labels.emplace(std::piecewise_construct,
-										 std::tuple(labelAddress),
-										 std::tuple(m_device, labelAddress));
-			label = &pair.first->second;
+			LabelSlot& slot = m_slots[(index + i) & (MaxLabelCount - 1)];
+
+			void* key = slot.key.load(std::memory_order_acquire);
+			if (key == nullptr)
+			{
+				if (slot.key.compare_exchange_strong(key, labelAddress,
+													 std::memory_order_acq_rel))
+				{
+					slot.label.init(this, labelAddress);
+					slot.generation.store(generation, std::memory_order_relaxed);
+					slot.ready.store(true, std::memory_order_release);
+					return &slot.label;
+				}
+				// Lost the race, key now holds the winner's address.
+			}
+
+			if (key == labelAddress)
+			{
+				// The slot may be in the middle of being (re)initialized.
+				util::sync::spin(200, [&slot]()
+								 { return slot.ready.load(std::memory_order_acquire); });
+
+				// Check again, the slot might have been reused meanwhile.
+				if (slot.key.load(std::memory_order_acquire) == labelAddress)
+				{
+					slot.generation.store(generation, std::memory_order_relaxed);
+					return &slot.label;
+				}
+			}
 		}
-		else 
+
+		return nullptr;
+	}
+
+	GnmGpuLabel* SceLabelManager::reuseStaleSlot(void* labelAddress)
+	{
+		// Slow path, only taken once the table is full.
+		// Rebinding an occupied slot keeps probe chains intact,
+		// so readers never see a hole in the table.
+		std::lock_guard<util::sync::Spinlock> guard(m_reuseLock);
+
+		// Someone else may have inserted it while we wait.
+		GnmGpuLabel* label = findOrInsert(labelAddress);
+		if (label != nullptr)
 		{
-			label = &iter->second;
+			return label;
 		}
+
+		uint64_t generation = m_generation.load(std::memory_order_relaxed);
+		uint32_t index      = hashAddress(labelAddress);
+
+		for (uint32_t i = 0; i != MaxLabelCount; ++i)
+		{
+			LabelSlot& slot = m_slots[(index + i) & (MaxLabelCount - 1)];
+
+			uint64_t lastUsed = slot.generation.load(std::memory_order_relaxed);
+			if (lastUsed + LabelRetireAge > generation)
+			{
+				continue;
+			}
+
+			bool ready = true;
+			if (!slot.ready.compare_exchange_strong(ready, false,
+													std::memory_order_acq_rel))
+			{
+				continue;
+			}
+
+			LOG_DEBUG("reuse label slot of %p for %p",
+					  slot.key.load(std::memory_order_relaxed), labelAddress);
+
+			slot.key.store(labelAddress, std::memory_order_release);
+			slot.label.init(this, labelAddress);
+			slot.generation.store(generation, std::memory_order_relaxed);
+			slot.ready.store(true, std::memory_order_release);
+			return &slot.label;
+		}
+
+		return nullptr;
+	}
+
+	GnmGpuLabel* SceLabelManager::findOrInsertOverflow(void* labelAddress)
+	{
+		// Look here before reusing a slot, a label
+		// must not live in both places at once.
+		std::lock_guard<std::mutex> guard(m_overflowMutex);
+
+		auto iter = m_overflow.find(labelAddress);
+		if (iter != m_overflow.end())
+		{
+			return iter->second.get();
+		}
+
+		GnmGpuLabel* label = reuseStaleSlot(labelAddress);
+		if (label != nullptr)
+		{
+			return label;
+		}
+
+		LOG_WARN("label table is full, %p goes to overflow map", labelAddress);
+
+		auto overflow = std::make_unique<GnmGpuLabel>();
+		overflow->init(this, labelAddress);
+
+		label = overflow.get();
+		m_overflow.emplace(labelAddress, std::move(overflow));
 		return label;
 	}
 
-	void SceLabelManager::reset()
+	void SceLabelManager::nextGeneration()
+	{
+		m_generation.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint64_t SceLabelManager::signal(
+		VltContext*           context,
+		VkPipelineStageFlags2 stage,
+		SceLabelWrite         labelWrite)
+	{
+		std::lock_guard<std::mutex> guard(m_signalMutex);
+
+		uint64_t point = ++m_timelineValue;
+
+		VltSemaphoreSubmission submission;
+		submission.semaphore = m_timeline;
+		submission.stageMask = stage;
+		submission.value     = point;
+		context->signalSemaphore(submission);
+
+		labelWrite.point = point;
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_pendingWrites.push(labelWrite);
+		}
+		m_queueCond.notify_one();
+
+		return point;
+	}
+
+	uint64_t SceLabelManager::nextPoint()
+	{
+		std::lock_guard<std::mutex> guard(m_signalMutex);
+		return m_timelineValue + 1;
+	}
+
+	void SceLabelManager::wait(
+		VltContext* context,
+		uint64_t    point)
+	{
+		VltSemaphoreSubmission submission;
+		submission.semaphore = m_timeline;
+		submission.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+		submission.value     = point;
+		context->waitSemaphore(submission);
+	}
+
+	Rc<VltSemaphore> SceLabelManager::createLabelSemaphore()
+	{
+		VltSemaphoreCreateInfo info;
+		info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		info.initialValue  = 0;
+		return m_device->createSemaphore(info);
+	}
+
+	void SceLabelManager::synchronize()
+	{
+		uint64_t point = 0;
+		{
+			std::lock_guard<std::mutex> guard(m_signalMutex);
+			point = m_timelineValue;
+		}
+		m_completed.wait(point);
+	}
+
+	void SceLabelManager::runCompletion()
+	{
+		while (true)
+		{
+			SceLabelWrite labelWrite;
+			{
+				std::unique_lock<std::mutex> lock(m_queueMutex);
+				m_queueCond.wait(lock, [this]()
+								 { return m_stopped || !m_pendingWrites.empty(); });
+
+				if (m_pendingWrites.empty())
+				{
+					break;
+				}
+
+				labelWrite = m_pendingWrites.front();
+				m_pendingWrites.pop();
+			}
+
+			// Points are queued in increasing order,
+			// so labels are written in signal order.
+			if (!waitForPoint(labelWrite.point))
+			{
+				// Later points can't be reached either.
+				std::lock_guard<std::mutex> lock(m_queueMutex);
+				LOG_WARN("drop %zu label writes not reached on shutdown",
+						 m_pendingWrites.size() + 1);
+				m_pendingWrites = std::queue<SceLabelWrite>();
+				break;
+			}
+
+			// Data the label guards must be in
+			// guest memory before the label is.
+			m_tracker->completeReadbacks(labelWrite.point);
+			writeLabel(labelWrite);
+
+			m_completed.signal(labelWrite.point);
+		}
+	}
+
+	bool SceLabelManager::waitForPoint(uint64_t point)
+	{
+		// Once stopped, a point which is still not reached
+		// may belong to a command list that is never
+		// submitted, so don't wait for it forever.
+		while (!m_timeline->wait(point, CompletionPollTimeout))
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			if (m_stopped)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void SceLabelManager::writeLabel(const SceLabelWrite& labelWrite)
 	{
-		std::lock_guard<util::sync::Spinlock> guard(m_lock);
-		m_labels.clear();
+		if (labelWrite.srcSelector == kEventWriteSource32BitsImmediate)
+			*reinterpret_cast<uint32_t*>(labelWrite.address) = labelWrite.value;
+		else if (labelWrite.srcSelector == kEventWriteSource64BitsImmediate)
+			*reinterpret_cast<uint64_t*>(labelWrite.address) = labelWrite.value;
+		else
+			*reinterpret_cast<uint64_t*>(labelWrite.address) = plat::GetProcessTimeCounter();
 	}
 
-}  // namespace sce
\ No newline at end of file
+}  // namespace sce
@@ -2,7 +2,14 @@
 
 #include "SceCommon.h"
 #include "UtilSync.h"
+#include "Gnm/GnmConstant.h"
+#include "Violet/VltRc.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <queue>
+#include <thread>
 #include <unordered_map>
 
 namespace sce
@@ -10,6 +17,8 @@ namespace sce
 	namespace vlt
 	{
 		class VltDevice;
+		class VltContext;
+		class VltSemaphore;
 	}  // namespace vlt
 
 	namespace Gnm
@@ -17,19 +26,158 @@ namespace sce
 		class GnmGpuLabel;
 	}  // namespace Gnm
 
+	class SceResourceTracker;
+
+	/**
+	 * \brief Pending label write
+	 *
+	 * Guest memory write performed by the completion
+	 * thread once the timeline reaches \c point.
+	 */
+	struct SceLabelWrite
+	{
+		void*                 address;
+		Gnm::EventWriteSource srcSelector;
+		uint64_t              value;
+		uint64_t              point;
+	};
+
+	/**
+	 * \brief GPU label manager
+	 *
+	 * All labels share one timeline semaphore. Every
+	 * label write allocates the next point on the
+	 * timeline, and a single completion thread writes
+	 * label values into guest memory in signal order.
+	 *
+	 * Labels persist across frames in a fixed size
+	 * open-addressing table keyed by label address,
+	 * lookups don't take any lock. Slots of labels not
+	 * used for a while are reused once the table is full.
+	 * If none is stale, labels spill into a map guarded
+	 * by a lock, which is slow but never fails.
+	 *
+	 * Before a label is written, readbacks recorded ahead
+	 * of its point which could not be fenced are copied
+	 * to guest memory, so the guest never sees the label
+	 * before the data it guards.
+	 *
+	 * On destruction, writes whose point is not reached
+	 * shortly are dropped, their command lists may never
+	 * have been submitted.
+	 */
 	class SceLabelManager
 	{
 	public:
-		SceLabelManager(vlt::VltDevice* device);
+		SceLabelManager(
+			vlt::VltDevice*     device,
+			SceResourceTracker* tracker);
 		~SceLabelManager();
 
 		Gnm::GnmGpuLabel* getLabel(void* labelAddress);
 
-		void reset();
+		/**
+		 * \brief Signals the next timeline point
+		 *
+		 * Queues the signal to the context and the
+		 * guest memory write to the completion thread.
+		 * \param [in] context Context to queue the signal
+		 * \param [in] stage Stages to wait for before signaling
+		 * \param [in] labelWrite The write, point is ignored
+		 * \returns The timeline point to be signaled
+		 */
+		uint64_t signal(
+			vlt::VltContext*      context,
+			VkPipelineStageFlags2 stage,
+			SceLabelWrite         labelWrite);
+
+		/**
+		 * \brief Lowest point the next signal can get
+		 *
+		 * Work recorded before the next signal
+		 * completes before this point is written.
+		 * \returns Next timeline point
+		 */
+		uint64_t nextPoint();
+
+		/**
+		 * \brief Waits for a timeline point on GPU
+		 *
+		 * \param [in] context Context to queue the wait
+		 * \param [in] point Timeline point to wait for
+		 */
+		void wait(
+			vlt::VltContext* context,
+			uint64_t         point);
+
+		/**
+		 * \brief Creates a timeline semaphore for one label
+		 *
+		 * Used by labels waited on before any write which
+		 * produces the value is known. The shared timeline
+		 * can't express such waits, since any later point
+		 * would satisfy them. A label keeps its semaphore
+		 * when its slot is reused for another address.
+		 * \returns New timeline semaphore
+		 */
+		vlt::Rc<vlt::VltSemaphore> createLabelSemaphore();
+
+		/**
+		 * \brief Waits for all pending label writes
+		 *
+		 * Blocks until every label signaled so far
+		 * has been written to guest memory.
+		 */
+		void synchronize();
+
+		/**
+		 * \brief Advances label generation
+		 *
+		 * Called once per frame, used to find
+		 * stale labels whose slot can be reused.
+		 */
+		void nextGeneration();
 
 	private:
-		vlt::VltDevice*                             m_device;
-		std::unordered_map<void*, Gnm::GnmGpuLabel> m_labels;
-		util::sync::Spinlock                        m_lock;
+		struct LabelSlot;
+
+		Gnm::GnmGpuLabel* findOrInsert(void* labelAddress);
+
+		Gnm::GnmGpuLabel* reuseStaleSlot(void* labelAddress);
+
+		Gnm::GnmGpuLabel* findOrInsertOverflow(void* labelAddress);
+
+		void runCompletion();
+
+		bool waitForPoint(uint64_t point);
+
+		void writeLabel(const SceLabelWrite& labelWrite);
+
+	private:
+		vlt::VltDevice*            m_device;
+		SceResourceTracker*        m_tracker;
+		vlt::Rc<vlt::VltSemaphore> m_timeline;
+
+		std::unique_ptr<LabelSlot[]> m_slots;
+		std::atomic<uint64_t>        m_generation = { 0 };
+		util::sync::Spinlock         m_reuseLock;
+
+		// Labels which didn't fit into the table. Entries
+		// are never removed so pointers stay valid.
+		std::mutex                                                   m_overflowMutex;
+		std::unordered_map<void*, std::unique_ptr<Gnm::GnmGpuLabel>> m_overflow;
+
+		// Last timeline point allocated, protected by m_signalMutex
+		// so that points are signaled in increasing order.
+		uint64_t   m_timelineValue = 0;
+		std::mutex m_signalMutex;
+
+		// Completion thread states
+		std::mutex                m_queueMutex;
+		std::condition_variable   m_queueCond;
+		std::queue<SceLabelWrite> m_pendingWrites;
+		bool                      m_stopped = false;
+		util::sync::Fence         m_completed;
+		std::thread               m_completionThread;
 	};
-}  // namespace sce
\ No newline at end of file
+}  // namespace sce
@@ -0,0 +1,83 @@
+#include "SceResidencyManager.h"
+#include "SceResourceTracker.h"
+
+#include "Violet/VltAdapter.h"
+#include "Violet/VltDevice.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace sce::vlt;
+
+LOG_CHANNEL(Graphic.Sce.SceResidencyManager);
+
+namespace sce
+{
+	SceResidencyManager::SceResidencyManager(VltDevice* device) :
+		m_device(device)
+	{
+	}
+
+	SceResidencyManager::~SceResidencyManager()
+	{
+	}
+
+	void SceResidencyManager::update(SceResourceTracker& tracker)
+	{
+		// Don't evict the same bytes again while
+		// memory of earlier evictions is still held.
+		auto& slot = m_pending[m_frame % PendingFrames];
+		slot       = 0;
+
+		VkDeviceSize pending = std::accumulate(
+			m_pending.begin(), m_pending.end(), VkDeviceSize(0));
+		VkDeviceSize over = getOverBudget();
+
+		if (over > pending)
+		{
+			slot = tracker.evict(over - pending);
+		}
+		++m_frame;
+
+		auto stats = tracker.takeResidencyStats();
+		if (stats.evictions != 0 || stats.reuploads != 0)
+		{
+			LOG_DEBUG("evicted %d resources (%llu KB), re-uploaded %d resources (%llu KB)",
+					  stats.evictions, stats.evictedBytes >> 10,
+					  stats.reuploads, stats.reuploadedBytes >> 10);
+		}
+	}
+
+	VkDeviceSize SceResidencyManager::getOverBudget() const
+	{
+		VltAdapterMemoryInfo info = m_device->adapter()->getMemoryHeapInfo();
+		VkDeviceSize         over = 0;
+
+		for (uint32_t i = 0; i < info.heapCount; i++)
+		{
+			if (!(info.heaps[i].heapFlags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+			{
+				continue;
+			}
+
+			// The driver reports usage of the whole process,
+			// leave what isn't allocated by us out of the budget.
+			VltMemoryStats stats  = m_device->getMemoryStats(i);
+			VkDeviceSize   budget = info.heaps[i].memoryBudget;
+			VkDeviceSize   others = info.heaps[i].memoryAllocated > stats.memoryAllocated
+										? info.heaps[i].memoryAllocated - stats.memoryAllocated
+										: 0;
+			budget = budget > others ? budget - others : 0;
+
+			// Keep some headroom for the resources of the next frame.
+			VkDeviceSize target = (9 * budget) / 10;
+			if (stats.memoryUsed > target)
+			{
+				over = std::max(over, stats.memoryUsed - target);
+			}
+		}
+
+		return over;
+	}
+
+}  // namespace sce
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "SceCommon.h"
+
+#include <array>
+
+namespace sce
+{
+	namespace vlt
+	{
+		class VltDevice;
+	}  // namespace vlt
+
+	class SceResourceTracker;
+
+	/**
+	 * \brief Residency statistics of a frame
+	 */
+	struct SceResidencyStats
+	{
+		uint32_t     evictions       = 0;
+		VkDeviceSize evictedBytes    = 0;
+		uint32_t     reuploads       = 0;
+		VkDeviceSize reuploadedBytes = 0;
+	};
+
+	/**
+	 * \brief Video memory budget manager
+	 *
+	 * Compares the device local memory used by the
+	 * emulator with the heap budget, which is reported
+	 * by the driver if VK_EXT_memory_budget is supported.
+	 *
+	 * When over budget at the end of a frame, the least
+	 * recently used clean resources are evicted from the
+	 * tracker. They fall back to guest memory only and
+	 * are created and uploaded again on their next use.
+	 */
+	class SceResidencyManager
+	{
+		// Evicted resources are retired by the tracker and
+		// their memory is reused only after the GPU is done.
+		constexpr static uint32_t PendingFrames = 3;
+
+	public:
+		SceResidencyManager(vlt::VltDevice* device);
+		~SceResidencyManager();
+
+		/**
+		 * \brief Enforces the budget
+		 *
+		 * Called once per frame, after the
+		 * tracker has begun the next frame.
+		 */
+		void update(SceResourceTracker& tracker);
+
+	private:
+		VkDeviceSize getOverBudget() const;
+
+	private:
+		vlt::VltDevice* m_device;
+
+		std::array<VkDeviceSize, PendingFrames> m_pending = {};
+		uint64_t                                m_frame   = 0;
+	};
+
+}  // namespace sce
@@ -66,6 +66,26 @@ namespace sce
 		return this->depthRenderTarget.getZSizeAlign().m_size;
 	}
 
+	SceTextureViewKey::SceTextureViewKey(const Gnm::Texture& tsharp) :
+		dataFormat(tsharp.getDataFormat().m_asInt),
+		type(tsharp.getTextureType()),
+		baseLevel(tsharp.getBaseMipLevel()),
+		lastLevel(tsharp.getLastMipLevel()),
+		baseSlice(tsharp.getBaseArraySliceIndex()),
+		lastSlice(tsharp.getLastArraySliceIndex())
+	{
+	}
+
+	bool SceTextureViewKey::operator==(const SceTextureViewKey& other) const
+	{
+		return dataFormat == other.dataFormat &&
+			   type == other.type &&
+			   baseLevel == other.baseLevel &&
+			   lastLevel == other.lastLevel &&
+			   baseSlice == other.baseSlice &&
+			   lastSlice == other.lastSlice;
+	}
+
 	/////////////////////////////////////////////////////////////////////
 
 	SceResource::SceResource(const SceBuffer& buffer) :
@@ -86,6 +106,8 @@ namespace sce
 		m_gpuMemory = texture.gpuMemory();
 
 		m_memSize = texture.memorySize();
+
+		m_textureViews.emplace_back(SceTextureViewKey(texture.texture), texture.imageView);
 	}
 
 	SceResource::SceResource(const SceRenderTarget& renderTarget) :
@@ -129,6 +151,36 @@ namespace sce
 	{
 		m_texture = texture;
 		m_type.set(SceResourceType::Texture);
+
+		// Views of the previous image are useless now.
+		std::lock_guard<util::sync::Spinlock> guard(m_viewLock);
+		m_textureViews.clear();
+		m_textureViews.emplace_back(SceTextureViewKey(texture.texture), texture.imageView);
+	}
+
+	vlt::Rc<vlt::VltImageView> SceResource::findTextureView(
+		const SceTextureViewKey& key)
+	{
+		std::lock_guard<util::sync::Spinlock> guard(m_viewLock);
+
+		vlt::Rc<vlt::VltImageView> result = nullptr;
+		for (const auto& entry : m_textureViews)
+		{
+			if (entry.first == key)
+			{
+				result = entry.second;
+				break;
+			}
+		}
+		return result;
+	}
+
+	void SceResource::addTextureView(
+		const SceTextureViewKey&          key,
+		const vlt::Rc<vlt::VltImageView>& view)
+	{
+		std::lock_guard<util::sync::Spinlock> guard(m_viewLock);
+		m_textureViews.emplace_back(key, view);
 	}
 
 	void SceResource::setRenderTarget(const SceRenderTarget& renderTarget)
@@ -2,6 +2,8 @@
 
 #include "SceCommon.h"
 #include "UtilFlag.h"
+#include "UtilSync.h"
+#include "MemoryWatch.h"
 
 #include "Gnm/GnmBuffer.h"
 #include "Gnm/GnmDepthRenderTarget.h"
@@ -11,6 +13,7 @@
 #include "Violet/VltRc.h"
 
 #include <variant>
+#include <vector>
 
 
 namespace sce
@@ -39,7 +42,7 @@ namespace sce
 	{
 		GpuUpload   = 0,   // GPU buffer to GPU image
 		GpuDownload = 1,   // GPU image to GPU buffer
-		CpuUpload   = 2    // CPU buffer to GPU image
+		CpuUpload   = 2    // Guest memory to GPU buffer
 	};
 
 	using SceTransformFlags = util::Flags<SceTransformFlag>;
@@ -102,6 +105,26 @@ namespace sce
 		size_t memorySize() const;
 	};
 
+	/**
+	 * \brief Identifies a view of a texture image
+	 * 
+	 * Made of the T# fields selecting the format,
+	 * channel swizzle and subresource range.
+	 */
+	struct SceTextureViewKey
+	{
+		uint32_t dataFormat;
+		uint32_t type;
+		uint32_t baseLevel;
+		uint32_t lastLevel;
+		uint32_t baseSlice;
+		uint32_t lastSlice;
+
+		SceTextureViewKey(const Gnm::Texture& tsharp);
+
+		bool operator==(const SceTextureViewKey& other) const;
+	};
+
 	/**
 	 * Sampler is not memory resource so it won't be
 	 * tracked by resource tracker.
@@ -207,6 +230,19 @@ namespace sce
 
 		void setTexture(const SceTexture& texture);
 
+		/**
+		 * \brief Cached view of the texture image
+		 * 
+		 * Returns null if no view is created
+		 * for the key yet.
+		 */
+		vlt::Rc<vlt::VltImageView> findTextureView(
+			const SceTextureViewKey& key);
+
+		void addTextureView(
+			const SceTextureViewKey&          key,
+			const vlt::Rc<vlt::VltImageView>& view);
+
 		/**
 		 * \brief Treat the resource as RenderTarget
 		 * 
@@ -231,6 +267,164 @@ namespace sce
 
 		void setDepthRenderTarget(const SceDepthRenderTarget& depthTarget);
 
+		/**
+		 * \brief Whether the content is produced by GPU
+		 * 
+		 * Render targets are written by GPU, their
+		 * guest memory doesn't reflect the content.
+		 */
+		bool isGpuWritable() const
+		{
+			return m_type.any(SceResourceType::RenderTarget,
+							  SceResourceType::DepthRenderTarget);
+		}
+
+		/**
+		 * \brief Hash of the guest memory content
+		 * 
+		 * Taken when the content was last synchronized
+		 * with the Vulkan object.
+		 */
+		uint64_t contentHash() const
+		{
+			return m_contentHash;
+		}
+
+		void setContentHash(uint64_t hash)
+		{
+			m_contentHash = hash;
+		}
+
+		/**
+		 * \brief Last frame the resource is used in
+		 */
+		uint64_t lastUsedFrame() const
+		{
+			return m_lastUsedFrame;
+		}
+
+		void setLastUsedFrame(uint64_t frame)
+		{
+			m_lastUsedFrame = frame;
+		}
+
+		/**
+		 * \brief Whether guest writes are caught by the write watch
+		 * 
+		 * Content hash is not used for watched resources.
+		 */
+		bool isWatched() const
+		{
+			return m_watched;
+		}
+
+		void setWatched(bool watched)
+		{
+			m_watched = watched;
+		}
+
+		/**
+		 * \brief Write watch epoch
+		 * 
+		 * Taken when the content was last synchronized
+		 * with the Vulkan object.
+		 */
+		uint64_t watchEpoch() const
+		{
+			return m_watchEpoch;
+		}
+
+		void setWatchEpoch(uint64_t epoch)
+		{
+			m_watchEpoch = epoch;
+		}
+
+		/**
+		 * \brief Guest memory ranges written by CPU
+		 * 
+		 * Pending upload to the buffer.
+		 */
+		std::vector<MemoryRange>& dirtyRanges()
+		{
+			return m_dirtyRanges;
+		}
+
+		/**
+		 * \brief Whether GPU wrote the buffer since the last readback
+		 * 
+		 * Set when bound for shader writes.
+		 */
+		bool isGpuWritten() const
+		{
+			return m_gpuWritten;
+		}
+
+		void setGpuWritten(bool written)
+		{
+			m_gpuWritten = written;
+		}
+
+		/**
+		 * \brief Host visible copy of a device local buffer
+		 * 
+		 * Created on the first readback, then reused.
+		 */
+		const vlt::Rc<vlt::VltBuffer>& readbackBuffer() const
+		{
+			return m_readbackBuffer;
+		}
+
+		void setReadbackBuffer(const vlt::Rc<vlt::VltBuffer>& buffer)
+		{
+			m_readbackBuffer = buffer;
+		}
+
+		/**
+		 * \brief Whether guest memory is fenced for a readback
+		 * 
+		 * The content is copied on the first CPU access.
+		 */
+		bool isReadbackPending() const
+		{
+			return m_readbackPending;
+		}
+
+		void setReadbackPending(bool pending)
+		{
+			m_readbackPending = pending;
+		}
+
+		/**
+		 * \brief Number of consecutive readbacks read by CPU
+		 * 
+		 * Used to predict readbacks worth doing eagerly.
+		 */
+		uint32_t readbackStreak() const
+		{
+			return m_readbackStreak;
+		}
+
+		void setReadbackStreak(uint32_t streak)
+		{
+			m_readbackStreak = streak;
+		}
+
+		/**
+		 * \brief Whether the texture misses render target writes
+		 * 
+		 * Set for each draw to the render target, cleared
+		 * once the render target is copied to the texture.
+		 */
+		bool isTextureStale() const
+		{
+			return m_textureStale;
+		}
+
+		void setTextureStale(bool stale)
+		{
+			m_textureStale = stale;
+		}
+
 	private:
 		// vulkan memory
 		void* m_gpuMemory = nullptr;
@@ -242,8 +436,26 @@ namespace sce
 		SceResourceTypeFlags m_type;
 		SceTransformFlags    m_transform;
 
+		uint64_t m_contentHash   = 0;
+		uint64_t m_lastUsedFrame = 0;
+
+		bool                     m_watched    = false;
+		uint64_t                 m_watchEpoch = 0;
+		std::vector<MemoryRange> m_dirtyRanges;
+
+		bool                    m_gpuWritten      = false;
+		bool                    m_readbackPending = false;
+		uint32_t                m_readbackStreak  = 0;
+		vlt::Rc<vlt::VltBuffer> m_readbackBuffer;
+
+		bool m_textureStale = false;
+
 		SceBuffer                                           m_buffer;
 		SceTexture                                          m_texture;
+
+		util::sync::Spinlock                                                   m_viewLock;
+		std::vector<std::pair<SceTextureViewKey, vlt::Rc<vlt::VltImageView>>> m_textureViews;
+
 		std::variant<SceRenderTarget, SceDepthRenderTarget> m_target;
 	};
 
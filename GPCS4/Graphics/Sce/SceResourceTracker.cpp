@@ -1,66 +1,401 @@
 #include "SceResourceTracker.h"
+#include "Emulator.h"
+#include "MurmurHash2.h"
+#include "VirtualCPU.h"
+#include "Gnm/GpuAddress/GnmGpuAddress.h"
 #include "Violet/VltDevice.h"
 #include "Violet/VltContext.h"
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
 using namespace sce::vlt;
 
 LOG_CHANNEL(Graphic.Sce.SceResourceTracker);
 
 namespace sce
 {
+	// Resources not used for this many frames are released.
+	constexpr uint64_t ResourceRetireAge = 120;
+	// Resources read by CPU this many frames in a row are read back eagerly.
+	constexpr uint32_t ReadbackPrefetchStreak = 2;
+	// Frames in which no readback is done eagerly.
+	constexpr uint64_t ReadbackProbeInterval = 8;
 
-	SceResourceTracker::SceResourceTracker()
+	SceResourceTracker::SceResourceTracker() :
+		m_root(std::make_unique<std::atomic<Leaf*>[]>(RootSize))
 	{
 	}
 
 	SceResourceTracker::~SceResourceTracker()
 	{
+		for (size_t i = 0; i != RootSize; ++i)
+		{
+			Leaf* leaf = m_root[i].load(std::memory_order_relaxed);
+			if (leaf == nullptr)
+			{
+				continue;
+			}
+
+			for (auto& slot : *leaf)
+			{
+				delete slot.load(std::memory_order_relaxed);
+			}
+			delete leaf;
+		}
 	}
 
 	SceResource* SceResourceTracker::find(void* mem)
 	{
-		std::lock_guard<util::sync::Spinlock> guard(m_lock);
+		SceResource* result = lookup(mem);
+		if (result != nullptr && !isCurrent(*result))
+		{
+			std::lock_guard<std::mutex> guard(m_lock);
+
+			// Look it up again, another thread may
+			// have released it in the meantime.
+			result = lookup(mem);
+			if (result != nullptr && !validate(*result))
+			{
+				// Guest memory changed, the caller
+				// will recreate and upload it.
+				release(m_resources.find(result->cpuMemory()));
+				result = nullptr;
+			}
+		}
+		return result;
+	}
+
+	void SceResourceTracker::findOverlaps(
+		void*                      start,
+		size_t                     size,
+		std::vector<SceResource*>& result) const
+	{
+		if (size == 0)
+		{
+			return;
+		}
+
+		uintptr_t begin        = reinterpret_cast<uintptr_t>(start);
+		uintptr_t end          = begin + size;
+		size_t    firstGranule = begin >> GranuleShift;
+		size_t    lastGranule  = (end - 1) >> GranuleShift;
+
+		for (size_t granule = firstGranule; granule <= lastGranule; ++granule)
+		{
+			Bucket* bucket = getBucket(granule);
+			if (bucket == nullptr)
+			{
+				continue;
+			}
+
+			for (auto res : bucket->resources)
+			{
+				uintptr_t resBegin = reinterpret_cast<uintptr_t>(res->cpuMemory());
+				uintptr_t resEnd   = resBegin + res->size();
+				if (resBegin >= end || resEnd <= begin)
+				{
+					continue;
+				}
+
+				// A resource shows up in every granule it covers,
+				// only report it from the first one in the range.
+				size_t resGranule = resBegin >> GranuleShift;
+				if (granule == std::max(firstGranule, resGranule))
+				{
+					result.push_back(res);
+				}
+			}
+		}
+	}
+
+	void SceResourceTracker::invalidate(void* start, size_t size)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		std::vector<SceResource*> overlaps;
+		findOverlaps(start, size, overlaps);
+
+		for (auto res : overlaps)
+		{
+			release(m_resources.find(res->cpuMemory()));
+		}
+	}
+
+	void SceResourceTracker::stamp(SceResource& res)
+	{
+		res.setLastUsedFrame(m_frame.load(std::memory_order_relaxed));
+
+		if (!res.isGpuWritable())
+		{
+			auto& watch = CPU().writeWatch();
+			res.setWatchEpoch(watch.epoch());
+			res.setWatched(watch.watch(res.cpuMemory(), res.size()));
+		}
 
+		if (!res.isWatched())
+		{
+			res.setContentHash(hashContent(res));
+		}
+	}
+
+	bool SceResourceTracker::isCurrent(const SceResource& res) const
+	{
+		// Nothing to validate if the resource is already
+		// used in this frame and no watched page is written.
+		bool current = res.lastUsedFrame() == m_frame.load(std::memory_order_acquire);
+		if (current && res.isWatched())
+		{
+			current = res.watchEpoch() == CPU().writeWatch().epoch();
+		}
+		return current;
+	}
+
+	bool SceResourceTracker::validate(SceResource& res)
+	{
+		uint64_t frame = m_frame.load(std::memory_order_relaxed);
+		bool     valid = true;
+		if (res.isWatched())
+		{
+			// Checked on every lookup, it's cheap as long
+			// as no watched page has been written.
+			auto& watch = CPU().writeWatch();
+			if (watch.epoch() != res.watchEpoch())
+			{
+				auto&    ranges = res.dirtyRanges();
+				uint64_t epoch  = watch.collect(res.cpuMemory(), res.size(),
+												res.watchEpoch(), ranges);
+				res.setWatchEpoch(epoch);
+
+				if (!ranges.empty())
+				{
+					// Buffers are patched in place,
+					// images need to be detiled again.
+					if (res.type().any(SceResourceType::Texture,
+									   SceResourceType::RenderTarget,
+									   SceResourceType::DepthRenderTarget))
+					{
+						valid = false;
+					}
+					else
+					{
+						res.setTransform(SceTransformFlag::CpuUpload);
+					}
+				}
+			}
+			res.setLastUsedFrame(frame);
+		}
+		else if (res.lastUsedFrame() != frame)
+		{
+			res.setLastUsedFrame(frame);
+			valid = res.isGpuWritable() ||
+					hashContent(res) == res.contentHash();
+		}
+		return valid;
+	}
+
+	SceResourceTracker::SceResourceMap::iterator
+	SceResourceTracker::release(SceResourceMap::iterator iter)
+	{
+		auto& res = iter->second;
+		if (res->isReadbackPending())
+		{
+			// Guest memory may be freed already, the
+			// readback must not run on a later access.
+			CPU().writeWatch().unfence(res->cpuMemory());
+		}
+
+		if (res->isWatched())
+		{
+			CPU().writeWatch().unwatch(res->cpuMemory(), res->size());
+		}
+
+		remove(res.get());
+
+		// Lookups may still hold the resource,
+		// keep it alive until the next frame is done.
+		auto& retired = m_retired[m_frame.load(std::memory_order_relaxed) & 1];
+		retired.resources.push_back(std::move(res));
+
+		return m_resources.erase(iter);
+	}
+
+	SceResource* SceResourceTracker::lookup(void* mem) const
+	{
 		SceResource* result = nullptr;
-		auto iter = m_resources.lower_bound(mem);
-		if (iter != m_resources.end())
+
+		uintptr_t address = reinterpret_cast<uintptr_t>(mem);
+		Bucket*   bucket  = getBucket(address >> GranuleShift);
+		if (bucket != nullptr)
 		{
-			// detect if mem is within a resource's memory range
-			auto& res = iter->second;
-			void*       start = res.cpuMemory();
-			void*       end   = reinterpret_cast<uint8_t*>(start) + res.size();
-			if (mem	>= start && mem < end)
+			for (auto res : bucket->resources)
 			{
-				result = &res;
+				uintptr_t start = reinterpret_cast<uintptr_t>(res->cpuMemory());
+				uintptr_t end   = start + res->size();
+				if (address == start)
+				{
+					result = res;
+					break;
+				}
+
+				if (result == nullptr && address > start && address < end)
+				{
+					result = res;
+				}
 			}
 		}
 
 		return result;
 	}
 
+	SceResourceTracker::Bucket* SceResourceTracker::getBucket(size_t granule) const
+	{
+		Bucket* bucket = nullptr;
+		size_t  index  = granule >> LeafBits;
+		if (index < RootSize)
+		{
+			Leaf* leaf = m_root[index].load(std::memory_order_acquire);
+			if (leaf != nullptr)
+			{
+				bucket = (*leaf)[granule & (LeafSize - 1)].load(std::memory_order_acquire);
+			}
+		}
+		return bucket;
+	}
+
+	std::atomic<SceResourceTracker::Bucket*>& SceResourceTracker::getBucketSlot(size_t granule)
+	{
+		size_t index = granule >> LeafBits;
+		LOG_ASSERT(index < RootSize, "guest address out of range.");
+
+		Leaf* leaf = m_root[index].load(std::memory_order_acquire);
+		if (leaf == nullptr)
+		{
+			// Value initialized, all buckets are null.
+			leaf = new Leaf();
+			m_root[index].store(leaf, std::memory_order_release);
+		}
+		return (*leaf)[granule & (LeafSize - 1)];
+	}
+
+	void SceResourceTracker::insert(SceResource* res)
+	{
+		uintptr_t begin = reinterpret_cast<uintptr_t>(res->cpuMemory());
+		uintptr_t end   = begin + std::max<size_t>(res->size(), 1);
+
+		for (size_t granule = begin >> GranuleShift; granule <= (end - 1) >> GranuleShift; ++granule)
+		{
+			auto&   slot   = getBucketSlot(granule);
+			Bucket* bucket = slot.load(std::memory_order_relaxed);
+
+			auto newBucket = bucket ? std::make_unique<Bucket>(*bucket)
+									: std::make_unique<Bucket>();
+			newBucket->resources.push_back(res);
+			publish(slot, std::move(newBucket));
+		}
+	}
+
+	void SceResourceTracker::remove(SceResource* res)
+	{
+		uintptr_t begin = reinterpret_cast<uintptr_t>(res->cpuMemory());
+		uintptr_t end   = begin + std::max<size_t>(res->size(), 1);
+
+		for (size_t granule = begin >> GranuleShift; granule <= (end - 1) >> GranuleShift; ++granule)
+		{
+			auto&   slot   = getBucketSlot(granule);
+			Bucket* bucket = slot.load(std::memory_order_relaxed);
+			if (bucket == nullptr)
+			{
+				continue;
+			}
+
+			std::unique_ptr<Bucket> newBucket;
+			if (bucket->resources.size() > 1)
+			{
+				newBucket = std::make_unique<Bucket>();
+				std::copy_if(bucket->resources.begin(), bucket->resources.end(),
+							 std::back_inserter(newBucket->resources),
+							 [res](SceResource* other) { return other != res; });
+			}
+			publish(slot, std::move(newBucket));
+		}
+	}
+
+	void SceResourceTracker::publish(std::atomic<Bucket*>& slot, std::unique_ptr<Bucket>&& bucket)
+	{
+		Bucket* oldBucket = slot.exchange(bucket.release(), std::memory_order_acq_rel);
+		if (oldBucket != nullptr)
+		{
+			auto& retired = m_retired[m_frame.load(std::memory_order_relaxed) & 1];
+			retired.buckets.emplace_back(oldBucket);
+		}
+	}
+
+	VkDeviceSize SceResourceTracker::gpuMemorySize(const SceResource& res)
+	{
+		// Host visible buffers don't take video memory
+		// on systems with a dedicated device local heap,
+		// count what is in device local memory only.
+		VkDeviceSize size = 0;
+		auto         type = res.type();
+		if (type.test(SceResourceType::Buffer))
+		{
+			auto& buffer = res.buffer().buffer;
+			if (buffer != nullptr && (buffer->memFlags() & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
+			{
+				size += buffer->memSize();
+			}
+		}
+
+		if (type.test(SceResourceType::Texture))
+		{
+			auto& image = res.texture().image;
+			if (image != nullptr && (image->memFlags() & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
+			{
+				size += image->memSize();
+			}
+		}
+		return size;
+	}
+
+	uint64_t SceResourceTracker::hashContent(const SceResource& res)
+	{
+		uint64_t hash = 0;
+		if (!res.isGpuWritable())
+		{
+			hash = alg::MurmurHash(res.cpuMemory(), res.size());
+		}
+		return hash;
+	}
+
 	void SceResourceTracker::transform(VltContext* context)
 	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
 		for (auto& res : m_resources)
 		{
-			auto type      = res.second.type();
-			auto transform = res.second.transform();
+			auto type      = res.second->type();
+			auto transform = res.second->transform();
 
 			if (transform.test(SceTransformFlag::GpuUpload))
 			{
 				Rc<VltImage> dstImage = nullptr;
 				if (type.test(SceResourceType::RenderTarget))
 				{
-					dstImage = res.second.renderTarget().image;
+					dstImage = res.second->renderTarget().image;
 				}
 				else if (type.test(SceResourceType::Texture))
 				{
-					dstImage = res.second.texture().image;
+					dstImage = res.second->texture().image;
 				}
 
 				VkExtent3D               imageExtent       = dstImage->mipLevelExtent(0);
 				VkImageSubresourceLayers subresourceLayers = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
 
-				auto& srcBuffer = res.second.buffer().buffer;
+				auto& srcBuffer = res.second->buffer().buffer;
 				context->copyBufferToImage(dstImage, subresourceLayers, VkOffset3D{ 0, 0, 0 }, imageExtent,
 											 srcBuffer, 0, { 0u, 0u });
 			}
@@ -70,44 +405,391 @@ namespace sce
 				// TODO
 			}
 
-			res.second.clearTransform();
+			if (transform.test(SceTransformFlag::CpuUpload))
+			{
+				// Only the pages written by CPU are uploaded.
+				auto&        sceBuffer = res.second->buffer();
+				auto&        buffer    = sceBuffer.buffer;
+				auto&        ranges    = res.second->dirtyRanges();
+				uint8_t*     data      = reinterpret_cast<uint8_t*>(res.second->cpuMemory());
+				VkDeviceSize bufSize   = buffer->info().size;
+				bool         swizzled  = isSwizzled(sceBuffer.gnmBuffer);
+				for (const auto& range : ranges)
+				{
+					if (range.offset >= bufSize)
+					{
+						continue;
+					}
+
+					VkDeviceSize size = std::min<VkDeviceSize>(range.size, bufSize - range.offset);
+					if (swizzled)
+					{
+						uploadSwizzledRange(context, sceBuffer, range.offset, size);
+					}
+					else
+					{
+						context->updateBuffer(buffer, range.offset, size, data + range.offset);
+					}
+				}
+				ranges.clear();
+			}
+
+			res.second->clearTransform();
 		}
 	}
 
-	void SceResourceTracker::download(vlt::VltContext* context)
+	void SceResourceTracker::download(
+		VltDevice*  device,
+		VltContext* context,
+		uint64_t    point)
 	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		auto& watch = CPU().writeWatch();
 		for (auto& res : m_resources)
 		{
-			auto type      = res.second.type();
-			auto transform = res.second.transform();
+			auto type      = res.second->type();
+			bool rewritten = res.second->isGpuWritten() &&
+							 type.test(SceResourceType::Buffer) &&
+							 !type.any(SceResourceType::RenderTarget, SceResourceType::DepthRenderTarget);
 
-			if (type.test(SceResourceType::Buffer) &&
-				!type.any(SceResourceType::RenderTarget, SceResourceType::DepthRenderTarget))
+			// A fence not resolved by now still holds the latest
+			// content unless the GPU wrote the buffer again, in
+			// which case the new readback below replaces it.
+			// Either way the streak only learns once the
+			// outcome is known.
+			bool replace = false;
+			if (res.second->isReadbackPending())
 			{
-				auto& buffer   = res.second.buffer().buffer;
-				void* data     = res.second.cpuMemory();
-				auto  memFlags = buffer->memFlags();
-				if (memFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+				bool unread = watch.hasFence(res.first);
+				if (unread && !rewritten)
 				{
-					if (!(memFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
-					{
-						// vkInvalidateMappedMemoryRanges()
-					}
-					std::memcpy(data, buffer->mapPtr(0), buffer->info().size);
+					continue;
 				}
-				else
+
+				res.second->setReadbackStreak(unread ? 0 : res.second->readbackStreak() + 1);
+				res.second->setReadbackPending(false);
+				replace = unread;
+			}
+
+			if (!rewritten)
+			{
+				continue;
+			}
+			res.second->setGpuWritten(false);
+
+			auto callback = prepareReadback(device, context, *res.second);
+			if (res.second->isWatched() &&
+				watch.fence(res.first, res.second->size(), callback))
+			{
+				res.second->setReadbackPending(true);
+			}
+			else
+			{
+				// The old fence must not overwrite this one.
+				if (replace)
+				{
+					watch.unfence(res.first);
+				}
+				m_eagerReadbacks.push_back({ res.first, std::move(callback), point });
+			}
+		}
+	}
+
+	void SceResourceTracker::completeReadbacks(uint64_t point)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		// Those due have been copied by the GPU. Queues
+		// download concurrently, so points aren't sorted.
+		auto end = std::stable_partition(m_eagerReadbacks.begin(), m_eagerReadbacks.end(),
+										 [point](const EagerReadback& readback)
+										 { return readback.point <= point; });
+		runEagerReadbacks(m_eagerReadbacks.begin(), end);
+		m_eagerReadbacks.erase(m_eagerReadbacks.begin(), end);
+	}
+
+	void SceResourceTracker::prefetch()
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		runEagerReadbacks(m_eagerReadbacks.begin(), m_eagerReadbacks.end());
+		m_eagerReadbacks.clear();
+
+		// Every few frames predicted readbacks are left to fault,
+		// so resources the CPU stopped reading lose their streak.
+		uint64_t frame = m_frame.load(std::memory_order_relaxed);
+		if (frame % ReadbackProbeInterval == 0)
+		{
+			return;
+		}
+
+		auto& watch = CPU().writeWatch();
+		for (auto& res : m_resources)
+		{
+			if (res.second->isReadbackPending() &&
+				res.second->readbackStreak() >= ReadbackPrefetchStreak)
+			{
+				watch.resolve(res.first, res.second->size());
+			}
+		}
+	}
+
+	void SceResourceTracker::runEagerReadbacks(
+		std::vector<EagerReadback>::iterator begin,
+		std::vector<EagerReadback>::iterator end)
+	{
+		for (auto iter = begin; iter != end; ++iter)
+		{
+			iter->callback();
+
+			// Unwatched resources are validated by hash,
+			// the readback must not look like a CPU write.
+			auto res = m_resources.find(iter->address);
+			if (res != m_resources.end() && !res->second->isWatched())
+			{
+				res->second->setContentHash(hashContent(*res->second));
+			}
+		}
+	}
+
+	MemoryFenceCallback SceResourceTracker::prepareReadback(
+		VltDevice*   device,
+		VltContext*  context,
+		SceResource& res)
+	{
+		Rc<VltBuffer> src  = res.buffer().buffer;
+		void*         data = res.cpuMemory();
+		size_t        size = std::min<size_t>(res.size(), src->info().size);
+
+		if (!(src->memFlags() & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+		{
+			// Copy device local buffers to a host cached
+			// one on the GPU timeline, CPU reads it later.
+			Rc<VltBuffer> readback = res.readbackBuffer();
+			if (readback == nullptr || readback->info().size < size)
+			{
+				VltBufferCreateInfo info = {};
+				info.size                = size;
+				info.usage               = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+				info.stages              = VK_PIPELINE_STAGE_TRANSFER_BIT;
+				info.access              = VK_ACCESS_TRANSFER_WRITE_BIT;
+				readback                 = device->createBuffer(info,
+																VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+																	VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
+																	VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+				res.setReadbackBuffer(readback);
+			}
+
+			context->copyBuffer(readback, 0, src, 0, size);
+			src = readback;
+		}
+
+		// The GPU copy of swizzled buffers is linear,
+		// records are swizzled back for the guest.
+		// Everything slow happens in wait, while the
+		// guest memory is still fenced.
+		MemoryFenceCallback callback;
+
+		const Gnm::Buffer& vsharp = res.buffer().gnmBuffer;
+		if (isSwizzled(vsharp))
+		{
+			auto swizzled = std::make_shared<std::vector<uint8_t>>();
+
+			callback.wait = [src, size, vsharp, swizzled]()
+			{
+				src->waitIdle(VltAccess::Write);
+
+				uint32_t stride      = vsharp.getStride();
+				uint32_t recordCount = uint32_t(size / stride);
+
+				// The last block is padded, swizzle to a
+				// copy so nothing past the buffer is written.
+				uint64_t swizzledSize = 0;
+				GpuAddress::computeSwizzledBufferSize(
+					Gnm::kGpuModeBase, &swizzledSize, stride, recordCount,
+					vsharp.getSwizzleElementSize(), vsharp.getSwizzleStride());
+
+				swizzled->resize(swizzledSize);
+				int32_t status = GpuAddress::swizzleBufferData(
+					Gnm::kGpuModeBase, swizzled->data(), src->mapPtr(0), stride, recordCount,
+					vsharp.getSwizzleElementSize(), vsharp.getSwizzleStride());
+				if (status != GpuAddress::kStatusSuccess)
 				{
-					context->downloadBuffer(buffer, data);
+					swizzled->clear();
 				}
+			};
+			callback.fill = [data, size, swizzled]()
+			{
+				std::memcpy(data, swizzled->data(), std::min<size_t>(size, swizzled->size()));
+			};
+		}
+		else
+		{
+			callback.wait = [src]()
+			{
+				src->waitIdle(VltAccess::Write);
+			};
+			callback.fill = [src, data, size]()
+			{
+				std::memcpy(data, src->mapPtr(0), size);
+			};
+		}
+		return callback;
+	}
+
+	bool SceResourceTracker::isSwizzled(const Gnm::Buffer& vsharp)
+	{
+		// Same condition the initializer deswizzles on.
+		return vsharp.isSwizzled() && vsharp.getStride() != 0;
+	}
+
+	void SceResourceTracker::uploadSwizzledRange(
+		VltContext*      context,
+		const SceBuffer& buffer,
+		VkDeviceSize     offset,
+		VkDeviceSize     size)
+	{
+		// Records are interleaved in blocks, so the
+		// whole blocks covering the range are deswizzled.
+		// Blocks take the same bytes in both layouts.
+		const Gnm::Buffer& vsharp      = buffer.gnmBuffer;
+		uint32_t           stride      = vsharp.getStride();
+		uint32_t           indexStride = 8u << vsharp.getSwizzleStride();
+		VkDeviceSize       blockBytes  = VkDeviceSize(stride) * indexStride;
+
+		uint32_t recordLimit = uint32_t(std::min<VkDeviceSize>(
+			vsharp.getNumElements(), buffer.buffer->info().size / stride));
+		uint32_t firstRecord = uint32_t(offset / blockBytes) * indexStride;
+		uint32_t endRecord   = uint32_t((offset + size + blockBytes - 1) / blockBytes) * indexStride;
+		endRecord            = std::min(endRecord, recordLimit);
+
+		do
+		{
+			if (firstRecord >= endRecord)
+			{
+				break;
+			}
+
+			uint32_t             recordCount = endRecord - firstRecord;
+			VkDeviceSize         blockOffset = VkDeviceSize(firstRecord) * stride;
+			std::vector<uint8_t> linear(size_t(recordCount) * stride);
+
+			const uint8_t* swizzled = reinterpret_cast<const uint8_t*>(buffer.cpuMemory()) + blockOffset;
+			int32_t        status   = GpuAddress::deswizzleBufferData(
+				Gnm::kGpuModeBase, linear.data(), swizzled, stride, recordCount,
+				vsharp.getSwizzleElementSize(), vsharp.getSwizzleStride());
+			if (status != GpuAddress::kStatusSuccess)
+			{
+				LOG_ERR("failed to deswizzle buffer range %llu", offset);
+				break;
+			}
+
+			context->updateBuffer(buffer.buffer, blockOffset, linear.size(), linear.data());
+		} while (false);
+	}
+
+	void SceResourceTracker::nextFrame()
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		uint64_t frame = m_frame.load(std::memory_order_relaxed);
+		for (auto iter = m_resources.begin(); iter != m_resources.end();)
+		{
+			if (iter->second->lastUsedFrame() + ResourceRetireAge < frame)
+			{
+				iter = release(iter);
+			}
+			else
+			{
+				++iter;
 			}
 		}
+
+		// Resources evicted this long ago would have
+		// been released anyway, a new track is not a re-upload.
+		for (auto iter = m_evicted.begin(); iter != m_evicted.end();)
+		{
+			if (iter->second + ResourceRetireAge < frame)
+			{
+				iter = m_evicted.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
+
+		// Objects retired two frames ago can't
+		// be referenced by any lookup now.
+		auto& retired = m_retired[(frame + 1) & 1];
+		retired.buckets.clear();
+		retired.resources.clear();
+
+		m_frame.store(frame + 1, std::memory_order_release);
+	}
+
+	VkDeviceSize SceResourceTracker::evict(VkDeviceSize size)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		// Resources used in the last frame are likely used
+		// again in the next one, evicting them would only
+		// cause them to be uploaded once more.
+		uint64_t frame = m_frame.load(std::memory_order_relaxed);
+
+		std::vector<std::pair<uint64_t, void*>> candidates;
+		for (auto& res : m_resources)
+		{
+			if (res.second->isGpuWritable() ||
+				res.second->isReadbackPending() ||
+				res.second->lastUsedFrame() + 1 >= frame ||
+				gpuMemorySize(*res.second) == 0)
+			{
+				continue;
+			}
+			candidates.emplace_back(res.second->lastUsedFrame(), res.first);
+		}
+
+		std::sort(candidates.begin(), candidates.end());
+
+		VkDeviceSize freed = 0;
+		for (const auto& candidate : candidates)
+		{
+			if (freed >= size)
+			{
+				break;
+			}
+
+			auto         iter     = m_resources.find(candidate.second);
+			VkDeviceSize resBytes = gpuMemorySize(*iter->second);
+
+			release(iter);
+			m_evicted[candidate.second] = frame;
+
+			freed += resBytes;
+			m_residencyStats.evictions += 1;
+			m_residencyStats.evictedBytes += resBytes;
+		}
+		return freed;
+	}
+
+	SceResidencyStats SceResourceTracker::takeResidencyStats()
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		return std::exchange(m_residencyStats, SceResidencyStats());
 	}
 
 	void SceResourceTracker::reset()
 	{
-		std::lock_guard<util::sync::Spinlock> guard(m_lock);
+		std::lock_guard<std::mutex> guard(m_lock);
+
+		m_evicted.clear();
 
-		m_resources.clear();
+		for (auto iter = m_resources.begin(); iter != m_resources.end();)
+		{
+			iter = release(iter);
+		}
 	}
 
 }  // namespace sce
\ No newline at end of file
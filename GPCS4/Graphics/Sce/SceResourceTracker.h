@@ -1,34 +1,83 @@
 #pragma once
 
 #include "SceCommon.h"
+#include "SceResidencyManager.h"
 #include "SceResource.h"
 #include "UtilSync.h"
 #include "Violet/VltRc.h"
 
-#include <map>
-#include <variant>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace sce
 {
 	namespace vlt
 	{
+		class VltDevice;
 		class VltContext;
 	}  // namespace vlt
 
 
 	/**
 	 * \brief Global resource tracker.
-	 * 
+	 *
 	 * Use to query vulkan object by Gnm resource memory.
 	 * It's thread safe.
-	 * 
+	 *
+	 * Resources persist across frames. Guest memory of
+	 * resources not written by GPU is write watched, CPU
+	 * writes found on lookup are uploaded to buffers before
+	 * the next draw, while other resources are dropped.
+	 *
+	 * If the memory can't be watched, the first lookup
+	 * of a resource in a frame compares the hash of its
+	 * guest memory with the one taken when it was tracked,
+	 * and drops the resource if the content changed.
+	 *
+	 * Lookups are served by a two level page table over
+	 * guest memory without taking any lock. Each 64KB
+	 * granule points to an immutable bucket listing the
+	 * resources overlapping it. Buckets are replaced as a
+	 * whole on change, old buckets and released resources
+	 * are freed once no lookup can reference them anymore,
+	 * which is a full frame later.
+	 *
+	 * Clean resources may be evicted when video memory
+	 * runs over budget, see SceResidencyManager.
+	 *
+	 * Buffers written by GPU are read back lazily. Their
+	 * guest memory is fenced after the frame is submitted
+	 * and the content copied on the first CPU access.
+	 * Resources read by CPU after most frames are copied
+	 * right away instead of taking the fault.
+	 *
 	 */
 	class SceResourceTracker
 	{
-		// use std::greater as the compare function
-		// so that we can find the nearest smaller element 
-		// with a single lower_bound call
-		using SceResourceMap = std::map<void*, SceResource, std::greater<void*>>;
+		using SceResourceMap = std::unordered_map<void*, std::unique_ptr<SceResource>>;
+
+		constexpr static uint32_t GranuleShift = 16;
+		constexpr static uint32_t LeafBits     = 16;
+		constexpr static uint32_t RootBits     = 16;
+		constexpr static size_t   LeafSize     = size_t(1) << LeafBits;
+		constexpr static size_t   RootSize     = size_t(1) << RootBits;
+
+		struct Bucket
+		{
+			std::vector<SceResource*> resources;
+		};
+
+		using Leaf = std::array<std::atomic<Bucket*>, LeafSize>;
+
+		struct RetireList
+		{
+			std::vector<std::unique_ptr<Bucket>>      buckets;
+			std::vector<std::unique_ptr<SceResource>> resources;
+		};
 
 	public:
 		SceResourceTracker();
@@ -36,26 +85,66 @@ namespace sce
 
 		/**
 		 * \brief Track a sce resource type.
+		 *
+		 * Returns the resource tracked at the memory, and
+		 * whether it's newly inserted.
 		 */
 		template <class ResType>
-		std::pair<SceResourceMap::iterator, bool>
+		std::pair<SceResource*, bool>
 		track(ResType&& arg)
 		{
-			std::lock_guard<util::sync::Spinlock> guard(m_lock);
+			std::lock_guard<std::mutex> guard(m_lock);
 
 			void* cpuMem = arg.cpuMemory();
-			return m_resources.emplace(cpuMem, std::forward<ResType>(arg));
+			auto  result = m_resources.emplace(cpuMem, nullptr);
+			if (result.second)
+			{
+				auto& res = result.first->second;
+				res       = std::make_unique<SceResource>(std::forward<ResType>(arg));
+				stamp(*res);
+				insert(res.get());
+
+				if (m_evicted.erase(cpuMem))
+				{
+					m_residencyStats.reuploads += 1;
+					m_residencyStats.reuploadedBytes += gpuMemorySize(*res);
+				}
+			}
+			return std::make_pair(result.first->second.get(), result.second);
 		}
 
 		/**
 		 * \brief Find resource object by memory pointer
-		 * 
+		 *
 		 * The memory is not limited to the start address of a object,
-		 * it can be any address 
+		 * it can be any address
 		 * from start to end(not included) within the object memory.
+		 * A resource starting at the address is preferred over
+		 * others covering it.
+		 *
+		 * Returns null if the guest memory of an image
+		 * resource has changed since it was tracked.
 		 */
 		SceResource* find(void* mem);
 
+		/**
+		 * \brief Find resources overlapping a memory range
+		 *
+		 * e.g. a buffer aliasing a texture or render target.
+		 * Resources are not validated.
+		 */
+		void findOverlaps(
+			void*                      start,
+			size_t                     size,
+			std::vector<SceResource*>& result) const;
+
+		/**
+		 * \brief Drop resources within a memory range
+		 *
+		 * Called when guest memory is unmapped.
+		 */
+		void invalidate(void* start, size_t size);
+
 		/**
 		 * \brief Apple pending transforms
 		 */
@@ -63,19 +152,140 @@ namespace sce
 
 		/**
 		 * \brief Download resource memory
-		 * 
-		 * Transfer resource memory from GPU to CPU
-		 * 
+		 *
+		 * Records copies of buffers written by GPU in this
+		 * frame and fences their guest memory. The content
+		 * reaches guest memory on the first CPU access, or
+		 * in prefetch for resources which are usually read.
+		 * Fences not accessed yet are kept until the GPU
+		 * writes the buffer again.
+		 *
+		 * Called before every label write, since labels reach
+		 * guest memory while the frame is still executing and
+		 * the guest may read the buffers once it sees one.
+		 * \param [in] device Device to create readback buffers
+		 * \param [in] context Context to record the copies
+		 * \param [in] point Label timeline point following the
+		 *        copies, resources which can't be fenced are
+		 *        copied before that point is written
 		 */
-		void download(vlt::VltContext* context);
+		void download(
+			vlt::VltDevice*  device,
+			vlt::VltContext* context,
+			uint64_t         point);
+
+		/**
+		 * \brief Complete readbacks due at a label point
+		 *
+		 * Called by the label completion thread before the
+		 * label of \p point is written to guest memory. Copies
+		 * resources which can't be fenced and were downloaded
+		 * ahead of that point.
+		 * \param [in] point Label timeline point
+		 */
+		void completeReadbacks(uint64_t point);
+
+		/**
+		 * \brief Complete predicted readbacks
+		 *
+		 * Copies resources which can't be fenced
+		 * and those read by CPU in recent frames.
+		 */
+		void prefetch();
+
+		/**
+		 * \brief Begin a new frame
+		 *
+		 * Resources are revalidated on first use in the
+		 * new frame, those not used for a while are released.
+		 */
+		void nextFrame();
+
+		/**
+		 * \brief Evict least recently used resources
+		 *
+		 * Only resources whose content is in guest memory
+		 * and which were not used in the last frame are
+		 * evicted, oldest first.
+		 *
+		 * Returns the amount of device local memory freed.
+		 */
+		VkDeviceSize evict(VkDeviceSize size);
+
+		/**
+		 * \brief Residency statistics since the last call
+		 */
+		SceResidencyStats takeResidencyStats();
 
 		/**
 		 * \brief Clear all information in the tracker
 		 */
 		void reset();
-		
+
 	private:
-		util::sync::Spinlock m_lock;
-		SceResourceMap       m_resources;
+		struct EagerReadback
+		{
+			void*               address;
+			MemoryFenceCallback callback;
+			uint64_t            point;
+		};
+
+		void stamp(SceResource& res);
+
+		bool isCurrent(const SceResource& res) const;
+
+		bool validate(SceResource& res);
+
+		SceResourceMap::iterator release(SceResourceMap::iterator iter);
+
+		SceResource* lookup(void* mem) const;
+
+		Bucket* getBucket(size_t granule) const;
+
+		std::atomic<Bucket*>& getBucketSlot(size_t granule);
+
+		void insert(SceResource* res);
+
+		void remove(SceResource* res);
+
+		void publish(std::atomic<Bucket*>& slot, std::unique_ptr<Bucket>&& bucket);
+
+		static uint64_t hashContent(const SceResource& res);
+
+		static VkDeviceSize gpuMemorySize(const SceResource& res);
+
+		MemoryFenceCallback prepareReadback(
+			vlt::VltDevice*  device,
+			vlt::VltContext* context,
+			SceResource&     res);
+
+		static bool isSwizzled(const Gnm::Buffer& vsharp);
+
+		void runEagerReadbacks(
+			std::vector<EagerReadback>::iterator begin,
+			std::vector<EagerReadback>::iterator end);
+
+		static void uploadSwizzledRange(
+			vlt::VltContext* context,
+			const SceBuffer& buffer,
+			VkDeviceSize     offset,
+			VkDeviceSize     size);
+
+	private:
+		std::mutex             m_lock;
+		SceResourceMap         m_resources;
+		std::atomic<uint64_t>  m_frame = { 1 };
+
+		std::unique_ptr<std::atomic<Leaf*>[]> m_root;
+		std::array<RetireList, 2>             m_retired;
+
+		// Guest memory of evicted resources and the frame they
+		// were evicted in, to tell re-uploads from new resources.
+		std::unordered_map<void*, uint64_t> m_evicted;
+		SceResidencyStats                   m_residencyStats;
+
+		// Readbacks to complete in prefetch or before the label
+		// point they precede, with the resource they belong to.
+		std::vector<EagerReadback> m_eagerReadbacks;
 	};
-}  // namespace sce
\ No newline at end of file
+}  // namespace sce
@@ -0,0 +1,126 @@
+#include "SceSamplerCache.h"
+
+#include "Violet/VltSampler.h"
+
+#include <cstring>
+
+LOG_CHANNEL(Graphic.Sce.SceSamplerCache);
+
+namespace sce
+{
+	using namespace Gnm;
+	using namespace vlt;
+
+	static inline bool isBorderWrapMode(uint64_t mode)
+	{
+		// kWrapModeClampHalfBorder to kWrapModeMirrorOnceBorder
+		return mode >= kWrapModeClampHalfBorder;
+	}
+
+	SceSamplerKey::SceSamplerKey(const Sampler& ssharp)
+	{
+		static_assert(sizeof(SSharpBuffer) == sizeof(qwords), "S# size mismatch.");
+
+		const SSharpBuffer& src = ssharp.getSsharp();
+
+		// Only copy fields the sampler is created from,
+		// keep in sync with GnmResourceFactory::createSampler.
+		SSharpBuffer dst       = {};
+		dst.clamp_x            = src.clamp_x;
+		dst.clamp_y            = src.clamp_y;
+		dst.clamp_z            = src.clamp_z;
+		dst.max_aniso_ratio    = src.max_aniso_ratio;
+		dst.depth_compare_func = src.depth_compare_func;
+		dst.force_unorm_coords = src.force_unorm_coords;
+		dst.min_lod            = src.min_lod;
+		dst.max_lod            = src.max_lod;
+		dst.lod_bias           = src.lod_bias;
+		dst.xy_mag_filter      = src.xy_mag_filter;
+		dst.xy_min_filter      = src.xy_min_filter;
+		dst.mip_filter         = src.mip_filter;
+
+		if (src.max_aniso_ratio != kAnisotropyRatio1)
+		{
+			dst.aniso_threshold = src.aniso_threshold;
+		}
+
+		if (isBorderWrapMode(src.clamp_x) ||
+			isBorderWrapMode(src.clamp_y) ||
+			isBorderWrapMode(src.clamp_z))
+		{
+			dst.border_color_type = src.border_color_type;
+		}
+
+		std::memcpy(qwords, &dst, sizeof(qwords));
+	}
+
+	size_t SceSamplerKey::hash() const
+	{
+		VltHashState state;
+		state.add(std::hash<uint64_t>()(qwords[0]));
+		state.add(std::hash<uint64_t>()(qwords[1]));
+		return state;
+	}
+
+	bool SceSamplerKey::eq(const SceSamplerKey& other) const
+	{
+		return qwords[0] == other.qwords[0] &&
+			   qwords[1] == other.qwords[1];
+	}
+
+	SceSamplerCache::SceSamplerCache()
+	{
+	}
+
+	SceSamplerCache::~SceSamplerCache()
+	{
+		auto stats = getStats();
+		LOG_DEBUG("sampler cache: %zu samplers, %llu lookups, hit rate %.2f%%.",
+				  stats.samplerCount,
+				  stats.lookupCount,
+				  stats.hitRate() * 100.0f);
+	}
+
+	Rc<VltSampler> SceSamplerCache::find(const SceSamplerKey& key)
+	{
+		Rc<VltSampler> sampler;
+
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			auto iter = m_samplers.find(key);
+			if (iter != m_samplers.end())
+			{
+				sampler = iter->second;
+			}
+		}
+
+		m_lookupCount.fetch_add(1, std::memory_order_relaxed);
+		if (sampler != nullptr)
+		{
+			m_hitCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		return sampler;
+	}
+
+	Rc<VltSampler> SceSamplerCache::add(
+		const SceSamplerKey&  key,
+		const Rc<VltSampler>& sampler)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		auto result = m_samplers.emplace(key, sampler);
+		return result.first->second;
+	}
+
+	SceSamplerCacheStats SceSamplerCache::getStats()
+	{
+		SceSamplerCacheStats stats;
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			stats.samplerCount = m_samplers.size();
+		}
+		stats.lookupCount = m_lookupCount.load(std::memory_order_relaxed);
+		stats.hitCount    = m_hitCount.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+}  // namespace sce
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "SceCommon.h"
+#include "Gnm/GnmSampler.h"
+#include "Violet/VltHash.h"
+#include "Violet/VltRc.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace sce
+{
+	namespace vlt
+	{
+		class VltSampler;
+	}  // namespace vlt
+
+	/**
+	 * \brief Sampler cache key
+	 *
+	 * The S# with fields not affecting the created
+	 * sampler cleared, so that descriptors differing
+	 * only in such fields share one sampler.
+	 */
+	struct SceSamplerKey
+	{
+		SceSamplerKey(const Gnm::Sampler& ssharp);
+
+		uint64_t qwords[2];
+
+		size_t hash() const;
+
+		bool eq(const SceSamplerKey& other) const;
+	};
+
+	/**
+	 * \brief Sampler cache statistics
+	 */
+	struct SceSamplerCacheStats
+	{
+		size_t   samplerCount;
+		uint64_t lookupCount;
+		uint64_t hitCount;
+
+		float hitRate() const
+		{
+			return lookupCount ? float(hitCount) / float(lookupCount) : 0.0f;
+		}
+	};
+
+	/**
+	 * \brief Global sampler cache
+	 *
+	 * Samplers are looked up by canonicalized S#,
+	 * identical descriptors share a single sampler
+	 * object for the lifetime of the device.
+	 * It's thread safe.
+	 */
+	class SceSamplerCache
+	{
+	public:
+		SceSamplerCache();
+		~SceSamplerCache();
+
+		/**
+		 * \brief Find sampler for a S#
+		 *
+		 * Returns null if no sampler is created yet.
+		 */
+		vlt::Rc<vlt::VltSampler> find(const SceSamplerKey& key);
+
+		/**
+		 * \brief Add a newly created sampler
+		 *
+		 * If another thread added a sampler for the
+		 * same key in the meantime, that one is kept
+		 * and returned instead.
+		 */
+		vlt::Rc<vlt::VltSampler> add(
+			const SceSamplerKey&            key,
+			const vlt::Rc<vlt::VltSampler>& sampler);
+
+		/**
+		 * \brief Retrieve cache statistics
+		 */
+		SceSamplerCacheStats getStats();
+
+	private:
+		std::mutex m_mutex;
+
+		std::unordered_map<
+			SceSamplerKey,
+			vlt::Rc<vlt::VltSampler>,
+			vlt::VltHash,
+			vlt::VltEq>
+			m_samplers;
+
+		std::atomic<uint64_t> m_lookupCount = { 0 };
+		std::atomic<uint64_t> m_hitCount    = { 0 };
+	};
+}  // namespace sce
@@ -1,4 +1,6 @@
 #include "SceSwapchain.h"
+#include "Emulator.h"
+#include "VirtualGPU.h"
 
 #include "ScePresenter.h"
 #include "SceSwapchainBlitter.h"
@@ -12,6 +14,8 @@
 using namespace sce::vlt;
 using namespace sce::Gnm;
 
+LOG_CHANNEL(Graphic.Sce.SceSwapchain);
+
 namespace sce
 {
 	SceSwapchain::SceSwapchain(
@@ -26,6 +30,8 @@ namespace sce
 		createSwapImageViews();
 
 		createRenderTargets();
+
+		m_presentMode = pickPresentMode();
 	}
 
 	SceSwapchain::~SceSwapchain()
@@ -63,10 +69,37 @@ namespace sce
 			VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
 			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
-		// Record draw commands to copy render target image to swapchain image.
-		m_blitter->presentImage(m_context.ptr(),
-								m_imageViews.at(imageIndex), VkRect2D(),
-								target.imageView, VkRect2D());
+		// Copy render target image to swapchain image.
+		auto& swapImage = m_imageViews.at(imageIndex)->image();
+
+		VkImageSubresourceLayers subresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		VkExtent3D               extent      = target.image->mipLevelExtent(0);
+		switch (m_presentMode)
+		{
+			case SceSwapchainPresentMode::Copy:
+				m_context->copyImage(swapImage, subresource, VkOffset3D{ 0, 0, 0 },
+									 target.image, subresource, VkOffset3D{ 0, 0, 0 },
+									 extent);
+				break;
+			case SceSwapchainPresentMode::Blit:
+			{
+				VkImageBlit region;
+				region.srcSubresource = subresource;
+				region.srcOffsets[0]  = VkOffset3D{ 0, 0, 0 };
+				region.srcOffsets[1]  = VkOffset3D{ int32_t(extent.width), int32_t(extent.height), 1 };
+				region.dstSubresource = subresource;
+				region.dstOffsets[0]  = region.srcOffsets[0];
+				region.dstOffsets[1]  = region.srcOffsets[1];
+				m_context->blitImage(swapImage, target.image, region, VK_FILTER_NEAREST);
+			}
+				break;
+			case SceSwapchainPresentMode::Draw:
+				// Record draw commands to scale render target image to swapchain image.
+				m_blitter->presentImage(m_context.ptr(),
+										m_imageViews.at(imageIndex), VkRect2D(),
+										target.imageView, VkRect2D());
+				break;
+		}
 
 		auto cmdList = m_context->endRecording();
 
@@ -142,9 +175,9 @@ namespace sce
 			imageInfo.extent        = { attribute.width, attribute.height, 1 };
 			imageInfo.numLayers     = 1;
 			imageInfo.mipLevels     = 1;
-			imageInfo.usage         = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-			imageInfo.stages        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-			imageInfo.access        = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+			imageInfo.usage         = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+			imageInfo.stages        = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+			imageInfo.access        = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
 			imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
 			imageInfo.layout        = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
@@ -199,9 +232,9 @@ namespace sce
 		imageInfo.extent      = { info.imageExtent.width, info.imageExtent.height, 1 };
 		imageInfo.numLayers   = 1;
 		imageInfo.mipLevels   = 1;
-		imageInfo.usage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-		imageInfo.stages      = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-		imageInfo.access      = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		imageInfo.usage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		imageInfo.stages      = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+		imageInfo.access      = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
 		imageInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
 		imageInfo.layout      = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
@@ -227,4 +260,49 @@ namespace sce
 		}
 	}
 
+	SceSwapchainPresentMode SceSwapchain::pickPresentMode() const
+	{
+		// The shader draw is only needed to scale, if the
+		// sizes match a transfer is enough and cheaper.
+		auto          mode = SceSwapchainPresentMode::Draw;
+		PresenterInfo info = m_presenter->info();
+		do
+		{
+			if (m_renderTargets.empty())
+			{
+				break;
+			}
+
+			const auto& srcImage  = m_renderTargets.front().image;
+			VkExtent3D  srcExtent = srcImage->mipLevelExtent(0);
+			VkFormat    srcFormat = srcImage->info().format;
+			VkFormat    dstFormat = info.format.format;
+			if (srcExtent.width != info.imageExtent.width ||
+				srcExtent.height != info.imageExtent.height)
+			{
+				break;
+			}
+
+			if (srcFormat == dstFormat)
+			{
+				mode = SceSwapchainPresentMode::Copy;
+				break;
+			}
+
+			auto adapter     = m_device.device->adapter();
+			auto srcFeatures = adapter->formatProperties(srcFormat).optimalTilingFeatures;
+			auto dstFeatures = adapter->formatProperties(dstFormat).optimalTilingFeatures;
+			if ((srcFeatures & VK_FORMAT_FEATURE_BLIT_SRC_BIT) &&
+				(dstFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT))
+			{
+				mode = SceSwapchainPresentMode::Blit;
+			}
+		} while (false);
+
+		LOG_DEBUG("swapchain %dx%d, present mode %d",
+				  info.imageExtent.width, info.imageExtent.height,
+				  uint32_t(mode));
+		return mode;
+	}
+
 }  // namespace sce
\ No newline at end of file
@@ -25,6 +25,16 @@ namespace sce
 		SceVideoOut*     videoOut;
 	};
 
+	/**
+	 * \brief How display buffers reach the swapchain
+	 */
+	enum class SceSwapchainPresentMode : uint32_t
+	{
+		Copy,  ///< Same size and format, image copy
+		Blit,  ///< Same size, format converted by a blit
+		Draw,  ///< Scaled by the blitter shaders
+	};
+
 	class SceSwapchain
 	{
 	public:
@@ -42,6 +52,8 @@ namespace sce
 		 * \brief Present 
 		 * 
 		 * Draw the image specified by index to swapchain.
+		 * The image is transferred without a draw if the
+		 * display buffer matches the swapchain size.
 		 */
 		void present(uint32_t index);
 
@@ -53,6 +65,8 @@ namespace sce
 
 		void createSwapImageViews();
 
+		SceSwapchainPresentMode pickPresentMode() const;
+
 	private:
 		SceSwapchainDevice m_device;
 
@@ -63,6 +77,8 @@ namespace sce
 		vlt::Rc<SceSwapchainBlitter>            m_blitter;
 
 		std::vector<SceRenderTarget> m_renderTargets;
+
+		SceSwapchainPresentMode m_presentMode = SceSwapchainPresentMode::Draw;
 	};
 
 }  // namespace sce
\ No newline at end of file
@@ -425,6 +425,7 @@ namespace sce::vlt
 		enabled.core.features.tessellationShader = VK_TRUE;
 		enabled.core.features.logicOp            = VK_TRUE;
 		enabled.core.features.imageCubeArray     = VK_TRUE;
+		enabled.core.features.multiDrawIndirect  = supported.core.features.multiDrawIndirect;
 
 		enabled.vk11.sType                = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
 		enabled.vk11.pNext                = std::exchange(enabled.core.pNext, &enabled.vk11);
@@ -461,10 +462,11 @@ namespace sce::vlt
 	{
 		VltDeviceExtensions devExtensions;
 
-		std::array<VltExt*, 4> devExtensionList = { {
+		std::array<VltExt*, 5> devExtensionList = { {
 			&devExtensions.extMemoryBudget,
 			&devExtensions.extMemoryPriority,
 			&devExtensions.extDepthClipEnable,
+			&devExtensions.khrPushDescriptor,
 			&devExtensions.khrSwapchain,
 		} };
 
@@ -684,6 +686,12 @@ namespace sce::vlt
 			m_deviceInfo.khrDeviceDriverProperties.pNext = std::exchange(m_deviceInfo.core.pNext, &m_deviceInfo.khrDeviceDriverProperties);
 		}
 
+		if (m_deviceExtensions.supports(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+		{
+			m_deviceInfo.khrPushDescriptor.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+			m_deviceInfo.khrPushDescriptor.pNext = std::exchange(m_deviceInfo.core.pNext, &m_deviceInfo.khrPushDescriptor);
+		}
+
 		if (m_deviceExtensions.supports(VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME))
 		{
 			m_deviceInfo.khrShaderFloatControls.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FLOAT_CONTROLS_PROPERTIES_KHR;
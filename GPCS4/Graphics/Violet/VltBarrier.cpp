@@ -4,6 +4,10 @@
 #include "VltImage.h"
 #include "VltUtil.h"
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
 namespace sce::vlt
 {
 
@@ -38,6 +42,13 @@ namespace sce::vlt
 		VkPipelineStageFlags2       dstStages,
 		VkAccessFlags2              dstAccess)
 	{
+		// Nothing to wait for, e.g. the first use
+		if (!srcStages && !srcAccess)
+		{
+			m_stats.elided += 1;
+			return;
+		}
+
 		VltAccessFlags access = vutil::getAccessTypes(srcAccess);
 
 		if (srcStages == VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT ||
@@ -50,6 +61,31 @@ namespace sce::vlt
 		m_memBarrier.srcAccessMask |= srcAccess;
 		m_memBarrier.dstAccessMask |= dstAccess;
 
+		// Consecutive accesses to one buffer, like chunked
+		// uploads, extend the last slice to keep lookups short.
+		if (!m_bufSlices.empty())
+		{
+			BufSlice& last = m_bufSlices.back();
+
+			if (last.slice.handle == bufSlice.handle &&
+				last.access == access &&
+				last.slice.offset <= bufSlice.offset + bufSlice.length &&
+				bufSlice.offset <= last.slice.offset + last.slice.length)
+			{
+				VkDeviceSize end = std::max(last.slice.offset + last.slice.length,
+											bufSlice.offset + bufSlice.length);
+
+				if (bufSlice.offset < last.slice.offset)
+				{
+					last.slice.offset = bufSlice.offset;
+					last.slice.mapPtr = bufSlice.mapPtr;
+				}
+
+				last.slice.length = end - last.slice.offset;
+				return;
+			}
+		}
+
 		m_bufSlices.push_back({ bufSlice, access });
 	}
 
@@ -63,6 +99,13 @@ namespace sce::vlt
 		VkPipelineStageFlags2          dstStages,
 		VkAccessFlags2                 dstAccess)
 	{
+		// Nothing to wait for and no transition
+		if (!srcStages && !srcAccess && srcLayout == dstLayout)
+		{
+			m_stats.elided += 1;
+			return;
+		}
+
 		VltAccessFlags access = vutil::getAccessTypes(srcAccess);
 
 		if (srcStages == VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT ||
@@ -94,7 +137,11 @@ namespace sce::vlt
 			barrier.image                       = image->handle();
 			barrier.subresourceRange            = subresources;
 			barrier.subresourceRange.aspectMask = image->formatInfo()->aspectMask;
-			m_imgBarriers.push_back(barrier);
+
+			if (this->foldImageBarrier(barrier))
+				m_stats.elided += 1;
+			else
+				m_imgBarriers.push_back(barrier);
 		}
 
 		m_imgSlices.push_back({ image.ptr(), subresources, access });
@@ -284,6 +331,10 @@ namespace sce::vlt
 
 			commandList->cmdPipelineBarrier2(m_cmdBuffer, &dependency);
 
+			m_stats.batches += 1;
+			m_stats.bufferBarriers += m_bufBarriers.size();
+			m_stats.imageBarriers += m_imgBarriers.size();
+
 			this->reset();
 		}
 	}
@@ -304,6 +355,99 @@ namespace sce::vlt
 		m_imgSlices.resize(0);
 	}
 
+	VltBarrierStats VltBarrierSet::takeStats()
+	{
+		return std::exchange(m_stats, VltBarrierStats());
+	}
+
+	bool VltBarrierSet::foldImageBarrier(
+		const VkImageMemoryBarrier2& barrier)
+	{
+		for (auto iter = m_imgBarriers.rbegin(); iter != m_imgBarriers.rend(); ++iter)
+		{
+			auto& pending = *iter;
+
+			// Ownership transfers must stay as they are
+			if (pending.image != barrier.image ||
+				pending.srcQueueFamilyIndex != VK_QUEUE_FAMILY_IGNORED)
+				continue;
+
+			auto&       range = pending.subresourceRange;
+			const auto& other = barrier.subresourceRange;
+
+			bool sameRange = range.baseMipLevel == other.baseMipLevel &&
+							 range.levelCount == other.levelCount &&
+							 range.baseArrayLayer == other.baseArrayLayer &&
+							 range.layerCount == other.layerCount;
+
+			// The subresources are not used before the pending
+			// transition executes, or it would have been recorded,
+			// so both transitions can be done at once.
+			if (sameRange && pending.newLayout == barrier.oldLayout)
+			{
+				pending.newLayout     = barrier.newLayout;
+				pending.dstStageMask  = barrier.dstStageMask;
+				pending.dstAccessMask = barrier.dstAccessMask;
+
+				// Transitioned back, only the memory dependency is left
+				if (pending.oldLayout == pending.newLayout)
+				{
+					m_memBarrier.srcStageMask |= pending.srcStageMask;
+					m_memBarrier.srcAccessMask |= pending.srcAccessMask;
+					m_memBarrier.dstStageMask |= pending.dstStageMask;
+					m_memBarrier.dstAccessMask |= pending.dstAccessMask;
+					m_imgBarriers.erase(std::next(iter).base());
+				}
+
+				return true;
+			}
+
+			if (pending.oldLayout == barrier.oldLayout &&
+				pending.newLayout == barrier.newLayout &&
+				pending.srcStageMask == barrier.srcStageMask &&
+				pending.srcAccessMask == barrier.srcAccessMask &&
+				pending.dstStageMask == barrier.dstStageMask &&
+				pending.dstAccessMask == barrier.dstAccessMask &&
+				mergeImageRange(range, other))
+				return true;
+		}
+
+		return false;
+	}
+
+	bool VltBarrierSet::mergeImageRange(
+		VkImageSubresourceRange&       dst,
+		const VkImageSubresourceRange& src)
+	{
+		if (dst.levelCount == VK_REMAINING_MIP_LEVELS || src.levelCount == VK_REMAINING_MIP_LEVELS ||
+			dst.layerCount == VK_REMAINING_ARRAY_LAYERS || src.layerCount == VK_REMAINING_ARRAY_LAYERS)
+			return false;
+
+		if (dst.baseMipLevel == src.baseMipLevel && dst.levelCount == src.levelCount)
+		{
+			if (src.baseArrayLayer == dst.baseArrayLayer + dst.layerCount ||
+				src.baseArrayLayer + src.layerCount == dst.baseArrayLayer)
+			{
+				dst.baseArrayLayer = std::min(dst.baseArrayLayer, src.baseArrayLayer);
+				dst.layerCount += src.layerCount;
+				return true;
+			}
+		}
+
+		if (dst.baseArrayLayer == src.baseArrayLayer && dst.layerCount == src.layerCount)
+		{
+			if (src.baseMipLevel == dst.baseMipLevel + dst.levelCount ||
+				src.baseMipLevel + src.levelCount == dst.baseMipLevel)
+			{
+				dst.baseMipLevel = std::min(dst.baseMipLevel, src.baseMipLevel);
+				dst.levelCount += src.levelCount;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	bool VltBarrierSet::isBufferOverlapped(
 		const VltBufferSliceHandle& lhs,
 		const VltBufferSliceHandle& rhs)
@@ -8,12 +8,38 @@ namespace sce::vlt
 {
 	class VltImage;
 
+	/**
+     * \brief Barrier statistics
+     */
+	struct VltBarrierStats
+	{
+		uint32_t batches        = 0;  ///< Pipeline barrier commands recorded
+		uint32_t bufferBarriers = 0;  ///< Buffer memory barriers recorded
+		uint32_t imageBarriers  = 0;  ///< Image memory barriers recorded
+		uint32_t elided         = 0;  ///< Barriers dropped or merged into others
+	};
+
 	/**
      * \brief Barrier set
      * 
      * Accumulates memory barriers and provides a
      * method to record all those barriers into a
      * command buffer at once.
+     * 
+     * Barriers without a source scope are dropped.
+     * A layout transition of subresources which are
+     * already pending a transition is folded into it,
+     * and transitions of adjacent subresources with
+     * identical parameters share one image barrier.
+     * 
+     * All tracking is scoped to one batch, i.e. up to
+     * the next \ref recordCommands or \ref reset, and
+     * nothing is kept per resource across batches or
+     * command list flushes. Every access the context
+     * declares describes work recorded after the last
+     * batch, so an older barrier can't make it redundant.
+     * The current layout of an image is owned by the
+     * image info (see \ref VltImage::updateLayout).
      */
 	class VltBarrierSet
 	{
@@ -97,9 +123,29 @@ namespace sce::vlt
 		void recordCommands(
 			const Rc<VltCommandList>& commandList);
 
+		/**
+         * \brief Drops all pending barriers
+         * 
+         * Also forgets the buffer and image slices
+         * used for dirty checks, no per-resource
+         * state outlives this call.
+         */
 		void reset();
 
+		/**
+         * \brief Retrieves and resets statistics
+         * \returns Barrier statistics since the last call
+         */
+		VltBarrierStats takeStats();
+
 	private:
+		bool foldImageBarrier(
+			const VkImageMemoryBarrier2& barrier);
+
+		static bool mergeImageRange(
+			VkImageSubresourceRange&       dst,
+			const VkImageSubresourceRange& src);
+
 		bool isBufferOverlapped(
 			const VltBufferSliceHandle& lhs,
 			const VltBufferSliceHandle& rhs);
@@ -136,5 +182,7 @@ namespace sce::vlt
 
 		std::vector<BufSlice> m_bufSlices;
 		std::vector<ImgSlice> m_imgSlices;
+
+		VltBarrierStats m_stats;
 	};
 }  // namespace sce::vlt
\ No newline at end of file
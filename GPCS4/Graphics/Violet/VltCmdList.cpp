@@ -4,9 +4,14 @@
 
 namespace sce::vlt
 {
-	VltCommandList::VltCommandList(VltDevice* device, VltQueueType queueType) :
+	VltCommandList::VltCommandList(
+		VltDevice*           device,
+		VltQueueType         queueType,
+		VkCommandBufferLevel level) :
 		m_device(device),
 		m_queueType(queueType),
+		m_level(level),
+		m_pfnCmdPushDescriptorSetWithTemplate(device->pfnCmdPushDescriptorSetWithTemplate()),
 		m_cmdBuffersUsed(0),
 		m_descriptorPoolTracker(device),
 		m_debug(device)
@@ -45,14 +50,14 @@ namespace sce::vlt
 		cmdInfoExec.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 		cmdInfoExec.pNext              = nullptr;
 		cmdInfoExec.commandPool        = m_execPool;
-		cmdInfoExec.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		cmdInfoExec.level              = level;
 		cmdInfoExec.commandBufferCount = 1;
 
 		VkCommandBufferAllocateInfo cmdInfoDma;
 		cmdInfoDma.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 		cmdInfoDma.pNext              = nullptr;
 		cmdInfoDma.commandPool        = m_transferPool ? m_transferPool : m_execPool;
-		cmdInfoDma.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		cmdInfoDma.level              = level;
 		cmdInfoDma.commandBufferCount = 1;
 
 
@@ -61,7 +66,7 @@ namespace sce::vlt
 			vkAllocateCommandBuffers(m_device->handle(), &cmdInfoDma, &m_transBuffer) != VK_SUCCESS)
 			Logger::exception("DxvkCommandList: Failed to allocate command buffer");
 
-		if (m_device->hasDedicatedTransferQueue())
+		if (m_device->hasDedicatedTransferQueue() && !isSecondary())
 		{
 			VkSemaphoreCreateInfo semInfo;
 			semInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -151,11 +156,23 @@ namespace sce::vlt
 
 	void VltCommandList::beginRecording()
 	{
+		// Secondary lists hold whole render passes,
+		// so there is no render pass state to inherit.
+		VkCommandBufferInheritanceInfo inheritance;
+		inheritance.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritance.pNext                = nullptr;
+		inheritance.renderPass           = VK_NULL_HANDLE;
+		inheritance.subpass              = 0;
+		inheritance.framebuffer          = VK_NULL_HANDLE;
+		inheritance.occlusionQueryEnable = VK_FALSE;
+		inheritance.queryFlags           = 0;
+		inheritance.pipelineStatistics   = 0;
+
 		VkCommandBufferBeginInfo info;
 		info.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 		info.pNext            = nullptr;
 		info.flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-		info.pInheritanceInfo = nullptr;
+		info.pInheritanceInfo = isSecondary() ? &inheritance : nullptr;
 
 		if ((m_execPool && vkResetCommandPool(m_device->handle(), m_execPool, 0) != VK_SUCCESS) ||
 			(m_transferPool && vkResetCommandPool(m_device->handle(), m_transferPool, 0) != VK_SUCCESS))
@@ -182,6 +199,25 @@ namespace sce::vlt
 			Logger::err("DxvkCommandList::endRecording: Failed to record command buffer");
 	}
 
+	void VltCommandList::executeCommands(
+		const Rc<VltCommandList>& secondary)
+	{
+		for (auto type : { VltCmdType::TransferBuffer,
+						   VltCmdType::InitBuffer,
+						   VltCmdType::ExecBuffer })
+		{
+			if (!secondary->m_cmdBuffersUsed.test(type))
+				continue;
+
+			VkCommandBuffer cmdBuffer = secondary->getCmdBuffer(type);
+			vkCmdExecuteCommands(getCmdBuffer(type), 1, &cmdBuffer);
+
+			m_cmdBuffersUsed.set(type);
+		}
+
+		m_secondaries.push_back(secondary);
+	}
+
 	void VltCommandList::reset()
 	{
 		// Signal resources and events to
@@ -196,6 +232,15 @@ namespace sce::vlt
 		m_gpuEventTracker.reset();
 		m_semaphoreTracker.reset();
 		//m_gpuQueryTracker.reset();
+
+		// Secondary lists completed with this one
+		for (const auto& secondary : m_secondaries)
+		{
+			secondary->reset();
+			m_device->recycleCommandList(secondary);
+		}
+
+		m_secondaries.clear();
 	}
 
 	VkResult VltCommandList::submitToQueue(
@@ -69,8 +69,9 @@ namespace sce::vlt
 
 	public:
 		VltCommandList(
-			VltDevice*   device,
-			VltQueueType queueType);
+			VltDevice*           device,
+			VltQueueType         queueType,
+			VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 		virtual ~VltCommandList();
 
 		/**
@@ -81,6 +82,17 @@ namespace sce::vlt
 			return m_queueType;
 		}
 
+		/**
+		 * \brief Checks whether this is a secondary command list
+		 *
+		 * Secondary command lists are never submitted on their
+		 * own, they are executed from a primary command list.
+		 */
+		bool isSecondary() const
+		{
+			return m_level == VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+		}
+
 		/**
          * \brief Submits command list
          * 
@@ -119,6 +131,20 @@ namespace sce::vlt
          */
 		void endRecording();
 
+		/**
+		 * \brief Executes a secondary command list
+		 *
+		 * Each command buffer of the secondary list is executed
+		 * from the matching command buffer of this list, so its
+		 * uploads still run before any exec buffer work. The
+		 * secondary list must contain complete render passes.
+		 *
+		 * The secondary list is kept alive and reset together
+		 * with this list. Semaphores queued on it are ignored.
+		 * \param [in] secondary Finished secondary command list
+		 */
+		void executeCommands(
+			const Rc<VltCommandList>& secondary);
 
 		/**
          * \brief Adds a resource to track
@@ -377,6 +403,16 @@ namespace sce::vlt
 						   regionCount, pRegions, filter);
 		}
 
+		void cmdPushDescriptorSetWithTemplate(
+			VkDescriptorUpdateTemplate descriptorTemplate,
+			VkPipelineLayout           layout,
+			uint32_t                   set,
+			const void*                pData)
+		{
+			m_pfnCmdPushDescriptorSetWithTemplate(m_execBuffer,
+												  descriptorTemplate, layout, set, pData);
+		}
+
 		void cmdClearAttachments(
 			uint32_t                 attachmentCount,
 			const VkClearAttachment* pAttachments,
@@ -540,7 +576,7 @@ namespace sce::vlt
 			uint32_t indexCount,
 			uint32_t instanceCount,
 			uint32_t firstIndex,
-			uint32_t vertexOffset,
+			int32_t  vertexOffset,
 			uint32_t firstInstance)
 		{
 			vkCmdDrawIndexed(m_execBuffer,
@@ -843,8 +879,9 @@ namespace sce::vlt
 			const VltQueueSubmission& info);
 
 	private:
-		VltDevice*   m_device;
-		VltQueueType m_queueType;
+		VltDevice*           m_device;
+		VltQueueType         m_queueType;
+		VkCommandBufferLevel m_level;
 
 		VkFence m_fence;
 
@@ -857,6 +894,8 @@ namespace sce::vlt
 
 		VkSemaphore m_transSemaphore = VK_NULL_HANDLE;
 
+		PFN_vkCmdPushDescriptorSetWithTemplateKHR m_pfnCmdPushDescriptorSetWithTemplate = nullptr;
+
 		VltCmdBufferFlags m_cmdBuffersUsed;
 
 		VltLifetimeTracker       m_resources;
@@ -867,6 +906,8 @@ namespace sce::vlt
 		//DxvkGpuQueryTracker       m_gpuQueryTracker;
 
 		VltDebugUtil m_debug;
+
+		std::vector<Rc<VltCommandList>> m_secondaries;
 	};
 
 }  // namespace sce::vlt
\ No newline at end of file
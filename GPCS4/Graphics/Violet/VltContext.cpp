@@ -31,6 +31,47 @@ namespace sce::vlt
 		m_cmd = cmdList;
 		m_cmd->beginRecording();
 
+		this->resetCommandBufferState();
+	}
+
+	Rc<VltCommandList> VltContext::endRecording()
+	{
+		this->endRendering();
+
+		m_execBarriers.recordCommands(m_cmd);
+		m_transBarriers.recordCommands(m_cmd);
+		m_initBarriers.recordCommands(m_cmd);
+
+		m_staging.submit(m_cmd.ptr());
+
+		// Objects referenced by cached sets may be
+		// destroyed once the command list completes.
+		m_descSetCache.reset();
+
+		m_cmd->endRecording();
+		return std::exchange(m_cmd, nullptr);
+	}
+
+	void VltContext::executeCommands(
+		const Rc<VltCommandList>& secondary)
+	{
+		this->endRendering();
+
+		// Work recorded so far must be ordered
+		// before anything the secondary list does.
+		m_execBarriers.recordCommands(m_cmd);
+		m_transBarriers.recordCommands(m_cmd);
+		m_initBarriers.recordCommands(m_cmd);
+
+		m_cmd->executeCommands(secondary);
+
+		// The secondary list leaves its own
+		// bindings behind in the command buffer.
+		this->resetCommandBufferState();
+	}
+
+	void VltContext::resetCommandBufferState()
+	{
 		// The current state of the internal command buffer is
 		// undefined, so we have to bind and set up everything
 		// before any draw or dispatch command is recorded.
@@ -58,16 +99,22 @@ namespace sce::vlt
 			VltContextFlag::DirtyDrawBuffer);
 	}
 
-	Rc<VltCommandList> VltContext::endRecording()
+	VltBarrierStats VltContext::takeBarrierStats()
 	{
-		this->endRendering();
+		VltBarrierStats result;
 
-		m_execBarriers.recordCommands(m_cmd);
-		m_transBarriers.recordCommands(m_cmd);
-		m_initBarriers.recordCommands(m_cmd);
+		for (auto set : { &m_execBarriers, &m_execAcquires,
+						  &m_transBarriers, &m_transAcquires,
+						  &m_initBarriers })
+		{
+			VltBarrierStats stats = set->takeStats();
+			result.batches += stats.batches;
+			result.bufferBarriers += stats.bufferBarriers;
+			result.imageBarriers += stats.imageBarriers;
+			result.elided += stats.elided;
+		}
 
-		m_cmd->endRecording();
-		return std::exchange(m_cmd, nullptr);
+		return result;
 	}
 
 	void VltContext::flushCommandList()
@@ -113,6 +160,14 @@ namespace sce::vlt
 		m_flags.set(VltContextFlag::GpDirtyIndexBuffer);
 	}
 
+	void VltContext::bindDrawBuffer(
+		const VltBufferSlice& argBuffer)
+	{
+		m_state.id.argBuffer = argBuffer;
+
+		m_flags.set(VltContextFlag::DirtyDrawBuffer);
+	}
+
 	void VltContext::bindVertexBuffer(
 		uint32_t              binding,
 		const VltBufferSlice& buffer,
@@ -159,7 +214,7 @@ namespace sce::vlt
 		uint32_t indexCount,
 		uint32_t instanceCount,
 		uint32_t firstIndex,
-		uint32_t vertexOffset,
+		int32_t  vertexOffset,
 		uint32_t firstInstance)
 	{
 		if (this->commitGraphicsState<true, false>())
@@ -171,6 +226,22 @@ namespace sce::vlt
 		}
 	}
 	
+	void VltContext::drawIndexedIndirect(
+		VkDeviceSize offset,
+		uint32_t     count,
+		uint32_t     stride)
+	{
+		if (this->commitGraphicsState<true, true>())
+		{
+			auto descriptor = m_state.id.argBuffer.getDescriptor();
+
+			m_cmd->cmdDrawIndexedIndirect(
+				descriptor.buffer.buffer,
+				descriptor.buffer.offset + offset,
+				count, stride);
+		}
+	}
+
 	void VltContext::dispatch(
 		uint32_t x,
 		uint32_t y,
@@ -374,6 +445,158 @@ namespace sce::vlt
 		m_cmd->trackResource<VltAccess::Read>(srcBuffer);
 	}
 
+	void VltContext::copyImage(
+		const Rc<VltImage>&      dstImage,
+		VkImageSubresourceLayers dstSubresource,
+		VkOffset3D               dstOffset,
+		const Rc<VltImage>&      srcImage,
+		VkImageSubresourceLayers srcSubresource,
+		VkOffset3D               srcOffset,
+		VkExtent3D               extent)
+	{
+		this->endRendering();
+
+		auto dstSubresourceRange = vutil::makeSubresourceRange(dstSubresource);
+		auto srcSubresourceRange = vutil::makeSubresourceRange(srcSubresource);
+
+		if (m_execBarriers.isImageDirty(dstImage, dstSubresourceRange, VltAccess::Write) ||
+			m_execBarriers.isImageDirty(srcImage, srcSubresourceRange, VltAccess::Read))
+			m_execBarriers.recordCommands(m_cmd);
+
+		// Discard the destination if the entire subresource is covered
+		VkImageLayout dstImageLayoutInitial  = dstImage->info().layout;
+		VkImageLayout dstImageLayoutTransfer = dstImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		VkImageLayout srcImageLayoutTransfer = srcImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+		if (dstImage->isFullSubresource(dstSubresource, extent))
+			dstImageLayoutInitial = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		m_execAcquires.accessImage(
+			dstImage, dstSubresourceRange,
+			dstImageLayoutInitial, 0, 0,
+			dstImageLayoutTransfer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_ACCESS_TRANSFER_WRITE_BIT);
+
+		m_execAcquires.accessImage(
+			srcImage, srcSubresourceRange,
+			srcImage->info().layout,
+			srcImage->info().stages,
+			srcImage->info().access,
+			srcImageLayoutTransfer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_ACCESS_TRANSFER_READ_BIT);
+
+		m_execAcquires.recordCommands(m_cmd);
+
+		VkImageCopy imageRegion;
+		imageRegion.srcSubresource = srcSubresource;
+		imageRegion.srcOffset      = srcOffset;
+		imageRegion.dstSubresource = dstSubresource;
+		imageRegion.dstOffset      = dstOffset;
+		imageRegion.extent         = extent;
+
+		m_cmd->cmdCopyImage(VltCmdType::ExecBuffer,
+							srcImage->handle(), srcImageLayoutTransfer,
+							dstImage->handle(), dstImageLayoutTransfer,
+							1, &imageRegion);
+
+		m_execBarriers.accessImage(
+			dstImage, dstSubresourceRange,
+			dstImageLayoutTransfer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_ACCESS_TRANSFER_WRITE_BIT,
+			dstImage->info().layout,
+			dstImage->info().stages,
+			dstImage->info().access);
+
+		m_execBarriers.accessImage(
+			srcImage, srcSubresourceRange,
+			srcImageLayoutTransfer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_ACCESS_TRANSFER_READ_BIT,
+			srcImage->info().layout,
+			srcImage->info().stages,
+			srcImage->info().access);
+
+		m_cmd->trackResource<VltAccess::Write>(dstImage);
+		m_cmd->trackResource<VltAccess::Read>(srcImage);
+	}
+
+	void VltContext::blitImage(
+		const Rc<VltImage>& dstImage,
+		const Rc<VltImage>& srcImage,
+		const VkImageBlit&  region,
+		VkFilter            filter)
+	{
+		this->endRendering();
+
+		auto dstSubresourceRange = vutil::makeSubresourceRange(region.dstSubresource);
+		auto srcSubresourceRange = vutil::makeSubresourceRange(region.srcSubresource);
+
+		if (m_execBarriers.isImageDirty(dstImage, dstSubresourceRange, VltAccess::Write) ||
+			m_execBarriers.isImageDirty(srcImage, srcSubresourceRange, VltAccess::Read))
+			m_execBarriers.recordCommands(m_cmd);
+
+		// Discard the destination if the entire subresource is covered
+		VkExtent3D dstExtent = {
+			uint32_t(std::abs(region.dstOffsets[1].x - region.dstOffsets[0].x)),
+			uint32_t(std::abs(region.dstOffsets[1].y - region.dstOffsets[0].y)),
+			uint32_t(std::abs(region.dstOffsets[1].z - region.dstOffsets[0].z))
+		};
+
+		VkImageLayout dstImageLayoutInitial  = dstImage->info().layout;
+		VkImageLayout dstImageLayoutTransfer = dstImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		VkImageLayout srcImageLayoutTransfer = srcImage->pickLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+		if (dstImage->isFullSubresource(region.dstSubresource, dstExtent))
+			dstImageLayoutInitial = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		m_execAcquires.accessImage(
+			dstImage, dstSubresourceRange,
+			dstImageLayoutInitial, 0, 0,
+			dstImageLayoutTransfer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_ACCESS_TRANSFER_WRITE_BIT);
+
+		m_execAcquires.accessImage(
+			srcImage, srcSubresourceRange,
+			srcImage->info().layout,
+			srcImage->info().stages,
+			srcImage->info().access,
+			srcImageLayoutTransfer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_ACCESS_TRANSFER_READ_BIT);
+
+		m_execAcquires.recordCommands(m_cmd);
+
+		m_cmd->cmdBlitImage(
+			srcImage->handle(), srcImageLayoutTransfer,
+			dstImage->handle(), dstImageLayoutTransfer,
+			1, &region, filter);
+
+		m_execBarriers.accessImage(
+			dstImage, dstSubresourceRange,
+			dstImageLayoutTransfer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_ACCESS_TRANSFER_WRITE_BIT,
+			dstImage->info().layout,
+			dstImage->info().stages,
+			dstImage->info().access);
+
+		m_execBarriers.accessImage(
+			srcImage, srcSubresourceRange,
+			srcImageLayoutTransfer,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_ACCESS_TRANSFER_READ_BIT,
+			srcImage->info().layout,
+			srcImage->info().stages,
+			srcImage->info().access);
+
+		m_cmd->trackResource<VltAccess::Write>(dstImage);
+		m_cmd->trackResource<VltAccess::Read>(srcImage);
+	}
+
 
 	void VltContext::updateIndexBufferBinding()
 	{
@@ -396,6 +619,17 @@ namespace sce::vlt
 		}
 	}
 
+	void VltContext::updateDrawBufferBinding()
+	{
+		m_flags.clr(VltContextFlag::DirtyDrawBuffer);
+
+		if (m_state.id.argBuffer.defined())
+		{
+			m_cmd->trackResource<VltAccess::Read>(
+				m_state.id.argBuffer.buffer());
+		}
+	}
+
 	void VltContext::updateVertexBufferBindings()
 	{
 		m_flags.clr(VltContextFlag::GpDirtyVertexBuffers);
@@ -515,6 +749,9 @@ namespace sce::vlt
 		if (m_flags.test(VltContextFlag::GpDirtyVertexBuffers))
 			this->updateVertexBufferBindings();
 
+		if (m_flags.test(VltContextFlag::DirtyDrawBuffer) && Indirect)
+			this->updateDrawBufferBinding();
+
 		if (m_flags.any(
 				VltContextFlag::GpDirtyResources,
 				VltContextFlag::GpDirtyDescriptorBinding))
@@ -1064,7 +1301,7 @@ namespace sce::vlt
 		}
 		else
 		{
-			auto stagingSlice  = m_staging.alloc(CACHE_LINE_SIZE, size);
+			auto stagingSlice  = m_staging.alloc(size, CACHE_LINE_SIZE);
 			auto stagingHandle = stagingSlice.getSliceHandle();
 
 			std::memcpy(stagingHandle.mapPtr, data, size);
@@ -1114,8 +1351,8 @@ namespace sce::vlt
 
 		// Allocate staging buffer memory for the image data. The
 		// pixels or blocks will be tightly packed within the buffer.
-		auto stagingSlice  = m_staging.alloc(CACHE_LINE_SIZE,
-											 formatInfo->elementSize * vutil::flattenImageExtent(elementCount));
+		auto stagingSlice  = m_staging.alloc(formatInfo->elementSize * vutil::flattenImageExtent(elementCount),
+											 CACHE_LINE_SIZE);
 		auto stagingHandle = stagingSlice.getSliceHandle();
 		vutil::packImageData(stagingHandle.mapPtr, data,
 							 elementCount, formatInfo->elementSize,
@@ -1177,12 +1414,18 @@ namespace sce::vlt
 	void VltContext::uploadBuffer(
 		const Rc<VltBuffer>& buffer,
 		const void*          data)
+	{
+		void* stagingData = mapBufferUpload(buffer);
+		std::memcpy(stagingData, data, buffer->getSliceHandle().length);
+	}
+
+	void* VltContext::mapBufferUpload(
+		const Rc<VltBuffer>& buffer)
 	{
 		auto bufferSlice = buffer->getSliceHandle();
 
 		auto stagingSlice  = m_staging.alloc(bufferSlice.length, CACHE_LINE_SIZE);
 		auto stagingHandle = stagingSlice.getSliceHandle();
-		std::memcpy(stagingHandle.mapPtr, data, bufferSlice.length);
 
 		VkBufferCopy region;
 		region.srcOffset = stagingHandle.offset;
@@ -1207,6 +1450,8 @@ namespace sce::vlt
 
 		m_cmd->trackResource<VltAccess::Read>(stagingSlice.buffer());
 		m_cmd->trackResource<VltAccess::Write>(buffer);
+
+		return stagingHandle.mapPtr;
 	}
 
 	void VltContext::uploadImage(
@@ -1218,10 +1463,27 @@ namespace sce::vlt
 	{
 		const VltFormatInfo* formatInfo = image->formatInfo();
 
+		VkExtent3D elementCount = vutil::computeBlockCount(
+			image->mipLevelExtent(subresources.mipLevel), formatInfo->blockSize);
+		elementCount.depth *= subresources.layerCount;
+
+		void* stagingData = mapImageUpload(image, subresources);
+
+		vutil::packImageData(stagingData, data,
+							 elementCount, formatInfo->elementSize,
+							 pitchPerRow, pitchPerLayer);
+	}
+
+	void* VltContext::mapImageUpload(
+		const Rc<VltImage>&             image,
+		const VkImageSubresourceLayers& subresources)
+	{
+		const VltFormatInfo* formatInfo = image->formatInfo();
+
 		VkOffset3D imageOffset = { 0, 0, 0 };
 		VkExtent3D imageExtent = image->mipLevelExtent(subresources.mipLevel);
 
-		// Allocate staging buffer slice and copy data to it
+		// Allocate staging buffer slice, the caller writes data to it
 		VkExtent3D elementCount = vutil::computeBlockCount(
 			imageExtent, formatInfo->blockSize);
 		elementCount.depth *= subresources.layerCount;
@@ -1230,10 +1492,6 @@ namespace sce::vlt
                                             CACHE_LINE_SIZE);
 		auto stagingHandle = stagingSlice.getSliceHandle();
 
-		vutil::packImageData(stagingHandle.mapPtr, data,
-							 elementCount, formatInfo->elementSize,
-							 pitchPerRow, pitchPerLayer);
-
 		// Discard previous subresource contents
 		m_transAcquires.accessImage(image,
 									vutil::makeSubresourceRange(subresources),
@@ -1276,6 +1534,8 @@ namespace sce::vlt
 
 		m_cmd->trackResource<VltAccess::Write>(image);
 		m_cmd->trackResource<VltAccess::Read>(stagingSlice.buffer());
+
+		return stagingHandle.mapPtr;
 	}
 
 	void VltContext::downloadBuffer(
@@ -1701,12 +1961,30 @@ namespace sce::vlt
 		// Allocate and update descriptor set
 		auto& set = BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS ? m_gpSet : m_cpSet;
 
-		if (layout->bindingCount())
+		if (layout->usesPushDescriptors())
+		{
+			m_cmd->cmdPushDescriptorSetWithTemplate(layout->descriptorTemplate(),
+													layout->pipelineLayout(), 0, descriptors.data());
+
+			set = VK_NULL_HANDLE;
+		}
+		else if (layout->bindingCount())
 		{
-			set = allocateDescriptorSet(layout->descriptorSetLayout());
+			// Draws often bind the same resources,
+			// reuse a set already written for them.
+			size_t hash = VltDescriptorSetCache::hash(layout, descriptors.data());
 
-			m_cmd->updateDescriptorSetWithTemplate(set,
-												   layout->descriptorTemplate(), descriptors.data());
+			set = m_descSetCache.find(layout, descriptors.data(), hash);
+
+			if (set == VK_NULL_HANDLE)
+			{
+				set = allocateDescriptorSet(layout->descriptorSetLayout());
+
+				m_cmd->updateDescriptorSetWithTemplate(set,
+													   layout->descriptorTemplate(), descriptors.data());
+
+				m_descSetCache.insert(layout, descriptors.data(), hash, set);
+			}
 		}
 		else
 		{
@@ -1740,6 +2018,7 @@ namespace sce::vlt
 		if (set == VK_NULL_HANDLE)
 		{
 			m_cmd->trackDescriptorPool(std::move(m_descPool));
+			m_descSetCache.reset();
 
 			m_descPool = m_device->createDescriptorPool();
 			set        = m_descPool->alloc(layout);
@@ -1765,8 +2044,11 @@ namespace sce::vlt
 
 	void VltContext::updateComputeShaderResources()
 	{
+		// Pushed descriptors don't survive a rebind,
+		// push them again whenever the binding is dirty.
 		if ((m_flags.test(VltContextFlag::CpDirtyResources)) || 
-			(m_state.cp.pipeline->layout()->hasStaticBufferBindings()))
+			(m_state.cp.pipeline->layout()->hasStaticBufferBindings()) ||
+			(m_state.cp.pipeline->layout()->usesPushDescriptors()))
 			this->updateShaderResources<VK_PIPELINE_BIND_POINT_COMPUTE>(m_state.cp.pipeline->layout());
 
 		this->updateShaderDescriptorSetBinding<VK_PIPELINE_BIND_POINT_COMPUTE>(
@@ -1779,7 +2061,8 @@ namespace sce::vlt
 	void VltContext::updateGraphicsShaderResources()
 	{
 		if ((m_flags.test(VltContextFlag::GpDirtyResources)) || 
-			(m_state.gp.pipeline->layout()->hasStaticBufferBindings()))
+			(m_state.gp.pipeline->layout()->hasStaticBufferBindings()) ||
+			(m_state.gp.pipeline->layout()->usesPushDescriptors()))
 			this->updateShaderResources<VK_PIPELINE_BIND_POINT_GRAPHICS>(m_state.gp.pipeline->layout());
 
 		this->updateShaderDescriptorSetBinding<VK_PIPELINE_BIND_POINT_GRAPHICS>(
@@ -67,6 +67,26 @@ namespace sce::vlt
          */
 		Rc<VltCommandList> endRecording();
 
+		/**
+		 * \brief Executes a secondary command list
+		 *
+		 * Lets the frame be split at render pass boundaries
+		 * and recorded by several contexts at once, each into
+		 * its own secondary command list. The pieces are then
+		 * executed in order from this context's command list.
+		 *
+		 * Pending barriers of this context are recorded before
+		 * the secondary list, which in turn records its own
+		 * when its context ends recording, so work stays
+		 * ordered as if recorded by a single context.
+		 *
+		 * Plumbing only, the Gnm layer still records each
+		 * frame on a single context.
+		 * \param [in] secondary Finished secondary command list
+		 */
+		void executeCommands(
+			const Rc<VltCommandList>& secondary);
+
 		/**
 		 * \brief Flushes command buffer
 		 *
@@ -75,6 +95,21 @@ namespace sce::vlt
 		 */
 		void flushCommandList();
 
+		/**
+		 * \brief Retrieves staging memory statistics
+		 * \returns Staging allocator statistics
+		 */
+		VltStagingStats getStagingStats() const
+		{
+			return m_staging.getStats();
+		}
+
+		/**
+		 * \brief Retrieves and resets barrier statistics
+		 * \returns Barrier statistics of all barrier sets
+		 */
+		VltBarrierStats takeBarrierStats();
+
 		/**
          * \brief Sets render targets
          * 
@@ -105,6 +140,16 @@ namespace sce::vlt
 			const VltBufferSlice& buffer,
 			VkIndexType           indexType);
 
+		/**
+         * \brief Binds indirect argument buffer
+         * 
+         * Sets the buffer that is going to be used
+         * for indirect draws.
+         * \param [in] argBuffer New argument buffer
+         */
+		void bindDrawBuffer(
+			const VltBufferSlice& argBuffer);
+
 		/**
          * \brief Binds vertex buffer
          * 
@@ -344,9 +389,23 @@ namespace sce::vlt
 			uint32_t indexCount,
 			uint32_t instanceCount,
 			uint32_t firstIndex,
-			uint32_t vertexOffset,
+			int32_t  vertexOffset,
 			uint32_t firstInstance);
 
+		/**
+         * \brief Indirect indexed draw call
+         * 
+         * Takes the draw arguments from the bound
+         * indirect argument buffer.
+         * \param [in] offset Draw buffer offset
+         * \param [in] count Number of draws
+         * \param [in] stride Stride between dispatch calls
+         */
+		void drawIndexedIndirect(
+			VkDeviceSize offset,
+			uint32_t     count,
+			uint32_t     stride);
+
 		/**
          * \brief Starts compute jobs
          * 
@@ -444,6 +503,20 @@ namespace sce::vlt
 			const Rc<VltBuffer>& buffer,
 			const void*          data);
 
+		/**
+         * \brief Uses transfer queue to initialize buffer
+         * 
+         * Records the upload and returns the mapped staging
+         * memory for the caller to write the buffer data to.
+         * The memory must be written before the command list
+         * is submitted.
+         * Only safe to use if the buffer is not in use by the GPU.
+         * \param [in] buffer The buffer to initialize
+         * \returns Staging memory to write the data to
+         */
+		void* mapBufferUpload(
+			const Rc<VltBuffer>& buffer);
+
 		/**
          * \brief Uses transfer queue to initialize image
          * 
@@ -462,6 +535,22 @@ namespace sce::vlt
 			VkDeviceSize                    pitchPerLayer);
 
 		/**
+         * \brief Uses transfer queue to initialize image
+         * 
+         * Records the upload and returns the mapped staging
+         * memory for the caller to write the data to, tightly
+         * packed in blocks of the image format. The memory must
+         * be written before the command list is submitted.
+         * Only safe to use if the image is not in use by the GPU.
+         * \param [in] image The image to initialize
+         * \param [in] subresources Subresources to initialize
+         * \returns Staging memory to write the data to
+         */
+		void* mapImageUpload(
+			const Rc<VltImage>&             image,
+			const VkImageSubresourceLayers& subresources);
+
+		/**
 		 * \brief Uses transfer queue to download buffer
 		 *
 		 * Only safe to use if the buffer is not in use by the GPU.
@@ -577,6 +666,44 @@ namespace sce::vlt
 			VkExtent2D               srcExtent);
 
 		/**
+		 * \brief Copies data from one image to another
+		 *
+		 * Both images must have compatible formats
+		 * and the same number of samples.
+		 * \param [in] dstImage Destination image
+		 * \param [in] dstSubresource Destination subresource
+		 * \param [in] dstOffset Destination area offset
+		 * \param [in] srcImage Source image
+		 * \param [in] srcSubresource Source subresource
+		 * \param [in] srcOffset Source area offset
+		 * \param [in] extent Size of the area to copy
+		 */
+		void copyImage(
+			const Rc<VltImage>&      dstImage,
+			VkImageSubresourceLayers dstSubresource,
+			VkOffset3D               dstOffset,
+			const Rc<VltImage>&      srcImage,
+			VkImageSubresourceLayers srcSubresource,
+			VkOffset3D               srcOffset,
+			VkExtent3D               extent);
+
+		/**
+		 * \brief Blits an image
+		 *
+		 * Converts between formats and scales if
+		 * needed, both formats must support blits.
+		 * \param [in] dstImage Destination image
+		 * \param [in] srcImage Source image
+		 * \param [in] region Blit region
+		 * \param [in] filter Texture filter
+		 */
+		void blitImage(
+			const Rc<VltImage>& dstImage,
+			const Rc<VltImage>& srcImage,
+			const VkImageBlit&  region,
+			VkFilter            filter);
+
+		/**
          * \brief Sets barrier control flags
          *
          * Barrier control flags can be used to control
@@ -632,6 +759,7 @@ namespace sce::vlt
 		void endRendering();
 
 		void updateIndexBufferBinding();
+		void updateDrawBufferBinding();
 		void updateVertexBufferBindings();
 
 		bool updateGraphicsPipeline();
@@ -673,6 +801,8 @@ namespace sce::vlt
 		VkDescriptorSet allocateDescriptorSet(
 			VkDescriptorSetLayout layout);
 
+		void resetCommandBufferState();
+
 		void resetFramebufferOps();
 		void updateFramebuffer();
 
@@ -689,6 +819,7 @@ namespace sce::vlt
 
 		Rc<VltCommandList>    m_cmd;
 		Rc<VltDescriptorPool> m_descPool;
+		VltDescriptorSetCache m_descSetCache;
 
 		VltContextFlags m_flags;
 		VltContextState m_state = {};
@@ -1,6 +1,8 @@
 #include "VltDescriptor.h"
 
 #include "VltDevice.h"
+#include "VltHash.h"
+#include "VltPipeLayout.h"
 
 #include <array>
 
@@ -60,6 +62,132 @@ namespace sce::vlt
 			m_device->handle(), m_pool, 0);
 	}
 
+	VltDescriptorSetCache::VltDescriptorSetCache()
+	{
+	}
+
+	VltDescriptorSetCache::~VltDescriptorSetCache()
+	{
+	}
+
+	VkDescriptorSet VltDescriptorSetCache::find(
+		const VltPipelineLayout* layout,
+		const VltDescriptorInfo* descriptors,
+		size_t                   hash) const
+	{
+		auto range = m_entries.equal_range(hash);
+
+		for (auto iter = range.first; iter != range.second; ++iter)
+		{
+			const Entry& entry = iter->second;
+
+			if (entry.layout == layout &&
+				eq(layout, &m_descriptors[entry.offset], descriptors))
+				return entry.set;
+		}
+
+		return VK_NULL_HANDLE;
+	}
+
+	void VltDescriptorSetCache::insert(
+		const VltPipelineLayout* layout,
+		const VltDescriptorInfo* descriptors,
+		size_t                   hash,
+		VkDescriptorSet          set)
+	{
+		Entry entry;
+		entry.layout = layout;
+		entry.offset = m_descriptors.size();
+		entry.set    = set;
+
+		m_descriptors.insert(m_descriptors.end(),
+							 descriptors, descriptors + layout->bindingCount());
+		m_entries.emplace(hash, entry);
+	}
+
+	void VltDescriptorSetCache::reset()
+	{
+		m_entries.clear();
+		m_descriptors.clear();
+	}
+
+	size_t VltDescriptorSetCache::hash(
+		const VltPipelineLayout* layout,
+		const VltDescriptorInfo* descriptors)
+	{
+		VltHashState state;
+		state.add(reinterpret_cast<size_t>(layout));
+
+		for (uint32_t i = 0; i < layout->bindingCount(); i++)
+		{
+			const auto& info = descriptors[i];
+
+			switch (layout->binding(i).type)
+			{
+			case VK_DESCRIPTOR_TYPE_SAMPLER:
+			case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+			case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+			case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+				state.add(reinterpret_cast<size_t>(info.image.sampler));
+				state.add(reinterpret_cast<size_t>(info.image.imageView));
+				state.add(size_t(info.image.imageLayout));
+				break;
+
+			case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+			case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+				state.add(reinterpret_cast<size_t>(info.texelBuffer));
+				break;
+
+			default:
+				state.add(reinterpret_cast<size_t>(info.buffer.buffer));
+				state.add(size_t(info.buffer.offset));
+				state.add(size_t(info.buffer.range));
+				break;
+			}
+		}
+
+		return state;
+	}
+
+	bool VltDescriptorSetCache::eq(
+		const VltPipelineLayout* layout,
+		const VltDescriptorInfo* a,
+		const VltDescriptorInfo* b)
+	{
+		for (uint32_t i = 0; i < layout->bindingCount(); i++)
+		{
+			bool same;
+
+			switch (layout->binding(i).type)
+			{
+			case VK_DESCRIPTOR_TYPE_SAMPLER:
+			case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+			case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+			case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+				same = a[i].image.sampler == b[i].image.sampler &&
+					   a[i].image.imageView == b[i].image.imageView &&
+					   a[i].image.imageLayout == b[i].image.imageLayout;
+				break;
+
+			case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+			case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+				same = a[i].texelBuffer == b[i].texelBuffer;
+				break;
+
+			default:
+				same = a[i].buffer.buffer == b[i].buffer.buffer &&
+					   a[i].buffer.offset == b[i].buffer.offset &&
+					   a[i].buffer.range == b[i].buffer.range;
+				break;
+			}
+
+			if (!same)
+				return false;
+		}
+
+		return true;
+	}
+
 	VltDescriptorPoolTracker::VltDescriptorPoolTracker(VltDevice* device) :
 		m_device(device)
 	{
@@ -2,9 +2,12 @@
 
 #include "VltCommon.h"
 
+#include <unordered_map>
+
 namespace sce::vlt
 {
 	class VltDevice;
+	class VltPipelineLayout;
 
 	/**
      * \brief Descriptor info
@@ -55,6 +58,87 @@ namespace sce::vlt
 		VkDescriptorPool m_pool;
 	};
 
+	/**
+     * \brief Descriptor set cache
+     * 
+     * Remembers descriptor sets written in the current
+     * command list by layout and content, so that draws
+     * binding the same resources reuse a set instead of
+     * allocating and writing a new one.
+     * 
+     * Must be reset when the command list ends, since
+     * handles of destroyed objects may be reused, and
+     * when the pool the sets come from is retired.
+     */
+	class VltDescriptorSetCache
+	{
+		struct Entry
+		{
+			const VltPipelineLayout* layout;
+			size_t                   offset;
+			VkDescriptorSet          set;
+		};
+
+	public:
+		VltDescriptorSetCache();
+		~VltDescriptorSetCache();
+
+		/**
+         * \brief Looks up a descriptor set
+         * 
+         * \param [in] layout Pipeline layout
+         * \param [in] descriptors Descriptors, one per binding
+         * \param [in] hash Hash returned by \ref hash
+         * \returns The set, or \c VK_NULL_HANDLE if not cached
+         */
+		VkDescriptorSet find(
+			const VltPipelineLayout* layout,
+			const VltDescriptorInfo* descriptors,
+			size_t                   hash) const;
+
+		/**
+         * \brief Adds a written descriptor set
+         * 
+         * \param [in] layout Pipeline layout
+         * \param [in] descriptors Descriptors, one per binding
+         * \param [in] hash Hash returned by \ref hash
+         * \param [in] set The descriptor set
+         */
+		void insert(
+			const VltPipelineLayout* layout,
+			const VltDescriptorInfo* descriptors,
+			size_t                   hash,
+			VkDescriptorSet          set);
+
+		/**
+         * \brief Forgets all descriptor sets
+         */
+		void reset();
+
+		/**
+         * \brief Hashes descriptor set content
+         * 
+         * Only fields used by the binding types are
+         * hashed, padding and unused union members
+         * may hold anything.
+         * \param [in] layout Pipeline layout
+         * \param [in] descriptors Descriptors, one per binding
+         * \returns Hash of layout and descriptors
+         */
+		static size_t hash(
+			const VltPipelineLayout* layout,
+			const VltDescriptorInfo* descriptors);
+
+	private:
+		static bool eq(
+			const VltPipelineLayout* layout,
+			const VltDescriptorInfo* a,
+			const VltDescriptorInfo* b);
+
+		std::unordered_multimap<size_t, Entry> m_entries;
+		std::vector<VltDescriptorInfo>         m_descriptors;
+	};
+
 	/**
      * \brief Descriptor pool tracker
      * 
@@ -29,6 +29,14 @@ namespace sce::vlt
 		m_queues.graphics  = getQueue(queueFamilies.graphics, 0);
 		m_queues.compute   = getQueue(queueFamilies.compute, 0);
 		m_queues.transfer  = getQueue(queueFamilies.transfer, 0);
+
+		// Extension entry points aren't exported by every loader,
+		// a null pointer disables the feature that depends on it.
+		if (m_extensions.khrPushDescriptor)
+		{
+			m_pfnCmdPushDescriptorSetWithTemplate = reinterpret_cast<PFN_vkCmdPushDescriptorSetWithTemplateKHR>(
+				vkGetDeviceProcAddr(m_device, "vkCmdPushDescriptorSetWithTemplateKHR"));
+		}
 	}
 
 	VltDevice::~VltDevice()
@@ -43,6 +51,16 @@ namespace sce::vlt
 		return m_adapter->isUnifiedMemoryArchitecture();
 	}
 
+	VltMemoryStats VltDevice::getMemoryStats(uint32_t heap)
+	{
+		return m_objects.memoryManager().getMemoryStats(heap);
+	}
+
+	VltMemoryChunkStats VltDevice::getMemoryChunkStats(uint32_t heap)
+	{
+		return m_objects.memoryManager().getChunkStats(heap);
+	}
+
 	VkPipelineStageFlags VltDevice::getShaderPipelineStages() const
 	{
 		VkPipelineStageFlags result =
@@ -158,6 +176,20 @@ namespace sce::vlt
 		return cmdList;
 	}
 
+	Rc<VltCommandList> VltDevice::createSecondaryCommandList(VltQueueType queueType)
+	{
+		Rc<VltCommandList> cmdList = queueType == VltQueueType::Graphics
+										 ? m_recycledSecondaryListsGraphics.retrieveObject()
+										 : m_recycledSecondaryListsCompute.retrieveObject();
+		if (cmdList == nullptr)
+		{
+			cmdList = new VltCommandList(this, queueType,
+										 VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+		}
+
+		return cmdList;
+	}
+
 	Rc<VltDescriptorPool> VltDevice::createDescriptorPool()
 	{
 		Rc<VltDescriptorPool> pool = m_recycledDescriptorPools.retrieveObject();
@@ -212,7 +244,14 @@ namespace sce::vlt
 	void VltDevice::recycleCommandList(
 		const Rc<VltCommandList>& cmdList)
 	{
-		if (cmdList->type() == VltQueueType::Graphics)
+		if (cmdList->isSecondary())
+		{
+			if (cmdList->type() == VltQueueType::Graphics)
+				m_recycledSecondaryListsGraphics.returnObject(cmdList);
+			else
+				m_recycledSecondaryListsCompute.returnObject(cmdList);
+		}
+		else if (cmdList->type() == VltQueueType::Graphics)
 		{
 			m_recycledCommandListsGraphics.returnObject(cmdList);
 		}
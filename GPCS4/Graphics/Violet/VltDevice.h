@@ -59,6 +59,7 @@ namespace sce::vlt
 		friend class VltSubmissionQueue;
 		friend class VltDescriptorPoolTracker;
 		friend class VltContext;
+		friend class VltCommandList;
 
 	public:
 		VltDevice(
@@ -161,6 +162,19 @@ namespace sce::vlt
 			return m_properties;
 		}
 
+		/**
+         * \brief Push descriptor template entry point
+         * 
+         * Loaded at device creation when VK_KHR_push_descriptor
+         * is enabled. Push descriptors must not be used if this
+         * is \c nullptr.
+         * \returns The function pointer, or \c nullptr
+         */
+		PFN_vkCmdPushDescriptorSetWithTemplateKHR pfnCmdPushDescriptorSetWithTemplate() const
+		{
+			return m_pfnCmdPushDescriptorSetWithTemplate;
+		}
+
 		/**
          * \brief Checks whether this is a UMA system
          *
@@ -170,6 +184,26 @@ namespace sce::vlt
          */
 		bool isUnifiedMemoryArchitecture() const;
 
+		/**
+         * \brief Queries memory stats
+         *
+         * Returns the amount of memory allocated
+         * from and used in a given heap.
+         * \param [in] heap Heap index
+         * \returns Memory stats for this heap
+         */
+		VltMemoryStats getMemoryStats(uint32_t heap);
+
+		/**
+         * \brief Queries memory chunk stats
+         *
+         * Returns how fragmented the free memory
+         * of the chunks in a given heap is.
+         * \param [in] heap Heap index
+         * \returns Chunk stats for this heap
+         */
+		VltMemoryChunkStats getMemoryChunkStats(uint32_t heap);
+
 		/**
         * \brief Queries supported shader stages
         * \returns Supported shader pipeline stages
@@ -278,6 +312,19 @@ namespace sce::vlt
 		Rc<VltCommandList> createCommandList(
 			VltQueueType queueType);
 
+		/**
+		 * \brief Creates a secondary command list
+		 *
+		 * Lets another context record part of a frame in
+		 * parallel. The list must be executed from a primary
+		 * command list of the same queue type.
+		 *
+		 * Plumbing only, nothing records secondary lists yet.
+		 * \returns The command list
+		 */
+		Rc<VltCommandList> createSecondaryCommandList(
+			VltQueueType queueType);
+
 
 		/**
          * \brief Creates a descriptor pool
@@ -373,6 +420,8 @@ namespace sce::vlt
 		VltDeviceFeatures m_features;
 		VltDeviceInfo     m_properties;
 
+		PFN_vkCmdPushDescriptorSetWithTemplateKHR m_pfnCmdPushDescriptorSetWithTemplate = nullptr;
+
 		VltObjects m_objects;
 
 		VltDeviceQueueSet m_queues;
@@ -381,6 +430,8 @@ namespace sce::vlt
 
 		VltRecycler<VltCommandList, 16>    m_recycledCommandListsGraphics;
 		VltRecycler<VltCommandList, 16>    m_recycledCommandListsCompute;
+		VltRecycler<VltCommandList, 16>    m_recycledSecondaryListsGraphics;
+		VltRecycler<VltCommandList, 16>    m_recycledSecondaryListsCompute;
 		VltRecycler<VltDescriptorPool, 16> m_recycledDescriptorPools;
 	};
 
@@ -27,6 +27,7 @@ namespace sce::vlt
 		VkPhysicalDeviceVertexAttributeDivisorPropertiesEXT    extVertexAttributeDivisor;
 		VkPhysicalDeviceDepthStencilResolvePropertiesKHR       khrDepthStencilResolve;
 		VkPhysicalDeviceDriverPropertiesKHR                    khrDeviceDriverProperties;
+		VkPhysicalDevicePushDescriptorPropertiesKHR            khrPushDescriptor;
 		VkPhysicalDeviceFloatControlsPropertiesKHR             khrShaderFloatControls;
 	};
 
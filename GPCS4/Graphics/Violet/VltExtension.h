@@ -301,6 +301,7 @@ namespace sce::vlt
 		VltExt khrDepthStencilResolve            = { VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME, VltExtMode::Optional };
 		VltExt khrDrawIndirectCount              = { VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME, VltExtMode::Optional };
 		VltExt khrDriverProperties               = { VK_KHR_DRIVER_PROPERTIES_EXTENSION_NAME, VltExtMode::Optional };
+		VltExt khrPushDescriptor                 = { VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, VltExtMode::Optional };
 		VltExt khrSamplerMirrorClampToEdge       = { VK_KHR_SAMPLER_MIRROR_CLAMP_TO_EDGE_EXTENSION_NAME, VltExtMode::Optional };
 		VltExt khrShaderFloatControls            = { VK_KHR_SHADER_FLOAT_CONTROLS_EXTENSION_NAME, VltExtMode::Optional };
 		VltExt khrSwapchain                      = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VltExtMode::Required };
@@ -68,10 +68,9 @@ namespace sce::vlt
 		VltDeviceMemory     memory,
 		VltMemoryFlags      hints) :
 		m_alloc(alloc),
-		m_type(type), m_memory(memory), m_hints(hints)
+		m_type(type), m_memory(memory), m_hints(hints),
+		m_allocator(memory.memSize)
 	{
-		// Mark the entire chunk as free
-		m_freeList.push_back(FreeSlice{ 0, memory.memSize });
 	}
 
 	VltMemoryChunk::~VltMemoryChunk()
@@ -92,87 +91,33 @@ namespace sce::vlt
 		if (m_memory.memFlags != flags || !checkHints(hints))
 			return VltMemory();
 
-		// If the chunk is full, return
-		if (m_freeList.size() == 0)
-			return VltMemory();
-
-		// Select the slice to allocate from in a worst-fit
-		// manner. This may help keep fragmentation low.
-		auto bestSlice = m_freeList.begin();
-
-		for (auto slice = m_freeList.begin(); slice != m_freeList.end(); slice++)
-		{
-			if (slice->length == size)
-			{
-				bestSlice = slice;
-				break;
-			}
-			else if (slice->length > bestSlice->length)
-			{
-				bestSlice = slice;
-			}
-		}
-
-		// We need to align the allocation to the requested alignment
-		const VkDeviceSize sliceStart = bestSlice->offset;
-		const VkDeviceSize sliceEnd   = bestSlice->offset + bestSlice->length;
+		// Pad the length so that the end of the slice
+		// keeps the alignment, as resources may be placed
+		// right after it with the same requirements.
+		const VkDeviceSize length = util::align(size, align);
+		const VkDeviceSize offset = m_allocator.alloc(length, align);
 
-		const VkDeviceSize allocStart = util::align(sliceStart, align);
-		const VkDeviceSize allocEnd   = util::align(allocStart + size, align);
-
-		if (allocEnd > sliceEnd)
+		if (offset == util::TlsfAllocator::InvalidOffset)
 			return VltMemory();
 
-		// We can use this slice, but we'll have to add
-		// the unused parts of it back to the free list.
-		m_freeList.erase(bestSlice);
-
-		if (allocStart != sliceStart)
-			m_freeList.push_back({ sliceStart, allocStart - sliceStart });
-
-		if (allocEnd != sliceEnd)
-			m_freeList.push_back({ allocEnd, sliceEnd - allocEnd });
-
 		// Create the memory object with the aligned slice
 		return VltMemory(m_alloc, this, m_type,
-						 m_memory.memHandle, allocStart, allocEnd - allocStart,
-						 reinterpret_cast<char*>(m_memory.memPointer) + allocStart);
+						 m_memory.memHandle, offset, length,
+						 reinterpret_cast<char*>(m_memory.memPointer) + offset);
 	}
 
 	void VltMemoryChunk::free(
 		VkDeviceSize offset,
 		VkDeviceSize length)
 	{
-		// Remove adjacent entries from the free list and then add
-		// a new slice that covers all those entries. Without doing
-		// so, the slice could not be reused for larger allocations.
-		auto curr = m_freeList.begin();
-
-		while (curr != m_freeList.end())
-		{
-			if (curr->offset == offset + length)
-			{
-				length += curr->length;
-				curr = m_freeList.erase(curr);
-			}
-			else if (curr->offset + curr->length == offset)
-			{
-				offset -= curr->length;
-				length += curr->length;
-				curr = m_freeList.erase(curr);
-			}
-			else
-			{
-				curr++;
-			}
-		}
-
-		m_freeList.push_back({ offset, length });
+		// Adjacent free slices are merged right away,
+		// the allocator knows the length of the slice.
+		m_allocator.free(offset);
 	}
 
 	bool VltMemoryChunk::isEmpty() const
 	{
-		return m_freeList.size() == 1 && m_freeList[0].length == m_memory.memSize;
+		return m_allocator.isEmpty();
 	}
 
 	bool VltMemoryChunk::isCompatible(const Rc<VltMemoryChunk>& other) const
@@ -408,7 +353,10 @@ namespace sce::vlt
 					Rc<VltMemoryChunk> chunk = new VltMemoryChunk(this, type, devMem, hints);
 					memory                   = chunk->alloc(flags, size, align, hints);
 
-					type->chunks.push_back(std::move(chunk));
+					// Don't keep a chunk nothing could be allocated
+					// from, releasing it frees the device memory.
+					if (memory)
+						type->chunks.push_back(std::move(chunk));
 				}
 			}
 		}
@@ -475,6 +423,32 @@ namespace sce::vlt
 		return result;
 	}
 
+	VltMemoryChunkStats VltMemoryAllocator::getChunkStats(uint32_t heap)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		VltMemoryChunkStats result;
+
+		for (uint32_t i = 0; i < m_memProps.memoryTypeCount; i++)
+		{
+			if (m_memTypes[i].heapId != heap)
+				continue;
+
+			for (const auto& chunk : m_memTypes[i].chunks)
+			{
+				util::TlsfStats stats = chunk->getStats();
+
+				result.chunkCount += 1;
+				result.freeBlockCount += stats.freeBlockCount;
+				result.memoryFree += stats.totalSize - stats.usedSize;
+				result.largestFreeBlock = std::max<VkDeviceSize>(result.largestFreeBlock, stats.largestFreeBlock);
+				result.fragmentation    = std::max(result.fragmentation, chunk->fragmentation());
+			}
+		}
+
+		return result;
+	}
+
 	void VltMemoryAllocator::free(
 		const VltMemory& memory)
 	{
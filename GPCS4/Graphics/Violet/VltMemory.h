@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VltCommon.h"
+#include "UtilTlsfAllocator.h"
 
 #include <array>
 #include <mutex>
@@ -23,6 +24,21 @@ namespace sce::vlt
 		VkDeviceSize memoryUsed      = 0;
 	};
 
+	/**
+      * \brief Chunk stats
+      * 
+      * Reports how fragmented the free memory
+      * of the chunks in a heap is.
+      */
+	struct VltMemoryChunkStats
+	{
+		uint32_t     chunkCount       = 0;
+		uint32_t     freeBlockCount   = 0;
+		VkDeviceSize memoryFree       = 0;
+		VkDeviceSize largestFreeBlock = 0;
+		float        fragmentation    = 0.0f;  ///< Worst fragmentation of any chunk
+	};
+
 	/**
       * \brief Device memory object
       * 
@@ -183,7 +199,9 @@ namespace sce::vlt
      * \brief Memory chunk
      * 
      * A single chunk of memory that provides a
-     * sub-allocator. This is not thread-safe.
+     * sub-allocator. Slices are managed by a TLSF
+     * allocator, so allocating and freeing take
+     * constant time. This is not thread-safe.
      */
 	class VltMemoryChunk : public RcObject
 	{
@@ -239,19 +257,31 @@ namespace sce::vlt
          */
 		bool isCompatible(const Rc<VltMemoryChunk>& other) const;
 
-	private:
-		struct FreeSlice
+		/**
+         * \brief Queries sub-allocation stats
+         * \returns Usage of the chunk
+         */
+		util::TlsfStats getStats() const
 		{
-			VkDeviceSize offset;
-			VkDeviceSize length;
-		};
+			return m_allocator.getStats();
+		}
 
+		/**
+         * \brief Computes fragmentation of free memory
+         * \returns Share of free memory outside the largest free slice
+         */
+		float fragmentation() const
+		{
+			return m_allocator.fragmentation();
+		}
+
+	private:
 		VltMemoryAllocator* m_alloc;
 		VltMemoryType*      m_type;
 		VltDeviceMemory     m_memory;
 		VltMemoryFlags      m_hints;
 
-		std::vector<FreeSlice> m_freeList;
+		util::TlsfAllocator m_allocator;
 
 		bool checkHints(VltMemoryFlags hints) const;
 	};
@@ -316,6 +346,16 @@ namespace sce::vlt
 			return m_memHeaps[heap].stats;
 		}
 
+		/**
+         * \brief Queries chunk stats
+         * 
+         * Walks the chunks sub-allocated
+         * from a given heap.
+         * \param [in] heap Heap index
+         * \returns Chunk stats for this heap
+         */
+		VltMemoryChunkStats getChunkStats(uint32_t heap);
+
 	private:
 		VltMemory tryAlloc(
 			const VkMemoryRequirements*          req,
@@ -129,6 +129,16 @@ namespace sce::vlt
 			m_descriptorTypes.set(bindingInfos[i].type);
 		}
 
+		// Push descriptors save allocating and binding a set
+		// per draw. Dynamic buffers can't be pushed, and the
+		// number of pushed descriptors is limited. Without the
+		// entry point we fall back to allocated sets.
+		m_pushDescriptors = bindingCount > 0 &&
+							m_dynamicSlots.empty() &&
+							m_device->extensions().khrPushDescriptor &&
+							m_device->pfnCmdPushDescriptorSetWithTemplate() != nullptr &&
+							bindingCount <= m_device->properties().khrPushDescriptor.maxPushDescriptors;
+
 		// Create descriptor set layout. We do not need to
 		// create one if there are no active resource bindings.
 		if (bindingCount > 0)
@@ -136,7 +146,7 @@ namespace sce::vlt
 			VkDescriptorSetLayoutCreateInfo dsetInfo;
 			dsetInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 			dsetInfo.pNext        = nullptr;
-			dsetInfo.flags        = 0;
+			dsetInfo.flags        = m_pushDescriptors ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0;
 			dsetInfo.bindingCount = bindings.size();
 			dsetInfo.pBindings    = bindings.data();
 
@@ -178,7 +188,9 @@ namespace sce::vlt
 			templateInfo.flags                      = 0;
 			templateInfo.descriptorUpdateEntryCount = tEntries.size();
 			templateInfo.pDescriptorUpdateEntries   = tEntries.data();
-			templateInfo.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+			templateInfo.templateType               = m_pushDescriptors
+														  ? VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR
+														  : VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
 			templateInfo.descriptorSetLayout        = m_descriptorSetLayout;
 			templateInfo.pipelineBindPoint          = pipelineBindPoint;
 			templateInfo.pipelineLayout             = m_pipelineLayout;
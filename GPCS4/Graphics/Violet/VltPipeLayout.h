@@ -224,6 +224,18 @@ namespace sce::vlt
 			return m_descriptorTemplate;
 		}
 
+		/**
+         * \brief Checks whether descriptors are pushed
+         * 
+         * If \c true, the descriptor template pushes
+         * descriptors directly into the command buffer
+         * and no descriptor set is allocated.
+         */
+		bool usesPushDescriptors() const
+		{
+			return m_pushDescriptors;
+		}
+
 		/**
          * \brief Number of dynamic bindings
          * \returns Dynamic binding count
@@ -285,6 +297,7 @@ namespace sce::vlt
 		VkDescriptorSetLayout         m_descriptorSetLayout = VK_NULL_HANDLE;
 		VkPipelineLayout              m_pipelineLayout      = VK_NULL_HANDLE;
 		VkDescriptorUpdateTemplateKHR m_descriptorTemplate  = VK_NULL_HANDLE;
+		bool                          m_pushDescriptors     = false;
 
 		VltDescriptorSlotList m_bindingSlots;
 		std::vector<uint32_t> m_dynamicSlots;
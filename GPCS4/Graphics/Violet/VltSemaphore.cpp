@@ -36,6 +36,13 @@ namespace sce::vlt
 	}
 
 	void VltSemaphore::wait(uint64_t value)
+	{
+		while (!wait(value, 1'000'000'000ull))
+		{
+		}
+	}
+
+	bool VltSemaphore::wait(uint64_t value, uint64_t timeout)
 	{
 		VkSemaphoreWaitInfo waitInfo;
 		waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
@@ -45,13 +52,9 @@ namespace sce::vlt
 		waitInfo.pSemaphores    = &m_handle;
 		waitInfo.pValues        = &value;
 
-		VkResult status = VK_TIMEOUT;
-
-		while (status == VK_TIMEOUT)
-		{
-			status = vkWaitSemaphores(
-				m_device->handle(), &waitInfo, 1'000'000'000ull);
-		}
+		VkResult status = vkWaitSemaphores(
+			m_device->handle(), &waitInfo, timeout);
+		return status != VK_TIMEOUT;
 	}
 
 	VltSemaphoreTracker::VltSemaphoreTracker()
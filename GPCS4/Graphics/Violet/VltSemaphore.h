@@ -48,6 +48,17 @@ namespace sce::vlt
 		 */
 		void wait(uint64_t value);
 
+		/**
+		 * \brief Wait on host with timeout
+		 *
+		 * Only valid when type it is a
+		 * timeline semaphore.
+		 * \param [in] value Value to wait for
+		 * \param [in] timeout Timeout in nanoseconds
+		 * \returns \c true if the value was reached
+		 */
+		bool wait(uint64_t value, uint64_t timeout);
+
 	private:
 		VltDevice*  m_device;
 		VkSemaphore m_handle = VK_NULL_HANDLE;
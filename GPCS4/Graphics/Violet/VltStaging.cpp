@@ -1,12 +1,17 @@
 #include "VltStaging.h"
 
+#include "VltCmdList.h"
 #include "VltDevice.h"
 
 namespace sce::vlt
 {
-	VltStagingDataAlloc::VltStagingDataAlloc(VltDevice* device) :
-		m_device(device)
+	VltStagingDataAlloc::VltStagingDataAlloc(
+		VltDevice*   device,
+		VkDeviceSize ringSize) :
+		m_device(device),
+		m_ringSize(ringSize)
 	{
+		m_stats.ringSize = m_ringSize;
 	}
 
 	VltStagingDataAlloc::~VltStagingDataAlloc()
@@ -15,47 +20,81 @@ namespace sce::vlt
 
 	VltBufferSlice VltStagingDataAlloc::alloc(VkDeviceSize size, VkDeviceSize align)
 	{
-		if (size > MaxBufferSize)
-			return VltBufferSlice(createBuffer(size));
+		VltBufferSlice slice;
+		do
+		{
+			if (size > m_ringSize / 2)
+				break;
 
-		if (m_buffer == nullptr)
-			m_buffer = createBuffer(MaxBufferSize);
+			if (m_ring == nullptr)
+				m_ring = createBuffer(m_ringSize);
 
-		if (!m_buffer->isInUse())
-			m_offset = 0;
+			retireRegions();
 
-		m_offset = util::align(m_offset, align);
+			// Allocations never wrap around the end of the ring
+			VkDeviceSize offset = util::align(m_head, align);
 
-		if (m_offset + size > MaxBufferSize)
-		{
-			m_offset = 0;
+			if ((offset % m_ringSize) + size > m_ringSize)
+				offset += m_ringSize - (offset % m_ringSize);
 
-			if (m_buffers.size() < MaxBufferCount)
-				m_buffers.push(std::move(m_buffer));
+			// Ring is full of regions the GPU still reads from
+			if (offset + size - m_tail > m_ringSize)
+				break;
 
-			if (!m_buffers.front()->isInUse())
+			if (!m_regionOpen)
 			{
-				m_buffer = std::move(m_buffers.front());
-				m_buffers.pop();
+				m_regions.push({ new VltResource(), offset, offset + size });
+				m_regionOpen = true;
 			}
 			else
 			{
-				m_buffer = createBuffer(MaxBufferSize);
+				m_regions.back().end = offset + size;
 			}
+
+			m_head = offset + size;
+
+			m_stats.ringAllocs += 1;
+			m_stats.ringUsed      = m_head - m_tail;
+			m_stats.highWaterMark = std::max(m_stats.highWaterMark, m_stats.ringUsed);
+
+			slice = VltBufferSlice(m_ring, offset % m_ringSize, size);
+		} while (false);
+
+		if (!slice.defined())
+		{
+			m_stats.dedicatedAllocs += 1;
+			m_stats.dedicatedBytes += size;
+
+			slice = VltBufferSlice(createBuffer(size));
 		}
 
-		VltBufferSlice slice(m_buffer, m_offset, size);
-		m_offset = util::align(m_offset + size, align);
 		return slice;
 	}
 
+	void VltStagingDataAlloc::submit(VltCommandList* cmdList)
+	{
+		if (!m_regionOpen)
+			return;
+
+		// The command list releases the marker once its
+		// fence signals, which retires the whole region.
+		cmdList->trackResource<VltAccess::Read>(m_regions.back().marker);
+		m_regionOpen = false;
+	}
+
 	void VltStagingDataAlloc::trim()
 	{
-		m_buffer = nullptr;
-		m_offset = 0;
+		// Command lists keep the ring alive
+		// until they are done reading from it.
+		m_ring       = nullptr;
+		m_head       = 0;
+		m_tail       = 0;
+		m_regionOpen = false;
+
+		while (!m_regions.empty())
+			m_regions.pop();
 
-		while (!m_buffers.empty())
-			m_buffers.pop();
+		m_stats.ringUsed = 0;
 	}
 
 	Rc<VltBuffer> VltStagingDataAlloc::createBuffer(VkDeviceSize size)
@@ -70,4 +109,21 @@ namespace sce::vlt
 									  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
 									  VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 	}
-}  // namespace sce::vlt
\ No newline at end of file
+
+	void VltStagingDataAlloc::retireRegions()
+	{
+		while (!m_regions.empty())
+		{
+			bool isOpen = m_regionOpen && m_regions.size() == 1;
+
+			if (isOpen || m_regions.front().marker->isInUse())
+				break;
+
+			m_regions.pop();
+		}
+
+		m_tail = m_regions.empty()
+					 ? m_head
+					 : m_regions.front().begin;
+	}
+}  // namespace sce::vlt
@@ -2,42 +2,90 @@
 
 #include "VltBuffer.h"
 #include "VltCommon.h"
+#include "VltResource.h"
 
 #include <queue>
 
 namespace sce::vlt
 {
 	class VltDevice;
+	class VltCommandList;
+
+	/**
+     * \brief Staging allocator statistics
+     */
+	struct VltStagingStats
+	{
+		VkDeviceSize ringSize        = 0;  ///< Size of the staging ring
+		VkDeviceSize ringUsed        = 0;  ///< Bytes currently pending in the ring
+		VkDeviceSize highWaterMark   = 0;  ///< Largest number of bytes pending in the ring
+		uint64_t     ringAllocs      = 0;  ///< Allocations served by the ring
+		uint64_t     dedicatedAllocs = 0;  ///< Allocations served by dedicated buffers
+		VkDeviceSize dedicatedBytes  = 0;  ///< Bytes allocated in dedicated buffers
+	};
 
 	/**
      * \brief Staging data allocator
      *
-     * Allocates buffer slices for resource uploads,
-     * while trying to keep the number of allocations
-     * but also the amount of allocated memory low.
+     * Suballocates upload memory linearly from one
+     * persistently mapped ring buffer. Allocations made
+     * while recording a command list form a region, which
+     * is handed to the command list on submission and
+     * reclaimed once its fence signals and the lifetime
+     * tracker releases it.
+     *
+     * Allocations larger than half the ring, or made while
+     * the ring is full of pending regions, get a dedicated
+     * buffer instead of waiting for the GPU.
      */
 	class VltStagingDataAlloc
 	{
-		constexpr static VkDeviceSize MaxBufferSize  = 1 << 25;  // 32 MiB
-		constexpr static uint32_t     MaxBufferCount = 2;
+		constexpr static VkDeviceSize DefaultRingSize = 1 << 26;  // 64 MiB
+
+		struct Region
+		{
+			Rc<VltResource> marker;
+			VkDeviceSize    begin;
+			VkDeviceSize    end;
+		};
 
 	public:
-		VltStagingDataAlloc(VltDevice* device);
+		VltStagingDataAlloc(
+			VltDevice*   device,
+			VkDeviceSize ringSize = DefaultRingSize);
 
 		~VltStagingDataAlloc();
 
 		/**
          * \brief Alloctaes a staging buffer slice
-         * 
+         *
          * \param [in] size Size of the allocation
 		 * \param [in] align Alignment of the allocation
          * \returns Staging buffer slice
          */
 		VltBufferSlice alloc(VkDeviceSize size, VkDeviceSize align);
 
+		/**
+         * \brief Hands pending allocations to a command list
+         *
+         * Must be called before the command list which uses
+         * the allocations made since the last call is submitted.
+         * \param [in] cmdList The command list
+         */
+		void submit(VltCommandList* cmdList);
+
+		/**
+         * \brief Retrieves allocator statistics
+         * \returns Allocator statistics
+         */
+		VltStagingStats getStats() const
+		{
+			return m_stats;
+		}
+
 		/**
          * \brief Deletes all staging buffers
-         * 
+         *
          * Destroys allocated buffers and
          * releases all buffer memory.
          */
@@ -46,12 +94,24 @@ namespace sce::vlt
 	private:
 		Rc<VltBuffer> createBuffer(VkDeviceSize size);
 
+		void retireRegions();
+
 	private:
 		VltDevice*    m_device;
-		Rc<VltBuffer> m_buffer;
-		VkDeviceSize  m_offset = 0;
+		VkDeviceSize  m_ringSize;
+		Rc<VltBuffer> m_ring;
+
+		// Offsets grow monotonically, the ring
+		// offset is the remainder of the ring size.
+		VkDeviceSize m_head = 0;
+		VkDeviceSize m_tail = 0;
+
+		// Submitted regions in allocation order,
+		// the last one is open if m_regionOpen is set.
+		std::queue<Region> m_regions;
+		bool               m_regionOpen = false;
 
-		std::queue<Rc<VltBuffer>> m_buffers;
+		VltStagingStats m_stats;
 	};
 
-}  // namespace sce::vlt
\ No newline at end of file
+}  // namespace sce::vlt
@@ -1,12 +1,15 @@
 #include "VirtualGPU.h"
+#include "Emulator.h"
 
 #include "SceUserService/user_service_defs.h"
 #include "sce_errors.h"
 
 #include "Gnm/GnmConstant.h"
+#include "Gnm/GnmRenderTarget.h"
 #include "Sce/SceGnmDriver.h"
 #include "Sce/SceResourceTracker.h"
 #include "Sce/SceLabelManager.h"
+#include "Sce/SceSamplerCache.h"
 #include "Sce/SceVideoOut.h"
 
 LOG_CHANNEL(Graphic.VirtualGPU);
@@ -18,7 +21,8 @@ namespace sce
 	{
 		m_gnmDriver    = std::make_shared<SceGnmDriver>();
 		m_tracker      = std::make_shared<SceResourceTracker>();
-		m_labelManager = std::make_shared<SceLabelManager>(m_gnmDriver->m_device.ptr());
+		m_labelManager = std::make_shared<SceLabelManager>(m_gnmDriver->m_device.ptr(), m_tracker.get());
+		m_samplerCache = std::make_shared<SceSamplerCache>();
 	}
 
 	VirtualGPU::~VirtualGPU()
@@ -96,9 +100,24 @@ namespace sce
 		return *m_labelManager;
 	}
 
+	SceSamplerCache& VirtualGPU::samplerCache()
+	{
+		return *m_samplerCache;
+	}
+
 	Gnm::GpuMode VirtualGPU::mode()
 	{
 		return Gnm::kGpuModeNeo;
 	}
 
+	void VirtualGPU::onMemoryUnmap(void* start, size_t size)
+	{
+		m_tracker->invalidate(start, size);
+	}
+
+	Gnm::GpuMode Gnm::getGpuMode()
+	{
+		return GPU().mode();
+	}
+
 }  // namespace sce
\ No newline at end of file
@@ -3,21 +3,18 @@
 #include "GPCS4Common.h"
 #include "sce_types.h"
 #include "SceVideoOut/sce_videoout_types.h"
+#include "Gnm/GnmConstant.h"
 
 #include <array>
 #include <memory>
 
 namespace sce
 {
-	namespace Gnm
-	{
-		enum GpuMode;
-	}  // namespace Gnm
-
 	class SceVideoOut;
 	class SceGnmDriver;
 	class SceResourceTracker;
 	class SceLabelManager;
+	class SceSamplerCache;
 	
 	class VirtualGPU final
 	{
@@ -59,6 +56,11 @@ namespace sce
 		 */
 		SceLabelManager& labelManager();
 
+		/**
+		 * \brief Get GPU sampler cache.
+		 */
+		SceSamplerCache& samplerCache();
+
 		/**
 		 * \brief Global GPU mode.
 		 * 
@@ -68,6 +70,15 @@ namespace sce
 		 */
 		Gnm::GpuMode mode();
 
+		/**
+		 * \brief Guest memory is about to be unmapped
+		 *
+		 * Registered as unmap callback of the memory
+		 * allocator, drops GPU resources backed by
+		 * the range while it is still mapped.
+		 */
+		void onMemoryUnmap(void* start, size_t size);
+
 	private:
 
 		// it's better to use std::unique_ptr here
@@ -81,6 +92,7 @@ namespace sce
 
 		std::shared_ptr<SceResourceTracker> m_tracker      = nullptr;
 		std::shared_ptr<SceLabelManager>    m_labelManager = nullptr;
+		std::shared_ptr<SceSamplerCache>    m_samplerCache = nullptr;
 	};
 
 }  // namespace sce
\ No newline at end of file
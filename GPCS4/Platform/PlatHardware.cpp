@@ -1,5 +1,12 @@
 #include "PlatHardware.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 
 namespace plat
 {
@@ -33,4 +40,69 @@ uint64_t GetTscFrequency()
 #endif  //GPCS4_WINDOWS
 
 
+static void QueryCpuid(uint32_t leaf, uint32_t subLeaf, uint32_t regs[4])
+{
+#ifdef _MSC_VER
+	int info[4] = {};
+	__cpuidex(info, leaf, subLeaf);
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		regs[i] = static_cast<uint32_t>(info[i]);
+	}
+#else
+	if (!__get_cpuid_count(leaf, subLeaf, &regs[0], &regs[1], &regs[2], &regs[3]))
+	{
+		regs[0] = regs[1] = regs[2] = regs[3] = 0;
+	}
+#endif
+}
+
+__attribute__((target("xsave"))) static uint64_t QueryXcr0()
+{
+	return _xgetbv(0);
+}
+
+static CpuFeatures DetectCpuFeatures()
+{
+	CpuFeatures features = {};
+	do
+	{
+		uint32_t regs[4] = {};
+		QueryCpuid(0, 0, regs);
+		uint32_t maxLeaf = regs[0];
+		if (maxLeaf < 1)
+		{
+			break;
+		}
+
+		QueryCpuid(1, 0, regs);
+		features.ssse3 = (regs[2] >> 9) & 1;
+
+		// The OS must save the YMM and ZMM registers
+		// on context switches, or they can't be used.
+		bool osxsave = (regs[2] >> 27) & 1;
+		if (maxLeaf < 7 || !osxsave)
+		{
+			break;
+		}
+
+		uint64_t xcr0    = QueryXcr0();
+		bool     ymmSave = (xcr0 & 0x06) == 0x06;
+		bool     zmmSave = (xcr0 & 0xE6) == 0xE6;
+
+		QueryCpuid(7, 0, regs);
+		features.avx2     = ymmSave && ((regs[1] >> 5) & 1);
+		features.avx512f  = zmmSave && ((regs[1] >> 16) & 1);
+		features.avx512bw = zmmSave && ((regs[1] >> 30) & 1);
+	} while (false);
+	return features;
+}
+
+const CpuFeatures& GetCpuFeatures()
+{
+	static const CpuFeatures features = DetectCpuFeatures();
+	return features;
+}
+
+
 }
\ No newline at end of file
@@ -9,5 +9,17 @@ namespace plat
 
 uint64_t GetTscFrequency();
 
+struct CpuFeatures
+{
+	bool ssse3;
+	bool avx2;
+	bool avx512f;
+	bool avx512bw;
+};
+
+// Instruction sets usable by the process,
+// both supported by the CPU and enabled by the OS.
+const CpuFeatures& GetCpuFeatures();
+
 
 }
@@ -1,6 +1,8 @@
 #include "sce_libkernel.h"
 #include "sce_kernel_file.h"
 #include "MapSlot.h"
+#include "Emulator.h"
+#include "Emulator/VirtualCPU.h"
 #include "Platform/PlatPath.h"
 #include <io.h>
 #include <fcntl.h>
@@ -159,6 +161,8 @@ ssize_t PS4API sceKernelRead(int d, void *buf, size_t nbytes)
 {
 	LOG_SCE_TRACE("d %d buff %p nbytes %x", d, buf, nbytes);
 	int fd = g_fdSlots[d].fd;
+	// Host IO fails on write watched pages instead of faulting.
+	CPU().writeWatch().markDirty(buf, nbytes);
 	return _read(fd, buf, nbytes);
 }
 
@@ -462,6 +466,7 @@ ssize_t PS4API sceKernelPread(int d, void* buf, size_t nbytes, off_t offset)
 	// The read/write position pointer for the file will not move
 	auto off = _lseek(d, 0, SEEK_CUR);
 	_lseek(d, offset, SEEK_SET);
+	CPU().writeWatch().markDirty(buf, nbytes);
 	auto ret = _read(d, buf, nbytes);
 	_lseek(d, off, SEEK_SET);
 	return ret;
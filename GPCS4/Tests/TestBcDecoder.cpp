@@ -0,0 +1,247 @@
+#include "TestFramework.h"
+#include "TestBcDecoderImages.h"
+
+#include "Gnm/GnmBcDecoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace sce::Gnm;
+
+namespace
+{
+	enum class BlockPattern
+	{
+		Random,
+		// Cycles through the valid BC6H modes.
+		Bc6hModes,
+		// Cycles through the untransformed BC6H modes only.
+		Bc6hUntransformedModes,
+		// Cycles through the BC7 modes.
+		Bc7Modes,
+	};
+
+	enum class ChannelEncoding
+	{
+		Unorm,
+		Snorm,
+		Float,
+	};
+
+	struct ReferenceImage
+	{
+		const char*     name;
+		bc::BlockFormat format;
+		uint32_t        size;
+		uint32_t        blockBytes;
+		BlockPattern    pattern;
+		uint64_t        seed;
+		ChannelEncoding encoding;
+		uint32_t        channels;
+		// Interpolation may round differently
+		// between decoders, by one at most.
+		uint32_t       tolerance;
+		const uint8_t* reference;
+	};
+
+	// Signed BC6H is only checked on untransformed modes,
+	// the reference decoder gets transformed ones wrong.
+	const ReferenceImage g_images[] = {
+		{ "BC1", bc::BlockFormat::Bc1Rgba, 8, 8, BlockPattern::Random, 1, ChannelEncoding::Unorm, 4, 1, g_bc1Reference },
+		{ "BC2", bc::BlockFormat::Bc2, 8, 16, BlockPattern::Random, 2, ChannelEncoding::Unorm, 4, 1, g_bc2Reference },
+		{ "BC3", bc::BlockFormat::Bc3, 8, 16, BlockPattern::Random, 3, ChannelEncoding::Unorm, 4, 1, g_bc3Reference },
+		{ "BC4 UNORM", bc::BlockFormat::Bc4Unorm, 8, 8, BlockPattern::Random, 4, ChannelEncoding::Unorm, 1, 1, g_bc4UnormReference },
+		{ "BC5 UNORM", bc::BlockFormat::Bc5Unorm, 8, 16, BlockPattern::Random, 5, ChannelEncoding::Unorm, 2, 1, g_bc5UnormReference },
+		{ "BC5 SNORM", bc::BlockFormat::Bc5Snorm, 8, 16, BlockPattern::Random, 6, ChannelEncoding::Snorm, 2, 1, g_bc5SnormReference },
+		{ "BC6H UFLOAT", bc::BlockFormat::Bc6hUfloat, 16, 16, BlockPattern::Bc6hModes, 7, ChannelEncoding::Float, 3, 1, g_bc6hUfloatReference },
+		{ "BC6H SFLOAT", bc::BlockFormat::Bc6hSfloat, 16, 16, BlockPattern::Bc6hUntransformedModes, 8, ChannelEncoding::Float, 3, 1, g_bc6hSfloatReference },
+		{ "BC7", bc::BlockFormat::Bc7, 16, 16, BlockPattern::Bc7Modes, 9, ChannelEncoding::Unorm, 4, 0, g_bc7Reference },
+	};
+
+	const uint8_t g_bc6hModes[]              = { 0x00, 0x01, 0x02, 0x06, 0x0A, 0x0E, 0x12, 0x16, 0x1A, 0x1E, 0x03, 0x07, 0x0B, 0x0F };
+	const uint8_t g_bc6hUntransformedModes[] = { 0x03, 0x1E };
+
+	// Deterministic, the reference images were decoded from these blocks.
+	std::vector<uint8_t> makeBlocks(const ReferenceImage& image)
+	{
+		uint64_t state = 0x9E3779B97F4A7C15ull * image.seed;
+
+		uint32_t             blockCount = (image.size / 4) * (image.size / 4);
+		std::vector<uint8_t> blocks(blockCount * image.blockBytes);
+		for (auto& byte : blocks)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			byte = uint8_t(state >> 32);
+		}
+
+		for (uint32_t i = 0; i != blockCount; ++i)
+		{
+			uint8_t& mode = blocks[i * image.blockBytes];
+			switch (image.pattern)
+			{
+				case BlockPattern::Bc6hModes:
+				{
+					// Modes 0 and 1 use 2 bits, the others 5.
+					uint8_t value = g_bc6hModes[i % std::size(g_bc6hModes)];
+					mode          = value < 2 ? (mode & ~0x03) | value : (mode & ~0x1F) | value;
+					break;
+				}
+				case BlockPattern::Bc6hUntransformedModes:
+					mode = (mode & ~0x1F) | g_bc6hUntransformedModes[i % std::size(g_bc6hUntransformedModes)];
+					break;
+				case BlockPattern::Bc7Modes:
+				{
+					// The mode is the number of zero bits before the first one.
+					uint32_t index = i % 8;
+					mode           = (mode & ~((2u << index) - 1)) | (1u << index);
+					break;
+				}
+				default:
+					break;
+			}
+		}
+		return blocks;
+	}
+
+	float halfToFloat(uint16_t half)
+	{
+		uint32_t exponent = (half >> 10) & 0x1F;
+		uint32_t mantissa = half & 0x3FF;
+
+		float value = 0.0f;
+		if (exponent == 0)
+		{
+			value = std::ldexp(float(mantissa), -24);
+		}
+		else if (exponent == 31)
+		{
+			value = mantissa == 0 ? INFINITY : NAN;
+		}
+		else
+		{
+			value = std::ldexp(float(mantissa | 0x400), int(exponent) - 25);
+		}
+		return (half & 0x8000) ? -value : value;
+	}
+
+	// Decoded channel in the encoding of the reference images.
+	uint32_t getChannel(const ReferenceImage& image, const uint8_t* texel, uint32_t channel)
+	{
+		uint32_t value = 0;
+		switch (image.encoding)
+		{
+			case ChannelEncoding::Unorm:
+				value = texel[channel];
+				break;
+			case ChannelEncoding::Snorm:
+				value = uint8_t(texel[channel] + 128);
+				break;
+			case ChannelEncoding::Float:
+			{
+				uint16_t half;
+				std::memcpy(&half, texel + channel * 2, sizeof(half));
+				float f = halfToFloat(half);
+				value   = f > 0.0f ? uint32_t(std::min(f, 1.0f) * 255.0f) : 0;
+				break;
+			}
+		}
+		return value;
+	}
+
+	uint32_t getTexelSize(const ReferenceImage& image)
+	{
+		return image.encoding == ChannelEncoding::Float ? 8 : 4;
+	}
+
+}  // namespace
+
+GPCS4_TEST(BcDecoderReferenceImages)
+{
+	for (const auto& image : g_images)
+	{
+		auto blocks    = makeBlocks(image);
+		auto texelSize = getTexelSize(image);
+
+		std::vector<uint8_t> decoded(image.size * image.size * texelSize);
+		bc::decodeImage(image.format, decoded.data(), blocks.data(), image.size, image.size, 1);
+
+		uint32_t mismatches = 0;
+		for (uint32_t texel = 0; texel != image.size * image.size; ++texel)
+		{
+			for (uint32_t channel = 0; channel != image.channels; ++channel)
+			{
+				int32_t value     = int32_t(getChannel(image, &decoded[texel * texelSize], channel));
+				int32_t reference = image.reference[texel * image.channels + channel];
+				if (uint32_t(std::abs(value - reference)) > image.tolerance)
+				{
+					++mismatches;
+				}
+			}
+		}
+
+		std::string name = image.name;
+		ctx.check(mismatches == 0, (name + " matches reference").c_str(), __FILE__, __LINE__);
+	}
+}
+
+GPCS4_TEST(BcDecoderClipsEdgeBlocks)
+{
+	// A 6x5 image takes 2x2 blocks, the texels past
+	// the edge must not be written out.
+	const ReferenceImage& image  = g_images[0];
+	auto                  blocks = makeBlocks(image);
+
+	const uint32_t       width  = 6;
+	const uint32_t       height = 5;
+	std::vector<uint8_t> decoded(width * height * 4 + 64, 0xCD);
+	bc::decodeImage(image.format, decoded.data(), blocks.data(), width, height, 1);
+
+	// Blocks of the 8x8 image are laid out 2x2 as
+	// well, so texels match within the clipped area.
+	bool matches = true;
+	for (uint32_t y = 0; y != height; ++y)
+	{
+		for (uint32_t x = 0; x != width; ++x)
+		{
+			const uint8_t* texel     = &decoded[(y * width + x) * 4];
+			const uint8_t* reference = &image.reference[(y * image.size + x) * 4];
+			for (uint32_t channel = 0; channel != 4; ++channel)
+			{
+				matches &= std::abs(int32_t(texel[channel]) - int32_t(reference[channel])) <= 1;
+			}
+		}
+	}
+	ctx.check(matches, "clipped texels match reference", __FILE__, __LINE__);
+
+	bool guardIntact = std::all_of(decoded.begin() + width * height * 4, decoded.end(),
+								   [](uint8_t byte)
+								   { return byte == 0xCD; });
+	TEST_CHECK(guardIntact);
+}
+
+GPCS4_BENCH(BcDecoderThroughput)
+{
+	const uint32_t size = 1024;
+
+	for (const auto& image : g_images)
+	{
+		ReferenceImage large = image;
+		large.size           = size;
+		auto blocks          = makeBlocks(large);
+
+		std::vector<uint8_t> decoded(size * size * getTexelSize(image));
+
+		const uint32_t iterations = 8;
+		double         seconds    = test::measure(iterations, [&]()
+												  { bc::decodeImage(image.format, decoded.data(), blocks.data(), size, size, 1); });
+
+		// Throughput in decoded bytes.
+		ctx.reportThroughput(std::string(image.name) + " 1024x1024", double(decoded.size()) * iterations, seconds);
+	}
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <cstdint>
+
+// Reference images for TestBcDecoder.cpp, decoded by Pillow's BCn
+// decoder from the blocks generated by makeBlocks() in that file.
+//
+// Only the channels stored by the reference decoder are kept:
+// RGBA for BC1-BC3 and BC7, R for BC4, RG for BC5 and RGB for BC6H.
+// SNORM values are stored biased by 128. BC6H values are clamped
+// to [0, 1], scaled by 255 and truncated.
+
+namespace
+{
+	const uint8_t g_bc1Reference[8 * 8 * 4] = {
+		0xBD, 0x34, 0x73, 0xFF, 0xBD, 0x34, 0x73, 0xFF, 0x80, 0x53, 0x7B, 0xFF, 0x44, 0x72, 0x83, 0xFF,
+		0xD6, 0x71, 0x29, 0xFF, 0xA4, 0xA0, 0x70, 0xFF, 0x73, 0xCF, 0xB7, 0xFF, 0x73, 0xCF, 0xB7, 0xFF,
+		0x80, 0x53, 0x7B, 0xFF, 0x44, 0x72, 0x83, 0xFF, 0xBD, 0x34, 0x73, 0xFF, 0x44, 0x72, 0x83, 0xFF,
+		0x73, 0xCF, 0xB7, 0xFF, 0xA4, 0xA0, 0x70, 0xFF, 0x42, 0xFF, 0xFF, 0xFF, 0xA4, 0xA0, 0x70, 0xFF,
+		0xBD, 0x34, 0x73, 0xFF, 0x08, 0x92, 0x8C, 0xFF, 0xBD, 0x34, 0x73, 0xFF, 0x08, 0x92, 0x8C, 0xFF,
+		0xD6, 0x71, 0x29, 0xFF, 0xA4, 0xA0, 0x70, 0xFF, 0xA4, 0xA0, 0x70, 0xFF, 0x73, 0xCF, 0xB7, 0xFF,
+		0x80, 0x53, 0x7B, 0xFF, 0x44, 0x72, 0x83, 0xFF, 0x80, 0x53, 0x7B, 0xFF, 0xBD, 0x34, 0x73, 0xFF,
+		0x42, 0xFF, 0xFF, 0xFF, 0xA4, 0xA0, 0x70, 0xFF, 0x73, 0xCF, 0xB7, 0xFF, 0x42, 0xFF, 0xFF, 0xFF,
+		0x00, 0x00, 0x00, 0x00, 0xCE, 0xF7, 0x8C, 0xFF, 0xBD, 0xE7, 0xC6, 0xFF, 0x00, 0x00, 0x00, 0x00,
+		0xD3, 0x3B, 0x6D, 0xFF, 0xD3, 0x3B, 0x6D, 0xFF, 0xD3, 0x3B, 0x6D, 0xFF, 0xC6, 0x59, 0x9C, 0xFF,
+		0xC5, 0xEF, 0xA9, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCE, 0xF7, 0x8C, 0xFF,
+		0xEF, 0x00, 0x10, 0xFF, 0xD3, 0x3B, 0x6D, 0xFF, 0xE1, 0x1D, 0x3E, 0xFF, 0xEF, 0x00, 0x10, 0xFF,
+		0xCE, 0xF7, 0x8C, 0xFF, 0xCE, 0xF7, 0x8C, 0xFF, 0xCE, 0xF7, 0x8C, 0xFF, 0x00, 0x00, 0x00, 0x00,
+		0xE1, 0x1D, 0x3E, 0xFF, 0xD3, 0x3B, 0x6D, 0xFF, 0xC6, 0x59, 0x9C, 0xFF, 0xEF, 0x00, 0x10, 0xFF,
+		0xBD, 0xE7, 0xC6, 0xFF, 0xBD, 0xE7, 0xC6, 0xFF, 0xC5, 0xEF, 0xA9, 0xFF, 0xBD, 0xE7, 0xC6, 0xFF,
+		0xC6, 0x59, 0x9C, 0xFF, 0xEF, 0x00, 0x10, 0xFF, 0xE1, 0x1D, 0x3E, 0xFF, 0xEF, 0x00, 0x10, 0xFF,
+	};
+
+	const uint8_t g_bc2Reference[8 * 8 * 4] = {
+		0xBD, 0x84, 0x86, 0xCC, 0xBD, 0x82, 0x5A, 0x55, 0xBD, 0x86, 0x9C, 0x22, 0xBD, 0x83, 0x70, 0x77,
+		0xCE, 0x6D, 0x08, 0xAA, 0x52, 0xB2, 0x84, 0xEE, 0xA4, 0x84, 0x31, 0x66, 0x7B, 0x9B, 0x5A, 0x11,
+		0xBD, 0x83, 0x70, 0x33, 0xBD, 0x84, 0x86, 0x22, 0xBD, 0x86, 0x9C, 0xCC, 0xBD, 0x84, 0x86, 0x11,
+		0xCE, 0x6D, 0x08, 0x88, 0xA4, 0x84, 0x31, 0x55, 0xA4, 0x84, 0x31, 0xBB, 0xA4, 0x84, 0x31, 0x55,
+		0xBD, 0x83, 0x70, 0x77, 0xBD, 0x84, 0x86, 0xFF, 0xBD, 0x86, 0x9C, 0x99, 0xBD, 0x82, 0x5A, 0x00,
+		0xA4, 0x84, 0x31, 0x77, 0xA4, 0x84, 0x31, 0x77, 0x52, 0xB2, 0x84, 0x33, 0xA4, 0x84, 0x31, 0xEE,
+		0xBD, 0x82, 0x5A, 0x88, 0xBD, 0x84, 0x86, 0xAA, 0xBD, 0x83, 0x70, 0x44, 0xBD, 0x86, 0x9C, 0xDD,
+		0xA4, 0x84, 0x31, 0x55, 0x52, 0xB2, 0x84, 0x77, 0xCE, 0x6D, 0x08, 0xCC, 0x7B, 0x9B, 0x5A, 0xFF,
+		0x10, 0xCB, 0x5A, 0x22, 0x2B, 0xAF, 0x65, 0x55, 0x10, 0xCB, 0x5A, 0xCC, 0x2B, 0xAF, 0x65, 0x00,
+		0xE1, 0x4F, 0x3F, 0xAA, 0xCB, 0x86, 0x5D, 0x44, 0xCB, 0x86, 0x5D, 0x66, 0xE1, 0x4F, 0x3F, 0x11,
+		0x63, 0x79, 0x7B, 0x99, 0x63, 0x79, 0x7B, 0x55, 0x63, 0x79, 0x7B, 0x55, 0x10, 0xCB, 0x5A, 0x44,
+		0xB5, 0xBE, 0x7B, 0xBB, 0xB5, 0xBE, 0x7B, 0xFF, 0xB5, 0xBE, 0x7B, 0xFF, 0xB5, 0xBE, 0x7B, 0x55,
+		0x10, 0xCB, 0x5A, 0xCC, 0x47, 0x94, 0x70, 0xCC, 0x2B, 0xAF, 0x65, 0x55, 0x2B, 0xAF, 0x65, 0x00,
+		0xCB, 0x86, 0x5D, 0xFF, 0xCB, 0x86, 0x5D, 0x55, 0xF7, 0x18, 0x21, 0x77, 0xB5, 0xBE, 0x7B, 0x66,
+		0x47, 0x94, 0x70, 0xCC, 0x47, 0x94, 0x70, 0x44, 0x10, 0xCB, 0x5A, 0x55, 0x63, 0x79, 0x7B, 0x00,
+		0xCB, 0x86, 0x5D, 0x66, 0xCB, 0x86, 0x5D, 0x44, 0xCB, 0x86, 0x5D, 0x99, 0xB5, 0xBE, 0x7B, 0x77,
+	};
+
+	const uint8_t g_bc3Reference[8 * 8 * 4] = {
+		0xB2, 0x3C, 0x8B, 0xC6, 0x75, 0x54, 0xC5, 0xCC, 0x39, 0x6D, 0xFF, 0xC0, 0x39, 0x6D, 0xFF, 0xB4,
+		0x29, 0x9A, 0x7B, 0x66, 0x00, 0x9E, 0x84, 0x1D, 0x7B, 0x92, 0x6B, 0x57, 0x29, 0x9A, 0x7B, 0x0F,
+		0xB2, 0x3C, 0x8B, 0x00, 0xB2, 0x3C, 0x8B, 0xC6, 0xEF, 0x24, 0x52, 0xBA, 0x75, 0x54, 0xC5, 0xFF,
+		0x29, 0x9A, 0x7B, 0x0F, 0x29, 0x9A, 0x7B, 0x49, 0x52, 0x96, 0x73, 0x75, 0x29, 0x9A, 0x7B, 0x66,
+		0xB2, 0x3C, 0x8B, 0xAE, 0xB2, 0x3C, 0x8B, 0x00, 0x75, 0x54, 0xC5, 0xC0, 0xEF, 0x24, 0x52, 0xC0,
+		0x29, 0x9A, 0x7B, 0x66, 0x52, 0x96, 0x73, 0x66, 0x00, 0x9E, 0x84, 0x1D, 0x00, 0x9E, 0x84, 0x0F,
+		0xEF, 0x24, 0x52, 0xBA, 0x75, 0x54, 0xC5, 0xFF, 0xB2, 0x3C, 0x8B, 0xAE, 0xEF, 0x24, 0x52, 0xB4,
+		0x52, 0x96, 0x73, 0x1D, 0x7B, 0x92, 0x6B, 0x2C, 0x29, 0x9A, 0x7B, 0x0F, 0x29, 0x9A, 0x7B, 0x75,
+		0xB8, 0x70, 0x9C, 0x68, 0xB8, 0x70, 0x9C, 0x00, 0xAD, 0x41, 0x8C, 0x68, 0xCE, 0xCF, 0xBD, 0x68,
+		0xA5, 0x96, 0x3E, 0xE7, 0x84, 0xD3, 0x31, 0xC2, 0xE7, 0x1C, 0x5A, 0x9E, 0xE7, 0x1C, 0x5A, 0x92,
+		0xCE, 0xCF, 0xBD, 0x8F, 0xB8, 0x70, 0x9C, 0x68, 0xAD, 0x41, 0x8C, 0x68, 0xB8, 0x70, 0x9C, 0x9D,
+		0xA5, 0x96, 0x3E, 0xCE, 0x84, 0xD3, 0x31, 0xDA, 0x84, 0xD3, 0x31, 0xAA, 0xE7, 0x1C, 0x5A, 0xE7,
+		0xB8, 0x70, 0x9C, 0x82, 0xAD, 0x41, 0x8C, 0x82, 0xCE, 0xCF, 0xBD, 0x9D, 0xB8, 0x70, 0x9C, 0x8F,
+		0x84, 0xD3, 0x31, 0xCE, 0x84, 0xD3, 0x31, 0xC2, 0xC6, 0x59, 0x4C, 0xB6, 0xE7, 0x1C, 0x5A, 0xCE,
+		0xAD, 0x41, 0x8C, 0x82, 0xB8, 0x70, 0x9C, 0x75, 0xCE, 0xCF, 0xBD, 0x8F, 0xAD, 0x41, 0x8C, 0xFF,
+		0xC6, 0x59, 0x4C, 0xCE, 0xA5, 0x96, 0x3E, 0xC2, 0xA5, 0x96, 0x3E, 0x92, 0xC6, 0x59, 0x4C, 0xC2,
+	};
+
+	const uint8_t g_bc4UnormReference[8 * 8 * 1] = {
+		0xC9, 0xB8, 0xE4, 0xDB, 0x6C, 0x15, 0x32, 0xFF, 0xB8, 0xC0, 0xFF, 0xC0, 0x4F, 0x00, 0x6C, 0x6C,
+		0xFF, 0xD2, 0xC0, 0xD2, 0x15, 0xA6, 0xFF, 0x15, 0x00, 0xE4, 0x00, 0xE4, 0x4F, 0x32, 0x6C, 0x32,
+		0x00, 0x00, 0xCD, 0x85, 0x3A, 0x5F, 0x5F, 0x85, 0x85, 0xE0, 0xA9, 0xA9, 0x3A, 0x85, 0xAB, 0xAB,
+		0xE0, 0xE0, 0x85, 0xE0, 0x85, 0x4C, 0x98, 0x85, 0x00, 0xCD, 0xFF, 0x97, 0x4C, 0x4C, 0xAB, 0x3A,
+	};
+
+	const uint8_t g_bc5UnormReference[8 * 8 * 2] = {
+		0x6D, 0x85, 0x7E, 0x67, 0x3A, 0xB3, 0xFF, 0xB3, 0x0F, 0xAF, 0x12, 0xC3, 0x12, 0x00, 0x17, 0xEB,
+		0x4B, 0xA3, 0x7E, 0x85, 0x4B, 0x85, 0x8F, 0x76, 0x15, 0x9C, 0x15, 0xAF, 0x12, 0xAF, 0x0D, 0xD7,
+		0x3A, 0x67, 0x7E, 0x67, 0x3A, 0x49, 0x00, 0x85, 0x11, 0x9C, 0x0E, 0xC3, 0x0F, 0xFF, 0x12, 0xAF,
+		0x6D, 0xB3, 0x5C, 0x94, 0x6D, 0xA3, 0x5C, 0x94, 0x12, 0xEB, 0x17, 0xC3, 0x17, 0xD7, 0x15, 0xFF,
+		0x41, 0x99, 0x00, 0x0E, 0x2B, 0x0E, 0x00, 0x99, 0x53, 0x92, 0x66, 0xAC, 0x59, 0x92, 0x53, 0x8C,
+		0x32, 0x53, 0x48, 0x0E, 0x41, 0xBC, 0xFF, 0x00, 0x46, 0xAC, 0x53, 0xA5, 0x46, 0x86, 0x53, 0x86,
+		0x00, 0xFF, 0x00, 0xFF, 0x39, 0x00, 0x41, 0x0E, 0x66, 0xAC, 0x66, 0xAC, 0x5F, 0x9F, 0x3A, 0xA5,
+		0x39, 0x53, 0xFF, 0x53, 0x41, 0xBC, 0x50, 0xBC, 0x59, 0x86, 0x53, 0x92, 0x46, 0x86, 0x40, 0x80,
+	};
+
+	const uint8_t g_bc5SnormReference[8 * 8 * 2] = {
+		0xC0, 0xC8, 0xA4, 0x82, 0xDD, 0x9E, 0x6C, 0x75, 0x52, 0xFF, 0x64, 0xA5, 0x76, 0xA5, 0x5B, 0x92,
+		0x88, 0x82, 0x18, 0xAC, 0xA4, 0xBA, 0x50, 0xC8, 0x6D, 0xA5, 0x5B, 0x98, 0xFF, 0x98, 0x6D, 0x9E,
+		0x6C, 0xC8, 0x88, 0xD6, 0x6C, 0xAC, 0xDD, 0xAC, 0xFF, 0x8C, 0x5B, 0x00, 0x00, 0x98, 0x6D, 0x86,
+		0x6C, 0x90, 0xC0, 0x75, 0xA4, 0x75, 0x18, 0xAC, 0x76, 0x00, 0x6D, 0x98, 0x52, 0x98, 0x52, 0xFF,
+		0xEA, 0x2A, 0xEA, 0x8D, 0x95, 0x74, 0x95, 0x8D, 0x25, 0xAA, 0x7B, 0x00, 0x25, 0xCC, 0x69, 0xFF,
+		0xAA, 0x8D, 0xAA, 0x2A, 0x6B, 0x12, 0xD4, 0xA6, 0xFF, 0xCC, 0x00, 0x67, 0x36, 0x67, 0x58, 0x00,
+		0xEA, 0x12, 0x80, 0x43, 0xBF, 0x5C, 0x56, 0x12, 0x36, 0x88, 0x25, 0x88, 0x7B, 0xCC, 0x7B, 0x67,
+		0xD4, 0x74, 0x95, 0x8D, 0xBF, 0x8D, 0xD4, 0x5C, 0x25, 0x88, 0x7B, 0x67, 0x00, 0xFF, 0x7B, 0xFF,
+	};
+
+	const uint8_t g_bc6hUfloatReference[16 * 16 * 3] = {
+		0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0x72, 0x00, 0xFF,
+		0x4A, 0x00, 0xFF, 0x57, 0x00, 0xFF, 0x72, 0x00, 0x0E, 0x00, 0x2D, 0x0E, 0x00, 0x2C, 0x0E, 0x00,
+		0x2D, 0x0E, 0x00, 0x2D, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00,
+		0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x03, 0xFF,
+		0x99, 0x00, 0xFF, 0x4A, 0x00, 0xFF, 0x7F, 0x00, 0x0D, 0x00, 0x2C, 0x0D, 0x00, 0x2B, 0x0D, 0x00,
+		0x2B, 0x0E, 0x00, 0x2E, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00,
+		0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xD9, 0xFF, 0xFF,
+		0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0x99, 0x00, 0x0D, 0x00, 0x2C, 0x0E, 0x00, 0x2C, 0x0D, 0x00,
+		0x2B, 0x10, 0x00, 0x2E, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00,
+		0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF,
+		0xFF, 0x03, 0xFF, 0xFF, 0x40, 0xFF, 0xFF, 0xFF, 0x0D, 0x00, 0x2A, 0x0E, 0x00, 0x2D, 0x0F, 0x00,
+		0x2E, 0x0F, 0x00, 0x2E, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00,
+		0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x4D, 0xFF,
+		0xFF, 0x6C, 0xFF, 0xFF, 0x5F, 0xFF, 0xFF, 0x4C, 0x0B, 0x00, 0xFF, 0x07, 0x00, 0xFF, 0x00, 0x00,
+		0xFF, 0x01, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0x59, 0x00, 0xFF, 0x59, 0x00,
+		0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x4B, 0xF5,
+		0xFF, 0x45, 0xFF, 0xFF, 0x5F, 0xFF, 0xFF, 0x4B, 0x07, 0x00, 0xFF, 0x20, 0x00, 0xFF, 0x07, 0x00,
+		0xFF, 0x03, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00,
+		0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x4C, 0xFF,
+		0xFF, 0x6C, 0xD8, 0xFF, 0x3C, 0xFF, 0xFF, 0x4D, 0x01, 0x00, 0xFF, 0x07, 0x00, 0xFF, 0x0F, 0x00,
+		0xFF, 0x17, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0x59, 0x00, 0xFF, 0x59, 0x00, 0xFF, 0xFF, 0x00,
+		0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x4B, 0xFF,
+		0xFF, 0x53, 0xD8, 0xFF, 0x3C, 0xFF, 0xFF, 0x4D, 0x00, 0x00, 0xFF, 0x01, 0x00, 0xFF, 0x03, 0x00,
+		0xFF, 0x20, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00,
+		0x13, 0xFF, 0xFF, 0x10, 0xFF, 0xFF, 0x13, 0xFF, 0xFF, 0x18, 0xFF, 0xFF, 0xFF, 0xFF, 0x2E, 0x7C,
+		0xFF, 0xCD, 0x0B, 0x0A, 0x03, 0x01, 0x04, 0x02, 0xD2, 0xFF, 0x02, 0x2C, 0xFF, 0x00, 0x7F, 0xFF,
+		0x01, 0x06, 0x0A, 0x00, 0x00, 0xFF, 0x0E, 0x00, 0xFF, 0x03, 0x00, 0xFF, 0x0C, 0x00, 0xFF, 0x03,
+		0x0E, 0xFF, 0xFF, 0x0A, 0xFF, 0xFF, 0x13, 0xFF, 0xFF, 0x0D, 0xFF, 0xFF, 0x02, 0x0B, 0xFF, 0xFF,
+		0x34, 0x04, 0xFF, 0x73, 0x05, 0x00, 0x00, 0x01, 0xD2, 0xFF, 0x02, 0xD2, 0xFF, 0x02, 0x01, 0x00,
+		0x00, 0x1B, 0x8D, 0x00, 0x00, 0xFF, 0x16, 0x00, 0xFF, 0x02, 0x00, 0xFF, 0x12, 0x00, 0xFF, 0x0E,
+		0x16, 0xFF, 0xFF, 0x13, 0xFF, 0xFF, 0x12, 0xFF, 0xFF, 0x19, 0xFF, 0xFF, 0x00, 0x00, 0x01, 0x00,
+		0x01, 0x02, 0xFF, 0x73, 0x05, 0x00, 0x01, 0x02, 0x13, 0x4E, 0x00, 0xFF, 0xFF, 0x02, 0x3D, 0xFF,
+		0x00, 0x06, 0x0A, 0x00, 0x00, 0xFF, 0x19, 0x00, 0xFF, 0x0E, 0x00, 0xFF, 0x0A, 0x00, 0xFF, 0x05,
+		0x0E, 0xFF, 0xFF, 0x16, 0xFF, 0xFF, 0x16, 0xFF, 0xFF, 0x0F, 0xFF, 0xFF, 0x00, 0x01, 0x02, 0x00,
+		0x00, 0x01, 0x00, 0x00, 0x01, 0x43, 0x17, 0x03, 0x06, 0x0A, 0x00, 0x5D, 0xFF, 0x01, 0x00, 0x00,
+		0x00, 0x0D, 0x2B, 0x00, 0x00, 0xFF, 0x0F, 0x00, 0xFF, 0x0E, 0x00, 0xFF, 0x05, 0x00, 0xFF, 0x0A,
+		0xFF, 0x00, 0x0F, 0xFF, 0x00, 0x0D, 0xFF, 0x00, 0x12, 0xFF, 0x01, 0x0B, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x6E, 0xFD, 0xFF, 0x7D, 0xE8, 0xFF, 0x79,
+		0xED, 0xFF, 0x6E, 0xFD, 0xFF, 0x00, 0xFF, 0x1F, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0x1F, 0xFF, 0xFF,
+		0xFF, 0x00, 0x0F, 0xFF, 0x00, 0x0F, 0xFF, 0x01, 0x0A, 0xFF, 0x01, 0x0C, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x6E, 0xFD, 0xFF, 0x7D, 0xE8, 0xFF, 0x7D,
+		0xE8, 0xFF, 0x71, 0xF8, 0xFF, 0x44, 0xFF, 0xC4, 0xFF, 0xFF, 0x6B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0x01, 0x0C, 0xFF, 0x00, 0x12, 0xFF, 0x01, 0x0C, 0xFF, 0x00, 0x0F, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x7D, 0xE8, 0xFF, 0x79, 0xED, 0xFF, 0x83,
+		0xE3, 0xFF, 0x7F, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0x00, 0x0F, 0xFF, 0x01, 0x0C, 0xFF, 0x01, 0x0C, 0xFF, 0x00, 0x0D, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x6E, 0xFD, 0xFF, 0x66, 0xFF, 0xFF, 0x7D,
+		0xFF, 0xFF, 0x7C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0xFF,
+	};
+
+	const uint8_t g_bc6hSfloatReference[16 * 16 * 3] = {
+		0x00, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5E, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00,
+		0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x0D, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+		0x00, 0x04, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x5E, 0x00, 0x00, 0x07, 0x00,
+		0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+		0x00, 0x02, 0x00, 0x01, 0x0A, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0xFF, 0xFF, 0x20, 0xFF, 0x67, 0x1C, 0xFF, 0xFF, 0x1E, 0x76, 0x04, 0x18, 0x00, 0x00, 0x01, 0x00,
+		0x10, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00,
+		0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+		0xFF, 0x67, 0x1C, 0x76, 0x04, 0x18, 0x00, 0x00, 0x14, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x2B, 0x00,
+		0xFF, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+		0x00, 0x08, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x0E, 0x00, 0x00, 0x0D, 0xFF, 0x16, 0x1A, 0x00, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xC3, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x0F, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x0F, 0x00, 0x00, 0x09, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x07, 0x00, 0x00, 0x2B, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0xED, 0x00, 0x01, 0x0F, 0x00, 0x00, 0xED, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0x02, 0xFF, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0xFF, 0xFF, 0xFF, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x19, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x02,
+		0x00, 0x03, 0x02, 0x00, 0x03, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0xFF, 0x00, 0x00,
+		0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x02, 0xFF, 0x00, 0x00, 0xFF, 0x19, 0x00, 0xFF, 0x00,
+		0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+		0x00, 0x00, 0xFF, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xD7, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x03, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x02, 0x02, 0xFF, 0xE2, 0xFF, 0xFF, 0xE2, 0xFF, 0xFF,
+		0x00, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x16, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x02, 0xFF, 0x32, 0x59, 0xFF,
+		0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00,
+		0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x02, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0x32, 0x59, 0xFF, 0xE2, 0xFF, 0xFF,
+		0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0xDA, 0x00,
+		0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0xC3, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xC3, 0xFF,
+	};
+
+	const uint8_t g_bc7Reference[16 * 16 * 4] = {
+		0x98, 0xA7, 0xA7, 0xFF, 0xC1, 0xB0, 0xB0, 0xFF, 0x8D, 0x6C, 0xD7, 0xFF, 0x6A, 0x9C, 0x83, 0xFF,
+		0x77, 0x64, 0x28, 0xFF, 0x8D, 0x7E, 0x32, 0xFF, 0x8D, 0x7E, 0x32, 0xFF, 0x78, 0x54, 0x51, 0xFF,
+		0x52, 0xA5, 0x10, 0xFF, 0x52, 0xA5, 0x10, 0xFF, 0x3F, 0xBE, 0x77, 0xFF, 0x23, 0x8B, 0x3E, 0xFF,
+		0xB4, 0x30, 0x38, 0xFF, 0x21, 0x5B, 0x9D, 0xFF, 0x37, 0xA3, 0x01, 0xFF, 0xC2, 0x25, 0x94, 0xFF,
+		0x57, 0x99, 0x99, 0xFF, 0x71, 0x92, 0x94, 0xFF, 0x78, 0x89, 0xA4, 0xFF, 0x68, 0xC0, 0x35, 0xFF,
+		0x62, 0x4A, 0x1E, 0xFF, 0x4C, 0x30, 0x14, 0xFF, 0x4C, 0x30, 0x14, 0xFF, 0x6D, 0x71, 0x70, 0xFF,
+		0x79, 0x9A, 0x37, 0xFF, 0x5A, 0xEF, 0xAD, 0xFF, 0x56, 0xC0, 0xE4, 0xFF, 0x56, 0xC0, 0xE4, 0xFF,
+		0xB4, 0x30, 0x38, 0xFF, 0x21, 0x5B, 0x9D, 0xFF, 0x30, 0x8B, 0x34, 0xFF, 0xBB, 0x2A, 0x65, 0xFF,
+		0x7F, 0x7F, 0xB6, 0xFF, 0x7F, 0x7F, 0xB6, 0xFF, 0xC3, 0xA8, 0x86, 0xFF, 0x52, 0xC6, 0x21, 0xFF,
+		0xCF, 0xCF, 0x52, 0xFF, 0x8D, 0x7E, 0x32, 0xFF, 0xBA, 0xB5, 0x48, 0xFF, 0x67, 0x80, 0x81, 0xFF,
+		0x52, 0xA5, 0x10, 0xFF, 0x5A, 0xEF, 0xAD, 0xFF, 0x98, 0xCB, 0xE1, 0xFF, 0x18, 0xB5, 0xE7, 0xFF,
+		0x37, 0xA3, 0x01, 0xFF, 0xC2, 0x25, 0x94, 0xFF, 0xC9, 0x1F, 0xC1, 0xFF, 0x37, 0xA3, 0x01, 0xFF,
+		0x78, 0x89, 0xA4, 0xFF, 0x52, 0xC6, 0x21, 0xFF, 0xAD, 0xAE, 0x72, 0xFF, 0xAD, 0xAE, 0x72, 0xFF,
+		0x4C, 0x30, 0x14, 0xFF, 0xA4, 0x9B, 0x3E, 0xFF, 0x62, 0x4A, 0x1E, 0xFF, 0x78, 0x54, 0x51, 0xFF,
+		0x65, 0x9F, 0x23, 0xFF, 0x79, 0x9A, 0x37, 0xFF, 0x23, 0x8B, 0x3E, 0xFF, 0x3F, 0xBE, 0x77, 0xFF,
+		0x21, 0x5B, 0x9D, 0xFF, 0xB4, 0x30, 0x38, 0xFF, 0xC2, 0x25, 0x94, 0xFF, 0x21, 0x5B, 0x9D, 0xFF,
+		0xB8, 0x31, 0x23, 0x73, 0x8C, 0x31, 0x16, 0xA5, 0x8C, 0x31, 0x40, 0xA5, 0xB8, 0x31, 0x23, 0x73,
+		0x40, 0x1E, 0x58, 0xE3, 0x0A, 0x74, 0x58, 0x4C, 0x40, 0x1E, 0x37, 0xE3, 0x40, 0x1E, 0x58, 0xE3,
+		0x66, 0xB8, 0xC0, 0xC1, 0x66, 0xBC, 0xC6, 0xD2, 0x66, 0xB0, 0xB2, 0x98, 0x66, 0xB4, 0xB8, 0xAA,
+		0xB6, 0x7D, 0xDF, 0x86, 0xE4, 0x8B, 0xEC, 0x31, 0xFB, 0x92, 0xF3, 0x08, 0xB6, 0x7D, 0xDF, 0x86,
+		0xB8, 0x31, 0x40, 0x73, 0x8C, 0x31, 0x5B, 0xA5, 0x8C, 0x31, 0x4E, 0xA5, 0xA2, 0x31, 0x08, 0x8C,
+		0x1C, 0x58, 0x58, 0x7E, 0x0A, 0x74, 0x37, 0x4C, 0x0A, 0x74, 0x58, 0x4C, 0x2E, 0x3A, 0x77, 0xB1,
+		0x66, 0xB1, 0xB4, 0x9F, 0x66, 0xAE, 0xAE, 0x8D, 0x66, 0xB4, 0xB8, 0xAA, 0x66, 0xAB, 0xAA, 0x81,
+		0xE4, 0x8B, 0xEC, 0x31, 0xCD, 0x84, 0xE6, 0x5D, 0xB6, 0x7D, 0xDF, 0x86, 0x89, 0xD1, 0x6C, 0x2F,
+		0xA2, 0x31, 0x16, 0x8C, 0xA2, 0x31, 0x4E, 0x8C, 0xA2, 0x31, 0x5B, 0x8C, 0xA2, 0x31, 0x16, 0x8C,
+		0x0A, 0x74, 0x37, 0x4C, 0x0A, 0x74, 0x58, 0x4C, 0x40, 0x1E, 0x18, 0xE3, 0x2E, 0x3A, 0x58, 0xB1,
+		0x66, 0xAE, 0xAE, 0x8D, 0x66, 0xAD, 0xAC, 0x88, 0x66, 0xAE, 0xAE, 0x8D, 0x66, 0xB8, 0xC0, 0xC1,
+		0xE4, 0x8B, 0xEC, 0x31, 0xCD, 0x84, 0xE6, 0x5D, 0xCD, 0x84, 0xE6, 0x5D, 0x34, 0xBE, 0xF7, 0x2C,
+		0xCE, 0x31, 0x08, 0x5A, 0xCE, 0x31, 0x40, 0x5A, 0x8C, 0x31, 0x4E, 0xA5, 0xB8, 0x31, 0x5B, 0x73,
+		0x40, 0x1E, 0x77, 0xE3, 0x40, 0x1E, 0x58, 0xE3, 0x0A, 0x74, 0x37, 0x4C, 0x1C, 0x58, 0x77, 0x7E,
+		0x66, 0xB1, 0xB4, 0x9F, 0x66, 0xB5, 0xBA, 0xAF, 0x66, 0xB6, 0xBC, 0xB6, 0x66, 0xB5, 0xBA, 0xAF,
+		0xE4, 0x8B, 0xEC, 0x31, 0xFB, 0x92, 0xF3, 0x08, 0x5D, 0xC8, 0xB3, 0x2D, 0x89, 0xD1, 0x6C, 0x2F,
+		0x18, 0x8C, 0x08, 0xFF, 0x35, 0x7B, 0x0C, 0xFF, 0xCF, 0xEE, 0x97, 0xFF, 0xC3, 0xF9, 0xB0, 0xFF,
+		0x89, 0x10, 0xD5, 0xFF, 0x85, 0x1A, 0xBF, 0xFF, 0x68, 0xB4, 0x9F, 0xFF, 0x71, 0xAE, 0xB2, 0xFF,
+		0x4A, 0x63, 0x10, 0xFF, 0xAC, 0xAA, 0x52, 0xFF, 0x84, 0xBD, 0x29, 0xFF, 0x34, 0x37, 0x3C, 0xFF,
+		0x96, 0xAC, 0x4A, 0xFF, 0x89, 0x91, 0x31, 0xFF, 0x1D, 0x99, 0x3F, 0xFF, 0x33, 0xB4, 0x3E, 0xFF,
+		0x6F, 0x58, 0x13, 0xFF, 0xD5, 0xE7, 0x89, 0xFF, 0xCF, 0xEE, 0x97, 0xFF, 0x5C, 0x21, 0xDC, 0xFF,
+		0x85, 0x1A, 0xBF, 0xFF, 0x78, 0x3A, 0x7A, 0xFF, 0x78, 0xA7, 0xC4, 0xFF, 0x68, 0xB4, 0x9F, 0xFF,
+		0x84, 0xBD, 0x29, 0xFF, 0x4A, 0x29, 0x8C, 0xFF, 0xC6, 0x73, 0x29, 0xFF, 0xAC, 0xAA, 0x52, 0xFF,
+		0x89, 0x91, 0x31, 0xFF, 0x1D, 0x99, 0x3F, 0xFF, 0x33, 0xB4, 0x3E, 0xFF, 0x96, 0xAC, 0x4A, 0xFF,
+		0xE7, 0xD6, 0x63, 0xFF, 0xE7, 0xD6, 0x63, 0xFF, 0x5A, 0x18, 0xEF, 0xFF, 0x5C, 0x21, 0xDC, 0xFF,
+		0x85, 0x1A, 0xBF, 0xFF, 0x6C, 0x58, 0x38, 0xFF, 0x68, 0xB4, 0x9F, 0xFF, 0x87, 0x9B, 0xE7, 0xFF,
+		0xD7, 0x97, 0x7C, 0xFF, 0x9D, 0x5B, 0x49, 0xFF, 0xC6, 0x73, 0x29, 0xFF, 0xFF, 0x84, 0xA5, 0xFF,
+		0xB2, 0xE2, 0x7C, 0xFF, 0x33, 0xB4, 0x3E, 0xFF, 0x5F, 0xEB, 0x3B, 0xFF, 0x96, 0xAC, 0x4A, 0xFF,
+		0xBD, 0xFF, 0xBD, 0xFF, 0x64, 0x3E, 0xA3, 0xFF, 0x5F, 0x2B, 0xCA, 0xFF, 0x61, 0x34, 0xB7, 0xFF,
+		0x74, 0x44, 0x64, 0xFF, 0x7D, 0x2E, 0x93, 0xFF, 0x87, 0x9B, 0xE7, 0xFF, 0x71, 0xAE, 0xB2, 0xFF,
+		0x34, 0x37, 0x3C, 0xFF, 0x84, 0xBD, 0x29, 0xFF, 0xFF, 0x84, 0xA5, 0xFF, 0x3F, 0x4D, 0x26, 0xFF,
+		0x1D, 0x99, 0x3F, 0xFF, 0x1D, 0x99, 0x3F, 0xFF, 0x89, 0x91, 0x31, 0xFF, 0xA5, 0xC7, 0x63, 0xFF,
+		0x7D, 0x2C, 0x86, 0x92, 0x49, 0x39, 0x6B, 0xC6, 0x92, 0x10, 0xBD, 0x29, 0x7D, 0x39, 0x6B, 0xC6,
+		0x45, 0x14, 0x6C, 0x24, 0x78, 0x44, 0x67, 0x44, 0x78, 0x14, 0x6C, 0x24, 0x45, 0x14, 0x6C, 0x24,
+		0x56, 0x34, 0xCE, 0x63, 0xB6, 0x30, 0x49, 0x9C, 0x6A, 0x33, 0xB2, 0x6F, 0xA2, 0x31, 0x65, 0x90,
+		0xAE, 0xDF, 0xE7, 0x45, 0xD2, 0x8A, 0x98, 0x1C, 0xAE, 0xDF, 0xE7, 0x45, 0xBF, 0xB6, 0xC0, 0x31,
+		0x73, 0x10, 0xBD, 0x29, 0x5E, 0x10, 0xBD, 0x29, 0x92, 0x39, 0x6B, 0xC6, 0x7D, 0x10, 0xBD, 0x29,
+		0x78, 0x77, 0x61, 0x67, 0xA9, 0xA7, 0x5C, 0x87, 0x45, 0x77, 0x61, 0x67, 0x78, 0xA7, 0x5C, 0x87,
+		0x8B, 0x32, 0x84, 0x82, 0x35, 0x35, 0xFB, 0x4F, 0x3F, 0x35, 0xED, 0x55, 0xA2, 0x31, 0x65, 0x90,
+		0x24, 0x1C, 0xD7, 0xD7, 0xAE, 0xDF, 0xE7, 0x45, 0xD2, 0x8A, 0x98, 0x1C, 0xD2, 0x8A, 0x98, 0x1C,
+		0x5E, 0x10, 0xBD, 0x29, 0x5E, 0x2C, 0x86, 0x92, 0x49, 0x39, 0x6B, 0xC6, 0x5E, 0x1D, 0xA2, 0x5D,
+		0x14, 0x14, 0x6C, 0x24, 0xA9, 0x77, 0x61, 0x67, 0x45, 0x44, 0x67, 0x44, 0x78, 0x14, 0x6C, 0x24,
+		0x77, 0x33, 0xA0, 0x76, 0x6A, 0x33, 0xB2, 0x6F, 0x4C, 0x34, 0xDC, 0x5D, 0x4C, 0x34, 0xDC, 0x5D,
+		0x37, 0x40, 0xB3, 0x6C, 0x41, 0x51, 0xA2, 0x38, 0xAE, 0xDF, 0xE7, 0x45, 0xE3, 0x61, 0x71, 0x08,
+		0x73, 0x2C, 0x86, 0x92, 0x5E, 0x10, 0xBD, 0x29, 0x92, 0x10, 0xBD, 0x29, 0x5E, 0x1D, 0xA2, 0x5D,
+		0x14, 0x44, 0x67, 0x44, 0x14, 0xA7, 0x5C, 0x87, 0x45, 0x77, 0x61, 0x67, 0x14, 0xA7, 0x5C, 0x87,
+		0xD7, 0x2F, 0x1B, 0xAF, 0x35, 0x35, 0xFB, 0x4F, 0x6A, 0x33, 0xB2, 0x6F, 0x56, 0x34, 0xCE, 0x63,
+		0x24, 0x1C, 0xD7, 0xD7, 0x2E, 0x2D, 0xC6, 0xA3, 0x37, 0x40, 0xB3, 0x6C, 0xBF, 0xB6, 0xC0, 0x31,
+	};
+
+}  // namespace
@@ -0,0 +1,166 @@
+#include "TestFramework.h"
+
+#include "Gnm/GnmCommandBufferDummy.h"
+#include "Gnm/GnmCommandProcessor.h"
+#include "Gnm/GnmOpCode.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace sce::Gnm;
+
+namespace
+{
+	// Counts the calls the processor makes
+	// without touching a device.
+	class CountingCommandBuffer : public GnmCommandBufferDummy
+	{
+	public:
+		CountingCommandBuffer() :
+			GnmCommandBufferDummy(nullptr)
+		{
+		}
+
+		void setViewport(uint32_t viewportId, float dmin, float dmax, const float scale[3], const float offset[3]) override
+		{
+			++viewports;
+		}
+
+		void setDepthRenderTarget(DepthRenderTarget const* depthTarget) override
+		{
+			++depthTargets;
+		}
+
+		void drawIndexAuto(uint32_t indexCount) override
+		{
+			++draws;
+		}
+
+		uint32_t viewports    = 0;
+		uint32_t depthTargets = 0;
+		uint32_t draws        = 0;
+	};
+
+	uint32_t asDword(float value)
+	{
+		uint32_t dword;
+		std::memcpy(&dword, &value, sizeof(dword));
+		return dword;
+	}
+
+	void pushContextReg(std::vector<uint32_t>& cmd, uint32_t reg, std::initializer_list<uint32_t> values)
+	{
+		cmd.push_back(PM4_HEADER_BUILD(values.size() + 2, IT_SET_CONTEXT_REG, 0));
+		cmd.push_back(reg);
+		cmd.insert(cmd.end(), values);
+	}
+
+	// Same packet pair as Gnm::DrawCommandBuffer::setViewport.
+	void pushViewport(std::vector<uint32_t>& cmd)
+	{
+		pushContextReg(cmd, 0xB4, { asDword(0.0f), asDword(1.0f) });
+		pushContextReg(cmd, 0x10F,
+					   { asDword(960.0f), asDword(960.0f),
+						 asDword(-540.0f), asDword(540.0f),
+						 asDword(0.5f), asDword(0.5f) });
+	}
+
+	void pushDrawIndexAuto(std::vector<uint32_t>& cmd, uint32_t indexCount)
+	{
+		cmd.push_back(PM4_HEADER_BUILD(7, IT_GNM_PRIVATE, OP_PRIV_DRAW_INDEX_AUTO));
+		cmd.push_back(indexCount);
+		cmd.insert(cmd.end(), { 0, 0, 0, 0, 0 });
+	}
+
+	// A typical per draw state update, 6 packets.
+	// Returns the number of packets.
+	uint32_t synthesizeFrame(std::vector<uint32_t>& cmd, uint32_t drawCount)
+	{
+		for (uint32_t i = 0; i != drawCount; ++i)
+		{
+			pushViewport(cmd);
+			pushContextReg(cmd, OP_HINT_SET_SCREEN_SCISSOR, { 0, 1920 | (1080 << 16) });
+			pushContextReg(cmd, 0x1E0, { 0 });
+			cmd.insert(cmd.end(), { PM4_HEADER_BUILD(2, IT_NOP, 0), 0 });
+			pushDrawIndexAuto(cmd, 3);
+		}
+		return drawCount * 6;
+	}
+
+	uint32_t sizeInBytes(const std::vector<uint32_t>& cmd)
+	{
+		return static_cast<uint32_t>(cmd.size() * sizeof(uint32_t));
+	}
+
+}  // namespace
+
+GPCS4_TEST(CommandProcessorFrame)
+{
+	std::vector<uint32_t> cmd;
+	synthesizeFrame(cmd, 16);
+
+	CountingCommandBuffer cb;
+	GnmCommandProcessor   cp;
+	cp.attachCommandBuffer(&cb);
+	cp.processCommandBuffer(cmd.data(), sizeInBytes(cmd));
+
+	TEST_CHECK(cb.viewports == 16);
+	TEST_CHECK(cb.draws == 16);
+}
+
+GPCS4_TEST(CommandProcessorTruncatedLookahead)
+{
+	// The packets the handlers look ahead to are in memory,
+	// but past the size of the command buffer.
+	{
+		std::vector<uint32_t> cmd;
+		pushDrawIndexAuto(cmd, 3);
+		pushViewport(cmd);
+		uint32_t cutSize = sizeInBytes(cmd) - sizeof(uint32_t);
+
+		CountingCommandBuffer cb;
+		GnmCommandProcessor   cp;
+		cp.attachCommandBuffer(&cb);
+		cp.processCommandBuffer(cmd.data(), cutSize);
+
+		TEST_CHECK(cb.draws == 1);
+		TEST_CHECK(cb.viewports == 0);
+	}
+
+	{
+		// Depth render target is 6 packets, 24 dwords.
+		std::vector<uint32_t> cmd;
+		pushContextReg(cmd, OP_HINT_SET_DEPTH_RENDER_TARGET, { 0, 0, 0, 0, 0, 0, 0, 0 });
+		pushContextReg(cmd, 15, { 0 });
+		pushContextReg(cmd, 0x2, { 0 });
+		pushContextReg(cmd, 0x3, { 0 });
+		pushContextReg(cmd, 0x4, { 0 });
+		cmd.insert(cmd.end(), { PM4_HEADER_BUILD(2, IT_NOP, 0), 0 });
+
+		CountingCommandBuffer cb;
+		GnmCommandProcessor   cp;
+		cp.attachCommandBuffer(&cb);
+		cp.processCommandBuffer(cmd.data(), 20 * sizeof(uint32_t));
+		TEST_CHECK(cb.depthTargets == 0);
+
+		cp.processCommandBuffer(cmd.data(), sizeInBytes(cmd));
+		TEST_CHECK(cb.depthTargets == 1);
+	}
+}
+
+GPCS4_BENCH(CommandProcessorReplay)
+{
+	std::vector<uint32_t> cmd;
+	uint32_t              packets = synthesizeFrame(cmd, 4096);
+
+	CountingCommandBuffer cb;
+	GnmCommandProcessor   cp;
+	cp.attachCommandBuffer(&cb);
+
+	const uint32_t iterations = 100;
+	double         seconds    = test::measure(iterations, [&]()
+											  { cp.processCommandBuffer(cmd.data(), sizeInBytes(cmd)); });
+
+	ctx.reportRate("replay synthesized frame", double(packets) * iterations, "packets", seconds);
+	ctx.reportThroughput("replay synthesized frame", double(sizeInBytes(cmd)) * iterations, seconds);
+}
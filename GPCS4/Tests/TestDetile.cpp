@@ -0,0 +1,186 @@
+#include "TestFramework.h"
+
+#include "UtilWorkerPool.h"
+#include "Gnm/GpuAddress/GnmGpuAddress.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sce;
+using namespace sce::GpuAddress;
+
+namespace
+{
+	struct SurfaceDesc
+	{
+		const char*   name;
+		Gnm::TileMode tileMode;
+		uint32_t      width;
+		uint32_t      height;
+		uint32_t      depth;
+		uint32_t      bitsPerFragment;
+		bool          isBlockCompressed;
+		uint32_t      mipCount;
+	};
+
+	const SurfaceDesc g_surfaces[] = {
+		{ "2dThin 32bpp 4096x4096", Gnm::kTileModeThin_2dThin, 4096, 4096, 1, 32, false, 1 },
+		{ "2dThin 32bpp 2048x2048 mips", Gnm::kTileModeThin_2dThin, 2048, 2048, 1, 32, false, 12 },
+		{ "Display 32bpp 1920x1080", Gnm::kTileModeDisplay_2dThin, 1920, 1080, 1, 32, false, 1 },
+		{ "2dThin BC1 2048x2048", Gnm::kTileModeThin_2dThin, 2048, 2048, 1, 4, true, 1 },
+		{ "1dThin 64bpp 1000x700", Gnm::kTileModeThin_1dThin, 1000, 700, 1, 64, false, 1 },
+		{ "2dThick 32bpp 256x256x64", Gnm::kTileModeThick_2dThick, 256, 256, 64, 32, false, 1 },
+		{ "1dThick 16bpp 128x128x37", Gnm::kTileModeThick_1dThick, 128, 128, 37, 16, false, 1 },
+	};
+
+	// Tiled source and linear destination of every mip level.
+	struct DetileWork
+	{
+		std::vector<DetileRegionJob>      jobs;
+		std::vector<std::vector<uint8_t>> tiled;
+		std::vector<std::vector<uint8_t>> linear;
+		uint64_t                          linearBytes = 0;
+	};
+
+	bool makeWork(DetileWork& work, const SurfaceDesc& desc)
+	{
+		bool     result    = true;
+		uint32_t basePitch = 0;
+		for (uint32_t mip = 0; mip != desc.mipCount; ++mip)
+		{
+			TilingParameters tp         = {};
+			tp.m_tileMode               = desc.tileMode;
+			tp.m_minGpuMode             = Gnm::kGpuModeBase;
+			tp.m_linearWidth            = std::max(desc.width >> mip, 1u);
+			tp.m_linearHeight           = std::max(desc.height >> mip, 1u);
+			tp.m_linearDepth            = desc.depth;
+			tp.m_numFragmentsPerPixel   = 1;
+			tp.m_baseTiledPitch         = basePitch;
+			tp.m_mipLevel               = mip;
+			tp.m_bitsPerFragment        = desc.bitsPerFragment;
+			tp.m_isBlockCompressed      = desc.isBlockCompressed;
+			tp.m_surfaceFlags.m_value   = 0;
+			tp.m_surfaceFlags.m_pow2Pad = desc.mipCount > 1;
+			tp.m_surfaceFlags.m_volume  = desc.depth > 1;
+
+			SurfaceInfo surfInfo = {};
+			if (computeSurfaceInfo(&surfInfo, &tp) != kStatusSuccess)
+			{
+				result = false;
+				break;
+			}
+
+			if (mip == 0)
+			{
+				basePitch = surfInfo.m_pitch;
+			}
+
+			// Regions and pitches are in elements, 4x4 texels for BCn.
+			uint32_t blockSize    = desc.isBlockCompressed ? 4 : 1;
+			uint32_t elemWidth    = (tp.m_linearWidth + blockSize - 1) / blockSize;
+			uint32_t elemHeight   = (tp.m_linearHeight + blockSize - 1) / blockSize;
+			uint32_t elementBytes = desc.bitsPerFragment * blockSize * blockSize / 8;
+
+			std::vector<uint8_t> tiled(surfInfo.m_surfaceSize);
+			for (size_t i = 0; i != tiled.size(); ++i)
+			{
+				tiled[i] = uint8_t((i * 2654435761u) >> 13);
+			}
+			work.tiled.push_back(std::move(tiled));
+			work.linear.emplace_back(size_t(elemWidth) * elemHeight * desc.depth * elementBytes);
+			work.linearBytes += work.linear.back().size();
+
+			DetileRegionJob job  = {};
+			job.m_tp             = tp;
+			job.m_srcRegion      = { 0, 0, 0, elemWidth, elemHeight, desc.depth };
+			job.m_destPitch      = elemWidth;
+			job.m_destSlicePitch = elemWidth * elemHeight;
+			work.jobs.push_back(job);
+		}
+
+		for (size_t i = 0; i != work.jobs.size(); ++i)
+		{
+			work.jobs[i].m_tiledSurface      = work.tiled[i].data();
+			work.jobs[i].m_outUntiledSurface = work.linear[i].data();
+		}
+		return result;
+	}
+
+	// Worker counts to measure, up to one less
+	// than the number of hardware threads.
+	std::vector<uint32_t> getWorkerCounts()
+	{
+		uint32_t maxWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+		std::vector<uint32_t> counts = { 0 };
+		for (uint32_t count = 1; count < maxWorkers; count *= 2)
+		{
+			counts.push_back(count);
+		}
+		counts.push_back(maxWorkers);
+		return counts;
+	}
+
+}  // namespace
+
+GPCS4_TEST(DetileSurfaceRegionsMatchSerial)
+{
+	util::WorkerPool pool(3);
+
+	for (const auto& desc : g_surfaces)
+	{
+		DetileWork serial;
+		DetileWork parallel;
+		if (!ctx.check(makeWork(serial, desc) && makeWork(parallel, desc), desc.name, __FILE__, __LINE__))
+		{
+			continue;
+		}
+
+		bool serialDone = true;
+		for (const auto& job : serial.jobs)
+		{
+			serialDone &= detileSurfaceRegion(job.m_outUntiledSurface, job.m_tiledSurface, &job.m_tp,
+											  &job.m_srcRegion, job.m_destPitch, job.m_destSlicePitch) == kStatusSuccess;
+		}
+
+		int32_t status = detileSurfaceRegions(parallel.jobs.data(), uint32_t(parallel.jobs.size()), pool);
+
+		std::string name = desc.name;
+		ctx.check(serialDone && status == kStatusSuccess, (name + " status").c_str(), __FILE__, __LINE__);
+		ctx.check(serial.linear == parallel.linear, (name + " output").c_str(), __FILE__, __LINE__);
+	}
+}
+
+GPCS4_BENCH(DetileSurfaceRegionsScaling)
+{
+	const auto workerCounts = getWorkerCounts();
+
+	for (const auto& desc : g_surfaces)
+	{
+		DetileWork work;
+		if (!ctx.check(makeWork(work, desc), desc.name, __FILE__, __LINE__))
+		{
+			continue;
+		}
+
+		std::string name = desc.name;
+		for (uint32_t workers : workerCounts)
+		{
+			util::WorkerPool pool(workers);
+
+			// Warm up, the first pass faults in the destination.
+			detileSurfaceRegions(work.jobs.data(), uint32_t(work.jobs.size()), pool);
+
+			const uint32_t iterations = 4;
+			double         seconds    = test::measure(iterations, [&]()
+													  { detileSurfaceRegions(work.jobs.data(), uint32_t(work.jobs.size()), pool); });
+
+			uint32_t threads = workers + 1;
+			ctx.reportThroughput(name + ", " + std::to_string(threads) + (threads == 1 ? " thread" : " threads"),
+								 double(work.linearBytes) * iterations, seconds);
+		}
+	}
+}
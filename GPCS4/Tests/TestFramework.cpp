@@ -0,0 +1,109 @@
+#include "TestFramework.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace test
+{
+	struct TestEntry
+	{
+		const char* name;
+		TestFunc    func;
+		bool        bench;
+	};
+
+	// Function local, so registration does not
+	// depend on static initialization order.
+	static std::vector<TestEntry>& getTests()
+	{
+		static std::vector<TestEntry> tests;
+		return tests;
+	}
+
+	TestContext::TestContext(const char* name) :
+		m_name(name)
+	{
+	}
+
+	bool TestContext::check(
+		bool        passed,
+		const char* expr,
+		const char* file,
+		int         line)
+	{
+		if (!passed)
+		{
+			std::printf("  %s: check failed: %s (%s:%d)\n", m_name, expr, file, line);
+			++m_failures;
+		}
+		return passed;
+	}
+
+	void TestContext::reportThroughput(
+		const std::string& label,
+		double             bytes,
+		double             seconds)
+	{
+		double gbps = seconds > 0.0 ? bytes / seconds / 1e9 : 0.0;
+		std::printf("  %-40s %8.2f GB/s\n", label.c_str(), gbps);
+	}
+
+	void TestContext::reportLatency(
+		const std::string& label,
+		double             operations,
+		double             seconds)
+	{
+		double ns = operations > 0.0 ? seconds * 1e9 / operations : 0.0;
+		std::printf("  %-40s %8.2f ns/op\n", label.c_str(), ns);
+	}
+
+	void TestContext::reportRate(
+		const std::string& label,
+		double             items,
+		const char*        unit,
+		double             seconds)
+	{
+		double perUs = seconds > 0.0 ? items / (seconds * 1e6) : 0.0;
+		std::printf("  %-40s %8.2f %s/us\n", label.c_str(), perUs, unit);
+	}
+
+	TestRegistrar::TestRegistrar(const char* name, TestFunc func, bool bench)
+	{
+		getTests().push_back({ name, func, bench });
+	}
+
+	int runTests(const std::string& filter, bool bench)
+	{
+		uint32_t runCount  = 0;
+		uint32_t failCount = 0;
+
+		for (const auto& entry : getTests())
+		{
+			if (entry.bench != bench)
+			{
+				continue;
+			}
+
+			if (!filter.empty() &&
+				std::string(entry.name).find(filter) == std::string::npos)
+			{
+				continue;
+			}
+
+			std::printf("[ RUN  ] %s\n", entry.name);
+
+			TestContext ctx(entry.name);
+			entry.func(ctx);
+
+			bool passed = ctx.failures() == 0;
+			std::printf("[ %s ] %s\n", passed ? " OK " : "FAIL", entry.name);
+
+			++runCount;
+			failCount += passed ? 0 : 1;
+		}
+
+		std::printf("%u run, %u failed\n", runCount, failCount);
+		return int(failCount);
+	}
+
+}  // namespace test
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "GPCS4Common.h"
+
+#include <chrono>
+#include <string>
+
+namespace test
+{
+
+	/**
+	 * \brief Test context
+	 *
+	 * Passed to each test or benchmark,
+	 * counts failed checks and measures
+	 * throughput for benchmarks.
+	 */
+	class TestContext
+	{
+	public:
+		TestContext(const char* name);
+
+		/**
+		 * \brief Records a check
+		 *
+		 * \param [in] passed Result of the check
+		 * \param [in] expr Checked expression
+		 * \param [in] file Source file
+		 * \param [in] line Source line
+		 * \returns \c passed
+		 */
+		bool check(
+			bool        passed,
+			const char* expr,
+			const char* file,
+			int         line);
+
+		/**
+		 * \brief Prints one benchmark result
+		 *
+		 * \param [in] label What was measured
+		 * \param [in] bytes Bytes processed
+		 * \param [in] seconds Time taken
+		 */
+		void reportThroughput(
+			const std::string& label,
+			double             bytes,
+			double             seconds);
+
+		/**
+		 * \brief Prints the time per operation
+		 *
+		 * \param [in] label What was measured
+		 * \param [in] operations Operations done
+		 * \param [in] seconds Time taken
+		 */
+		void reportLatency(
+			const std::string& label,
+			double             operations,
+			double             seconds);
+
+		/**
+		 * \brief Prints the number of items per microsecond
+		 *
+		 * \param [in] label What was measured
+		 * \param [in] items Items processed
+		 * \param [in] unit Name of an item, plural
+		 * \param [in] seconds Time taken
+		 */
+		void reportRate(
+			const std::string& label,
+			double             items,
+			const char*        unit,
+			double             seconds);
+
+		/**
+		 * \brief Number of failed checks
+		 */
+		uint32_t failures() const
+		{
+			return m_failures;
+		}
+
+	private:
+		const char* m_name;
+		uint32_t    m_failures = 0;
+	};
+
+	using TestFunc = void (*)(TestContext& ctx);
+
+	/**
+	 * \brief Registers a test at startup
+	 *
+	 * Use the \c GPCS4_TEST and \c GPCS4_BENCH
+	 * macros rather than this class directly.
+	 */
+	class TestRegistrar
+	{
+	public:
+		TestRegistrar(const char* name, TestFunc func, bool bench);
+	};
+
+	/**
+	 * \brief Runs registered tests
+	 *
+	 * \param [in] filter Runs only the tests whose
+	 *   name contains this string, all if empty
+	 * \param [in] bench Runs benchmarks instead of tests
+	 * \returns Number of failed tests
+	 */
+	int runTests(const std::string& filter, bool bench);
+
+	/**
+	 * \brief Measures a loop
+	 *
+	 * Calls \c func \c iterations times and
+	 * returns the elapsed time in seconds.
+	 */
+	template <typename Func>
+	double measure(uint32_t iterations, Func&& func)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i != iterations; ++i)
+		{
+			func();
+		}
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration<double>(end - start).count();
+	}
+
+}  // namespace test
+
+#define GPCS4_TEST_DEFINE_(name, bench)                                \
+	static void name(::test::TestContext& ctx);                        \
+	static ::test::TestRegistrar name##Registrar_(#name, name, bench); \
+	static void name(::test::TestContext& ctx)
+
+// Unit test, run by --test
+#define GPCS4_TEST(name) GPCS4_TEST_DEFINE_(name, false)
+// Benchmark, run by --bench
+#define GPCS4_BENCH(name) GPCS4_TEST_DEFINE_(name, true)
+
+// Records a failure and goes on if expr is false
+#define TEST_CHECK(expr) ctx.check(!!(expr), #expr, __FILE__, __LINE__)
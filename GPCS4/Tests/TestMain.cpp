@@ -0,0 +1,41 @@
+#include "TestFramework.h"
+
+#include "Gnm/GnmRenderTarget.h"
+
+#include <cstdio>
+#include <string>
+
+// Entry point of the standalone test runner in Tests/CMakeLists.txt.
+// GPCS4.exe runs the same tests with -T and -B.
+
+namespace sce::Gnm
+{
+	// There is no emulator here, report the mode VirtualGPU uses.
+	GpuMode getGpuMode()
+	{
+		return kGpuModeNeo;
+	}
+}  // namespace sce::Gnm
+
+int main(int argc, char* argv[])
+{
+	int nRet = -1;
+
+	do
+	{
+		std::string option = argc > 1 ? argv[1] : "";
+		bool        bench  = option == "-B" || option == "--bench";
+		if (!bench && option != "-T" && option != "--test")
+		{
+			std::printf("usage: %s -T|--test [filter]\n"
+						"       %s -B|--bench [filter]\n",
+						argv[0], argv[0]);
+			break;
+		}
+
+		std::string filter = argc > 2 ? argv[2] : "";
+		nRet               = test::runTests(filter, bench);
+	} while (false);
+
+	return nRet;
+}
@@ -0,0 +1,94 @@
+#include "TestFramework.h"
+
+#include "Gnm/GnmStateFilter.h"
+
+#include <cstring>
+
+using namespace sce::Gnm;
+
+namespace
+{
+	// Stands in for VltContext and records
+	// the state calls which get through.
+	struct RecordingContext
+	{
+		uint32_t   viewportCalls = 0;
+		uint32_t   scissorCalls  = 0;
+		VkViewport viewport      = {};
+		VkRect2D   scissor       = {};
+
+		void setViewports(uint32_t count, const VkViewport* viewports)
+		{
+			++viewportCalls;
+			viewport = viewports[0];
+
+			// Same fallback as VltContext::setViewports
+			if (viewport.width == 0.0f)
+			{
+				viewport = VkViewport{ 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+				scissor  = VkRect2D{ { 0, 0 }, { 0, 0 } };
+			}
+		}
+
+		void setScissors(uint32_t count, const VkRect2D* scissors)
+		{
+			++scissorCalls;
+			scissor = scissors[0];
+		}
+	};
+
+	const VkViewport g_viewport      = { 0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f };
+	const VkViewport g_emptyViewport = { 0.0f, 0.0f, 0.0f, 1080.0f, 0.0f, 1.0f };
+	const VkRect2D   g_scissor       = { { 0, 0 }, { 1920, 1080 } };
+
+	bool isScissor(const VkRect2D& lhs, const VkRect2D& rhs)
+	{
+		return std::memcmp(&lhs, &rhs, sizeof(VkRect2D)) == 0;
+	}
+
+}  // namespace
+
+GPCS4_TEST(StateFilterDropsRedundantState)
+{
+	RecordingContext                 context;
+	GnmStateFilterT<RecordingContext> filter(&context);
+
+	filter.setViewport(g_viewport);
+	filter.setScissor(g_scissor);
+	filter.setViewport(g_viewport);
+	filter.setScissor(g_scissor);
+
+	TEST_CHECK(context.viewportCalls == 1);
+	TEST_CHECK(context.scissorCalls == 1);
+	TEST_CHECK(filter.stats().filtered == 2);
+
+	// Recording a new command list forgets the state
+	filter.invalidate();
+	filter.setScissor(g_scissor);
+	TEST_CHECK(context.scissorCalls == 2);
+}
+
+GPCS4_TEST(StateFilterZeroWidthViewport)
+{
+	RecordingContext                 context;
+	GnmStateFilterT<RecordingContext> filter(&context);
+
+	filter.setScissor(g_scissor);
+	filter.setViewport(g_emptyViewport);
+
+	// The context cleared the scissor rect, setting
+	// the old one again must reach it.
+	filter.setScissor(g_scissor);
+	TEST_CHECK(context.scissorCalls == 2);
+	TEST_CHECK(isScissor(context.scissor, g_scissor));
+
+	// And an empty viewport after that has to clear it again.
+	filter.setViewport(g_emptyViewport);
+	TEST_CHECK(context.viewportCalls == 2);
+	TEST_CHECK(context.scissor.extent.width == 0);
+
+	filter.setViewport(g_viewport);
+	filter.setScissor(g_scissor);
+	TEST_CHECK(isScissor(context.scissor, g_scissor));
+	TEST_CHECK(context.viewport.width == g_viewport.width);
+}
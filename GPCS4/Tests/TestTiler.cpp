@@ -0,0 +1,190 @@
+#include "TestFramework.h"
+
+#include "PlatHardware.h"
+#include "Gnm/GpuAddress/GnmTilerSSE2.h"
+#include "Gnm/GpuAddress/GnmTilerAVX2.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace sce;
+using namespace sce::GpuAddress;
+
+namespace
+{
+	struct MicroTileKernel
+	{
+		const char*        name;
+		Gnm::MicroTileMode mode;
+		uint32_t           bitsPerElement;
+		MicroTileFunc      tileSse2;
+		MicroTileFunc      detileSse2;
+		// Only set for the kernels dispatched on AVX2 machines.
+		MicroTileFunc tileAvx2;
+		MicroTileFunc detileAvx2;
+	};
+
+#define MICRO_TILE_SSE2(mode, bits) \
+	{ #mode " " #bits "bpp", Gnm::kMicroTileMode##mode, bits, tile##bits##bpp##mode##Sse2, detile##bits##bpp##mode##Sse2, nullptr, nullptr }
+#define MICRO_TILE_AVX2(mode, bits)                                                                               \
+	{ #mode " " #bits "bpp", Gnm::kMicroTileMode##mode, bits, tile##bits##bpp##mode##Sse2, detile##bits##bpp##mode##Sse2, \
+	  tileMicroTileAvx2<Gnm::kMicroTileMode##mode, bits>, detileMicroTileAvx2<Gnm::kMicroTileMode##mode, bits> }
+
+	const MicroTileKernel g_kernels[] = {
+		MICRO_TILE_SSE2(Display, 8),
+		MICRO_TILE_SSE2(Display, 16),
+		MICRO_TILE_AVX2(Display, 32),
+		MICRO_TILE_AVX2(Display, 64),
+		MICRO_TILE_SSE2(Thin, 8),
+		MICRO_TILE_SSE2(Thin, 16),
+		MICRO_TILE_AVX2(Thin, 32),
+		MICRO_TILE_AVX2(Thin, 64),
+		MICRO_TILE_AVX2(Thin, 128),
+		MICRO_TILE_SSE2(Thick, 8),
+		MICRO_TILE_SSE2(Thick, 16),
+		MICRO_TILE_AVX2(Thick, 32),
+		MICRO_TILE_AVX2(Thick, 64),
+		MICRO_TILE_AVX2(Thick, 128),
+	};
+
+#undef MICRO_TILE_AVX2
+#undef MICRO_TILE_SSE2
+
+	// Linear layout the kernels are run against,
+	// wider than a microtile to catch stray writes.
+	constexpr uint32_t TestPitch      = 64;
+	constexpr uint32_t TestSlicePitch = TestPitch * 16;
+	// Thick 128bpp tile, the largest one.
+	constexpr size_t MaxTileBytes = 64 * 4 * 16;
+
+	struct MicroTileData
+	{
+		uint32_t             elementBytes;
+		uint32_t             depth;
+		std::vector<uint8_t> tiled;
+		std::vector<uint8_t> linear;
+	};
+
+	// Builds a tile with distinct bytes and
+	// the linear surface it detiles to.
+	MicroTileData makeReference(const MicroTileKernel& kernel)
+	{
+		MicroTileData data;
+		data.elementBytes = kernel.bitsPerElement / 8;
+		data.depth        = kernel.mode == Gnm::kMicroTileModeThick ? 4 : 1;
+		data.tiled.resize(64 * data.depth * data.elementBytes);
+		data.linear.resize(TestSlicePitch * data.depth * data.elementBytes, 0xCD);
+
+		for (size_t i = 0; i != data.tiled.size(); ++i)
+		{
+			data.tiled[i] = uint8_t(i * 7 + 3);
+		}
+
+		for (uint32_t z = 0; z != data.depth; ++z)
+		{
+			for (uint32_t y = 0; y != 8; ++y)
+			{
+				for (uint32_t x = 0; x != 8; ++x)
+				{
+					uint32_t element = getMicroTileElementIndex(kernel.mode, kernel.bitsPerElement, x, y, z);
+					size_t   offset  = (z * TestSlicePitch + y * TestPitch + x) * data.elementBytes;
+					std::memcpy(&data.linear[offset], &data.tiled[element * data.elementBytes], data.elementBytes);
+				}
+			}
+		}
+		return data;
+	}
+
+	bool checkDetile(MicroTileFunc detile, const MicroTileData& data)
+	{
+		alignas(64) uint8_t tile[MaxTileBytes];
+		std::memcpy(tile, data.tiled.data(), data.tiled.size());
+
+		std::vector<uint8_t> linear(data.linear.size(), 0xCD);
+		detile(linear.data(), tile, TestPitch, TestSlicePitch);
+		return linear == data.linear;
+	}
+
+	bool checkTile(MicroTileFunc tile, const MicroTileData& data)
+	{
+		alignas(64) uint8_t tiled[MaxTileBytes + 64];
+		std::memset(tiled, 0xCD, sizeof(tiled));
+		tile(tiled, data.linear.data(), TestPitch, TestSlicePitch);
+
+		// Nothing past the end of the tile may be written.
+		bool guardIntact = true;
+		for (size_t i = data.tiled.size(); i != data.tiled.size() + 64; ++i)
+		{
+			guardIntact &= tiled[i] == 0xCD;
+		}
+		return guardIntact && std::memcmp(tiled, data.tiled.data(), data.tiled.size()) == 0;
+	}
+
+	void benchKernel(
+		test::TestContext&   ctx,
+		const std::string&   label,
+		MicroTileFunc        func,
+		bool                 detile,
+		const MicroTileData& data)
+	{
+		alignas(64) static uint8_t tile[MaxTileBytes];
+		std::vector<uint8_t>       linear = data.linear;
+
+		const uint32_t iterations = uint32_t((256ull << 20) / data.tiled.size());
+
+		double seconds = 0.0;
+		if (detile)
+		{
+			seconds = test::measure(iterations, [&]()
+									{ func(linear.data(), tile, TestPitch, TestSlicePitch); });
+		}
+		else
+		{
+			seconds = test::measure(iterations, [&]()
+									{ func(tile, linear.data(), TestPitch, TestSlicePitch); });
+		}
+		ctx.reportThroughput(label, double(iterations) * double(data.tiled.size()), seconds);
+	}
+
+}  // namespace
+
+GPCS4_TEST(TilerMicroTileKernels)
+{
+	bool avx2 = plat::GetCpuFeatures().avx2;
+
+	for (const auto& kernel : g_kernels)
+	{
+		auto data = makeReference(kernel);
+
+		std::string name = kernel.name;
+		ctx.check(checkDetile(kernel.detileSse2, data), (name + " detile sse2").c_str(), __FILE__, __LINE__);
+		ctx.check(checkTile(kernel.tileSse2, data), (name + " tile sse2").c_str(), __FILE__, __LINE__);
+
+		if (avx2 && kernel.tileAvx2 != nullptr)
+		{
+			ctx.check(checkDetile(kernel.detileAvx2, data), (name + " detile avx2").c_str(), __FILE__, __LINE__);
+			ctx.check(checkTile(kernel.tileAvx2, data), (name + " tile avx2").c_str(), __FILE__, __LINE__);
+		}
+	}
+}
+
+GPCS4_BENCH(TilerMicroTileThroughput)
+{
+	bool avx2 = plat::GetCpuFeatures().avx2;
+
+	for (const auto& kernel : g_kernels)
+	{
+		auto data = makeReference(kernel);
+
+		std::string name = kernel.name;
+		benchKernel(ctx, name + " detile sse2", kernel.detileSse2, true, data);
+		benchKernel(ctx, name + " tile sse2", kernel.tileSse2, false, data);
+
+		if (avx2 && kernel.tileAvx2 != nullptr)
+		{
+			benchKernel(ctx, name + " detile avx2", kernel.detileAvx2, true, data);
+			benchKernel(ctx, name + " tile avx2", kernel.tileAvx2, false, data);
+		}
+	}
+}
@@ -0,0 +1,122 @@
+#include "TestFramework.h"
+
+#include "UtilTlsfAllocator.h"
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace util;
+
+GPCS4_TEST(TlsfAllocatorExactFit)
+{
+	// The good fit search rounds up to the next bin,
+	// exact sizes must still find their block.
+	TlsfAllocator whole(12345);
+	TEST_CHECK(whole.alloc(12345, 1) == 0);
+	TEST_CHECK(whole.alloc(1, 1) == TlsfAllocator::InvalidOffset);
+
+	TlsfAllocator aligned(4096);
+	TEST_CHECK(aligned.alloc(4096, 4096) == 0);
+
+	// A freed hole is reused for a request of its size.
+	TlsfAllocator holes(1000 + 5000 + 1000);
+	uint64_t      a = holes.alloc(1000, 1);
+	uint64_t      b = holes.alloc(5000, 1);
+	uint64_t      c = holes.alloc(1000, 1);
+	TEST_CHECK(holes.free(b) == 5000);
+	TEST_CHECK(holes.alloc(5000, 1) == b);
+	TEST_CHECK(a != TlsfAllocator::InvalidOffset && c != TlsfAllocator::InvalidOffset);
+
+	// An aligned request fits a hole just large enough
+	// once the start of the hole is aligned.
+	TlsfAllocator padded(8192);
+	uint64_t      head = padded.alloc(100, 1);
+	uint64_t      hole = padded.alloc(4096 - 100 + 256, 1);
+	uint64_t      tail = padded.alloc(8192 - 4096 - 256, 1);
+	TEST_CHECK(padded.free(hole) != 0);
+	TEST_CHECK(padded.alloc(256, 4096) == 4096);
+	TEST_CHECK(head == 0 && tail == 4096 + 256);
+}
+
+GPCS4_TEST(TlsfAllocatorRandom)
+{
+	const uint64_t size = 64ull << 20;
+
+	TlsfAllocator allocator(size);
+	std::mt19937  rng(1);
+
+	// Live ranges by offset, to check for overlaps.
+	std::map<uint64_t, uint64_t> live;
+
+	bool valid = true;
+	for (uint32_t i = 0; i != 200000; ++i)
+	{
+		if (live.empty() || rng() % 100 < 55)
+		{
+			uint64_t length = 1 + rng() % (rng() % 10 == 0 ? (1u << 20) : 4096);
+			uint64_t align  = 1ull << (rng() % 13);
+			uint64_t offset = allocator.alloc(length, align);
+			if (offset == TlsfAllocator::InvalidOffset)
+			{
+				continue;
+			}
+
+			valid &= offset % align == 0 && offset + length <= size;
+
+			auto next = live.lower_bound(offset);
+			valid &= next == live.end() || next->first >= offset + length;
+			valid &= next == live.begin() || std::prev(next)->first + std::prev(next)->second <= offset;
+
+			live.emplace(offset, length);
+		}
+		else
+		{
+			auto entry = live.begin();
+			std::advance(entry, rng() % std::min<size_t>(live.size(), 64));
+			valid &= allocator.free(entry->first) == entry->second;
+			live.erase(entry);
+		}
+	}
+	TEST_CHECK(valid);
+
+	TlsfStats stats = allocator.getStats();
+	TEST_CHECK(stats.allocCount == live.size());
+	TEST_CHECK(allocator.fragmentation() >= 0.0f && allocator.fragmentation() <= 1.0f);
+
+	for (const auto& entry : live)
+	{
+		allocator.free(entry.first);
+	}
+
+	// Everything merges back into one block.
+	stats = allocator.getStats();
+	TEST_CHECK(allocator.isEmpty());
+	TEST_CHECK(stats.freeBlockCount == 1 && stats.largestFreeBlock == size);
+	TEST_CHECK(allocator.fragmentation() == 0.0f);
+	TEST_CHECK(allocator.free(0) == 0);
+}
+
+GPCS4_BENCH(TlsfAllocatorAllocFree)
+{
+	TlsfAllocator         allocator(256ull << 20);
+	std::vector<uint64_t> offsets;
+	offsets.reserve(10000);
+
+	// Typical resource sizes, aligned like buffers.
+	const uint32_t rounds  = 100;
+	double         seconds = test::measure(rounds, [&]()
+										   {
+											   for (uint32_t i = 0; i != 10000; ++i)
+											   {
+												   offsets.push_back(allocator.alloc(256 + (i % 7) * 64, 256));
+											   }
+											   for (uint64_t offset : offsets)
+											   {
+												   allocator.free(offset);
+											   }
+											   offsets.clear();
+										   });
+	ctx.reportLatency("alloc and free", double(rounds) * 10000 * 2, seconds);
+}
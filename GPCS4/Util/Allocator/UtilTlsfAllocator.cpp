@@ -0,0 +1,492 @@
+#include "UtilTlsfAllocator.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace util
+{
+	namespace
+	{
+		inline uint32_t bsr64(uint64_t n)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanReverse64(&index, n);
+			return index;
+#else
+			return 63 - __builtin_clzll(n);
+#endif
+		}
+
+		inline uint32_t bsf64(uint64_t n)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward64(&index, n);
+			return index;
+#else
+			return __builtin_ctzll(n);
+#endif
+		}
+
+		inline uint64_t alignOffset(uint64_t offset, uint64_t align)
+		{
+			return (offset + align - 1) & ~(align - 1);
+		}
+	}  // namespace
+
+	TlsfAllocator::TlsfAllocator(uint64_t size) :
+		m_size(size),
+		m_allocTable(1u << MinTableBits, InvalidBlock)
+	{
+		m_slBitmaps.fill(0);
+		m_freeHeads.fill(InvalidBlock);
+
+		if (size != 0)
+		{
+			uint32_t index = createBlock();
+
+			Block& block   = m_blocks[index];
+			block.offset   = 0;
+			block.size     = size;
+			block.prevPhys = InvalidBlock;
+			block.nextPhys = InvalidBlock;
+
+			insertFreeBlock(index);
+		}
+	}
+
+	TlsfAllocator::~TlsfAllocator()
+	{
+	}
+
+	uint64_t TlsfAllocator::alloc(uint64_t size, uint64_t align)
+	{
+		if (size == 0 || size > m_size)
+			return InvalidOffset;
+
+		if (align == 0)
+			align = 1;
+
+		// Blocks start at any byte, so only alignments above
+		// one can need padding. Try the good fit without it
+		// first, the block found may be aligned already.
+		uint32_t index = findFreeBlock(size);
+
+		if (index != InvalidBlock && !fitsBlock(index, size, align))
+		{
+			// Reserving room to align the start of whatever block
+			// we find keeps the search independent of offsets.
+			index = findFreeBlock(size + align - 1);
+		}
+
+		// Rounding up to the next bin skips blocks which may
+		// still fit, like the whole range for an exact size.
+		if (index == InvalidBlock)
+			index = findFittingBlock(size, align);
+
+		if (index == InvalidBlock)
+			return InvalidOffset;
+
+		removeFreeBlock(index);
+
+		uint64_t offset  = m_blocks[index].offset;
+		uint64_t padding = alignOffset(offset, align) - offset;
+
+		// The physical neighbours of a free block are always
+		// in use, so the split off parts need no merging.
+		if (padding != 0)
+		{
+			uint32_t head = index;
+			index         = splitBlock(head, padding);
+			insertFreeBlock(head);
+		}
+
+		if (m_blocks[index].size > size)
+		{
+			uint32_t tail = splitBlock(index, size);
+			insertFreeBlock(tail);
+		}
+
+		m_used += size;
+		insertAllocation(index);
+		return m_blocks[index].offset;
+	}
+
+	uint64_t TlsfAllocator::free(uint64_t offset)
+	{
+		uint32_t slot = findAllocation(offset);
+
+		if (slot == InvalidBlock)
+			return 0;
+
+		uint32_t index = m_allocTable[slot];
+		uint64_t size  = m_blocks[index].size;
+
+		eraseAllocation(slot);
+		m_used -= size;
+
+		uint32_t next = m_blocks[index].nextPhys;
+
+		if (next != InvalidBlock && m_blocks[next].isFree)
+		{
+			removeFreeBlock(next);
+			mergeBlocks(index, next);
+		}
+
+		uint32_t prev = m_blocks[index].prevPhys;
+
+		if (prev != InvalidBlock && m_blocks[prev].isFree)
+		{
+			removeFreeBlock(prev);
+			mergeBlocks(prev, index);
+			index = prev;
+		}
+
+		insertFreeBlock(index);
+		return size;
+	}
+
+	TlsfStats TlsfAllocator::getStats() const
+	{
+		TlsfStats stats;
+		stats.totalSize      = m_size;
+		stats.usedSize       = m_used;
+		stats.allocCount     = m_allocCount;
+		stats.freeBlockCount = m_freeCount;
+
+		// The largest free block lives in the highest non-empty
+		// bin. Blocks within one bin differ in size, so walk it.
+		if (m_flBitmap != 0)
+		{
+			uint32_t fl = bsr64(m_flBitmap);
+			uint32_t sl = bsr64(m_slBitmaps[fl]);
+
+			for (uint32_t index = m_freeHeads[fl * SlCount + sl];
+				 index != InvalidBlock;
+				 index = m_blocks[index].nextFree)
+			{
+				if (m_blocks[index].size > stats.largestFreeBlock)
+					stats.largestFreeBlock = m_blocks[index].size;
+			}
+		}
+
+		return stats;
+	}
+
+	float TlsfAllocator::fragmentation() const
+	{
+		uint64_t freeSize = m_size - m_used;
+
+		if (freeSize == 0)
+			return 0.0f;
+
+		TlsfStats stats = getStats();
+		return 1.0f - float(stats.largestFreeBlock) / float(freeSize);
+	}
+
+	void TlsfAllocator::mapSize(
+		uint64_t  size,
+		uint32_t& fl,
+		uint32_t& sl)
+	{
+		// Small sizes get one bin each on the first level
+		if (size < SlCount)
+		{
+			fl = 0;
+			sl = uint32_t(size);
+		}
+		else
+		{
+			uint32_t msb = bsr64(size);
+
+			fl = msb - SlBits + 1;
+			sl = uint32_t(size >> (msb - SlBits)) ^ SlCount;
+		}
+	}
+
+	uint32_t TlsfAllocator::findFreeBlock(uint64_t size) const
+	{
+		// Round the size up to the next bin boundary so that
+		// any block of the bin we pick is large enough.
+		if (size >= SlCount)
+			size += (1ull << (bsr64(size) - SlBits)) - 1;
+
+		uint32_t fl, sl;
+		mapSize(size, fl, sl);
+
+		if (fl >= FlCount)
+			return InvalidBlock;
+
+		uint32_t slMap = m_slBitmaps[fl] & (~0u << sl);
+
+		if (slMap == 0)
+		{
+			uint64_t flMap = fl + 1 < 64
+								 ? m_flBitmap & (~0ull << (fl + 1))
+								 : 0;
+
+			if (flMap == 0)
+				return InvalidBlock;
+
+			fl    = bsf64(flMap);
+			slMap = m_slBitmaps[fl];
+		}
+
+		sl = bsf64(slMap);
+		return m_freeHeads[fl * SlCount + sl];
+	}
+
+	uint32_t TlsfAllocator::findFittingBlock(uint64_t size, uint64_t align) const
+	{
+		// Walk the bins the rounded search skips, from
+		// the one the size maps to up to the one the
+		// size with the worst case padding maps to.
+		uint32_t firstFl, firstSl;
+		mapSize(size, firstFl, firstSl);
+
+		uint32_t lastFl, lastSl;
+		mapSize(size + align - 1, lastFl, lastSl);
+
+		if (firstFl >= FlCount)
+			return InvalidBlock;
+
+		lastFl = lastFl < FlCount ? lastFl : FlCount - 1;
+
+		for (uint32_t fl = firstFl; fl <= lastFl; fl++)
+		{
+			if (!(m_flBitmap & (1ull << fl)))
+				continue;
+
+			uint32_t slMap = m_slBitmaps[fl];
+
+			if (fl == firstFl)
+				slMap &= ~0u << firstSl;
+
+			if (fl == lastFl && lastSl + 1 < SlCount)
+				slMap &= ~(~0u << (lastSl + 1));
+
+			while (slMap != 0)
+			{
+				uint32_t sl = bsf64(slMap);
+				slMap &= slMap - 1;
+
+				for (uint32_t index = m_freeHeads[fl * SlCount + sl];
+					 index != InvalidBlock;
+					 index = m_blocks[index].nextFree)
+				{
+					if (fitsBlock(index, size, align))
+						return index;
+				}
+			}
+		}
+
+		return InvalidBlock;
+	}
+
+	bool TlsfAllocator::fitsBlock(uint32_t index, uint64_t size, uint64_t align) const
+	{
+		const Block& block   = m_blocks[index];
+		uint64_t     padding = alignOffset(block.offset, align) - block.offset;
+		return block.size >= padding && block.size - padding >= size;
+	}
+
+	void TlsfAllocator::insertFreeBlock(uint32_t index)
+	{
+		uint32_t fl, sl;
+		mapSize(m_blocks[index].size, fl, sl);
+
+		uint32_t& head  = m_freeHeads[fl * SlCount + sl];
+		Block&    block = m_blocks[index];
+
+		block.isFree   = true;
+		block.prevFree = InvalidBlock;
+		block.nextFree = head;
+
+		if (head != InvalidBlock)
+			m_blocks[head].prevFree = index;
+
+		head = index;
+
+		m_slBitmaps[fl] |= 1u << sl;
+		m_flBitmap |= 1ull << fl;
+		m_freeCount += 1;
+	}
+
+	void TlsfAllocator::removeFreeBlock(uint32_t index)
+	{
+		uint32_t fl, sl;
+		mapSize(m_blocks[index].size, fl, sl);
+
+		uint32_t& head  = m_freeHeads[fl * SlCount + sl];
+		Block&    block = m_blocks[index];
+
+		if (block.prevFree != InvalidBlock)
+			m_blocks[block.prevFree].nextFree = block.nextFree;
+
+		if (block.nextFree != InvalidBlock)
+			m_blocks[block.nextFree].prevFree = block.prevFree;
+
+		if (head == index)
+		{
+			head = block.nextFree;
+
+			if (head == InvalidBlock)
+			{
+				m_slBitmaps[fl] &= ~(1u << sl);
+
+				if (m_slBitmaps[fl] == 0)
+					m_flBitmap &= ~(1ull << fl);
+			}
+		}
+
+		block.isFree = false;
+		m_freeCount -= 1;
+	}
+
+	uint32_t TlsfAllocator::splitBlock(uint32_t index, uint64_t size)
+	{
+		// Creating a block may reallocate the block array,
+		// so don't hold references across this call.
+		uint32_t tail = createBlock();
+
+		Block& block = m_blocks[index];
+		Block& rest  = m_blocks[tail];
+
+		rest.offset   = block.offset + size;
+		rest.size     = block.size - size;
+		rest.prevPhys = index;
+		rest.nextPhys = block.nextPhys;
+		rest.isFree   = false;
+
+		if (block.nextPhys != InvalidBlock)
+			m_blocks[block.nextPhys].prevPhys = tail;
+
+		block.size     = size;
+		block.nextPhys = tail;
+		return tail;
+	}
+
+	void TlsfAllocator::mergeBlocks(uint32_t index, uint32_t next)
+	{
+		Block& block = m_blocks[index];
+		Block& other = m_blocks[next];
+
+		block.size += other.size;
+		block.nextPhys = other.nextPhys;
+
+		if (other.nextPhys != InvalidBlock)
+			m_blocks[other.nextPhys].prevPhys = index;
+
+		releaseBlock(next);
+	}
+
+	uint32_t TlsfAllocator::createBlock()
+	{
+		uint32_t index;
+
+		if (!m_unusedBlocks.empty())
+		{
+			index = m_unusedBlocks.back();
+			m_unusedBlocks.pop_back();
+		}
+		else
+		{
+			index = uint32_t(m_blocks.size());
+			m_blocks.emplace_back();
+		}
+
+		Block& block   = m_blocks[index];
+		block.prevFree = InvalidBlock;
+		block.nextFree = InvalidBlock;
+		block.isFree   = false;
+		return index;
+	}
+
+	void TlsfAllocator::releaseBlock(uint32_t index)
+	{
+		m_unusedBlocks.push_back(index);
+	}
+
+	uint32_t TlsfAllocator::getTableSlot(uint64_t offset) const
+	{
+		// Offsets are mostly aligned, multiply so the
+		// top bits depend on all of them.
+		return uint32_t((offset * 0x9E3779B97F4A7C15ull) >> (64 - m_allocTableBits));
+	}
+
+	uint32_t TlsfAllocator::findAllocation(uint64_t offset) const
+	{
+		uint32_t mask = uint32_t(m_allocTable.size()) - 1;
+		uint32_t slot = getTableSlot(offset);
+
+		while (m_allocTable[slot] != InvalidBlock)
+		{
+			if (m_blocks[m_allocTable[slot]].offset == offset)
+				return slot;
+
+			slot = (slot + 1) & mask;
+		}
+
+		return InvalidBlock;
+	}
+
+	void TlsfAllocator::insertAllocation(uint32_t index)
+	{
+		// Keep the table at most three quarters full
+		if ((m_allocCount + 1) * 4 > m_allocTable.size() * 3)
+			growAllocTable();
+
+		uint32_t mask = uint32_t(m_allocTable.size()) - 1;
+		uint32_t slot = getTableSlot(m_blocks[index].offset);
+
+		while (m_allocTable[slot] != InvalidBlock)
+			slot = (slot + 1) & mask;
+
+		m_allocTable[slot] = index;
+		m_allocCount += 1;
+	}
+
+	void TlsfAllocator::eraseAllocation(uint32_t slot)
+	{
+		// Shift following entries back into the hole, unless
+		// that moves them in front of their home slot, so
+		// lookups never stop at an empty slot too early.
+		uint32_t mask = uint32_t(m_allocTable.size()) - 1;
+		uint32_t hole = slot;
+		uint32_t next = (hole + 1) & mask;
+
+		while (m_allocTable[next] != InvalidBlock)
+		{
+			uint32_t home = getTableSlot(m_blocks[m_allocTable[next]].offset);
+
+			if (((next - home) & mask) >= ((next - hole) & mask))
+			{
+				m_allocTable[hole] = m_allocTable[next];
+				hole               = next;
+			}
+
+			next = (next + 1) & mask;
+		}
+
+		m_allocTable[hole] = InvalidBlock;
+		m_allocCount -= 1;
+	}
+
+	void TlsfAllocator::growAllocTable()
+	{
+		std::vector<uint32_t> table(m_allocTable.size() * 2, InvalidBlock);
+		std::swap(table, m_allocTable);
+
+		m_allocTableBits += 1;
+		m_allocCount = 0;
+
+		for (uint32_t index : table)
+		{
+			if (index != InvalidBlock)
+				insertAllocation(index);
+		}
+	}
+
+}  // namespace util
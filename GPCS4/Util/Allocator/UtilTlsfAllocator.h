@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace util
+{
+	/**
+	 * \brief TLSF allocator statistics
+	 */
+	struct TlsfStats
+	{
+		uint64_t totalSize        = 0;  ///< Size of the managed range
+		uint64_t usedSize         = 0;  ///< Bytes currently allocated
+		uint64_t largestFreeBlock = 0;  ///< Size of the largest free block
+		uint32_t allocCount       = 0;  ///< Number of live allocations
+		uint32_t freeBlockCount   = 0;  ///< Number of free blocks
+	};
+
+	/**
+	 * \brief Two-level segregated fit allocator
+	 *
+	 * Manages offsets into an external range of memory,
+	 * so it does not touch the memory it hands out and
+	 * can be used for device memory.
+	 *
+	 * Free blocks are binned by the position of their
+	 * highest set bit and the next SlBits bits below it.
+	 * Two levels of bitmaps locate a large enough free
+	 * block in constant time, and freed blocks are merged
+	 * with their free neighbours immediately. Only when
+	 * that search fails are the bins it rounded past
+	 * walked for a block that fits exactly.
+	 *
+	 * This is not thread-safe.
+	 */
+	class TlsfAllocator
+	{
+		constexpr static uint32_t SlBits  = 5;
+		constexpr static uint32_t SlCount = 1u << SlBits;
+		constexpr static uint32_t FlCount = 64 - SlBits + 1;
+
+		constexpr static uint32_t InvalidBlock = ~0u;
+
+		constexpr static uint32_t MinTableBits = 6;
+
+	public:
+		constexpr static uint64_t InvalidOffset = ~0ull;
+
+		TlsfAllocator(uint64_t size);
+		~TlsfAllocator();
+
+		/**
+		 * \brief Allocates a range
+		 *
+		 * \param [in] size Number of bytes to allocate
+		 * \param [in] align Required alignment, a power of two
+		 * \returns Offset of the range, or \c InvalidOffset
+		 *          if no free block is large enough
+		 */
+		uint64_t alloc(uint64_t size, uint64_t align);
+
+		/**
+		 * \brief Frees a range
+		 *
+		 * \param [in] offset Offset returned by \c alloc
+		 * \returns Number of bytes freed, or 0 if
+		 *          the offset is not allocated
+		 */
+		uint64_t free(uint64_t offset);
+
+		/**
+		 * \brief Checks whether no range is allocated
+		 * \returns \c true if all memory is free
+		 */
+		bool isEmpty() const
+		{
+			return m_used == 0;
+		}
+
+		/**
+		 * \brief Retrieves allocator statistics
+		 * \returns Allocator statistics
+		 */
+		TlsfStats getStats() const;
+
+		/**
+		 * \brief Computes external fragmentation
+		 *
+		 * The share of free memory which is not
+		 * part of the largest free block.
+		 * \returns Value between 0 and 1
+		 */
+		float fragmentation() const;
+
+	private:
+		struct Block
+		{
+			uint64_t offset;
+			uint64_t size;
+			uint32_t prevPhys;
+			uint32_t nextPhys;
+			uint32_t prevFree;
+			uint32_t nextFree;
+			bool     isFree;
+		};
+
+		uint64_t m_size;
+		uint64_t m_used = 0;
+
+		uint64_t                                m_flBitmap = 0;
+		std::array<uint32_t, FlCount>           m_slBitmaps;
+		std::array<uint32_t, FlCount * SlCount> m_freeHeads;
+		uint32_t                                m_freeCount = 0;
+
+		// Block records are recycled through the
+		// unused list, links between them are indices.
+		std::vector<Block>    m_blocks;
+		std::vector<uint32_t> m_unusedBlocks;
+
+		// Open addressing table of allocated block indices, keyed
+		// by block offset. It only allocates when it doubles, a
+		// node based map would allocate on every alloc call.
+		std::vector<uint32_t> m_allocTable;
+		uint32_t              m_allocTableBits = MinTableBits;
+		uint32_t              m_allocCount     = 0;
+
+		static void mapSize(
+			uint64_t  size,
+			uint32_t& fl,
+			uint32_t& sl);
+
+		uint32_t findFreeBlock(uint64_t size) const;
+
+		uint32_t findFittingBlock(uint64_t size, uint64_t align) const;
+
+		bool fitsBlock(uint32_t index, uint64_t size, uint64_t align) const;
+
+		void insertFreeBlock(uint32_t index);
+
+		void removeFreeBlock(uint32_t index);
+
+		uint32_t splitBlock(uint32_t index, uint64_t size);
+
+		void mergeBlocks(uint32_t index, uint32_t next);
+
+		uint32_t createBlock();
+
+		void releaseBlock(uint32_t index);
+
+		uint32_t getTableSlot(uint64_t offset) const;
+
+		uint32_t findAllocation(uint64_t offset) const;
+
+		void insertAllocation(uint32_t index);
+
+		void eraseAllocation(uint32_t slot);
+
+		void growAllocTable();
+	};
+
+}  // namespace util
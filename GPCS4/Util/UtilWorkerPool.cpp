@@ -0,0 +1,135 @@
+#include "UtilWorkerPool.h"
+
+#include <algorithm>
+
+namespace util
+{
+
+	WorkerPool::WorkerPool(uint32_t threadCount)
+	{
+		for (uint32_t i = 0; i < threadCount; ++i)
+		{
+			m_threads.emplace_back([this]() { runWorker(); });
+		}
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopped = true;
+		}
+		m_jobCond.notify_all();
+
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	void WorkerPool::parallelFor(
+		uint32_t                             count,
+		const std::function<void(uint32_t)>& func)
+	{
+		do
+		{
+			if (count == 0)
+			{
+				break;
+			}
+
+			if (count == 1 || m_threads.empty())
+			{
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					func(i);
+				}
+				break;
+			}
+
+			auto job   = std::make_shared<Job>();
+			job->func  = func;
+			job->count = count;
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_jobs.push_back(job);
+			}
+			m_jobCond.notify_all();
+
+			// Help with our own job, then wait for
+			// iterations still running on workers.
+			while (runJob(*job))
+				;
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			auto                         iter = std::find(m_jobs.begin(), m_jobs.end(), job);
+			if (iter != m_jobs.end())
+			{
+				m_jobs.erase(iter);
+			}
+
+			m_doneCond.wait(lock, [&job]
+							{ return job->done.load(std::memory_order_acquire) == job->count; });
+		} while (false);
+	}
+
+	WorkerPool& WorkerPool::global()
+	{
+		static WorkerPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+		return pool;
+	}
+
+	void WorkerPool::runWorker()
+	{
+		while (true)
+		{
+			std::shared_ptr<Job> job;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobCond.wait(lock, [this]
+							   { return m_stopped || !m_jobs.empty(); });
+				if (m_stopped)
+				{
+					break;
+				}
+
+				job = m_jobs.front();
+				// All iterations are claimed, leave the
+				// remaining ones to the threads running them.
+				if (job->next.load(std::memory_order_relaxed) >= job->count)
+				{
+					m_jobs.pop_front();
+					continue;
+				}
+			}
+
+			while (runJob(*job))
+				;
+		}
+	}
+
+	bool WorkerPool::runJob(Job& job)
+	{
+		uint32_t index = job.next.fetch_add(1, std::memory_order_relaxed);
+		if (index >= job.count)
+		{
+			return false;
+		}
+
+		job.func(index);
+
+		if (job.done.fetch_add(1, std::memory_order_acq_rel) + 1 == job.count)
+		{
+			// Take the lock so the wakeup can't slip in between
+			// the waiter checking the count and going to sleep.
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+			}
+			m_doneCond.notify_all();
+			return false;
+		}
+		return true;
+	}
+
+}  // namespace util
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "GPCS4Common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+
+	/**
+     * \brief Worker pool
+     *
+     * A fixed set of threads running data parallel
+     * loops, shared by CPU heavy conversions such as
+     * surface detiling. The calling thread takes part
+     * in its own loop, so nested or concurrent loops
+     * always make progress.
+     */
+	class WorkerPool
+	{
+		struct Job
+		{
+			std::function<void(uint32_t)> func;
+			uint32_t                      count = 0;
+			std::atomic<uint32_t>         next  = { 0 };
+			std::atomic<uint32_t>         done  = { 0 };
+		};
+
+	public:
+		explicit WorkerPool(uint32_t threadCount);
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		/**
+         * \brief Number of worker threads
+         */
+		uint32_t threadCount() const
+		{
+			return uint32_t(m_threads.size());
+		}
+
+		/**
+         * \brief Runs a loop in parallel
+         *
+         * Calls \c func for each index in \c [0, count)
+         * on the workers and the calling thread, and
+         * returns once all iterations are done.
+         * \param [in] count Iteration count
+         * \param [in] func Loop body
+         */
+		void parallelFor(
+			uint32_t                             count,
+			const std::function<void(uint32_t)>& func);
+
+		/**
+         * \brief Process wide pool
+         *
+         * Created on first use, with one worker
+         * less than the number of hardware threads.
+         */
+		static WorkerPool& global();
+
+	private:
+		void runWorker();
+
+		bool runJob(Job& job);
+
+	private:
+		std::mutex                       m_mutex;
+		std::condition_variable          m_jobCond;
+		std::condition_variable          m_doneCond;
+		std::deque<std::shared_ptr<Job>> m_jobs;
+		bool                             m_stopped = false;
+
+		std::vector<std::thread> m_threads;
+	};
+
+}  // namespace util